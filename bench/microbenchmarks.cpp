@@ -0,0 +1,374 @@
+/* mockturtle: C++ logic network library
+ * Copyright (C) 2018-2022  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*!
+  \file microbenchmarks.cpp
+  \brief Microbenchmarks of core data structures and kernels
+
+  Usage: run_benchmarks [--filter <substring>] [--repetitions <n>] [--output <file.json>]
+
+  Each benchmark is run `repetitions` times on the same input.  The
+  results (minimum and median time, and throughput) are printed as
+  a table and, if an output file is given, written as JSON for regression
+  tracking.
+*/
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <fmt/format.h>
+#include <kitty/constructors.hpp>
+#include <kitty/dynamic_truth_table.hpp>
+#include <kitty/npn.hpp>
+#include <kitty/partial_truth_table.hpp>
+#include <lorina/aiger.hpp>
+#include <lorina/verilog.hpp>
+#include <nlohmann/json.hpp>
+
+#include <mockturtle/algorithms/cut_enumeration.hpp>
+#include <mockturtle/algorithms/simulation.hpp>
+#include <mockturtle/generators/arithmetic.hpp>
+#include <mockturtle/generators/random_network.hpp>
+#include <mockturtle/io/aiger_reader.hpp>
+#include <mockturtle/io/verilog_reader.hpp>
+#include <mockturtle/io/write_aiger.hpp>
+#include <mockturtle/io/write_verilog.hpp>
+#include <mockturtle/networks/aig.hpp>
+#include <mockturtle/utils/node_map.hpp>
+#include <mockturtle/utils/truth_table_cache.hpp>
+#include <mockturtle/views/fanout_view.hpp>
+
+using namespace mockturtle;
+
+namespace
+{
+
+/* keeps results alive such that the compiler does not remove the kernels */
+volatile uint64_t sink;
+
+struct benchmark
+{
+  std::string name;
+
+  /* prepares the input and returns the kernel, which returns the number of processed items */
+  std::function<std::function<uint64_t()>()> setup;
+};
+
+struct result
+{
+  std::string name;
+  uint64_t items;
+  std::vector<double> seconds;
+};
+
+aig_network multiplier( uint32_t bits )
+{
+  aig_network aig;
+  std::vector<aig_network::signal> a( bits ), b( bits );
+  std::generate( a.begin(), a.end(), [&]() { return aig.create_pi(); } );
+  std::generate( b.begin(), b.end(), [&]() { return aig.create_pi(); } );
+  for ( auto const& f : carry_ripple_multiplier( aig, a, b ) )
+  {
+    aig.create_po( f );
+  }
+  return aig;
+}
+
+aig_network random_aig( uint32_t num_pis, uint32_t num_gates, uint64_t seed )
+{
+  random_network_generator_params_size ps;
+  ps.seed = seed;
+  ps.num_pis = num_pis;
+  ps.num_gates = num_gates;
+  return random_aig_generator( ps ).generate();
+}
+
+std::vector<benchmark> make_benchmarks()
+{
+  std::vector<benchmark> benchmarks;
+
+  /* structural hashing: half of the requests hit existing nodes */
+  benchmarks.push_back( { "aig_create_and", []() {
+                           return []() -> uint64_t {
+                             constexpr uint32_t num_ands = 1000000u;
+                             std::mt19937 rng( 1u );
+                             aig_network aig;
+                             std::vector<aig_network::signal> fs;
+                             for ( auto i = 0u; i < 64u; ++i )
+                             {
+                               fs.push_back( aig.create_pi() );
+                             }
+                             for ( auto i = 0u; i < num_ands; ++i )
+                             {
+                               auto const window = std::min<uint32_t>( fs.size(), 256u );
+                               auto const a = fs[fs.size() - 1u - rng() % window];
+                               auto const b = fs[fs.size() - 1u - rng() % window];
+                               auto const f = aig.create_and( a ^ ( rng() & 1u ), b ^ ( rng() & 1u ) );
+                               if ( i % 2u == 0u )
+                               {
+                                 fs.push_back( f );
+                               }
+                             }
+                             sink = aig.size();
+                             return num_ands;
+                           };
+                         } } );
+
+  benchmarks.push_back( { "node_map_access", []() {
+                           auto aig = std::make_shared<aig_network>( multiplier( 64u ) );
+                           return [aig]() -> uint64_t {
+                             constexpr uint32_t rounds = 20u;
+                             node_map<uint32_t, aig_network> values( *aig );
+                             for ( auto r = 0u; r < rounds; ++r )
+                             {
+                               aig->foreach_gate( [&]( auto const& n ) {
+                                 uint32_t v = r;
+                                 aig->foreach_fanin( n, [&]( auto const& f ) {
+                                   v += values[f];
+                                 } );
+                                 values[n] = v;
+                               } );
+                             }
+                             sink = values[aig->get_node( aig->po_at( 0 ) )];
+                             return uint64_t( rounds ) * aig->num_gates();
+                           };
+                         } } );
+
+  benchmarks.push_back( { "fanout_view_construction", []() {
+                           auto aig = std::make_shared<aig_network>( multiplier( 64u ) );
+                           return [aig]() -> uint64_t {
+                             fanout_view<aig_network> fanout_aig{ *aig };
+                             sink = fanout_aig.fanout( aig->pi_at( 0 ) ).size();
+                             return aig->size();
+                           };
+                         } } );
+
+  benchmarks.push_back( { "simulate_nodes_256", []() {
+                           auto aig = std::make_shared<aig_network>( multiplier( 64u ) );
+                           auto sim = std::make_shared<partial_simulator>( aig->num_pis(), 256u );
+                           return [aig, sim]() -> uint64_t {
+                             auto const values = simulate_nodes<kitty::partial_truth_table>( *aig, *sim );
+                             sink = values[aig->get_node( aig->po_at( 0 ) )]._bits[0];
+                             return aig->num_gates();
+                           };
+                         } } );
+
+  benchmarks.push_back( { "cut_enumeration_6_8", []() {
+                           auto aig = std::make_shared<aig_network>( random_aig( 64u, 20000u, 2u ) );
+                           return [aig]() -> uint64_t {
+                             cut_enumeration_params ps;
+                             ps.cut_size = 6u;
+                             ps.cut_limit = 8u;
+                             auto const cuts = cut_enumeration<aig_network, true>( *aig, ps );
+                             sink = cuts.total_cuts();
+                             return aig->num_gates();
+                           };
+                         } } );
+
+  benchmarks.push_back( { "exact_npn_canonization_4", []() {
+                           auto tts = std::make_shared<std::vector<kitty::dynamic_truth_table>>( 10000u, kitty::dynamic_truth_table( 4u ) );
+                           for ( auto i = 0u; i < tts->size(); ++i )
+                           {
+                             kitty::create_random( ( *tts )[i], i );
+                           }
+                           return [tts]() -> uint64_t {
+                             uint64_t checksum{ 0u };
+                             for ( auto const& tt : *tts )
+                             {
+                               checksum += std::get<0>( kitty::exact_npn_canonization( tt ) )._bits[0];
+                             }
+                             sink = checksum;
+                             return tts->size();
+                           };
+                         } } );
+
+  benchmarks.push_back( { "truth_table_cache_insert_6", []() {
+                           /* a quarter of the insertions are repeated functions */
+                           auto tts = std::make_shared<std::vector<kitty::dynamic_truth_table>>( 200000u, kitty::dynamic_truth_table( 6u ) );
+                           for ( auto i = 0u; i < tts->size(); ++i )
+                           {
+                             kitty::create_random( ( *tts )[i], i % 4u == 3u ? i / 4u : i );
+                           }
+                           return [tts]() -> uint64_t {
+                             truth_table_cache<kitty::dynamic_truth_table> cache( tts->size() );
+                             for ( auto const& tt : *tts )
+                             {
+                               cache.insert( tt );
+                             }
+                             sink = cache.size();
+                             return tts->size();
+                           };
+                         } } );
+
+  benchmarks.push_back( { "read_aiger", []() {
+                           std::vector<std::string> names = { "adder", "bar", "div", "log2", "max", "multiplier", "sin", "sqrt", "square" };
+                           std::vector<std::string> files;
+                           for ( auto const& name : names )
+                           {
+                             std::ifstream in( fmt::format( "{}/{}.aig", BENCHMARKS_PATH, name ), std::ifstream::binary );
+                             if ( in.good() )
+                             {
+                               files.emplace_back( std::istreambuf_iterator<char>( in ), std::istreambuf_iterator<char>() );
+                             }
+                           }
+                           /* fall back to a synthetic network if the benchmarks are missing */
+                           if ( files.empty() )
+                           {
+                             std::ostringstream os;
+                             write_aiger( multiplier( 64u ), os );
+                             files.push_back( os.str() );
+                           }
+                           auto contents = std::make_shared<std::vector<std::string>>( files );
+                           return [contents]() -> uint64_t {
+                             uint64_t gates{ 0u };
+                             for ( auto const& content : *contents )
+                             {
+                               aig_network aig;
+                               std::istringstream in( content );
+                               if ( lorina::read_aiger( in, aiger_reader( aig ) ) != lorina::return_code::success )
+                               {
+                                 std::cerr << "[e] could not parse AIGER benchmark\n";
+                               }
+                               gates += aig.num_gates();
+                             }
+                             sink = gates;
+                             return gates;
+                           };
+                         } } );
+
+  benchmarks.push_back( { "read_verilog", []() {
+                           std::ostringstream os;
+                           write_verilog( random_aig( 128u, 50000u, 3u ), os );
+                           auto content = std::make_shared<std::string>( os.str() );
+                           return [content]() -> uint64_t {
+                             aig_network aig;
+                             std::istringstream in( *content );
+                             if ( lorina::read_verilog( in, verilog_reader( aig ) ) != lorina::return_code::success )
+                             {
+                               std::cerr << "[e] could not parse Verilog benchmark\n";
+                             }
+                             sink = aig.num_gates();
+                             return aig.num_gates();
+                           };
+                         } } );
+
+  return benchmarks;
+}
+
+double median( std::vector<double> values )
+{
+  std::sort( values.begin(), values.end() );
+  auto const mid = values.size() / 2u;
+  return values.size() % 2u == 1u ? values[mid] : 0.5 * ( values[mid - 1u] + values[mid] );
+}
+
+} // namespace
+
+int main( int argc, char** argv )
+{
+  std::string filter;
+  std::string output;
+  uint32_t repetitions = 5u;
+
+  for ( auto i = 1; i < argc; ++i )
+  {
+    std::string const arg = argv[i];
+    if ( arg == "--filter" && i + 1 < argc )
+    {
+      filter = argv[++i];
+    }
+    else if ( arg == "--repetitions" && i + 1 < argc )
+    {
+      repetitions = std::max( 1, std::stoi( argv[++i] ) );
+    }
+    else if ( arg == "--output" && i + 1 < argc )
+    {
+      output = argv[++i];
+    }
+    else
+    {
+      std::cerr << "usage: " << argv[0] << " [--filter <substring>] [--repetitions <n>] [--output <file.json>]\n";
+      return 1;
+    }
+  }
+
+  std::vector<result> results;
+  std::cout << fmt::format( "{:<28} {:>12} {:>12} {:>12} {:>14}\n", "benchmark", "items", "min [ms]", "median [ms]", "items/s" );
+  for ( auto const& b : make_benchmarks() )
+  {
+    if ( !filter.empty() && b.name.find( filter ) == std::string::npos )
+    {
+      continue;
+    }
+
+    auto kernel = b.setup();
+    result r{ b.name, 0u, {} };
+    for ( auto i = 0u; i < repetitions; ++i )
+    {
+      auto const start = std::chrono::steady_clock::now();
+      r.items = kernel();
+      auto const end = std::chrono::steady_clock::now();
+      r.seconds.push_back( std::chrono::duration<double>( end - start ).count() );
+    }
+
+    auto const min = *std::min_element( r.seconds.begin(), r.seconds.end() );
+    std::cout << fmt::format( "{:<28} {:>12} {:>12.3f} {:>12.3f} {:>14.0f}\n", r.name, r.items, min * 1e3, median( r.seconds ) * 1e3, r.items / min );
+    results.push_back( r );
+  }
+
+  if ( !output.empty() )
+  {
+    nlohmann::json entries = nlohmann::json::array();
+    for ( auto const& r : results )
+    {
+      auto const min = *std::min_element( r.seconds.begin(), r.seconds.end() );
+      entries.push_back( { { "name", r.name },
+                           { "items", r.items },
+                           { "repetitions", r.seconds.size() },
+                           { "seconds", r.seconds },
+                           { "min_seconds", min },
+                           { "median_seconds", median( r.seconds ) },
+                           { "items_per_second", r.items / min } } );
+    }
+
+    nlohmann::json data = { { "benchmarks", entries } };
+#ifdef GIT_SHORT_REVISION
+    data["version"] = GIT_SHORT_REVISION;
+#endif
+
+    std::ofstream os( output, std::ofstream::out );
+    os << data.dump( 2 ) << "\n";
+  }
+
+  return 0;
+}
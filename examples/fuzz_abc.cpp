@@ -21,8 +21,8 @@ int main( int argc, char* argv[] )
   }
 
   std::string commands( argv[1] );
-  auto fn = [&]( std::string const& filename ) -> std::string {
-    return "abc -c \"read " + filename + "; " + commands + "; write fuzz_opt.aig\"";
+  auto fn = [&]( std::string const& filename, std::string const& outputfile ) -> std::string {
+    return "abc -c \"read " + filename + "; " + commands + "; write " + outputfile + "\"";
   };
 
 #ifdef ENABLE_NAUTY
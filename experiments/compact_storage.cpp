@@ -0,0 +1,114 @@
+/* mockturtle: C++ logic network library
+ * Copyright (C) 2018-2022  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <cstdint>
+#include <string>
+
+#include <fmt/format.h>
+#include <lorina/aiger.hpp>
+#include <mockturtle/algorithms/cleanup.hpp>
+#include <mockturtle/algorithms/lut_mapper.hpp>
+#include <mockturtle/io/aiger_reader.hpp>
+#include <mockturtle/networks/aig.hpp>
+#include <mockturtle/networks/mig.hpp>
+#include <mockturtle/utils/stopwatch.hpp>
+#include <mockturtle/views/depth_view.hpp>
+
+#include <experiments.hpp>
+
+using namespace mockturtle;
+
+struct storage_result
+{
+  double memory{ 0 };     /* MB */
+  double build_time{ 0 }; /* s */
+  double map_time{ 0 };   /* s */
+  uint32_t luts{ 0 };
+};
+
+/* reads and rebuilds the benchmark, computes its depth, and maps it into 6-LUTs */
+template<class Ntk>
+storage_result evaluate_layout( std::string const& benchmark )
+{
+  storage_result result;
+  stopwatch<>::duration build_time{ 0 }, map_time{ 0 };
+
+  Ntk ntk;
+  call_with_stopwatch( build_time, [&]() {
+    if ( lorina::read_aiger( experiments::benchmark_path( benchmark ), aiger_reader( ntk ) ) == lorina::return_code::success )
+    {
+      ntk = cleanup_dangling( ntk );
+    }
+    depth_view<Ntk> depth_ntk{ ntk };
+    (void)depth_ntk.depth();
+  } );
+  result.memory = ntk.memory_usage() / ( 1024.0 * 1024.0 );
+
+  call_with_stopwatch( map_time, [&]() {
+    result.luts = lut_map( ntk ).num_gates();
+  } );
+
+  result.build_time = to_seconds( build_time );
+  result.map_time = to_seconds( map_time );
+  return result;
+}
+
+int main()
+{
+  using namespace experiments;
+
+  experiment<std::string, uint32_t, double, double, double, double, double, double, double, double, double, double, bool> exp(
+      "compact_storage", "benchmark", "size", "aig MB", "compact MB", "cold MB", "mig MB", "cold mig MB", "aig build", "compact build", "cold build", "aig map", "cold map", "equal" );
+
+  for ( auto const& benchmark : epfl_benchmarks() )
+  {
+    fmt::print( "[i] processing {}\n", benchmark );
+
+    aig_network aig;
+    if ( lorina::read_aiger( benchmark_path( benchmark ), aiger_reader( aig ) ) != lorina::return_code::success )
+    {
+      continue;
+    }
+
+    auto const wide = evaluate_layout<aig_network>( benchmark );
+    auto const compact = evaluate_layout<compact_aig_network>( benchmark );
+    auto const cold = evaluate_layout<compact_cold_aig_network>( benchmark );
+
+    mig_network mig;
+    compact_cold_mig_network cold_mig;
+    bool equal = lorina::read_aiger( benchmark_path( benchmark ), aiger_reader( mig ) ) == lorina::return_code::success;
+    equal &= lorina::read_aiger( benchmark_path( benchmark ), aiger_reader( cold_mig ) ) == lorina::return_code::success;
+    equal &= wide.luts == compact.luts && wide.luts == cold.luts;
+
+    exp( benchmark, aig.num_gates(), wide.memory, compact.memory, cold.memory,
+         mig.memory_usage() / ( 1024.0 * 1024.0 ), cold_mig.memory_usage() / ( 1024.0 * 1024.0 ),
+         wide.build_time, compact.build_time, cold.build_time, wide.map_time, cold.map_time, equal );
+  }
+
+  exp.save();
+  exp.table();
+
+  return 0;
+}
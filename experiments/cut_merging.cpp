@@ -0,0 +1,90 @@
+/* mockturtle: C++ logic network library
+ * Copyright (C) 2018-2019  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <string>
+
+#include <fmt/format.h>
+#include <lorina/aiger.hpp>
+#include <mockturtle/algorithms/cut_enumeration.hpp>
+#include <mockturtle/algorithms/lut_mapper.hpp>
+#include <mockturtle/io/aiger_reader.hpp>
+#include <mockturtle/networks/aig.hpp>
+#include <mockturtle/utils/stopwatch.hpp>
+
+#include <experiments.hpp>
+
+/* Runtime of cut enumeration and LUT mapping with 6- and 8-input cuts.  Build
+ * with and without MOCKTURTLE_ENABLE_AVX2 to compare the cut-merge kernels. */
+int main()
+{
+  using namespace experiments;
+  using namespace mockturtle;
+
+  experiment<std::string, uint32_t, double, double, double, double, uint32_t, uint32_t> exp( "cut_merging", "benchmark", "size", "enum6", "enum8", "map6", "map8", "luts6", "luts8" );
+
+  for ( auto const& benchmark : epfl_benchmarks() )
+  {
+    if ( benchmark == "hyp" )
+    {
+      continue;
+    }
+
+    fmt::print( "[i] processing {}\n", benchmark );
+    aig_network aig;
+    if ( lorina::read_aiger( benchmark_path( benchmark ), aiger_reader( aig ) ) != lorina::return_code::success )
+    {
+      continue;
+    }
+
+    double time_enum[2], time_map[2];
+    uint32_t luts[2];
+    for ( auto i = 0u; i < 2u; ++i )
+    {
+      uint32_t const cut_size = i == 0u ? 6u : 8u;
+
+      cut_enumeration_params cps;
+      cps.cut_size = cut_size;
+      cps.cut_limit = 8u;
+      cut_enumeration_stats cst;
+      cut_enumeration( aig, cps, &cst );
+      time_enum[i] = to_seconds( cst.time_total );
+
+      lut_map_params mps;
+      mps.cut_enumeration_ps.cut_size = cut_size;
+      mps.cut_enumeration_ps.cut_limit = 8u;
+      lut_map_stats mst;
+      auto const klut = lut_map( aig, mps, &mst );
+      time_map[i] = to_seconds( mst.time_total );
+      luts[i] = klut.num_gates();
+    }
+
+    exp( benchmark, aig.num_gates(), time_enum[0], time_enum[1], time_map[0], time_map[1], luts[0], luts[1] );
+  }
+
+  exp.save();
+  exp.table();
+
+  return 0;
+}
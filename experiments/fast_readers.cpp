@@ -0,0 +1,89 @@
+/* mockturtle: C++ logic network library
+ * Copyright (C) 2018-2019  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <cstdio>
+#include <string>
+
+#include <fmt/format.h>
+#include <lorina/aiger.hpp>
+#include <lorina/blif.hpp>
+#include <lorina/verilog.hpp>
+#include <mockturtle/io/aiger_reader.hpp>
+#include <mockturtle/io/blif_reader.hpp>
+#include <mockturtle/io/fast_blif_reader.hpp>
+#include <mockturtle/io/fast_verilog_reader.hpp>
+#include <mockturtle/io/verilog_reader.hpp>
+#include <mockturtle/io/write_blif.hpp>
+#include <mockturtle/io/write_verilog.hpp>
+#include <mockturtle/networks/aig.hpp>
+#include <mockturtle/networks/klut.hpp>
+#include <mockturtle/utils/stopwatch.hpp>
+
+#include <experiments.hpp>
+
+int main()
+{
+  using namespace experiments;
+  using namespace mockturtle;
+
+  experiment<std::string, uint32_t, double, double, double, double, bool> exp( "fast_readers", "benchmark", "size", "verilog_lorina", "verilog_fast", "blif_lorina", "blif_fast", "equal" );
+
+  std::string const verilog_file = "fast_readers_tmp.v";
+  std::string const blif_file = "fast_readers_tmp.blif";
+
+  for ( auto const& benchmark : epfl_benchmarks() )
+  {
+    fmt::print( "[i] processing {}\n", benchmark );
+    aig_network aig;
+    if ( lorina::read_aiger( benchmark_path( benchmark ), aiger_reader( aig ) ) != lorina::return_code::success )
+    {
+      continue;
+    }
+    write_verilog( aig, verilog_file );
+    write_blif( aig, blif_file );
+
+    stopwatch<>::duration time_verilog_lorina{ 0 }, time_verilog_fast{ 0 }, time_blif_lorina{ 0 }, time_blif_fast{ 0 };
+    aig_network aig_lorina, aig_fast;
+    klut_network klut_lorina, klut_fast;
+    bool equal = true;
+
+    call_with_stopwatch( time_verilog_lorina, [&]() { equal &= lorina::read_verilog( verilog_file, verilog_reader( aig_lorina ) ) == lorina::return_code::success; } );
+    call_with_stopwatch( time_verilog_fast, [&]() { equal &= read_verilog_fast( verilog_file, aig_fast ) == lorina::return_code::success; } );
+    call_with_stopwatch( time_blif_lorina, [&]() { equal &= lorina::read_blif( blif_file, blif_reader( klut_lorina ) ) == lorina::return_code::success; } );
+    call_with_stopwatch( time_blif_fast, [&]() { equal &= read_blif_fast( blif_file, klut_fast ) == lorina::return_code::success; } );
+
+    equal &= aig_lorina.num_gates() == aig_fast.num_gates() && klut_lorina.num_gates() == klut_fast.num_gates();
+
+    exp( benchmark, aig.num_gates(), to_seconds( time_verilog_lorina ), to_seconds( time_verilog_fast ), to_seconds( time_blif_lorina ), to_seconds( time_blif_fast ), equal );
+  }
+
+  std::remove( verilog_file.c_str() );
+  std::remove( blif_file.c_str() );
+
+  exp.save();
+  exp.table();
+
+  return 0;
+}
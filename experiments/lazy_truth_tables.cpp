@@ -0,0 +1,100 @@
+/* mockturtle: C++ logic network library
+ * Copyright (C) 2018-2019  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <string>
+
+#include <fmt/format.h>
+#include <lorina/aiger.hpp>
+#include <mockturtle/algorithms/cut_enumeration.hpp>
+#include <mockturtle/io/aiger_reader.hpp>
+#include <mockturtle/networks/aig.hpp>
+#include <mockturtle/utils/stopwatch.hpp>
+
+#include <experiments.hpp>
+
+/* Eager versus on-demand truth tables in cut enumeration, for a consumer
+ * that queries the function of one cut per gate (as a LUT mapper that
+ * stores the functions of the selected cuts). */
+int main()
+{
+  using namespace experiments;
+  using namespace mockturtle;
+
+  experiment<std::string, uint64_t, uint64_t, uint64_t, double, double, double, uint64_t, uint64_t> exp( "lazy_truth_tables", "benchmark", "cuts", "tts eager", "tts lazy", "avoided", "time eager", "time lazy", "cache eager", "cache lazy" );
+
+  for ( auto const& benchmark : epfl_benchmarks() )
+  {
+    if ( benchmark == "hyp" )
+    {
+      continue;
+    }
+
+    fmt::print( "[i] processing {}\n", benchmark );
+    aig_network aig;
+    if ( lorina::read_aiger( benchmark_path( benchmark ), aiger_reader( aig ) ) != lorina::return_code::success )
+    {
+      continue;
+    }
+
+    cut_enumeration_params ps;
+    ps.cut_size = 6u;
+    ps.cut_limit = 8u;
+
+    auto const query = [&]( auto const& cuts ) {
+      aig.foreach_gate( [&]( auto const& n ) {
+        /* the last cut before the unit cut */
+        auto const& set = cuts.cuts( aig.node_to_index( n ) );
+        cuts.truth_table( set[set.size() > 1u ? set.size() - 2u : 0u] );
+      } );
+    };
+
+    stopwatch<>::duration time_eager{ 0 };
+    cut_enumeration_stats st_eager;
+    auto const eager = call_with_stopwatch( time_eager, [&]() {
+      auto cuts = cut_enumeration<aig_network, true>( aig, ps, &st_eager );
+      query( cuts );
+      return cuts;
+    } );
+
+    ps.lazy_truth_tables = true;
+    stopwatch<>::duration time_lazy{ 0 };
+    cut_enumeration_stats st_lazy;
+    auto const lazy = call_with_stopwatch( time_lazy, [&]() {
+      auto cuts = cut_enumeration<aig_network, true>( aig, ps, &st_lazy );
+      query( cuts );
+      return cuts;
+    } );
+
+    auto const avoided = st_eager.num_truth_tables == 0u ? 0.0 : 1.0 - static_cast<double>( lazy.num_deferred_truth_tables() ) / st_eager.num_truth_tables;
+
+    exp( benchmark, static_cast<uint64_t>( eager.total_cuts() ), st_eager.num_truth_tables, lazy.num_deferred_truth_tables(), avoided,
+         to_seconds( time_eager ), to_seconds( time_lazy ), static_cast<uint64_t>( eager.num_truth_tables() ), static_cast<uint64_t>( lazy.num_truth_tables() ) );
+  }
+
+  exp.save();
+  exp.table();
+
+  return 0;
+}
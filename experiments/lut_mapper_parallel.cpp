@@ -0,0 +1,81 @@
+/* mockturtle: C++ logic network library
+ * Copyright (C) 2018-2019  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <string>
+#include <thread>
+
+#include <fmt/format.h>
+#include <lorina/aiger.hpp>
+#include <mockturtle/algorithms/lut_mapper.hpp>
+#include <mockturtle/io/aiger_reader.hpp>
+#include <mockturtle/networks/aig.hpp>
+#include <mockturtle/networks/klut.hpp>
+#include <mockturtle/views/depth_view.hpp>
+
+#include <experiments.hpp>
+
+int main()
+{
+  using namespace experiments;
+  using namespace mockturtle;
+
+  uint32_t const num_threads = std::max( 2u, std::thread::hardware_concurrency() );
+
+  experiment<std::string, uint32_t, uint32_t, double, double, double, bool> exp( "lut_mapper_parallel", "benchmark", "luts", "lut_depth", "runtime", "runtime_mt", "speedup", "same" );
+
+  for ( auto const& benchmark : epfl_benchmarks() )
+  {
+    fmt::print( "[i] processing {}\n", benchmark );
+    aig_network aig;
+    if ( lorina::read_aiger( benchmark_path( benchmark ), aiger_reader( aig ) ) != lorina::return_code::success )
+    {
+      continue;
+    }
+
+    lut_map_params ps;
+    ps.cut_enumeration_ps.cut_size = 6u;
+    ps.cut_enumeration_ps.cut_limit = 8u;
+    ps.recompute_cuts = true;
+    ps.area_oriented_mapping = false;
+    ps.cut_expansion = true;
+    lut_map_stats st;
+    const auto klut = lut_map( aig, ps, &st );
+
+    ps.num_threads = num_threads;
+    lut_map_stats st_mt;
+    const auto klut_mt = lut_map( aig, ps, &st_mt );
+
+    depth_view<klut_network> klut_d{ klut }, klut_mt_d{ klut_mt };
+
+    bool const same = klut.num_gates() == klut_mt.num_gates() && klut_d.depth() == klut_mt_d.depth() && st.edges == st_mt.edges;
+
+    exp( benchmark, klut.num_gates(), klut_d.depth(), to_seconds( st.time_total ), to_seconds( st_mt.time_total ), to_seconds( st.time_total ) / to_seconds( st_mt.time_total ), same );
+  }
+
+  exp.save();
+  exp.table();
+
+  return 0;
+}
@@ -0,0 +1,104 @@
+/* mockturtle: C++ logic network library
+ * Copyright (C) 2018-2019  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <string>
+#include <vector>
+
+#include <fmt/format.h>
+#include <lorina/aiger.hpp>
+#include <mockturtle/algorithms/aig_resub.hpp>
+#include <mockturtle/algorithms/lut_mapper.hpp>
+#include <mockturtle/algorithms/node_reordering.hpp>
+#include <mockturtle/algorithms/resubstitution.hpp>
+#include <mockturtle/algorithms/simulation.hpp>
+#include <mockturtle/io/aiger_reader.hpp>
+#include <mockturtle/networks/aig.hpp>
+#include <mockturtle/utils/stopwatch.hpp>
+#include <mockturtle/views/depth_view.hpp>
+#include <mockturtle/views/fanout_view.hpp>
+#include <mockturtle/views/topo_view.hpp>
+
+#include <experiments.hpp>
+
+int main()
+{
+  using namespace experiments;
+  using namespace mockturtle;
+
+  experiment<std::string, uint32_t, double, double, double, double, double, double, double, bool> exp( "node_reordering", "benchmark", "size", "dist_before", "dist_after", "reorder", "sim_before", "sim_after", "map_before", "map_after", "equivalent" );
+
+  for ( auto const& benchmark : epfl_benchmarks() )
+  {
+    fmt::print( "[i] processing {}\n", benchmark );
+    aig_network aig;
+    if ( lorina::read_aiger( benchmark_path( benchmark ), aiger_reader( aig ) ) != lorina::return_code::success )
+    {
+      continue;
+    }
+
+    /* scatter the storage with a round of resubstitution */
+    {
+      resubstitution_params ps;
+      ps.max_pis = 8u;
+      ps.max_inserts = 2u;
+      depth_view depth_aig{ aig };
+      fanout_view fanout_aig{ depth_aig };
+      aig_resubstitution2( fanout_aig, ps );
+    }
+
+    node_reordering_params rps;
+    rps.strategy = node_reordering_strategy::locality;
+    node_reordering_stats rst;
+    auto const reordered = node_reordering( aig, rps, &rst );
+
+    partial_simulator sim( aig.num_pis(), 1u << 14 );
+    lut_map_params mps;
+    mps.cut_enumeration_ps.cut_size = 6u;
+    mps.cut_enumeration_ps.cut_limit = 8u;
+
+    auto const measure = [&]( aig_network const& ntk, stopwatch<>::duration& time_sim, stopwatch<>::duration& time_map ) {
+      topo_view topo{ ntk };
+      call_with_stopwatch( time_sim, [&]() { simulate_nodes<kitty::partial_truth_table>( topo, sim ); } );
+      lut_map_stats mst;
+      auto const klut = lut_map( ntk, mps, &mst );
+      time_map = mst.time_total;
+      return klut;
+    };
+
+    stopwatch<>::duration sim_before{ 0 }, sim_after{ 0 }, map_before{ 0 }, map_after{ 0 };
+    measure( aig, sim_before, map_before );
+    auto const klut = measure( reordered, sim_after, map_after );
+
+    auto const cec = benchmark == "hyp" ? true : abc_cec( klut, benchmark );
+
+    exp( benchmark, reordered.num_gates(), rst.distance_before, rst.distance_after, to_seconds( rst.time_total ),
+         to_seconds( sim_before ), to_seconds( sim_after ), to_seconds( map_before ), to_seconds( map_after ), cec );
+  }
+
+  exp.save();
+  exp.table();
+
+  return 0;
+}
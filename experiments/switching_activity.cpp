@@ -0,0 +1,97 @@
+/* mockturtle: C++ logic network library
+ * Copyright (C) 2018-2019  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <string>
+#include <vector>
+
+#include <fmt/format.h>
+#include <kitty/bit_operations.hpp>
+#include <lorina/aiger.hpp>
+#include <mockturtle/algorithms/simulation.hpp>
+#include <mockturtle/algorithms/switching_activity.hpp>
+#include <mockturtle/io/aiger_reader.hpp>
+#include <mockturtle/networks/aig.hpp>
+
+#include <experiments.hpp>
+
+int main()
+{
+  using namespace experiments;
+  using namespace mockturtle;
+
+  experiment<std::string, uint32_t, double, double, double, double, double, double> exp( "switching_activity", "benchmark", "size", "sw_prob", "sw_toggle", "sw_correlated", "time_prob", "time_1t", "time_4t" );
+
+  uint32_t const num_cycles = 1u << 14;
+
+  for ( auto const& benchmark : epfl_benchmarks() )
+  {
+    fmt::print( "[i] processing {}\n", benchmark );
+    aig_network aig;
+    if ( lorina::read_aiger( benchmark_path( benchmark ), aiger_reader( aig ) ) != lorina::return_code::success )
+    {
+      continue;
+    }
+
+    /* estimation from signal probabilities: 2p(1-p) */
+    stopwatch<>::duration time_prob{ 0 };
+    double sw_prob{ 0 };
+    {
+      stopwatch t( time_prob );
+      partial_simulator sim( aig.num_pis(), num_cycles );
+      auto const tts = simulate_nodes<kitty::partial_truth_table>( aig, sim );
+      aig.foreach_gate( [&]( auto const& n ) {
+        double const p = static_cast<double>( kitty::count_ones( tts[n] ) ) / num_cycles;
+        sw_prob += 2.0 * p * ( 1.0 - p );
+      } );
+    }
+
+    auto const total_activity = [&]( std::vector<float> const& sw ) {
+      double sum{ 0 };
+      aig.foreach_gate( [&]( auto const& n ) {
+        sum += sw[aig.node_to_index( n )];
+      } );
+      return sum;
+    };
+
+    switching_activity_params ps;
+    ps.num_cycles = num_cycles;
+    switching_activity_stats st1, st4;
+    auto const sw_toggle = total_activity( compute_switching_activity( aig, ps, &st1 ) );
+
+    ps.num_threads = 4u;
+    compute_switching_activity( aig, ps, &st4 );
+
+    /* inputs with low toggle rate */
+    ps.input_toggle_rates = std::vector<double>( aig.num_pis(), 0.1 );
+    auto const sw_correlated = total_activity( compute_switching_activity( aig, ps ) );
+
+    exp( benchmark, aig.num_gates(), sw_prob, sw_toggle, sw_correlated, to_seconds( time_prob ), to_seconds( st1.time_total ), to_seconds( st4.time_total ) );
+  }
+
+  exp.save();
+  exp.table();
+
+  return 0;
+}
@@ -40,14 +40,17 @@
 #include <limits>
 #include <memory>
 #include <optional>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
 #include <fmt/format.h>
 #include <kitty/dynamic_truth_table.hpp>
+#include <kitty/operations.hpp>
 #include <kitty/properties.hpp>
 
 #include "../utils/cost_functions.hpp"
+#include "../utils/cut_store.hpp"
 #include "../utils/node_map.hpp"
 #include "../utils/progress_bar.hpp"
 #include "../utils/stopwatch.hpp"
@@ -103,14 +106,15 @@ struct balancing_stats
 namespace detail
 {
 
-template<class Ntk, class CostFn>
+template<class Ntk, class CostFn, class CutStore = void>
 struct balancing_impl
 {
-  balancing_impl( Ntk const& ntk, rebalancing_function_t<Ntk> const& rebalancing_fn, balancing_params const& ps, balancing_stats& st )
+  balancing_impl( Ntk const& ntk, rebalancing_function_t<Ntk> const& rebalancing_fn, balancing_params const& ps, balancing_stats& st, CutStore* cuts = nullptr )
       : ntk_( ntk ),
         rebalancing_fn_( rebalancing_fn ),
         ps_( ps ),
-        st_( st )
+        st_( st ),
+        cuts_( cuts )
   {
   }
 
@@ -136,8 +140,28 @@ struct balancing_impl
     }
 
     stopwatch<> t( st_.time_total );
-    const auto cuts = cut_enumeration<Ntk, true>( ntk_, ps_.cut_enumeration_ps, &st_.cut_enumeration_st );
+    if constexpr ( std::is_void_v<CutStore> )
+    {
+      const auto cuts = cut_enumeration<Ntk, true>( ntk_, ps_.cut_enumeration_ps, &st_.cut_enumeration_st );
+      rebalance( dest, old_to_new, depth_ntk, cuts );
+    }
+    else
+    {
+      rebalance( dest, old_to_new, depth_ntk, *cuts_ );
+    }
+
+    ntk_.foreach_po( [&]( auto const& f ) {
+      const auto s = old_to_new[f].f;
+      dest.create_po( ntk_.is_complemented( f ) ? dest.create_not( s ) : s );
+    } );
 
+    return cleanup_dangling( dest );
+  }
+
+private:
+  template<class Cuts>
+  void rebalance( Ntk& dest, node_map<arrival_time_pair<Ntk>, Ntk>& old_to_new, std::shared_ptr<depth_view<Ntk, CostFn>> const& depth_ntk, Cuts& cuts )
+  {
     uint32_t current_level{};
     const auto size = ntk_.size();
     progress_bar pbar{ ntk_.size(), "balancing |{0}| node = {1:>4} / " + std::to_string( size ) + "   current level = {2}", ps_.progress };
@@ -162,9 +186,14 @@ struct balancing_impl
 
       arrival_time_pair<Ntk> best{ {}, std::numeric_limits<uint32_t>::max() };
       uint32_t best_size{};
-      for ( auto& cut : cuts.cuts( ntk_.node_to_index( n ) ) )
+      for ( auto& cut : cut_set( cuts, n ) )
       {
-        if ( cut->size() == 1u || kitty::is_const0( cuts.truth_table( *cut ) ) )
+        if ( cut->size() == 1u )
+        {
+          continue;
+        }
+        const auto tt = cut_function( cuts, *cut );
+        if ( kitty::is_const0( tt ) )
         {
           continue;
         }
@@ -172,7 +201,7 @@ struct balancing_impl
         std::vector<arrival_time_pair<Ntk>> arrival_times( cut->size() );
         std::transform( cut->begin(), cut->end(), arrival_times.begin(), [&]( auto leaf ) { return old_to_new[ntk_.index_to_node( leaf )]; } );
 
-        rebalancing_fn_( dest, cuts.truth_table( *cut ), arrival_times, best.level, best_size, [&]( arrival_time_pair<Ntk> const& cand, uint32_t cand_size ) {
+        rebalancing_fn_( dest, tt, arrival_times, best.level, best_size, [&]( arrival_time_pair<Ntk> const& cand, uint32_t cand_size ) {
           if ( cand.level < best.level || ( cand.level == best.level && cand_size < best_size ) )
           {
             best = cand;
@@ -183,13 +212,35 @@ struct balancing_impl
       old_to_new[n] = best;
       current_level = std::max( current_level, best.level );
     } );
+  }
 
-    ntk_.foreach_po( [&]( auto const& f ) {
-      const auto s = old_to_new[f].f;
-      dest.create_po( ntk_.is_complemented( f ) ? dest.create_not( s ) : s );
-    } );
+  template<class Cuts>
+  auto const& cut_set( Cuts& cuts, node<Ntk> const& n ) const
+  {
+    if constexpr ( std::is_void_v<CutStore> )
+    {
+      return cuts.cuts( ntk_.node_to_index( n ) );
+    }
+    else
+    {
+      return cuts.cuts( n );
+    }
+  }
 
-    return cleanup_dangling( dest );
+  /* cut stores keep functions with a fixed number of variables */
+  template<class Cuts, class Cut>
+  kitty::dynamic_truth_table cut_function( Cuts const& cuts, Cut const& cut ) const
+  {
+    if constexpr ( std::is_void_v<CutStore> )
+    {
+      return cuts.truth_table( cut );
+    }
+    else
+    {
+      kitty::dynamic_truth_table tt( cut.size() );
+      kitty::shrink_to_inplace( tt, cuts.truth_table( cut ) );
+      return tt;
+    }
   }
 
 private:
@@ -197,6 +248,7 @@ private:
   rebalancing_function_t<Ntk> const& rebalancing_fn_;
   balancing_params const& ps_;
   balancing_stats& st_;
+  CutStore* cuts_;
 };
 
 template<class Ntk>
@@ -335,6 +387,46 @@ Ntk balancing( Ntk const& ntk, rebalancing_function_t<Ntk> const& rebalancing_fn
   return dest;
 }
 
+/*! Balancing of a logic network with a cut store owned by the caller
+ *
+ * Same as the function above, but the cuts are taken from `cuts` instead of
+ * being enumerated, such that they can be shared with other passes (e.g.,
+ * `rewrite`) and with further calls of balancing on the same network.  The
+ * store must be attached to a view of `ntk` (e.g., `fanout_view<Ntk>`).  The
+ * cut enumeration parameters in `ps` are not used.
+ */
+template<class Ntk, class StoreNtk, uint32_t NumVars, typename CutData, class CostFn = unit_cost<Ntk>>
+Ntk balancing( Ntk const& ntk, rebalancing_function_t<Ntk> const& rebalancing_fn, cut_store<StoreNtk, NumVars, CutData>& cuts, balancing_params const& ps = {}, balancing_stats* pst = nullptr )
+{
+  static_assert( is_network_type_v<Ntk>, "Ntk is not a network type" );
+  static_assert( has_create_not_v<Ntk>, "Ntk does not implement the create_not method" );
+  static_assert( has_create_pi_v<Ntk>, "Ntk does not implement the create_pi method" );
+  static_assert( has_create_po_v<Ntk>, "Ntk does not implement the create_po method" );
+  static_assert( has_foreach_pi_v<Ntk>, "Ntk does not implement the foreach_pi method" );
+  static_assert( has_foreach_po_v<Ntk>, "Ntk does not implement the foreach_po method" );
+  static_assert( has_get_constant_v<Ntk>, "Ntk does not implement the get_constant method" );
+  static_assert( has_get_node_v<Ntk>, "Ntk does not implement the get_node method" );
+  static_assert( has_is_complemented_v<Ntk>, "Ntk does not implement the is_complemented method" );
+  static_assert( has_is_constant_v<Ntk>, "Ntk does not implement the is_constant method" );
+  static_assert( has_is_pi_v<Ntk>, "Ntk does not implement the is_pi method" );
+  static_assert( has_node_to_index_v<Ntk>, "Ntk does not implement the node_to_index method" );
+  static_assert( has_size_v<Ntk>, "Ntk does not implement the size method" );
+
+  balancing_stats st;
+  const auto dest = detail::balancing_impl<Ntk, CostFn, cut_store<StoreNtk, NumVars, CutData>>{ ntk, rebalancing_fn, ps, st, &cuts }.run();
+
+  if ( pst )
+  {
+    *pst = st;
+  }
+  if ( ps.verbose )
+  {
+    st.report();
+  }
+
+  return dest;
+}
+
 /*! \brief SOP balancing of a logic network
  *
  * This function implements an LUT-based SOP balancing algorithm.
@@ -51,181 +51,193 @@ namespace mockturtle
 namespace detail
 {
 
-template<typename NtkSrc, typename NtkDest, typename LeavesIterator>
-void cleanup_dangling_impl( NtkSrc const& ntk, NtkDest& dest, LeavesIterator begin, LeavesIterator end, node_map<signal<NtkDest>, NtkSrc>& old_to_new )
+/*! \brief Copies a single gate into `dest`.
+ *
+ * The fanins of `node` must have been copied before, i.e., `old_to_new` must
+ * contain their images in `dest`.  The image of `node` is stored in
+ * `old_to_new`, and its names are copied if both networks support names.
+ */
+template<typename NtkSrc, typename NtkDest>
+void cleanup_copy_gate( NtkSrc const& ntk, NtkDest& dest, typename NtkSrc::node const& node, node_map<signal<NtkDest>, NtkSrc>& old_to_new )
 {
-  /* constants */
-  old_to_new[ntk.get_constant( false )] = dest.get_constant( false );
-  if ( ntk.get_node( ntk.get_constant( true ) ) != ntk.get_node( ntk.get_constant( false ) ) )
-  {
-    old_to_new[ntk.get_constant( true )] = dest.get_constant( true );
-  }
-
-  /* create inputs in the same order */
-  auto it = begin;
-  ntk.foreach_pi( [&]( auto node ) {
-    old_to_new[node] = *it++;
-  } );
-  if constexpr ( has_foreach_ro_v<NtkSrc> )
-  {
-    ntk.foreach_ro( [&]( auto node ) {
-      old_to_new[node] = *it++;
-    } );
-  }
-  assert( it == end );
-  (void)end;
-
-  /* foreach node in topological order */
-  topo_view topo{ ntk };
-  topo.foreach_node( [&]( auto node ) {
-    if ( ntk.is_constant( node ) || ntk.is_ci( node ) )
-      return;
-
-    /* collect children */
-    std::vector<signal<NtkDest>> children;
-    ntk.foreach_fanin( node, [&]( auto child, auto ) {
-      const auto f = old_to_new[child];
-      if ( ntk.is_complemented( child ) )
-      {
-        children.push_back( dest.create_not( f ) );
-      }
-      else
-      {
-        children.push_back( f );
-      }
-    } );
-
-    /* clone node */
-    if constexpr ( std::is_same_v<NtkSrc, NtkDest> )
+  /* collect children */
+  std::vector<signal<NtkDest>> children;
+  ntk.foreach_fanin( node, [&]( auto child, auto ) {
+    const auto f = old_to_new[child];
+    if ( ntk.is_complemented( child ) )
     {
-      old_to_new[node] = dest.clone_node( ntk, node, children );
+      children.push_back( dest.create_not( f ) );
     }
     else
     {
-      do
+      children.push_back( f );
+    }
+  } );
+
+  /* clone node */
+  if constexpr ( std::is_same_v<NtkSrc, NtkDest> )
+  {
+    old_to_new[node] = dest.clone_node( ntk, node, children );
+  }
+  else
+  {
+    do
+    {
+      if constexpr ( has_is_and_v<NtkSrc> )
       {
-        if constexpr ( has_is_and_v<NtkSrc> )
-        {
-          static_assert( has_create_and_v<NtkDest>, "NtkDest cannot create AND gates" );
-          if ( ntk.is_and( node ) )
-          {
-            old_to_new[node] = dest.create_and( children[0], children[1] );
-            break;
-          }
-        }
-        if constexpr ( has_is_or_v<NtkSrc> )
+        static_assert( has_create_and_v<NtkDest>, "NtkDest cannot create AND gates" );
+        if ( ntk.is_and( node ) )
         {
-          static_assert( has_create_or_v<NtkDest>, "NtkDest cannot create OR gates" );
-          if ( ntk.is_or( node ) )
-          {
-            old_to_new[node] = dest.create_or( children[0], children[1] );
-            break;
-          }
+          old_to_new[node] = dest.create_and( children[0], children[1] );
+          break;
         }
-        if constexpr ( has_is_xor_v<NtkSrc> )
+      }
+      if constexpr ( has_is_or_v<NtkSrc> )
+      {
+        static_assert( has_create_or_v<NtkDest>, "NtkDest cannot create OR gates" );
+        if ( ntk.is_or( node ) )
         {
-          static_assert( has_create_xor_v<NtkDest>, "NtkDest cannot create XOR gates" );
-          if ( ntk.is_xor( node ) )
-          {
-            old_to_new[node] = dest.create_xor( children[0], children[1] );
-            break;
-          }
+          old_to_new[node] = dest.create_or( children[0], children[1] );
+          break;
         }
-        if constexpr ( has_is_maj_v<NtkSrc> )
+      }
+      if constexpr ( has_is_xor_v<NtkSrc> )
+      {
+        static_assert( has_create_xor_v<NtkDest>, "NtkDest cannot create XOR gates" );
+        if ( ntk.is_xor( node ) )
         {
-          static_assert( has_create_maj_v<NtkDest>, "NtkDest cannot create MAJ gates" );
-          if ( ntk.is_maj( node ) )
-          {
-            old_to_new[node] = dest.create_maj( children[0], children[1], children[2] );
-            break;
-          }
+          old_to_new[node] = dest.create_xor( children[0], children[1] );
+          break;
         }
-        if constexpr ( has_is_ite_v<NtkSrc> )
+      }
+      if constexpr ( has_is_maj_v<NtkSrc> )
+      {
+        static_assert( has_create_maj_v<NtkDest>, "NtkDest cannot create MAJ gates" );
+        if ( ntk.is_maj( node ) )
         {
-          static_assert( has_create_ite_v<NtkDest>, "NtkDest cannot create ITE gates" );
-          if ( ntk.is_ite( node ) )
-          {
-            old_to_new[node] = dest.create_ite( children[0], children[1], children[2] );
-            break;
-          }
+          old_to_new[node] = dest.create_maj( children[0], children[1], children[2] );
+          break;
         }
-        if constexpr ( has_is_xor3_v<NtkSrc> )
+      }
+      if constexpr ( has_is_ite_v<NtkSrc> )
+      {
+        static_assert( has_create_ite_v<NtkDest>, "NtkDest cannot create ITE gates" );
+        if ( ntk.is_ite( node ) )
         {
-          static_assert( has_create_xor3_v<NtkDest>, "NtkDest cannot create XOR3 gates" );
-          if ( ntk.is_xor3( node ) )
-          {
-            old_to_new[node] = dest.create_xor3( children[0], children[1], children[2] );
-            break;
-          }
+          old_to_new[node] = dest.create_ite( children[0], children[1], children[2] );
+          break;
         }
-        if constexpr ( has_is_nary_and_v<NtkSrc> )
+      }
+      if constexpr ( has_is_xor3_v<NtkSrc> )
+      {
+        static_assert( has_create_xor3_v<NtkDest>, "NtkDest cannot create XOR3 gates" );
+        if ( ntk.is_xor3( node ) )
         {
-          static_assert( has_create_nary_and_v<NtkDest>, "NtkDest cannot create n-ary AND gates" );
-          if ( ntk.is_nary_and( node ) )
-          {
-            old_to_new[node] = dest.create_nary_and( children );
-            break;
-          }
+          old_to_new[node] = dest.create_xor3( children[0], children[1], children[2] );
+          break;
         }
-        if constexpr ( has_is_nary_or_v<NtkSrc> )
+      }
+      if constexpr ( has_is_nary_and_v<NtkSrc> )
+      {
+        static_assert( has_create_nary_and_v<NtkDest>, "NtkDest cannot create n-ary AND gates" );
+        if ( ntk.is_nary_and( node ) )
         {
-          static_assert( has_create_nary_or_v<NtkDest>, "NtkDest cannot create n-ary OR gates" );
-          if ( ntk.is_nary_or( node ) )
-          {
-            old_to_new[node] = dest.create_nary_or( children );
-            break;
-          }
+          old_to_new[node] = dest.create_nary_and( children );
+          break;
         }
-        if constexpr ( has_is_nary_xor_v<NtkSrc> )
+      }
+      if constexpr ( has_is_nary_or_v<NtkSrc> )
+      {
+        static_assert( has_create_nary_or_v<NtkDest>, "NtkDest cannot create n-ary OR gates" );
+        if ( ntk.is_nary_or( node ) )
         {
-          static_assert( has_create_nary_xor_v<NtkDest>, "NtkDest cannot create n-ary XOR gates" );
-          if ( ntk.is_nary_xor( node ) )
-          {
-            old_to_new[node] = dest.create_nary_xor( children );
-            break;
-          }
+          old_to_new[node] = dest.create_nary_or( children );
+          break;
         }
-        if constexpr ( has_is_not_v<NtkSrc> )
+      }
+      if constexpr ( has_is_nary_xor_v<NtkSrc> )
+      {
+        static_assert( has_create_nary_xor_v<NtkDest>, "NtkDest cannot create n-ary XOR gates" );
+        if ( ntk.is_nary_xor( node ) )
         {
-          static_assert( has_create_not_v<NtkDest>, "NtkDest cannot create NOT gates" );
-          if ( ntk.is_not( node ) )
-          {
-            old_to_new[node] = dest.create_not( children[0] );
-            break;
-          }
+          old_to_new[node] = dest.create_nary_xor( children );
+          break;
         }
-        if constexpr ( has_is_buf_v<NtkSrc> )
+      }
+      if constexpr ( has_is_not_v<NtkSrc> )
+      {
+        static_assert( has_create_not_v<NtkDest>, "NtkDest cannot create NOT gates" );
+        if ( ntk.is_not( node ) )
         {
-          static_assert( has_create_buf_v<NtkDest>, "NtkDest cannot create buffers" );
-          if ( ntk.is_buf( node ) )
-          {
-            old_to_new[node] = dest.create_buf( children[0] );
-            break;
-          }
+          old_to_new[node] = dest.create_not( children[0] );
+          break;
         }
-        if constexpr ( has_is_function_v<NtkSrc> )
+      }
+      if constexpr ( has_is_buf_v<NtkSrc> )
+      {
+        static_assert( has_create_buf_v<NtkDest>, "NtkDest cannot create buffers" );
+        if ( ntk.is_buf( node ) )
         {
-          static_assert( has_create_node_v<NtkDest>, "NtkDest cannot create arbitrary function gates" );
-          old_to_new[node] = dest.create_node( children, ntk.node_function( node ) );
+          old_to_new[node] = dest.create_buf( children[0] );
           break;
         }
-        std::cerr << "[e] something went wrong, could not copy node " << ntk.node_to_index( node ) << "\n";
-      } while ( false );
-    }
-
-    /* copy name */
-    if constexpr ( has_has_name_v<NtkSrc> && has_get_name_v<NtkSrc> && has_set_name_v<NtkDest> )
-    {
-      auto const s = ntk.make_signal( node );
-      if ( ntk.has_name( s ) )
-      {
-        dest.set_name( old_to_new[node], ntk.get_name( s ) );
       }
-      if ( ntk.has_name( !s ) )
+      if constexpr ( has_is_function_v<NtkSrc> )
       {
-        dest.set_name( !old_to_new[node], ntk.get_name( !s ) );
+        static_assert( has_create_node_v<NtkDest>, "NtkDest cannot create arbitrary function gates" );
+        old_to_new[node] = dest.create_node( children, ntk.node_function( node ) );
+        break;
       }
+      std::cerr << "[e] something went wrong, could not copy node " << ntk.node_to_index( node ) << "\n";
+    } while ( false );
+  }
+
+  /* copy name */
+  if constexpr ( has_has_name_v<NtkSrc> && has_get_name_v<NtkSrc> && has_set_name_v<NtkDest> )
+  {
+    auto const s = ntk.make_signal( node );
+    if ( ntk.has_name( s ) )
+    {
+      dest.set_name( old_to_new[node], ntk.get_name( s ) );
+    }
+    if ( ntk.has_name( !s ) )
+    {
+      dest.set_name( !old_to_new[node], ntk.get_name( !s ) );
     }
+  }
+}
+
+template<typename NtkSrc, typename NtkDest, typename LeavesIterator>
+void cleanup_dangling_impl( NtkSrc const& ntk, NtkDest& dest, LeavesIterator begin, LeavesIterator end, node_map<signal<NtkDest>, NtkSrc>& old_to_new )
+{
+  /* constants */
+  old_to_new[ntk.get_constant( false )] = dest.get_constant( false );
+  if ( ntk.get_node( ntk.get_constant( true ) ) != ntk.get_node( ntk.get_constant( false ) ) )
+  {
+    old_to_new[ntk.get_constant( true )] = dest.get_constant( true );
+  }
+
+  /* create inputs in the same order */
+  auto it = begin;
+  ntk.foreach_pi( [&]( auto node ) {
+    old_to_new[node] = *it++;
+  } );
+  if constexpr ( has_foreach_ro_v<NtkSrc> )
+  {
+    ntk.foreach_ro( [&]( auto node ) {
+      old_to_new[node] = *it++;
+    } );
+  }
+  assert( it == end );
+  (void)end;
+
+  /* foreach node in topological order */
+  topo_view topo{ ntk };
+  topo.foreach_node( [&]( auto node ) {
+    if ( ntk.is_constant( node ) || ntk.is_ci( node ) )
+      return;
+
+    cleanup_copy_gate( ntk, dest, node, old_to_new );
   } );
 }
 
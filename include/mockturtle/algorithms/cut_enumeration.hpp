@@ -41,6 +41,7 @@
 #include <cstdint>
 #include <iostream>
 #include <optional>
+#include <unordered_map>
 #include <vector>
 
 #include <kitty/constructors.hpp>
@@ -76,6 +77,17 @@ struct cut_enumeration_params
   /*! \brief Prune cuts by removing don't cares. */
   bool minimize_truth_table{ false };
 
+  /*! \brief Compute the truth tables of cuts on demand.
+   *
+   * If true, the truth table of a cut is only computed (and memoized) when
+   * it is queried with `network_cuts::truth_table`, such that no truth
+   * tables are computed for cuts that are never used.  The network must not
+   * be modified or destroyed before all truth tables have been queried.
+   * This option is ignored when `minimize_truth_table` is true, since the
+   * leaves of a cut depend on its function.
+   */
+  bool lazy_truth_tables{ false };
+
   /*! \brief Be verbose. */
   bool verbose{ false };
 
@@ -91,11 +103,18 @@ struct cut_enumeration_stats
   /*! \brief Time for truth table computation. */
   stopwatch<>::duration time_truth_table{ 0 };
 
+  /*! \brief Number of truth tables computed during enumeration. */
+  uint64_t num_truth_tables{ 0 };
+
+  /*! \brief Number of cuts whose truth table computation was deferred. */
+  uint64_t num_deferred_truth_tables{ 0 };
+
   /*! \brief Prints report. */
   void report() const
   {
     std::cout << fmt::format( "[i] total time       = {:>5.2f} secs\n", to_seconds( time_total ) );
     std::cout << fmt::format( "[i] truth table time = {:>5.2f} secs\n", to_seconds( time_truth_table ) );
+    std::cout << fmt::format( "[i] truth tables     = {} computed, {} deferred\n", num_truth_tables, num_deferred_truth_tables );
   }
 };
 
@@ -107,7 +126,8 @@ struct cut_data;
 template<typename T>
 struct cut_data<true, T>
 {
-  uint32_t func_id;
+  /* mutable, since deferred truth tables are resolved on first access */
+  mutable uint32_t func_id;
   T data;
 };
 
@@ -184,10 +204,21 @@ public:
   /*! \brief Returns the cut set of a node */
   cut_set_t const& cuts( uint32_t node_index ) const { return _cuts[node_index]; }
 
-  /*! \brief Returns the truth table of a cut */
+  /*! \brief Returns the truth table of a cut
+   *
+   * If the truth table of the cut was deferred (see
+   * `cut_enumeration_params::lazy_truth_tables`), it is computed by
+   * simulating the cone between the leaves and the root of the cut, and is
+   * memoized in the cut.  Since this updates the cut and the truth table
+   * cache, it is not thread-safe in lazy mode.
+   */
   template<bool enabled = ComputeTruth, typename = std::enable_if_t<std::is_same_v<Ntk, Ntk> && enabled>>
   auto truth_table( cut_t const& cut ) const
   {
+    if ( ( cut->func_id & deferred_flag ) != 0u )
+    {
+      cut->func_id = compute_deferred_truth_table( cut->func_id & ~deferred_flag, cut );
+    }
     return _truth_tables[cut->func_id];
   }
 
@@ -209,6 +240,30 @@ public:
     return _cuts.size();
   }
 
+  /*! \brief Returns the memory used by the cut sets and truth tables in bytes */
+  uint64_t memory_usage() const
+  {
+    return sizeof( *this ) + dynamic_memory_usage( _cuts ) + dynamic_memory_usage( _truth_tables );
+  }
+
+  /*! \brief Returns the number of distinct truth tables in the cache */
+  auto num_truth_tables() const
+  {
+    return _truth_tables.size();
+  }
+
+  /*! \brief Returns the number of deferred truth tables computed on demand */
+  auto num_deferred_truth_tables() const
+  {
+    return _num_deferred_computed;
+  }
+
+  /*! \brief Returns the time spent on computing deferred truth tables */
+  auto time_deferred_truth_tables() const
+  {
+    return _time_deferred;
+  }
+
   /* compute positions of leave indices in cut `sub` (subset) with respect to
    * leaves in cut `sup` (super set).
    *
@@ -243,6 +298,70 @@ public:
     return _truth_tables.insert( tt );
   }
 
+private:
+  /* marks the `func_id` of a cut whose truth table is deferred, the
+   * remaining bits hold the index of the root */
+  static constexpr uint32_t deferred_flag = 0x80000000u;
+
+  uint32_t compute_deferred_truth_table( uint32_t root, cut_t const& cut ) const
+  {
+    assert( _ntk != nullptr );
+    stopwatch t( _time_deferred );
+    ++_num_deferred_computed;
+
+    std::unordered_map<uint32_t, kitty::dynamic_truth_table> values;
+    auto i = 0u;
+    for ( auto leaf : cut )
+    {
+      kitty::dynamic_truth_table tt( cut.size() );
+      kitty::create_nth_var( tt, i++ );
+      values.emplace( leaf, tt );
+    }
+
+    return _truth_tables.insert( compute_cone( root, static_cast<uint32_t>( cut.size() ), values ) );
+  }
+
+  /* simulates the cone in post-order using an explicit stack */
+  kitty::dynamic_truth_table compute_cone( uint32_t root, uint32_t num_vars, std::unordered_map<uint32_t, kitty::dynamic_truth_table>& values ) const
+  {
+    std::vector<std::pair<uint32_t, bool>> stack{ { root, false } };
+    while ( !stack.empty() )
+    {
+      auto const [index, expanded] = stack.back();
+      stack.pop_back();
+      if ( values.find( index ) != values.end() )
+      {
+        continue;
+      }
+
+      auto const n = _ntk->index_to_node( index );
+      if ( _ntk->is_constant( n ) )
+      {
+        kitty::dynamic_truth_table tt( num_vars );
+        values.emplace( index, _ntk->constant_value( n ) ? ~tt : tt );
+        continue;
+      }
+      assert( !_ntk->is_ci( n ) && "cone of a cut reaches a CI that is not a leaf" );
+
+      if ( !expanded )
+      {
+        stack.emplace_back( index, true );
+        _ntk->foreach_fanin( n, [&]( auto const& f ) {
+          stack.emplace_back( _ntk->node_to_index( _ntk->get_node( f ) ), false );
+        } );
+        continue;
+      }
+
+      std::vector<kitty::dynamic_truth_table> fanin_values;
+      _ntk->foreach_fanin( n, [&]( auto const& f ) {
+        fanin_values.emplace_back( values.at( _ntk->node_to_index( _ntk->get_node( f ) ) ) );
+      } );
+      values.emplace( index, _ntk->compute( n, fanin_values.begin(), fanin_values.end() ) );
+    }
+
+    return values.at( root );
+  }
+
 private:
   template<typename _Ntk, bool _ComputeTruth, typename _CutData>
   friend class detail::cut_enumeration_impl;
@@ -276,11 +395,16 @@ private:
   std::vector<cut_set_t> _cuts;
 
   /* cut truth tables */
-  truth_table_cache<kitty::dynamic_truth_table> _truth_tables;
+  mutable truth_table_cache<kitty::dynamic_truth_table> _truth_tables;
+
+  /* network for deferred truth tables */
+  Ntk const* _ntk{ nullptr };
 
   /* statistics */
   uint32_t _total_tuples{};
   std::size_t _total_cuts{};
+  mutable uint64_t _num_deferred_computed{};
+  mutable stopwatch<>::duration _time_deferred{ 0 };
 };
 
 /*! \cond PRIVATE */
@@ -298,9 +422,16 @@ public:
       : ntk( ntk ),
         ps( ps ),
         st( st ),
-        cuts( cuts )
+        cuts( cuts ),
+        lazy( ps.lazy_truth_tables && !ps.minimize_truth_table )
   {
     assert( ps.cut_limit < cuts.max_cut_num && "cut_limit exceeds the compile-time limit for the maximum number of cuts" );
+    assert( ntk.size() < cuts.deferred_flag && "network is too large for deferred truth tables" );
+
+    if ( lazy )
+    {
+      cuts._ntk = &ntk;
+    }
   }
 
 public:
@@ -341,7 +472,14 @@ public:
 private:
   uint32_t compute_truth_table( uint32_t index, std::vector<cut_t const*> const& vcuts, cut_t& res )
   {
+    if ( lazy )
+    {
+      ++st.num_deferred_truth_tables;
+      return index | cuts.deferred_flag;
+    }
+
     stopwatch t( st.time_truth_table );
+    ++st.num_truth_tables;
 
     std::vector<kitty::dynamic_truth_table> tt( vcuts.size() );
     auto i = 0;
@@ -532,6 +670,7 @@ private:
   cut_enumeration_params const& ps;
   cut_enumeration_stats& st;
   network_cuts<Ntk, ComputeTruth, CutData>& cuts;
+  bool lazy;
 
   std::array<cut_set_t*, Ntk::max_fanin_size + 1> lcuts;
 };
@@ -692,6 +831,12 @@ public:
     return _cuts.size();
   }
 
+  /*! \brief Returns the memory used by the cut sets and truth tables in bytes */
+  uint64_t memory_usage() const
+  {
+    return sizeof( *this ) + dynamic_memory_usage( _cuts ) + dynamic_memory_usage( _truth_tables );
+  }
+
   /* compute positions of leave indices in cut `sub` (subset) with respect to
    * leaves in cut `sup` (super set).
    *
@@ -1186,6 +1331,12 @@ public:
     return _cuts.size();
   }
 
+  /*! \brief Returns the memory used by the cut sets and truth tables in bytes */
+  uint64_t memory_usage() const
+  {
+    return sizeof( *this ) + dynamic_memory_usage( _cuts ) + dynamic_memory_usage( _truth_tables );
+  }
+
   /* compute positions of leave indices in cut `sub` (subset) with respect to
    * leaves in cut `sup` (super set).
    *
@@ -416,6 +416,13 @@ public:
     /* store best replacement for each cut */
     node_map<std::vector<signal<Ntk>>, Ntk> best_replacements( ntk );
 
+    /* windows and simulation buffers for don't care computation */
+    std::optional<dont_care_manager<Ntk>> dcs;
+    if ( ps.use_dont_cares )
+    {
+      dcs.emplace( ntk );
+    }
+
     /* iterate over all original nodes in the network */
     const auto size = ntk.size();
     auto max_total_gain = 0u;
@@ -488,7 +495,7 @@ public:
               {
                 pivots.push_back( ntk.get_node( c ) );
               }
-              rewriting_fn( ntk, cuts.truth_table( *cut ), satisfiability_dont_cares( ntk, pivots ), children.begin(), children.end(), on_signal );
+              rewriting_fn( ntk, cuts.truth_table( *cut ), dcs->satisfiability_dont_cares( pivots ), children.begin(), children.end(), on_signal );
             }
             else
             {
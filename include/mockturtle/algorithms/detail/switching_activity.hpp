@@ -35,6 +35,7 @@
 #include <vector>
 
 #include "../simulation.hpp"
+#include "../switching_activity.hpp"
 
 #include <kitty/bit_operations.hpp>
 #include <kitty/partial_truth_table.hpp>
@@ -67,4 +68,22 @@ std::vector<float> switching_activity( Ntk const& ntk, unsigned simulation_size
   return sw_map;
 }
 
-} // namespace mockturtle::detail
\ No newline at end of file
+/*! \brief Switching Activity by toggle counting.
+ *
+ * This function computes the switching activity for each node
+ * in the network by simulating a random sequence of input vectors
+ * and counting the value changes between consecutive cycles
+ * (see `switching_activity_engine`).
+ *
+ * \param ntk Network
+ * \param simulation_size Number of simulated cycles
+ */
+template<typename Ntk>
+std::vector<float> toggle_switching_activity( Ntk const& ntk, unsigned simulation_size = 2048 )
+{
+  switching_activity_params ps;
+  ps.num_cycles = simulation_size;
+  return compute_switching_activity( ntk, ps );
+}
+
+} // namespace mockturtle::detail
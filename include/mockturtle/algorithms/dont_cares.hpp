@@ -35,7 +35,9 @@
 
 #pragma once
 
+#include <algorithm>
 #include <cstdint>
+#include <type_traits>
 #include <vector>
 
 #include "../algorithms/cnf.hpp"
@@ -51,53 +53,378 @@
 
 #include <fmt/format.h>
 #include <kitty/bit_operations.hpp>
+#include <kitty/constructors.hpp>
 #include <kitty/dynamic_truth_table.hpp>
+#include <kitty/operations.hpp>
 
 namespace mockturtle
 {
 
-/*! \brief Computes satisfiability don't cares of a set of nodes.
+/*! \brief Window-based don't care manager.
  *
- * This function returns an under approximation of input assignments that
- * cannot occur on a given set of nodes in a network.  They may therefore be
- * used as don't care conditions.
+ * Computing don't cares inside an optimization loop requires a window
+ * around the current node, a simulation of that window, and a projection of
+ * the simulation values onto the leaves of a cut.  This class keeps the
+ * reconvergence-driven cut computation, the window membership, and the
+ * simulation buffers alive between calls, so that a query only touches the
+ * nodes of the window and does not allocate memory proportional to the size
+ * of the network.
  *
- * \param ntk Network
- * \param leaves Set of nodes
- * \param max_tfi_inputs Maximum number of inputs in the transitive fanin.
+ * A typical use computes a window around a node once with `set_window` and
+ * then calls `compute_care` for each of its cuts.  The network may grow
+ * between two calls to `set_window`.
+ *
+ * The truth table type `TT` must be large enough to hold the simulation
+ * values of a window, i.e., `kitty::static_truth_table<NumVars>` with
+ * `NumVars` not smaller than the window size, or
+ * `kitty::dynamic_truth_table`.
+ *
+ * If `SortByLevel` is true, the reconvergence-driven cut expands leaves of
+ * equal cost in the order of their level, which requires `level`.
+ *
+   \verbatim embed:rst
+
+   Example
+
+   .. code-block:: c++
+
+      dont_care_manager<aig_network> dcs( aig, 12u );
+      aig.foreach_gate( [&]( auto const& n ) {
+        auto const sdc = dcs.satisfiability_dont_cares( { aig.get_node( aig.get_fanin0( n ) ), aig.get_node( aig.get_fanin1( n ) ) } );
+        // ...
+      } );
+   \endverbatim
+ *
+ * **Required network functions:**
+ * - `get_node`
+ * - `size`
+ * - `node_to_index`
+ * - `is_constant`
+ * - `constant_value`
+ * - `is_ci`
+ * - `foreach_fanin`
+ * - `compute`
+ * - `visited`
+ * - `set_visited`
+ * - `incr_trav_id`
+ * - `trav_id`
  */
-template<class Ntk>
-kitty::dynamic_truth_table satisfiability_dont_cares( Ntk const& ntk, std::vector<node<Ntk>> const& leaves, uint64_t max_tfi_inputs = 16u )
+template<class Ntk, class TT = kitty::dynamic_truth_table, bool SortByLevel = false>
+class dont_care_manager
 {
-  reconvergence_driven_cut_parameters ps;
-  ps.max_leaves = max_tfi_inputs;
-  reconvergence_driven_cut_statistics st;
+public:
+  using node = typename Ntk::node;
+  using signal = typename Ntk::signal;
+
+public:
+  /*! \brief Constructor.
+   *
+   * \param ntk Network
+   * \param max_tfi_inputs Maximum number of inputs of a window
+   */
+  explicit dont_care_manager( Ntk const& ntk, uint32_t max_tfi_inputs = 16u )
+      : ntk( ntk ),
+        rps( make_reconv_parameters( max_tfi_inputs ) ),
+        reconv_cuts( ntk, rps, rst ),
+        stamps( ntk ),
+        indices( ntk )
+  {
+    if constexpr ( !std::is_same_v<TT, kitty::dynamic_truth_table> )
+    {
+      assert( max_tfi_inputs <= TT().num_vars() && "truth table type is too small for the window size" );
+    }
+  }
 
-  detail::reconvergence_driven_cut_impl<Ntk, false, false> cuts( ntk, ps, st );
-  auto const extended_leaves = cuts.run( leaves ).first;
+  /*! \brief Computes a window for a set of roots.
+   *
+   * The leaves of the window are computed with a reconvergence-driven cut
+   * of the roots, then all nodes of the window are simulated.
+   *
+   * \param roots Set of root nodes
+   * \return Number of leaves of the window
+   */
+  uint32_t set_window( std::vector<node> const& roots )
+  {
+    auto const extended_leaves = reconv_cuts.run( roots ).first;
+    set_window( extended_leaves, roots );
+    return static_cast<uint32_t>( window_leaves.size() );
+  }
+
+  /*! \brief Sets a window given by its leaves and roots.
+   *
+   * Every path from a primary input to a root must pass through a leaf.
+   *
+   * \param leaves Set of leaf nodes
+   * \param roots Set of root nodes
+   */
+  void set_window( std::vector<node> const& leaves, std::vector<node> const& roots )
+  {
+    stamps.resize();
+    indices.resize();
+    ++window_id;
 
-  fanout_view<Ntk> fanout_ntk{ ntk };
-  fanout_ntk.clear_visited();
-  color_view<Ntk> color_ntk{ fanout_ntk };
+    window_leaves = leaves;
+    window_gates.clear();
+    for ( auto const& l : window_leaves )
+    {
+      stamps[l] = window_id;
+    }
+    for ( auto const& r : roots )
+    {
+      collect_rec( r );
+    }
 
-  std::vector<node<Ntk>> gates{ collect_nodes( color_ntk, extended_leaves, leaves ) };
-  window_view window_ntk{ color_ntk, extended_leaves, leaves, gates };
+    simulate();
+  }
 
-  default_simulator<kitty::dynamic_truth_table> sim( window_ntk.num_pis() );
-  const auto tts = simulate_nodes<kitty::dynamic_truth_table>( window_ntk, sim );
+  /*! \brief Returns true if a node belongs to the current window. */
+  bool in_window( node const& n ) const
+  {
+    return ntk.node_to_index( n ) < stamps.size() && stamps[n] == window_id;
+  }
 
-  /* first create care and then invert */
-  kitty::dynamic_truth_table care( static_cast<uint32_t>( leaves.size() ) );
-  for ( auto i = 0u; i < ( 1u << window_ntk.num_pis() ); ++i )
+  /*! \brief Returns the simulation value of a node in the current window. */
+  TT const& value( node const& n ) const
   {
-    uint32_t entry{ 0u };
-    for ( auto j = 0u; j < leaves.size(); ++j )
+    assert( in_window( n ) );
+    return values[indices[n]];
+  }
+
+  /*! \brief Computes the care set of a cut in the current window.
+   *
+   * Bit `i` of `care` is set, if the values of the cut leaves can be equal
+   * to the assignment `i` for some assignment to the window leaves.  The
+   * leaves are given as a range of nodes.  If one of them is not contained
+   * in the current window, `care` is not modified and the function returns
+   * false.
+   *
+   * \param begin Begin iterator to the cut leaves
+   * \param end End iterator to the cut leaves
+   * \param care Care set, must have at least as many variables as leaves
+   */
+  template<class Iterator, class CareTT>
+  bool compute_care( Iterator begin, Iterator end, CareTT& care )
+  {
+    cut_values.clear();
+    for ( auto it = begin; it != end; ++it )
     {
-      entry |= kitty::get_bit( tts[leaves[j]], i ) << j;
+      if ( !in_window( *it ) )
+      {
+        return false;
+      }
+      cut_values.emplace_back( indices[*it] );
     }
-    kitty::set_bit( care, entry );
+
+    kitty::clear( care );
+    products.resize( cut_values.size() + 1u, make_tt() );
+    products[0u] = ~make_tt();
+    care_rec( 0u, 0u, care );
+    return true;
   }
-  return ~care;
+
+  /*! \brief Computes satisfiability don't cares of a set of nodes.
+   *
+   * The window is computed around the nodes (see `set_window`).
+   *
+   * \param leaves Set of nodes
+   */
+  kitty::dynamic_truth_table satisfiability_dont_cares( std::vector<node> const& leaves )
+  {
+    set_window( leaves );
+
+    kitty::dynamic_truth_table care( static_cast<uint32_t>( leaves.size() ) );
+    compute_care( leaves.begin(), leaves.end(), care );
+    return ~care;
+  }
+
+  /*! \brief Computes observability don't cares of a node.
+   *
+   * Returns the assignments to the leaves for which a change of the value
+   * of `n` cannot be observed at any of the roots.
+   *
+   * \param n A node in the window
+   * \param leaves Set of leaf nodes
+   * \param roots Set of root nodes
+   */
+  kitty::dynamic_truth_table observability_dont_cares( node const& n, std::vector<node> const& leaves, std::vector<node> const& roots )
+  {
+    set_window( leaves, roots );
+    assert( in_window( n ) );
+
+    kitty::dynamic_truth_table care( static_cast<uint32_t>( leaves.size() ) );
+
+    std::vector<TT> root_values;
+    root_values.reserve( roots.size() );
+
+    /* simulate with `n` forced to 0 and to 1, and compare the roots */
+    values[indices[n]] = make_tt();
+    simulate_after( n );
+    for ( auto const& r : roots )
+    {
+      root_values.emplace_back( values[indices[r]] );
+    }
+
+    values[indices[n]] = ~make_tt();
+    simulate_after( n );
+    auto diff = make_tt();
+    for ( auto i = 0u; i < roots.size(); ++i )
+    {
+      diff |= root_values[i] ^ values[indices[roots[i]]];
+    }
+
+    /* the window leaves are the variables of the result */
+    for ( auto i = 0u; i < care.num_bits(); ++i )
+    {
+      if ( kitty::get_bit( diff, i ) )
+      {
+        kitty::set_bit( care, i );
+      }
+    }
+
+    /* restore the window values */
+    simulate();
+    return ~care;
+  }
+
+private:
+  static reconvergence_driven_cut_parameters make_reconv_parameters( uint32_t max_tfi_inputs )
+  {
+    reconvergence_driven_cut_parameters ps;
+    ps.max_leaves = max_tfi_inputs;
+    return ps;
+  }
+
+  TT make_tt() const
+  {
+    if constexpr ( std::is_same_v<TT, kitty::dynamic_truth_table> )
+    {
+      return TT( static_cast<uint32_t>( window_leaves.size() ) );
+    }
+    else
+    {
+      return TT();
+    }
+  }
+
+  void collect_rec( node const& n )
+  {
+    if ( stamps[n] == window_id )
+    {
+      return;
+    }
+    stamps[n] = window_id;
+
+    assert( !ntk.is_ci( n ) && "window leaves must separate the roots from the inputs" );
+    ntk.foreach_fanin( n, [&]( auto const& f ) {
+      if ( ntk.is_constant( ntk.get_node( f ) ) )
+        return;
+      collect_rec( ntk.get_node( f ) );
+    } );
+    window_gates.emplace_back( n );
+  }
+
+  void simulate()
+  {
+    values.resize( window_leaves.size() + window_gates.size() );
+
+    auto i = 0u;
+    for ( auto const& l : window_leaves )
+    {
+      indices[l] = i;
+      values[i] = make_tt();
+      kitty::create_nth_var( values[i], i );
+      ++i;
+    }
+    for ( auto const& n : window_gates )
+    {
+      indices[n] = i;
+      values[i++] = compute( n );
+    }
+  }
+
+  /* re-simulates the gates collected after `n`, i.e., its transitive fanout in the window */
+  void simulate_after( node const& n )
+  {
+    for ( auto i = std::max<uint32_t>( indices[n] + 1u, window_leaves.size() ); i < values.size(); ++i )
+    {
+      values[i] = compute( window_gates[i - window_leaves.size()] );
+    }
+  }
+
+  TT compute( node const& n )
+  {
+    fanin_values.clear();
+    ntk.foreach_fanin( n, [&]( auto const& f ) {
+      auto const child = ntk.get_node( f );
+      if ( ntk.is_constant( child ) )
+      {
+        fanin_values.emplace_back( ntk.constant_value( child ) ? ~make_tt() : make_tt() );
+      }
+      else
+      {
+        fanin_values.emplace_back( values[indices[child]] );
+      }
+    } );
+    return ntk.compute( n, fanin_values.begin(), fanin_values.end() );
+  }
+
+  /* enumerates the assignments to the cut leaves that intersect the window's on-set */
+  template<class CareTT>
+  void care_rec( uint32_t j, uint32_t entry, CareTT& care )
+  {
+    if ( kitty::is_const0( products[j] ) )
+    {
+      return;
+    }
+    if ( j == cut_values.size() )
+    {
+      kitty::set_bit( care, entry );
+      return;
+    }
+
+    auto const& tt = values[cut_values[j]];
+    products[j + 1] = products[j] & ~tt;
+    care_rec( j + 1, entry, care );
+    products[j + 1] = products[j] & tt;
+    care_rec( j + 1, entry | ( 1u << j ), care );
+  }
+
+private:
+  Ntk const& ntk;
+  reconvergence_driven_cut_parameters const rps;
+  reconvergence_driven_cut_statistics rst;
+  detail::reconvergence_driven_cut_impl<Ntk, false, SortByLevel> reconv_cuts;
+
+  node_map<uint32_t, Ntk> stamps;
+  node_map<uint32_t, Ntk> indices;
+  uint32_t window_id{ 0u };
+
+  std::vector<node> window_leaves;
+  std::vector<node> window_gates;
+  std::vector<TT> values;
+  std::vector<TT> fanin_values;
+  std::vector<TT> products;
+  std::vector<uint32_t> cut_values;
+};
+
+/*! \brief Computes satisfiability don't cares of a set of nodes.
+ *
+ * This function returns an under approximation of input assignments that
+ * cannot occur on a given set of nodes in a network.  They may therefore be
+ * used as don't care conditions.
+ *
+ * When don't cares are computed for many sets of nodes in the same network,
+ * use a `dont_care_manager` instead, which reuses its memory across calls.
+ *
+ * \param ntk Network
+ * \param leaves Set of nodes
+ * \param max_tfi_inputs Maximum number of inputs in the transitive fanin.
+ */
+template<class Ntk>
+kitty::dynamic_truth_table satisfiability_dont_cares( Ntk const& ntk, std::vector<node<Ntk>> const& leaves, uint64_t max_tfi_inputs = 16u )
+{
+  dont_care_manager<Ntk> dcs( ntk, static_cast<uint32_t>( max_tfi_inputs ) );
+  return dcs.satisfiability_dont_cares( leaves );
 }
 
 /*! \brief Computes observability don't cares of a node.
@@ -114,14 +441,7 @@ kitty::dynamic_truth_table satisfiability_dont_cares( Ntk const& ntk, std::vecto
 template<class Ntk>
 kitty::dynamic_truth_table observability_dont_cares( Ntk const& ntk, node<Ntk> const& n, std::vector<node<Ntk>> const& leaves, std::vector<node<Ntk>> const& roots )
 {
-  fanout_view<Ntk> fanout_ntk{ ntk };
-  fanout_ntk.clear_visited();
-  color_view<Ntk> color_ntk{ fanout_ntk };
-
-  std::vector<node<Ntk>> gates{ collect_nodes( color_ntk, leaves, roots ) };
-  window_view window_ntk{ color_ntk, leaves, roots, gates };
-
-  default_simulator<kitty::dynamic_truth_table> sim( window_ntk.num_pis() );
+  default_simulator<kitty::dynamic_truth_table> sim( static_cast<uint32_t>( leaves.size() ) );
   unordered_node_map<kitty::dynamic_truth_table, Ntk> node_to_value0( ntk );
   unordered_node_map<kitty::dynamic_truth_table, Ntk> node_to_value1( ntk );
 
@@ -32,6 +32,8 @@
 
 #pragma once
 
+#include <algorithm>
+#include <atomic>
 #include <chrono>
 #include <cstdint>
 #include <limits>
@@ -51,6 +53,8 @@
 #include "../networks/block.hpp"
 #include "../networks/klut.hpp"
 #include "../utils/cuts.hpp"
+#include "../utils/level_parallel.hpp"
+#include "../utils/memory_usage.hpp"
 #include "../utils/node_map.hpp"
 #include "../utils/stopwatch.hpp"
 #include "../utils/tech_library.hpp"
@@ -131,6 +135,22 @@ struct emap_params
   /*! \brief Number of patterns for switching activity computation. */
   uint32_t switching_activity_patterns{ 2048u };
 
+  /*! \brief Precomputed switching activity of each node, indexed by node index.
+   *
+   * If empty, the switching activity is computed by random simulation
+   * of `switching_activity_patterns` patterns.
+   */
+  std::vector<float> switching_activities{};
+
+  /*! \brief Estimate the switching activity by toggle counting.
+   *
+   * If true, the switching activity is estimated by counting the value
+   * changes over `switching_activity_patterns` random cycles (see
+   * `switching_activity_engine`) instead of using `2p(1-p)` from the
+   * signal probabilities.
+   */
+  bool toggle_switching_activity{ false };
+
   /*! \brief Compute area-oriented alternative matches */
   bool use_match_alternatives{ true };
 
@@ -140,6 +160,15 @@ struct emap_params
   /*! \brief Remove overlapping multi-output cuts */
   bool remove_overlapping_multicuts{ false };
 
+  /*! \brief Number of threads for cut enumeration and matching.
+   *
+   * Nodes on the same level are processed in parallel (0 uses all
+   * hardware threads).  The mapping is identical to the one computed
+   * with a single thread.  Mapping with multi-output gates and exact
+   * area recovery always run on a single thread.
+   */
+  uint32_t num_threads{ 1u };
+
   /*! \brief Be verbose. */
   bool verbose{ false };
 };
@@ -168,6 +197,9 @@ struct emap_stats
   /*! \brief Total runtime. */
   stopwatch<>::duration time_total{ 0 };
 
+  /*! \brief Memory of the networks and the mapper's data structures at the end (bytes). */
+  uint64_t memory_footprint{ 0 };
+
   /*! \brief Cut enumeration stats. */
   cut_enumeration_stats cut_enumeration_st{};
 
@@ -194,6 +226,10 @@ struct emap_stats
       std::cout << fmt::format( "[i] Multi-output runtime = {:>5.2f} secs\n", to_seconds( time_multioutput ) );
     }
     std::cout << fmt::format( "[i] Total runtime        = {:>5.2f} secs\n", to_seconds( time_total ) );
+    if ( memory_footprint > 0u )
+    {
+      std::cout << fmt::format( "[i] Memory footprint     = {:>5.2f} MB\n", memory_footprint / 1048576.0 );
+    }
   }
 };
 
@@ -801,9 +837,10 @@ public:
         st( st ),
         node_match( ntk.size() ),
         node_tuple_match( ntk.size() ),
-        switch_activity( ps.eswp_rounds ? switching_activity( ntk, ps.switching_activity_patterns ) : std::vector<float>( 0 ) ),
+        switch_activity( ps.eswp_rounds ? ( !ps.switching_activities.empty() ? ps.switching_activities : ps.toggle_switching_activity ? toggle_switching_activity( ntk, ps.switching_activity_patterns ) : switching_activity( ntk, ps.switching_activity_patterns ) ) : std::vector<float>( 0 ) ),
         cuts( ntk.size() )
   {
+    assert( ps.switching_activities.empty() || ps.switching_activities.size() >= ntk.size() );
     std::memset( node_tuple_match.data(), 0, sizeof( multioutput_info ) * ntk.size() );
     std::tie( lib_inv_area, lib_inv_delay, lib_inv_id ) = library.get_inverter_info();
     std::tie( lib_buf_area, lib_buf_delay, lib_buf_id ) = library.get_buffer_info();
@@ -828,6 +865,7 @@ public:
 
   cell_view<block_network> run_block()
   {
+    trace_span span( "emap" );
     time_begin = clock::now();
 
     auto [res, old2new] = initialize_block_network();
@@ -879,6 +917,7 @@ public:
 
     /* generate the output network */
     finalize_cover_block( res, old2new );
+    update_memory_footprint( res );
     st.time_total = ( clock::now() - time_begin );
 
     return res;
@@ -886,6 +925,7 @@ public:
 
   binding_view<klut_network> run_klut()
   {
+    trace_span span( "emap" );
     time_begin = clock::now();
 
     auto [res, old2new] = initialize_map_network();
@@ -937,6 +977,7 @@ public:
 
     /* generate the output network */
     finalize_cover( res, old2new );
+    update_memory_footprint( res );
     st.time_total = ( clock::now() - time_begin );
 
     return res;
@@ -944,6 +985,7 @@ public:
 
   binding_view<klut_network> run_node_map()
   {
+    trace_span span( "emap" );
     time_begin = clock::now();
 
     auto [res, old2new] = initialize_map_network();
@@ -982,6 +1024,7 @@ public:
 
     /* generate the output network */
     finalize_cover( res, old2new );
+    update_memory_footprint( res );
     st.time_total = ( clock::now() - time_begin );
 
     return res;
@@ -990,6 +1033,8 @@ public:
 private:
   bool improve_mapping()
   {
+    trace_span span( "emap_area_recovery" );
+
     /* compute mapping using global area flow */
     uint32_t i = 0;
     while ( i++ < ps.area_flow_rounds )
@@ -1028,15 +1073,14 @@ private:
   template<bool DO_AREA>
   bool compute_mapping_match()
   {
-    bool warning_box = false;
+    trace_span span( "emap_match" );
 
-    for ( auto const& n : topo_order )
-    {
+    bool const warning_box = foreach_mapping_node( [&]( auto const& n, bool& warning ) {
       auto const index = ntk.node_to_index( n );
 
-      if ( !compute_matches_node<DO_AREA>( n, warning_box ) )
+      if ( !compute_matches_node<DO_AREA>( n, warning ) )
       {
-        continue;
+        return;
       }
 
       /* load multi-output cuts and data */
@@ -1066,7 +1110,7 @@ private:
             multi_node_update<DO_AREA>( n );
         }
       }
-    }
+    } );
 
     double area_old = area;
     bool success = set_mapping_refs_and_req<DO_AREA, false>();
@@ -1176,7 +1220,8 @@ private:
 
     /* compute cuts */
     const auto fanin = 2;
-    ntk.foreach_fanin( ntk.index_to_node( index ), [this]( auto child, auto i ) {
+    cut_merge_t lcuts{};
+    ntk.foreach_fanin( ntk.index_to_node( index ), [&]( auto child, auto i ) {
       lcuts[i] = &cuts[ntk.node_to_index( ntk.get_node( child ) )];
     } );
     lcuts[2] = &cuts[index];
@@ -1184,9 +1229,9 @@ private:
 
     /* move pre-computed structural cuts to a temporary cutset */
     bool reinsert_cuts = false;
+    cut_set_t temp_cuts;
     if ( rcuts.size() )
     {
-      temp_cuts.clear();
       for ( auto& cut : rcuts )
       {
         if ( ( *cut )->ignore )
@@ -1274,7 +1319,8 @@ private:
 
     /* compute cuts */
     std::vector<uint32_t> cut_sizes;
-    ntk.foreach_fanin( ntk.index_to_node( index ), [this, &cut_sizes]( auto child, auto i ) {
+    cut_merge_t lcuts{};
+    ntk.foreach_fanin( ntk.index_to_node( index ), [&]( auto child, auto i ) {
       lcuts[i] = &cuts[ntk.node_to_index( ntk.get_node( child ) )];
       cut_sizes.push_back( static_cast<uint32_t>( lcuts[i]->size() ) );
     } );
@@ -1387,22 +1433,19 @@ private:
       return true;
     }
 
-    bool warning_box = false;
-    for ( auto const& n : topo_order )
-    {
+    bool const warning_box = foreach_mapping_node( [&]( auto const& n, bool& ) {
       auto const index = ntk.node_to_index( n );
-      auto& node_data = node_match[index];
 
       if ( ntk.is_constant( n ) )
       {
         add_zero_cut( index );
         match_constants( index );
-        continue;
+        return;
       }
       else if ( ntk.is_pi( n ) )
       {
         add_unit_cut( index );
-        continue;
+        return;
       }
 
       /* don't touch box */
@@ -1411,13 +1454,13 @@ private:
         if ( ntk.is_dont_touch( n ) )
         {
           add_unit_cut( index );
-          continue;
+          return;
         }
       }
 
       /* compute cuts for node */
       merge_cuts_structural( n );
-    }
+    } );
 
     if ( warning_box )
     {
@@ -1427,7 +1470,7 @@ private:
     /* round stats */
     if ( ps.verbose )
     {
-      st.round_stats.push_back( fmt::format( "[i] SCuts    : Cuts  = {:>12d}  Time = {:>12.2f}\n", cuts_total, to_seconds( clock::now() - time_begin ) ) );
+      st.round_stats.push_back( fmt::format( "[i] SCuts    : Cuts  = {:>12d}  Time = {:>12.2f}\n", cuts_total.load(), to_seconds( clock::now() - time_begin ) ) );
     }
 
     return true;
@@ -1442,6 +1485,7 @@ private:
     /* compute cuts */
     const auto fanin = 2;
     std::array<uint32_t, 2> children_phase;
+    cut_merge_t lcuts{};
     ntk.foreach_fanin( ntk.index_to_node( index ), [&]( auto child, auto i ) {
       lcuts[i] = &cuts[ntk.node_to_index( ntk.get_node( child ) )];
       children_phase[i] = ntk.is_complemented( child ) ? 1 : 0;
@@ -1512,8 +1556,9 @@ private:
   template<bool DO_AREA>
   bool compute_mapping_match_node()
   {
-    for ( auto const& n : topo_order )
-    {
+    trace_span span( "emap_match" );
+
+    foreach_mapping_node( [&]( auto const& n, bool& ) {
       auto const index = ntk.node_to_index( n );
       auto& node_data = node_match[index];
 
@@ -1531,7 +1576,7 @@ private:
         node_data.arrival[0] = node_data.arrival[1] = 0.0f;
         add_zero_cut( index );
         match_constants( index );
-        continue;
+        return;
       }
       else if ( ntk.is_pi( n ) )
       {
@@ -1540,7 +1585,7 @@ private:
         /* PIs have the negative phase implemented with an inverter */
         node_data.flows[1] = lib_inv_area / node_data.est_refs[1];
         add_unit_cut( index );
-        continue;
+        return;
       }
 
       /* compute the node mapping */
@@ -1557,7 +1602,7 @@ private:
 
       /* select alternative matches to use */
       select_alternatives<DO_AREA>( n );
-    }
+    } );
     double area_old = area;
     bool success = set_mapping_refs_and_req<DO_AREA, false>();
 
@@ -1612,20 +1657,19 @@ private:
   template<bool DO_AREA>
   bool compute_mapping()
   {
-    for ( auto const& n : topo_order )
-    {
+    foreach_mapping_node( [&]( auto const& n, bool& ) {
       uint32_t index = ntk.node_to_index( n );
 
       /* reset mapping */
       node_match[index].map_refs[0] = node_match[index].map_refs[1] = 0u;
 
       if ( ntk.is_constant( n ) )
-        continue;
+        return;
       if ( ntk.is_pi( n ) )
       {
         node_match[index].flows[1] = lib_inv_area / node_match[index].est_refs[1];
         node_match[index].best_alternative[1].flow = lib_inv_area / node_match[index].est_refs[1];
-        continue;
+        return;
       }
 
       /* don't touch box */
@@ -1637,7 +1681,7 @@ private:
           {
             propagate_data_forward_white_box( n );
           }
-          continue;
+          return;
         }
       }
 
@@ -1663,7 +1707,7 @@ private:
 
       assert( node_match[index].arrival[0] < node_match[index].required[0] + epsilon );
       assert( node_match[index].arrival[1] < node_match[index].required[1] + epsilon );
-    }
+    } );
 
     double area_old = area;
     bool success = set_mapping_refs_and_req<DO_AREA, false>();
@@ -4148,6 +4192,34 @@ private:
     topo_view<Ntk>( ntk ).foreach_node( [this]( auto n ) {
       topo_order.push_back( n );
     } );
+
+    if ( ps.num_threads != 1u && !ps.map_multioutput )
+    {
+      levels = compute_level_order( ntk, topo_order );
+    }
+  }
+
+  /* calls `fn( n, warning_box )` on the nodes in topological order, or level by level in parallel */
+  template<class Fn>
+  bool foreach_mapping_node( Fn&& fn )
+  {
+    if ( levels.nodes.empty() )
+    {
+      bool warning_box = false;
+      for ( auto const& n : topo_order )
+      {
+        fn( n, warning_box );
+      }
+      return warning_box;
+    }
+
+    std::vector<uint8_t> warnings( level_parallel_threads( ps.num_threads ), 0u );
+    foreach_node_level_parallel( levels, ps.num_threads, [&]( auto const& n, uint32_t thread_id ) {
+      bool warning_box = false;
+      fn( n, warning_box );
+      warnings[thread_id] |= warning_box ? 1u : 0u;
+    } );
+    return std::any_of( warnings.begin(), warnings.end(), []( auto w ) { return w != 0u; } );
   }
 
   bool init_arrivals()
@@ -4816,6 +4888,7 @@ private:
    */
   void compute_truth_table_support( cut_t const& sub, cut_t const& sup, TT& tt )
   {
+    support_t lsupport;
     size_t j = 0;
     auto itp = sup.begin();
     for ( auto i : sub )
@@ -4914,6 +4987,7 @@ private:
 
   void compute_truth_table( uint32_t index, fanin_cut_t const& vcuts, uint32_t fanin, cut_t& res )
   {
+    truth_compute_t ltruth;
     for ( uint32_t i = 0; i < fanin; ++i )
     {
       cut_t const* cut = vcuts[i];
@@ -5697,6 +5771,12 @@ private:
   }
 #pragma endregion
 
+  template<class MappedNtk>
+  void update_memory_footprint( MappedNtk const& res )
+  {
+    st.memory_footprint = memory_footprint( ntk, res, topo_order, node_match, node_tuple_match, switch_activity, tmp_visited, cuts, multi_cut_set, multi_node_match );
+  }
+
 private:
   Ntk const& ntk;
   tech_library<NInputs, Configuration> const& library;
@@ -5719,18 +5799,15 @@ private:
   uint32_t lib_buf_id;
 
   std::vector<node<Ntk>> topo_order;
+  level_order<Ntk> levels; /* nodes grouped by level for parallel matching */
   node_match_t node_match;
   std::vector<multioutput_info> node_tuple_match;
   std::vector<float> switch_activity;
   std::vector<uint64_t> tmp_visited;
 
   /* cut computation */
-  std::vector<cut_set_t> cuts; /* compressed representation of cuts */
-  cut_merge_t lcuts;           /* cut merger container */
-  cut_set_t temp_cuts;         /* temporary cut set container */
-  truth_compute_t ltruth;      /* truth table merger container */
-  support_t lsupport;          /* support merger container */
-  uint32_t cuts_total{ 0 };    /* current computed cuts */
+  std::vector<cut_set_t> cuts;           /* compressed representation of cuts */
+  std::atomic<uint32_t> cuts_total{ 0 }; /* current computed cuts */
 
   /* multi-output matching */
   multi_cut_set_t multi_cut_set;    /* set of multi-output cuts */
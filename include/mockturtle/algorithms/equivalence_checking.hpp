@@ -33,13 +33,20 @@
 
 #pragma once
 
+#include <algorithm>
+#include <atomic>
 #include <cstdint>
 #include <iostream>
+#include <optional>
+#include <random>
+#include <thread>
 #include <vector>
 
 #include "cleanup.hpp"
 #include "functional_reduction.hpp"
+#include "simulation.hpp"
 #include "../traits.hpp"
+#include "../utils/node_map.hpp"
 #include "../utils/include/percy.hpp"
 #include "../utils/stopwatch.hpp"
 #include "../networks/klut.hpp"
@@ -70,6 +77,24 @@ struct equivalence_checking_params
   /*! \brief Whether to apply functional reduction before SAT solving. */
   bool functional_reduction{ true };
 
+  /*! \brief Number of threads checking the outputs of a multi-output miter.
+   *
+   * Each thread checks the cones of some outputs with its own solver
+   * (0 uses all hardware threads).
+   */
+  uint32_t num_threads{ 1u };
+
+  /*! \brief Number of consecutive outputs of a multi-output miter that are
+   * checked together with one solver. */
+  uint32_t output_group_size{ 1u };
+
+  /*! \brief Number of random patterns simulated on a multi-output miter
+   * before SAT solving (0 disables simulation). */
+  uint32_t num_patterns{ 256u };
+
+  /*! \brief Seed for the random patterns. */
+  uint32_t seed{ 1u };
+
   /*! \brief Be verbose. */
   bool verbose{ false };
 };
@@ -87,6 +112,20 @@ struct equivalence_checking_stats
   /*! \brief Counter-example, in case miter is not equivalent. */
   std::vector<bool> counter_example;
 
+  /*! \brief Miter output set to 1 by the counter-example (multi-output miters). */
+  std::optional<uint32_t> failing_output;
+
+  /*! \brief Time spent checking each output (multi-output miters).
+   *
+   * Outputs checked together share the time of their group.  Outputs
+   * resolved by simulation or skipped after a counter-example was found
+   * have no time.
+   */
+  std::vector<stopwatch<>::duration> output_times;
+
+  /*! \brief Number of SAT instances solved (multi-output miters). */
+  uint32_t num_sat_calls{ 0u };
+
   void report() const
   {
     if ( counter_example.size() > 0 )
@@ -96,6 +135,17 @@ struct equivalence_checking_stats
         std::cout << "pi" << i << "=" << counter_example[i] << " ";
       std::cout << "\n";
     }
+    if ( failing_output )
+    {
+      std::cout << fmt::format( "[i] failing output = {}\n", *failing_output );
+    }
+
+    if ( num_sat_calls > 0 )
+    {
+      auto const slowest = std::max_element( output_times.begin(), output_times.end() ) - output_times.begin();
+      std::cout << fmt::format( "[i] outputs = {}\t SAT calls = {}\t slowest output = {} ({:>5.2f} secs)\n",
+                                output_times.size(), num_sat_calls, slowest, to_seconds( output_times[slowest] ) );
+    }
 
     std::cout << fmt::format( "[i] total time = {:>5.2f} secs\n", to_seconds( time_total ) );
   }
@@ -246,6 +296,253 @@ private:
   equivalence_checking_stats& st_;
 };
 
+/* checks the outputs of a multi-output miter separately: outputs refuted
+ * by random simulation are reported directly, the other ones are copied
+ * into single-output miters (one for each group of outputs) and checked
+ * by independent solvers in parallel */
+template<class Ntk>
+class equivalence_checking_outputs_impl
+{
+public:
+  using node = typename Ntk::node;
+  using signal = typename Ntk::signal;
+
+  equivalence_checking_outputs_impl( Ntk const& miter, equivalence_checking_params const& ps, equivalence_checking_stats& st )
+      : miter_( miter ),
+        ps_( ps ),
+        st_( st )
+  {
+  }
+
+  std::optional<bool> run()
+  {
+    stopwatch<> t( st_.time_total );
+
+    st_.output_times.assign( miter_.num_pos(), stopwatch<>::duration{} );
+
+    /* outputs that are not refuted by simulation */
+    std::vector<uint32_t> outputs;
+    if ( ps_.num_patterns > 0u && miter_.num_pis() > 0u )
+    {
+      /* one engine for all inputs to avoid correlated patterns */
+      std::mt19937_64 rng( ps_.seed );
+      std::vector<kitty::partial_truth_table> patterns( miter_.num_pis(), kitty::partial_truth_table( ps_.num_patterns ) );
+      for ( auto& pattern : patterns )
+      {
+        for ( auto& word : pattern._bits )
+        {
+          word = rng();
+        }
+        pattern.mask_bits();
+      }
+
+      partial_simulator sim( patterns );
+      auto const values = simulate<kitty::partial_truth_table>( miter_, sim );
+      for ( auto i = 0u; i < values.size(); ++i )
+      {
+        /* bits beyond the number of patterns may be set by complementation */
+        if ( auto const bit = kitty::find_first_one_bit( values[i] ); bit != -1 && bit < ps_.num_patterns )
+        {
+          st_.counter_example.clear();
+          for ( auto const& pattern : sim.get_patterns() )
+          {
+            st_.counter_example.push_back( kitty::get_bit( pattern, bit ) );
+          }
+          st_.failing_output = i;
+          return false;
+        }
+        outputs.push_back( i );
+      }
+    }
+    else
+    {
+      for ( auto i = 0u; i < miter_.num_pos(); ++i )
+      {
+        outputs.push_back( i );
+      }
+    }
+
+    /* gates in topological order, shared by all threads */
+    topo_view topo{ miter_ };
+    topo.foreach_gate( [&]( auto const& n ) {
+      topo_order_.push_back( n );
+    } );
+    position_.resize( miter_.size() );
+    for ( auto i = 0u; i < topo_order_.size(); ++i )
+    {
+      position_[miter_.node_to_index( topo_order_[i] )] = i;
+    }
+
+    auto const group_size = std::max( 1u, ps_.output_group_size );
+    for ( auto i = 0u; i < outputs.size(); i += group_size )
+    {
+      groups_.emplace_back( outputs.begin() + i, outputs.begin() + std::min<std::size_t>( i + group_size, outputs.size() ) );
+    }
+    started_.resize( groups_.size(), 0u );
+    results_.resize( groups_.size() );
+    counter_examples_.resize( groups_.size() );
+    times_.resize( groups_.size() );
+
+    uint32_t num_threads = ps_.num_threads == 0u ? std::max( 1u, std::thread::hardware_concurrency() ) : ps_.num_threads;
+    num_threads = std::max<uint32_t>( 1u, std::min<std::size_t>( num_threads, groups_.size() ) );
+    if ( num_threads == 1u )
+    {
+      worker();
+    }
+    else
+    {
+      std::vector<std::thread> threads;
+      for ( auto i = 0u; i < num_threads; ++i )
+      {
+        threads.emplace_back( [&]() { worker(); } );
+      }
+      for ( auto& thread : threads )
+      {
+        thread.join();
+      }
+    }
+
+    /* collect the results in output order */
+    std::optional<bool> result = true;
+    for ( auto i = 0u; i < groups_.size(); ++i )
+    {
+      if ( !started_[i] )
+        continue;
+
+      ++st_.num_sat_calls;
+      for ( auto o : groups_[i] )
+      {
+        st_.output_times[o] = times_[i];
+      }
+
+      if ( !results_[i] )
+      {
+        result = std::nullopt;
+      }
+      else if ( !*results_[i] )
+      {
+        st_.counter_example = counter_examples_[i];
+        st_.failing_output = failing_output( counter_examples_[i] );
+        return false;
+      }
+    }
+    return result;
+  }
+
+private:
+  void worker()
+  {
+    node_map<signal, Ntk> old_to_new( miter_ );
+    std::vector<uint32_t> stamps( miter_.size(), 0u );
+    std::vector<node> stack;
+    std::vector<uint32_t> cone;
+
+    while ( !found_ )
+    {
+      auto const i = next_group_++;
+      if ( i >= groups_.size() )
+        break;
+      started_[i] = 1u;
+
+      stopwatch<> t( times_[i] );
+      auto const single = extract_cone( groups_[i], i + 1u, old_to_new, stamps, stack, cone );
+
+      equivalence_checking_params ps = ps_;
+      ps.verbose = false;
+      equivalence_checking_stats st;
+      results_[i] = equivalence_checking_impl<Ntk>( single, ps, st ).run();
+
+      if ( results_[i] && !*results_[i] )
+      {
+        /* functional reduction may reduce the miter without solving */
+        if ( st.counter_example.empty() )
+        {
+          ps.functional_reduction = false;
+          results_[i] = equivalence_checking_impl<Ntk>( single, ps, st ).run();
+        }
+        counter_examples_[i] = st.counter_example;
+        found_ = true;
+      }
+    }
+  }
+
+  /* copies the transitive fanin of the outputs into a single-output
+   * miter with the same primary inputs */
+  Ntk extract_cone( std::vector<uint32_t> const& outputs, uint32_t stamp, node_map<signal, Ntk>& old_to_new,
+                    std::vector<uint32_t>& stamps, std::vector<node>& stack, std::vector<uint32_t>& cone ) const
+  {
+    Ntk dest;
+    old_to_new[miter_.get_constant( false )] = dest.get_constant( false );
+    if ( miter_.get_node( miter_.get_constant( true ) ) != miter_.get_node( miter_.get_constant( false ) ) )
+    {
+      old_to_new[miter_.get_constant( true )] = dest.get_constant( true );
+    }
+    miter_.foreach_pi( [&]( auto const& n ) {
+      old_to_new[n] = dest.create_pi();
+    } );
+
+    cone.clear();
+    for ( auto o : outputs )
+    {
+      stack.push_back( miter_.get_node( miter_.po_at( o ) ) );
+    }
+    while ( !stack.empty() )
+    {
+      auto const n = stack.back();
+      stack.pop_back();
+
+      auto const index = miter_.node_to_index( n );
+      if ( stamps[index] == stamp || miter_.is_constant( n ) || miter_.is_ci( n ) )
+        continue;
+      stamps[index] = stamp;
+      cone.push_back( position_[index] );
+
+      miter_.foreach_fanin( n, [&]( auto const& f ) {
+        stack.push_back( miter_.get_node( f ) );
+      } );
+    }
+
+    std::sort( cone.begin(), cone.end() );
+    for ( auto position : cone )
+    {
+      cleanup_copy_gate( miter_, dest, topo_order_[position], old_to_new );
+    }
+
+    std::vector<signal> pos;
+    for ( auto o : outputs )
+    {
+      auto const f = miter_.po_at( o );
+      pos.push_back( miter_.is_complemented( f ) ? dest.create_not( old_to_new[f] ) : old_to_new[f] );
+    }
+    dest.create_po( pos.size() == 1u ? pos[0] : dest.create_nary_or( pos ) );
+    return dest;
+  }
+
+  uint32_t failing_output( std::vector<bool> const& counter_example ) const
+  {
+    auto const values = simulate<bool>( miter_, default_simulator<bool>( counter_example ) );
+    return static_cast<uint32_t>( std::find( values.begin(), values.end(), true ) - values.begin() );
+  }
+
+private:
+  Ntk const& miter_;
+  equivalence_checking_params const& ps_;
+  equivalence_checking_stats& st_;
+
+  std::vector<node> topo_order_;
+  std::vector<uint32_t> position_;
+  std::vector<std::vector<uint32_t>> groups_;
+
+  /* per group, written only by the thread checking the group */
+  std::vector<std::optional<bool>> results_;
+  std::vector<std::vector<bool>> counter_examples_;
+  std::vector<stopwatch<>::duration> times_;
+  std::vector<uint8_t> started_;
+
+  std::atomic<uint32_t> next_group_{ 0u };
+  std::atomic<bool> found_{ false };
+};
+
 } // namespace detail
 
 /*! \brief Combinational equivalence checking.
@@ -258,6 +555,15 @@ private:
  * the counter example is written to the statistics pointer as a
  * `std::vector<bool>` following the same order as the primary inputs.
  *
+ * The miter may also have several outputs, e.g., when it is generated with
+ * `miter_per_output`, and is equivalent if all outputs are constant 0.  The
+ * outputs are first simulated with random patterns.  The remaining outputs
+ * are checked one by one (or in groups of `output_group_size`) by
+ * independent solvers on `num_threads` threads, each on a copy of the
+ * transitive fanin of its outputs.  No further outputs are checked after a
+ * counter-example is found.  The statistics report the failing output and
+ * the time spent on each output.
+ *
  * \param miter Miter network
  * \param ps Parameters
  * \param st Statistics
@@ -269,15 +575,24 @@ std::optional<bool> equivalence_checking( Ntk const& miter, equivalence_checking
   static_assert( has_num_pis_v<Ntk>, "Ntk does not implement the num_pis method" );
   static_assert( has_num_pos_v<Ntk>, "Ntk does not implement the num_pos method" );
 
-  if ( miter.num_pos() != 1u )
+  if ( miter.num_pos() == 0u )
   {
-    std::cout << "[e] miter network must have a single output\n";
+    std::cout << "[e] miter network must have at least one output\n";
     return std::nullopt;
   }
 
   equivalence_checking_stats st;
-  detail::equivalence_checking_impl<Ntk> impl( miter, ps, st );
-  const auto result = impl.run();
+  std::optional<bool> result;
+  if ( miter.num_pos() == 1u )
+  {
+    detail::equivalence_checking_impl<Ntk> impl( miter, ps, st );
+    result = impl.run();
+  }
+  else
+  {
+    detail::equivalence_checking_outputs_impl<Ntk> impl( miter, ps, st );
+    result = impl.run();
+  }
 
   if ( ps.verbose )
   {
@@ -62,7 +62,9 @@
 #include "../utils/stopwatch.hpp"
 #include "../utils/abc.hpp"
 
+#include <algorithm>
 #include <random>
+#include <thread>
 
 #define explorer_debug 0
 
@@ -87,9 +89,26 @@ struct explorer_params
   /*! \brief Number of compressing scripts to run per step. */
   uint32_t compressing_scripts_per_step{3u};
 
-  /*! \brief Timeout per iteration in seconds. */
+  /*! \brief Timeout per iteration in seconds.
+   *
+   * The timeout is measured in wall-clock time from the start of the
+   * iteration and includes the time spent evaluating the cost function.
+   * It is checked after each step, so a step is never interrupted.
+   */
   uint32_t timeout{30u};
 
+  /*! \brief Number of iterations run in parallel (0 uses all cores).
+   *
+   * Each iteration works on its own copy of the network, hence the scripts
+   * must not share mutable state (e.g., the global frame of ABC).
+   */
+  uint32_t num_threads{1u};
+
+  /*! \brief Number of steps without improvement after which an iteration
+   * continues from the best network of the previous iterations, if it is
+   * better than its own (0 disables). */
+  uint32_t reseed_after{0u};
+
   /*! \brief Be verbose. */
   bool verbose{false};
 
@@ -153,30 +172,70 @@ public:
     auto init_cost = call_with_stopwatch( _st.time_evaluate, [&](){ return cost( ntk ); } );
     Ntk best = ntk.clone();
     auto best_cost = init_cost;
-    for ( auto i = 0u; i < _ps.num_restarts; ++i )
+
+    /* seeds are drawn upfront, such that the result of each restart only depends on its seed */
+    std::vector<uint32_t> seeds( _ps.num_restarts );
+    std::generate( seeds.begin(), seeds.end(), [&](){ return static_cast<uint32_t>( rnd() ); } );
+
+    /* restarts run in rounds of `num_threads`; a round sees the best network of the previous rounds */
+    uint32_t num_threads = _ps.num_threads == 0u ? std::max( 1u, std::thread::hardware_concurrency() ) : _ps.num_threads;
+    num_threads = std::max( 1u, std::min( num_threads, _ps.num_restarts ) );
+    for ( auto first = 0u; first < _ps.num_restarts; first += num_threads )
     {
-      Ntk current = ntk.clone();
-      auto new_cost = run_one_iteration( current, rnd(), init_cost );
-      if ( new_cost < best_cost )
+      auto const round_size = std::min( num_threads, _ps.num_restarts - first );
+      std::vector<Ntk> results;
+      for ( auto j = 0u; j < round_size; ++j )
       {
-        best = current.clone();
-        best_cost = new_cost;
+        results.emplace_back( ntk.clone() );
+      }
+      std::vector<uint32_t> costs( round_size );
+      std::vector<stopwatch<>::duration> times_evaluate( round_size, stopwatch<>::duration{0} );
+
+      auto const run_restart = [&]( uint32_t j ){
+        costs[j] = run_one_iteration( results[j], seeds[first + j], init_cost, best, best_cost, times_evaluate[j] );
+      };
+      if ( round_size == 1u )
+      {
+        run_restart( 0u );
+      }
+      else
+      {
+        std::vector<std::thread> threads;
+        for ( auto j = 0u; j < round_size; ++j )
+        {
+          threads.emplace_back( run_restart, j );
+        }
+        for ( auto& thread : threads )
+        {
+          thread.join();
+        }
+      }
+
+      for ( auto j = 0u; j < round_size; ++j )
+      {
+        _st.time_evaluate += times_evaluate[j];
+        if ( costs[j] < best_cost )
+        {
+          best = results[j].clone();
+          best_cost = costs[j];
+        }
+        if ( _ps.verbose )
+          fmt::print( "[i] best cost in restart {}: {}, overall best cost: {}\n", first + j, costs[j], best_cost );
       }
-      if ( _ps.verbose )
-        fmt::print( "[i] best cost in restart {}: {}, overall best cost: {}\n", i, new_cost, best_cost );
     }
     return best;
   }
 
 private:
-  uint32_t run_one_iteration( Ntk& ntk, uint32_t seed, uint32_t init_cost )
+  uint32_t run_one_iteration( Ntk& ntk, uint32_t seed, uint32_t init_cost, Ntk const& shared_best, uint32_t shared_best_cost, stopwatch<>::duration& time_evaluate )
   {
     if ( _ps.verbose )
     {
       fmt::print( "\n[i] new restart using seed {}, original cost = {}\n", seed, init_cost );
     }
  
-    stopwatch<>::duration elapsed_time{0};
+    auto const start = stopwatch<>::clock::now();
+    auto const elapsed_time = [&](){ return stopwatch<>::clock::now() - start; };
     RandEngine rnd( seed );
     Ntk best = ntk.clone();
     auto best_cost = init_cost;
@@ -187,12 +246,9 @@ private:
       Ntk backup = ntk.clone();
     #endif
 
-      {
-        stopwatch t( elapsed_time );
-        decompress( ntk, rnd, i );
-        compress( ntk, rnd, i );
-      }
-      auto new_cost = call_with_stopwatch( _st.time_evaluate, [&](){ return cost( ntk ); } );
+      decompress( ntk, rnd, i );
+      compress( ntk, rnd, i );
+      auto new_cost = call_with_stopwatch( time_evaluate, [&](){ return cost( ntk ); } );
       if ( _ps.very_verbose )
         fmt::print( "[i] after step {}, cost = {}\n", i, new_cost );
 
@@ -216,16 +272,25 @@ private:
           fmt::print( "[i] updated new best at step {}: {}\n", i, best_cost );
         }
       }
+      if ( _ps.reseed_after > 0u && i - last_update >= _ps.reseed_after && shared_best_cost < best_cost )
+      {
+        ntk = shared_best.clone();
+        best = shared_best.clone();
+        best_cost = shared_best_cost;
+        last_update = i;
+        if ( _ps.verbose )
+          fmt::print( "[i] continue from the best network of previous restarts at step {}: {}\n", i, best_cost );
+      }
       if ( i - last_update >= _ps.max_steps_no_impr )
       {
         if ( _ps.verbose )
-          fmt::print( "[i] break restart at step {} after {} steps without improvement (elapsed time: {} secs)\n", i, _ps.max_steps_no_impr, to_seconds( elapsed_time ) );
+          fmt::print( "[i] break restart at step {} after {} steps without improvement (elapsed time: {} secs)\n", i, _ps.max_steps_no_impr, to_seconds( elapsed_time() ) );
         break;
       }
-      if ( to_seconds( elapsed_time ) >= _ps.timeout )
+      if ( to_seconds( elapsed_time() ) >= _ps.timeout )
       {
         if ( _ps.verbose )
-          fmt::print( "[i] break restart at step {} after timeout of {} secs\n", i, to_seconds( elapsed_time ) );
+          fmt::print( "[i] break restart at step {} after timeout of {} secs\n", i, to_seconds( elapsed_time() ) );
         break;
       }
     }
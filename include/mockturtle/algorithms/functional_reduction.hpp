@@ -157,10 +157,10 @@ public:
 
   void run()
   {
-    stopwatch t( st.time_total );
+    stopwatch t( st.time_total, "functional_reduction" );
 
     /* first simulation: the whole circuit; from 0 bits. */
-    call_with_stopwatch( st.time_sim, [&]() {
+    call_with_stopwatch( st.time_sim, "functional_reduction_simulation", [&]() {
       simulate_nodes<Ntk>( ntk, tts, sim, true );
     } );
 
@@ -176,6 +176,7 @@ public:
       size_before = ntk.size();
       substitute_equivalent_nodes();
     }
+    trace_counter( "gates", ntk.num_gates() );
   }
 
 private:
@@ -35,10 +35,15 @@
 
 #pragma once
 
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
 #include <iostream>
+#include <limits>
 #include <optional>
+#include <set>
 #include <unordered_map>
-#include <unordered_set>
+#include <utility>
 #include <vector>
 
 #include "../algorithms/cnf.hpp"
@@ -49,6 +54,11 @@
 #include "../views/cnf_view.hpp"
 
 #include <fmt/format.h>
+#include <kitty/detail/mscfix.hpp>
+
+#if defined( __AVX2__ )
+#include <immintrin.h>
+#endif
 
 namespace mockturtle
 {
@@ -56,132 +66,169 @@ namespace mockturtle
 namespace detail
 {
 
-class linear_sum_simulator
+/* index of the least significant one in a non-zero word */
+inline uint32_t trailing_zeros( uint64_t word )
 {
-public:
-  std::vector<uint32_t> compute_constant( bool ) const { return {}; }
-  std::vector<uint32_t> compute_pi( uint32_t index ) const { return { index }; }
-  std::vector<uint32_t> compute_not( std::vector<uint32_t> const& value ) const
+  assert( word != 0u );
+#if defined( _MSC_VER )
+  unsigned long index;
+  _BitScanForward64( &index, word );
+  return static_cast<uint32_t>( index );
+#else
+  return static_cast<uint32_t>( __builtin_ctzll( word ) );
+#endif
+}
+
+inline void xor_words( uint64_t* dst, uint64_t const* src, uint32_t num_words )
+{
+  auto i = 0u;
+#if defined( __AVX2__ )
+  for ( ; i + 4u <= num_words; i += 4u )
   {
-    assert( false && "No NOTs in linear forms allowed" );
-    std::abort();
-    return value;
+    auto const x = _mm256_loadu_si256( reinterpret_cast<__m256i const*>( dst + i ) );
+    auto const y = _mm256_loadu_si256( reinterpret_cast<__m256i const*>( src + i ) );
+    _mm256_storeu_si256( reinterpret_cast<__m256i*>( dst + i ), _mm256_xor_si256( x, y ) );
   }
-};
+#endif
+  for ( ; i < num_words; ++i )
+  {
+    dst[i] ^= src[i];
+  }
+}
 
-class linear_matrix_simulator
+/* number of ones in the bitwise AND of two word arrays */
+inline uint32_t and_count_words( uint64_t const* a, uint64_t const* b, uint32_t num_words )
 {
-public:
-  linear_matrix_simulator( uint32_t num_inputs ) : num_inputs_( num_inputs ) {}
-
-  std::vector<bool> compute_constant( bool ) const { return std::vector<bool>( num_inputs_, false ); }
-  std::vector<bool> compute_pi( uint32_t index ) const
+  uint64_t count{ 0u };
+  auto i = 0u;
+#if defined( __AVX2__ )
+  /* nibble-wise popcount with a lookup table, accumulated per 64-bit lane */
+  auto const lookup = _mm256_setr_epi8( 0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+                                        0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4 );
+  auto const low_mask = _mm256_set1_epi8( 0x0f );
+  auto acc = _mm256_setzero_si256();
+  for ( ; i + 4u <= num_words; i += 4u )
   {
-    std::vector<bool> row( num_inputs_, false );
-    row[index] = true;
-    return row;
+    auto const x = _mm256_and_si256( _mm256_loadu_si256( reinterpret_cast<__m256i const*>( a + i ) ),
+                                     _mm256_loadu_si256( reinterpret_cast<__m256i const*>( b + i ) ) );
+    auto const lo = _mm256_shuffle_epi8( lookup, _mm256_and_si256( x, low_mask ) );
+    auto const hi = _mm256_shuffle_epi8( lookup, _mm256_and_si256( _mm256_srli_epi16( x, 4 ), low_mask ) );
+    acc = _mm256_add_epi64( acc, _mm256_sad_epu8( _mm256_add_epi8( lo, hi ), _mm256_setzero_si256() ) );
   }
-  std::vector<bool> compute_not( std::vector<bool> const& value ) const
+  count += static_cast<uint64_t>( _mm256_extract_epi64( acc, 0 ) ) + static_cast<uint64_t>( _mm256_extract_epi64( acc, 1 ) ) +
+           static_cast<uint64_t>( _mm256_extract_epi64( acc, 2 ) ) + static_cast<uint64_t>( _mm256_extract_epi64( acc, 3 ) );
+#endif
+  for ( ; i < num_words; ++i )
   {
-    assert( false && "No NOTs in linear forms allowed" );
-    std::abort();
-    return value;
+    count += __builtin_popcountll( a[i] & b[i] );
   }
+  return static_cast<uint32_t>( count );
+}
 
-private:
-  uint32_t num_inputs_;
-};
-
-class linear_xag : public xag_network
+/*! \brief Bit-packed matrix over GF(2).
+ *
+ * Each row is stored in `num_words` consecutive 64-bit words, such that row
+ * operations are word-parallel.  Rows can be appended, which invalidates
+ * pointers returned by `row`.
+ */
+class gf2_matrix
 {
 public:
-  linear_xag( xag_network const& xag ) : xag_network( xag ) {}
-
-  template<typename Iterator>
-  iterates_over_t<Iterator, std::vector<uint32_t>>
-  compute( node const& n, Iterator begin, Iterator end ) const
+  explicit gf2_matrix( uint32_t num_columns = 0u )
+      : _num_columns( num_columns ),
+        _num_words( ( num_columns + 63u ) >> 6 )
   {
-    (void)end;
-
-    assert( n != 0 && !is_pi( n ) );
-
-    auto const& c1 = _storage->nodes[n].children[0];
-    auto const& c2 = _storage->nodes[n].children[1];
-
-    auto set1 = *begin++;
-    auto set2 = *begin++;
+  }
 
-    if ( c1.index < c2.index )
-    {
-      assert( false );
-      std::abort();
-      return {};
-    }
-    else
-    {
-      std::vector<uint32_t> result;
-      auto it1 = set1.begin();
-      auto it2 = set2.begin();
+  uint32_t num_rows() const { return _num_rows; }
+  uint32_t num_columns() const { return _num_columns; }
+  uint32_t num_words() const { return _num_words; }
 
-      while ( it1 != set1.end() && it2 != set2.end() )
-      {
-        if ( *it1 < *it2 )
-        {
-          result.push_back( *it1++ );
-        }
-        else if ( *it1 > *it2 )
-        {
-          result.push_back( *it2++ );
-        }
-        else
-        {
-          ++it1;
-          ++it2;
-        }
-      }
+  /*! \brief Appends a zero row and returns its index. */
+  uint32_t add_row()
+  {
+    _words.resize( _words.size() + _num_words, 0u );
+    return _num_rows++;
+  }
 
-      if ( it1 != set1.end() )
-      {
-        std::copy( it1, set1.end(), std::back_inserter( result ) );
-      }
-      else if ( it2 != set2.end() )
-      {
-        std::copy( it2, set2.end(), std::back_inserter( result ) );
-      }
+  uint64_t* row( uint32_t r ) { return _words.data() + static_cast<std::size_t>( r ) * _num_words; }
+  uint64_t const* row( uint32_t r ) const { return _words.data() + static_cast<std::size_t>( r ) * _num_words; }
 
-      return result;
-    }
+  bool get( uint32_t r, uint32_t c ) const
+  {
+    return ( row( r )[c >> 6] >> ( c & 63u ) ) & 1u;
   }
 
-  template<typename Iterator>
-  iterates_over_t<Iterator, std::vector<bool>>
-  compute( node const& n, Iterator begin, Iterator end ) const
+  void set( uint32_t r, uint32_t c )
   {
-    (void)end;
-
-    assert( n != 0 && !is_pi( n ) );
+    row( r )[c >> 6] |= uint64_t( 1 ) << ( c & 63u );
+  }
 
-    auto const& c1 = _storage->nodes[n].children[0];
-    auto const& c2 = _storage->nodes[n].children[1];
+  /*! \brief Row `dst` becomes the sum of rows `dst` and `src`. */
+  void xor_rows( uint32_t dst, uint32_t src )
+  {
+    xor_words( row( dst ), row( src ), _num_words );
+  }
 
-    auto set1 = *begin++;
-    auto set2 = *begin++;
+  /*! \brief Number of columns in which both rows have a one. */
+  uint32_t and_count( uint32_t r1, uint32_t r2 ) const
+  {
+    return and_count_words( row( r1 ), row( r2 ), _num_words );
+  }
 
-    if ( c1.index < c2.index )
-    {
-      assert( false );
-      std::abort();
-      return {};
-    }
-    else
+  /*! \brief Calls `fn` on the index of each one in row `r`. */
+  template<class Fn>
+  void foreach_one( uint32_t r, Fn&& fn ) const
+  {
+    auto const* words = row( r );
+    for ( auto w = 0u; w < _num_words; ++w )
     {
-      std::vector<bool> result( set1.size() );
-      std::transform( set1.begin(), set1.end(), set2.begin(), result.begin(), std::not_equal_to<bool>{} );
-      return result;
+      for ( auto word = words[w]; word != 0u; word &= word - 1u )
+      {
+        fn( ( w << 6 ) + trailing_zeros( word ) );
+      }
     }
   }
+
+private:
+  uint32_t _num_columns;
+  uint32_t _num_words;
+  uint32_t _num_rows{ 0u };
+  std::vector<uint64_t> _words;
 };
 
+/* linear forms of the outputs over the inputs, one row per output */
+template<class Ntk>
+gf2_matrix linear_output_forms( Ntk const& xag )
+{
+  gf2_matrix forms( xag.num_pis() );
+  std::vector<uint32_t> node_to_row( xag.size() );
+
+  node_to_row[xag.node_to_index( xag.get_node( xag.get_constant( false ) ) )] = forms.add_row();
+  xag.foreach_pi( [&]( auto const& n, auto i ) {
+    auto const r = forms.add_row();
+    forms.set( r, i );
+    node_to_row[xag.node_to_index( n )] = r;
+  } );
+  xag.foreach_gate( [&]( auto const& n ) {
+    assert( xag.is_xor( n ) && "No ANDs in linear forms allowed" );
+    auto const r = forms.add_row();
+    xag.foreach_fanin( n, [&]( auto const& f ) {
+      forms.xor_rows( r, node_to_row[xag.node_to_index( xag.get_node( f ) )] );
+    } );
+    node_to_row[xag.node_to_index( n )] = r;
+  } );
+
+  gf2_matrix outputs( xag.num_pis() );
+  xag.foreach_po( [&]( auto const& f ) {
+    auto const r = outputs.add_row();
+    forms.foreach_one( node_to_row[xag.node_to_index( xag.get_node( f ) )], [&]( auto c ) {
+      outputs.set( r, c );
+    } );
+  } );
+  return outputs;
+}
+
 struct pair_hash
 {
   template<class T1, class T2>
@@ -209,19 +256,28 @@ public:
 
     while ( !occurrence_to_pairs.empty() )
     {
-      const auto p = *( occurrence_to_pairs.back().begin() );
-      replace_one_pair( p );
+      auto const [a, b] = *occurrence_to_pairs.back().begin();
+      replace_one_pair( a, b );
+    }
+
+    /* each output is covered by at most one signal */
+    std::vector<uint32_t> output_to_signal( columns.num_columns(), std::numeric_limits<uint32_t>::max() );
+    for ( auto x = 0u; x < columns.num_rows(); ++x )
+    {
+      columns.foreach_one( x, [&]( auto o ) {
+        assert( output_to_signal[o] == std::numeric_limits<uint32_t>::max() );
+        output_to_signal[o] = x;
+      } );
     }
 
     xag.foreach_po( [&]( auto const& f, auto i ) {
-      if ( linear_equations[i].empty() )
+      if ( output_to_signal[i] == std::numeric_limits<uint32_t>::max() )
       {
         dest.create_po( dest.get_constant( xag.is_complemented( f ) ) );
       }
       else
       {
-        assert( linear_equations[i].size() == 1u );
-        dest.create_po( signals[linear_equations[i].front()] ^ xag.is_complemented( f ) );
+        dest.create_po( signals[output_to_signal[i]] ^ xag.is_complemented( f ) );
       }
     } );
 
@@ -229,130 +285,115 @@ public:
   }
 
 private:
+  /* stores the linear equations column-wise, one bit-vector over the outputs per signal */
   void extract_linear_equations()
   {
-    occurrence_to_pairs.resize( 1u );
+    auto const outputs = linear_output_forms( xag );
 
-    linear_xag lxag{ xag };
-    linear_equations = simulate<std::vector<uint32_t>>( lxag, linear_sum_simulator{} );
+    columns = gf2_matrix( outputs.num_rows() );
+    for ( auto i = 0u; i < signals.size(); ++i )
+    {
+      columns.add_row();
+    }
+    for ( auto o = 0u; o < outputs.num_rows(); ++o )
+    {
+      outputs.foreach_one( o, [&]( auto i ) {
+        columns.set( i, o );
+      } );
+    }
 
-    for ( auto o = 0u; o < linear_equations.size(); ++o )
+    for ( auto x = 0u; x < columns.num_rows(); ++x )
     {
-      const auto& lin_eq = linear_equations[o];
-      for ( auto j = 1u; j < lin_eq.size(); ++j )
+      for ( auto y = x + 1u; y < columns.num_rows(); ++y )
       {
-        for ( auto i = 0u; i < j; ++i )
-        {
-          const auto p = std::make_pair( lin_eq[i], lin_eq[j] );
-          pairs_to_output[p].push_back( o );
-          add_pair( p );
-        }
+        set_occurrence( { x, y }, columns.and_count( x, y ) );
       }
     }
   }
 
-  void add_pair( index_pair_t const& p )
+  /* moves pair `p` to the bucket of `occ` occurrences, pairs without occurrences are not stored */
+  void set_occurrence( index_pair_t const& p, uint32_t occ )
   {
     if ( auto it = pair_to_occurrence.find( p ); it != pair_to_occurrence.end() )
     {
-      // found another time
-      const auto occ = it->second;
-      occurrence_to_pairs[occ - 1u].erase( p );
-      if ( occurrence_to_pairs.size() <= occ + 1u )
+      occurrence_to_pairs[it->second - 1u].erase( p );
+      if ( occ == 0u )
+      {
+        pair_to_occurrence.erase( it );
+      }
+      else
       {
-        occurrence_to_pairs.resize( occ + 1u );
+        it->second = occ;
       }
-      occurrence_to_pairs[occ].insert( p );
-      it->second++;
     }
-    else
+    else if ( occ != 0u )
     {
-      // first time found
-      pair_to_occurrence[p] = 1u;
-      occurrence_to_pairs[0u].insert( p );
+      pair_to_occurrence.emplace( p, occ );
     }
-  }
 
-  void remove_all_pairs( index_pair_t const& p )
-  {
-    auto it = pair_to_occurrence.find( p );
-    const auto occ = it->second;
-    pair_to_occurrence.erase( it );
-    occurrence_to_pairs[occ - 1u].erase( p );
+    if ( occ != 0u )
+    {
+      if ( occurrence_to_pairs.size() < occ )
+      {
+        occurrence_to_pairs.resize( occ );
+      }
+      occurrence_to_pairs[occ - 1u].insert( p );
+    }
     while ( !occurrence_to_pairs.empty() && occurrence_to_pairs.back().empty() )
     {
       occurrence_to_pairs.pop_back();
     }
-    pairs_to_output.erase( p );
   }
 
-  void remove_one_pair( index_pair_t const& p, uint32_t output )
+  uint32_t get_occurrence( index_pair_t const& p ) const
   {
     auto it = pair_to_occurrence.find( p );
-    const auto occ = it->second;
-    occurrence_to_pairs[occ - 1u].erase( p );
-    if ( occ > 1u )
-    {
-      occurrence_to_pairs[occ - 2u].insert( p );
-    }
-    it->second--;
-    pairs_to_output[p].erase( std::remove( pairs_to_output[p].begin(), pairs_to_output[p].end(), output ), pairs_to_output[p].end() );
+    return it == pair_to_occurrence.end() ? 0u : it->second;
   }
 
-  void replace_one_pair( index_pair_t const& p )
+  void replace_one_pair( uint32_t a, uint32_t b )
   {
-    const auto [a, b] = p;
-    auto c = static_cast<uint32_t>( signals.size() );
+    auto const c = static_cast<uint32_t>( signals.size() );
     signals.push_back( dest.create_xor( signals[a], signals[b] ) );
 
-    /* update data structures */
-    for ( auto o : pairs_to_output[p] )
+    /* the new signal covers the outputs that contain both a and b */
+    columns.add_row();
+    auto* col_c = columns.row( c );
+    auto const* col_a = columns.row( a );
+    auto const* col_b = columns.row( b );
+    for ( auto w = 0u; w < columns.num_words(); ++w )
     {
-      auto& leq = linear_equations[o];
-      leq.erase( std::remove( leq.begin(), leq.end(), a ), leq.end() );
-      leq.erase( std::remove( leq.begin(), leq.end(), b ), leq.end() );
-      for ( auto i : leq )
-      {
-        remove_one_pair( { std::min( i, a ), std::max( i, a ) }, o );
-        remove_one_pair( { std::min( i, b ), std::max( i, b ) }, o );
-        add_pair( { i, c } );
-        pairs_to_output[{ i, c }].push_back( o );
-      }
-      leq.push_back( c );
+      col_c[w] = col_a[w] & col_b[w];
     }
-    remove_all_pairs( p );
-  }
+    columns.xor_rows( a, c );
+    columns.xor_rows( b, c );
 
-  void print_linear_matrix()
-  {
-    for ( auto const& le : linear_equations )
+    /* update pair occurrences */
+    for ( auto x = 0u; x < c; ++x )
     {
-      auto it = le.begin();
-      for ( auto i = 0u; i < signals.size(); ++i )
-      {
-        if ( it != le.end() && *it == i )
-        {
-          std::cout << " 1";
-          it++;
-        }
-        else
-        {
-          std::cout << " 0";
-        }
-      }
-      assert( it == le.end() );
-      std::cout << "\n";
+      if ( x == a || x == b )
+        continue;
+
+      auto const occ = columns.and_count( c, x );
+      if ( occ == 0u )
+        continue;
+
+      set_occurrence( { x, c }, occ );
+      index_pair_t const pa{ std::min( x, a ), std::max( x, a ) };
+      index_pair_t const pb{ std::min( x, b ), std::max( x, b ) };
+      set_occurrence( pa, get_occurrence( pa ) - occ );
+      set_occurrence( pb, get_occurrence( pb ) - occ );
     }
+    set_occurrence( { a, b }, 0u );
   }
 
 private:
   Ntk const& xag;
   Ntk dest;
   std::vector<signal<Ntk>> signals;
-  std::vector<std::vector<uint32_t>> linear_equations;
-  std::vector<std::unordered_set<index_pair_t, pair_hash>> occurrence_to_pairs;
+  gf2_matrix columns;
   std::unordered_map<index_pair_t, uint32_t, pair_hash> pair_to_occurrence;
-  std::unordered_map<index_pair_t, std::vector<uint32_t>, pair_hash> pairs_to_output;
+  std::vector<std::set<index_pair_t>> occurrence_to_pairs;
 };
 
 } // namespace detail
@@ -956,8 +997,16 @@ std::vector<std::vector<bool>> get_linear_matrix( Ntk const& ntk )
 {
   static_assert( std::is_same_v<typename Ntk::base_type, xag_network>, "Ntk is not XAG-like" );
 
-  detail::linear_matrix_simulator sim( ntk.num_pis() );
-  return simulate<std::vector<bool>>( detail::linear_xag{ ntk }, sim );
+  auto const forms = detail::linear_output_forms( ntk );
+
+  std::vector<std::vector<bool>> matrix( forms.num_rows(), std::vector<bool>( forms.num_columns(), false ) );
+  for ( auto o = 0u; o < forms.num_rows(); ++o )
+  {
+    forms.foreach_one( o, [&]( auto i ) {
+      matrix[o][i] = true;
+    } );
+  }
+  return matrix;
 }
 
 /*! \brief Optimum linear circuit synthesis (based on SAT)
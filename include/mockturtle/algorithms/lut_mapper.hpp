@@ -32,6 +32,7 @@
 
 #pragma once
 
+#include <atomic>
 #include <cstdint>
 #include <fstream>
 #include <iostream>
@@ -50,6 +51,8 @@
 #include "../networks/klut.hpp"
 #include "../utils/cost_functions.hpp"
 #include "../utils/cuts.hpp"
+#include "../utils/level_parallel.hpp"
+#include "../utils/memory_usage.hpp"
 #include "../utils/node_map.hpp"
 #include "../utils/stopwatch.hpp"
 #include "../utils/truth_table_cache.hpp"
@@ -130,6 +133,16 @@ struct lut_map_params
   /*! \brief Maximum number variables for cost function caching */
   uint32_t cost_cache_vars{ 3u };
 
+  /*! \brief Number of threads for cut enumeration (0: all hardware threads).
+   *
+   * Delay-oriented rounds and the first area-oriented round process the
+   * nodes of each level in parallel, and the mapping is identical to the
+   * one computed with a single thread.  Area recovery rounds always run on
+   * a single thread, since they update the references of the cover while
+   * traversing the network.  Mapping with `StoreFunction` is sequential.
+   */
+  uint32_t num_threads{ 1u };
+
   /*! \brief Be verbose. */
   bool verbose{ false };
 };
@@ -151,6 +164,9 @@ struct lut_map_stats
   /*! \brief Total runtime. */
   stopwatch<>::duration time_total{ 0 };
 
+  /*! \brief Memory of the network and the mapper's data structures at the end (bytes). */
+  uint64_t memory_footprint{ 0 };
+
   /*! \brief Cut enumeration stats. */
   cut_enumeration_stats cut_enumeration_st{};
 
@@ -164,6 +180,10 @@ struct lut_map_stats
       std::cout << stat;
     }
     std::cout << fmt::format( "[i] Total runtime           = {:>5.2f} secs\n", to_seconds( time_total ) );
+    if ( memory_footprint > 0u )
+    {
+      std::cout << fmt::format( "[i] Memory footprint        = {:>5.2f} MB\n", memory_footprint / 1048576.0 );
+    }
   }
 };
 
@@ -660,7 +680,7 @@ public:
 
   klut_network run()
   {
-    stopwatch t( st.time_total );
+    stopwatch t( st.time_total, "lut_map" );
 
     /* compute and save topological order */
     topo_order.reserve( ntk.size() );
@@ -674,7 +694,7 @@ public:
 
   void run_inplace()
   {
-    stopwatch t( st.time_total );
+    stopwatch t( st.time_total, "lut_map" );
 
     /* compute and save topological order */
     topo_order.reserve( ntk.size() );
@@ -685,6 +705,7 @@ public:
     if ( ps.collapse_mffcs )
     {
       compute_mffcs_mapping();
+      update_memory_footprint();
       return;
     }
 
@@ -702,6 +723,15 @@ private:
     init_nodes();
     init_cuts();
 
+    /* group nodes by level for parallel cut enumeration */
+    if constexpr ( !StoreFunction )
+    {
+      if ( ps.num_threads != 1u )
+      {
+        levels = compute_level_order( ntk, topo_order );
+      }
+    }
+
     /* compute mapping for depth or area */
     if ( !ps.area_oriented_mapping )
     {
@@ -774,6 +804,13 @@ private:
       }
       ++i;
     }
+
+    update_memory_footprint();
+  }
+
+  void update_memory_footprint()
+  {
+    st.memory_footprint = memory_footprint( ntk, topo_order, tmp_visited, node_match, cuts, truth_tables, truth_tables_cost, isops );
   }
 
   void init_nodes()
@@ -803,9 +840,9 @@ private:
   template<bool DO_AREA, bool ELA>
   void compute_mapping( lut_cut_sort_type const sort, bool preprocess, bool recompute_cuts )
   {
+    trace_span span( "lut_map_round" );
     cuts_total = 0;
-    for ( auto const& n : topo_order )
-    {
+    auto const map_node = [&]( node const& n ) {
       if constexpr ( !ELA )
       {
         auto const index = ntk.node_to_index( n );
@@ -821,7 +858,7 @@ private:
 
       if ( ntk.is_constant( n ) || ntk.is_ci( n ) )
       {
-        continue;
+        return;
       }
 
       if ( recompute_cuts )
@@ -840,6 +877,21 @@ private:
         /* update cost the function and move the best one first */
         update_cut_data<DO_AREA, ELA>( n, sort );
       }
+    };
+
+    /* area recovery updates the references of the cover node by node */
+    if ( levels.nodes.empty() || ( DO_AREA && iteration != 0 ) )
+    {
+      for ( auto const& n : topo_order )
+      {
+        map_node( n );
+      }
+    }
+    else
+    {
+      foreach_node_level_parallel( levels, ps.num_threads, [&]( node const& n, uint32_t ) {
+        map_node( n );
+      } );
     }
 
     set_mapping_refs<ELA>();
@@ -855,19 +907,19 @@ private:
 
       if ( ( sort == lut_cut_sort_type::AREA || sort == lut_cut_sort_type::AREA2 ) && ELA )
       {
-        stats << fmt::format( "[i] Area     : Delay = {:8d}  Area = {:8d}  Edges = {:8d}  Cuts = {:8d}\n", delay, area, edges, cuts_total );
+        stats << fmt::format( "[i] Area     : Delay = {:8d}  Area = {:8d}  Edges = {:8d}  Cuts = {:8d}\n", delay, area, edges, cuts_total.load() );
       }
       else if ( sort == lut_cut_sort_type::AREA || sort == lut_cut_sort_type::AREA2 )
       {
-        stats << fmt::format( "[i] AreaFlow : Delay = {:8d}  Area = {:8d}  Edges = {:8d}  Cuts = {:8d}\n", delay, area, edges, cuts_total );
+        stats << fmt::format( "[i] AreaFlow : Delay = {:8d}  Area = {:8d}  Edges = {:8d}  Cuts = {:8d}\n", delay, area, edges, cuts_total.load() );
       }
       else if ( sort == lut_cut_sort_type::DELAY2 )
       {
-        stats << fmt::format( "[i] Delay2   : Delay = {:8d}  Area = {:8d}  Edges = {:8d}  Cuts = {:8d}\n", delay, area, edges, cuts_total );
+        stats << fmt::format( "[i] Delay2   : Delay = {:8d}  Area = {:8d}  Edges = {:8d}  Cuts = {:8d}\n", delay, area, edges, cuts_total.load() );
       }
       else
       {
-        stats << fmt::format( "[i] Delay    : Delay = {:8d}  Area = {:8d}  Edges = {:8d}  Cuts = {:8d}\n", delay, area, edges, cuts_total );
+        stats << fmt::format( "[i] Delay    : Delay = {:8d}  Area = {:8d}  Edges = {:8d}  Cuts = {:8d}\n", delay, area, edges, cuts_total.load() );
       }
       st.round_stats.push_back( stats.str() );
     }
@@ -895,7 +947,7 @@ private:
 
     /* round stats */
     {
-      st.round_stats.push_back( fmt::format( "[i] AreaSh   : Delay = {:8d}  Area = {:8d}  Edges = {:8d}  Cuts = {:8d}\n", delay, area, edges, cuts_total ) );
+      st.round_stats.push_back( fmt::format( "[i] AreaSh   : Delay = {:8d}  Area = {:8d}  Edges = {:8d}  Cuts = {:8d}\n", delay, area, edges, cuts_total.load() ) );
     }
   }
 
@@ -922,7 +974,7 @@ private:
 
     set_mapping_refs<ELA>();
 
-    std::string stats = fmt::format( "[i] Reduce   : Delay = {:8d}  Area = {:8d}  Edges = {:8d}  Cuts = {:8d}\n", delay, area, edges, cuts_total );
+    std::string stats = fmt::format( "[i] Reduce   : Delay = {:8d}  Area = {:8d}  Edges = {:8d}  Cuts = {:8d}\n", delay, area, edges, cuts_total.load() );
     st.round_stats.push_back( stats );
   }
 
@@ -1148,7 +1200,8 @@ private:
     /* compute cuts */
     const auto fanin = 2;
     uint32_t pairs{ 1 };
-    ntk.foreach_fanin( ntk.index_to_node( index ), [this, &pairs]( auto child, auto i ) {
+    cut_merge_t lcuts{};
+    ntk.foreach_fanin( ntk.index_to_node( index ), [&]( auto child, auto i ) {
       lcuts[i] = &cuts[ntk.node_to_index( ntk.get_node( child ) )];
       pairs *= static_cast<uint32_t>( lcuts[i]->size() );
     } );
@@ -1260,7 +1313,8 @@ private:
     /* compute cuts */
     uint32_t pairs{ 1 };
     std::vector<uint32_t> cut_sizes;
-    ntk.foreach_fanin( ntk.index_to_node( index ), [this, &pairs, &cut_sizes]( auto child, auto i ) {
+    cut_merge_t lcuts{};
+    ntk.foreach_fanin( ntk.index_to_node( index ), [&]( auto child, auto i ) {
       lcuts[i] = &cuts[ntk.node_to_index( ntk.get_node( child ) )];
       cut_sizes.push_back( static_cast<uint32_t>( lcuts[i]->size() ) );
       pairs *= cut_sizes.back();
@@ -1575,7 +1629,8 @@ private:
 
     assert( cost_after <= cost_before );
 
-    /* create the new cut */
+    /* create the new cut (cut merging requires sorted leaves) */
+    std::sort( leaves.begin(), leaves.end() );
     cut_t new_cut;
     new_cut.set_leaves( leaves.begin(), leaves.end() );
     new_cut->data = best_cut->data;
@@ -2145,7 +2200,7 @@ private:
 
     {
       std::stringstream stats;
-      stats << fmt::format( "[i] Area MFFC: Delay = {:8d}  Area = {:8d}  Edges = {:8d}  Cuts = {:8d}\n", delay, area, edges, cuts_total );
+      stats << fmt::format( "[i] Area MFFC: Delay = {:8d}  Area = {:8d}  Edges = {:8d}  Cuts = {:8d}\n", delay, area, edges, cuts_total.load() );
       st.round_stats.push_back( stats.str() );
     }
   }
@@ -2830,21 +2885,21 @@ private:
   lut_map_params const& ps;
   lut_map_stats& st;
 
-  uint32_t iteration{ 0 };       /* current mapping iteration */
-  uint32_t area_iteration{ 0 };  /* current area iteration */
-  uint32_t delay{ 0 };           /* current delay of the mapping */
-  uint32_t area{ 0 };            /* current area of the mapping */
-  uint32_t edges{ 0 };           /* current edges of the mapping */
-  uint32_t cuts_total{ 0 };      /* current computed cuts */
-  const float epsilon{ 0.005f }; /* epsilon */
+  uint32_t iteration{ 0 };               /* current mapping iteration */
+  uint32_t area_iteration{ 0 };          /* current area iteration */
+  uint32_t delay{ 0 };                   /* current delay of the mapping */
+  uint32_t area{ 0 };                    /* current area of the mapping */
+  uint32_t edges{ 0 };                   /* current edges of the mapping */
+  std::atomic<uint32_t> cuts_total{ 0 }; /* current computed cuts */
+  const float epsilon{ 0.005f };         /* epsilon */
   LUTCostFn lut_cost{};
 
   std::vector<node> topo_order;
+  level_order<Ntk> levels;
   std::vector<uint32_t> tmp_visited;
   std::vector<node_lut> node_match;
 
   std::vector<cut_set_t> cuts;  /* compressed representation of cuts */
-  cut_merge_t lcuts;            /* cut merger container */
   tt_cache truth_tables;        /* cut truth tables */
   cost_cache truth_tables_cost; /* truth tables cost */
   isop_cache isops;             /* cache for isops */
@@ -56,11 +56,14 @@ struct lut_mapping_params
   {
     cut_enumeration_ps.cut_size = 6;
     cut_enumeration_ps.cut_limit = 8;
+    cut_enumeration_ps.lazy_truth_tables = true;
   }
 
   /*! \brief Parameters for cut enumeration
    *
-   * The default cut size is 6, the default cut limit is 8.
+   * The default cut size is 6, the default cut limit is 8.  Since only the
+   * functions of the selected cuts are needed, truth tables are computed
+   * lazily by default (see `cut_enumeration_params::lazy_truth_tables`).
    */
   cut_enumeration_params cut_enumeration_ps{};
 
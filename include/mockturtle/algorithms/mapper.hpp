@@ -56,6 +56,7 @@
 #include "cut_enumeration/tech_map_cut.hpp"
 #include "detail/mffc_utils.hpp"
 #include "detail/switching_activity.hpp"
+#include "dont_cares.hpp"
 #include "reconv_cut.hpp"
 #include "resyn_engines/mig_resyn.hpp"
 #include "resyn_engines/xag_resyn.hpp"
@@ -102,6 +103,22 @@ struct map_params
   /*! \brief Number of patterns for switching activity computation. */
   uint32_t switching_activity_patterns{ 2048u };
 
+  /*! \brief Precomputed switching activity of each node, indexed by node index.
+   *
+   * If empty, the switching activity is computed by random simulation
+   * of `switching_activity_patterns` patterns.
+   */
+  std::vector<float> switching_activities{};
+
+  /*! \brief Estimate the switching activity by toggle counting.
+   *
+   * If true, the switching activity is estimated by counting the value
+   * changes over `switching_activity_patterns` random cycles (see
+   * `switching_activity_engine`) instead of using `2p(1-p)` from the
+   * signal probabilities.
+   */
+  bool toggle_switching_activity{ false };
+
   /*! \brief Exploit logic sharing in exact area optimization of graph mapping. */
   bool enable_logic_sharing{ false };
 
@@ -220,9 +237,10 @@ public:
         st( st ),
         node_match( ntk.size() ),
         matches(),
-        switch_activity( ps.eswp_rounds ? switching_activity( ntk, ps.switching_activity_patterns ) : std::vector<float>( 0 ) ),
+        switch_activity( ps.eswp_rounds ? ( !ps.switching_activities.empty() ? ps.switching_activities : ps.toggle_switching_activity ? toggle_switching_activity( ntk, ps.switching_activity_patterns ) : switching_activity( ntk, ps.switching_activity_patterns ) ) : std::vector<float>( 0 ) ),
         cuts( fast_cut_enumeration<Ntk, CutSize, true, CutData>( ntk, ps.cut_enumeration_ps, &st.cut_enumeration_st ) )
   {
+    assert( ps.switching_activities.empty() || ps.switching_activities.size() >= ntk.size() );
     std::tie( lib_inv_area, lib_inv_delay, lib_inv_id ) = library.get_inverter_info();
     std::tie( lib_buf_area, lib_buf_delay, lib_buf_id ) = library.get_buffer_info();
   }
@@ -2066,12 +2084,8 @@ private:
 
   void compute_matches_dc()
   {
-    reconvergence_driven_cut_parameters rps;
-    rps.max_leaves = ps.window_size;
-    reconvergence_driven_cut_statistics rst;
-    detail::reconvergence_driven_cut_impl<Ntk, false, false> reconv_cuts( ntk, rps, rst );
-
-    color_view<Ntk> color_ntk{ ntk };
+    dont_care_manager<Ntk, kitty::static_truth_table<max_window_size>> dcs( ntk, ps.window_size );
+    std::array<node<Ntk>, NInputs> cut_leaves;
     std::array<uint32_t, NInputs> divisors;
     for ( uint32_t i = 0; i < NInputs; ++i )
     {
@@ -2083,14 +2097,7 @@ private:
       const auto index = ntk.node_to_index( n );
       std::vector<cut_match_t<NtkDest, NInputs>> node_matches;
 
-      std::vector<node<Ntk>> roots = { n };
-      auto const extended_leaves = reconv_cuts.run( roots ).first;
-
-      std::vector<node<Ntk>> gates{ collect_nodes( color_ntk, extended_leaves, roots ) };
-      window_view window_ntk{ color_ntk, extended_leaves, roots, gates };
-
-      default_simulator<kitty::static_truth_table<max_window_size>> sim;
-      const auto tts = simulate_nodes<kitty::static_truth_table<max_window_size>>( window_ntk, sim );
+      dcs.set_window( { n } );
 
       auto i = 0u;
       for ( auto& cut : cuts.cuts( index ) )
@@ -2120,35 +2127,15 @@ private:
         /* dont cares computation */
         kitty::static_truth_table<NInputs> care;
 
-        bool containment = true;
-        bool filter = false;
+        auto num_leaves = 0u;
         for ( auto const& l : *cut )
         {
-          if ( color_ntk.color( ntk.index_to_node( l ) ) != color_ntk.current_color() )
-          {
-            containment = false;
-            break;
-          }
+          cut_leaves[num_leaves++] = ntk.index_to_node( l );
         }
 
-        if ( containment )
-        {
-          /* compute care set */
-          for ( auto i = 0u; i < ( 1u << window_ntk.num_pis() ); ++i )
-          {
-            uint32_t entry{ 0u };
-            auto j = 0u;
-            for ( auto const& l : *cut )
-            {
-              entry |= kitty::get_bit( tts[l], i ) << j;
-              ++j;
-            }
-            kitty::set_bit( care, entry );
-          }
-        }
-        else
+        /* compute care set, completely specified if the cut is not in the window */
+        if ( !dcs.compute_care( cut_leaves.begin(), cut_leaves.begin() + num_leaves, care ) )
         {
-          /* completely specified */
           care = ~care;
         }
 
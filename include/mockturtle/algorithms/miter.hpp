@@ -110,4 +110,58 @@ std::optional<NtkDest> miter( NtkSource1 const& ntk1, NtkSource2 const& ntk2 )
   return dest;
 }
 
+/*! \brief Creates a combinational miter with one output per output pair.
+ *
+ * This method works like `miter`, but it does not combine the XORs of the
+ * primary output pairs into a single output.  Instead, the miter has one
+ * primary output for each output pair, in the same order.  The two input
+ * networks are equivalent, if all outputs of the miter are constant 0.
+ * Such a miter can be checked output by output, e.g., by
+ * `equivalence_checking` with multiple threads.
+ *
+ * The method returns `nullopt`, whenever the two input networks don't match
+ * in their number of primary inputs and primary outputs.
+ */
+template<class NtkDest, class NtkSource1, class NtkSource2>
+std::optional<NtkDest> miter_per_output( NtkSource1 const& ntk1, NtkSource2 const& ntk2 )
+{
+  static_assert( is_network_type_v<NtkSource1>, "NtkSource1 is not a network type" );
+  static_assert( is_network_type_v<NtkSource2>, "NtkSource2 is not a network type" );
+  static_assert( is_network_type_v<NtkDest>, "NtkDest is not a network type" );
+
+  static_assert( has_num_pis_v<NtkSource1>, "NtkSource1 does not implement the num_pis method" );
+  static_assert( has_num_pos_v<NtkSource1>, "NtkSource1 does not implement the num_pos method" );
+  static_assert( has_num_pis_v<NtkSource2>, "NtkSource2 does not implement the num_pis method" );
+  static_assert( has_num_pos_v<NtkSource2>, "NtkSource2 does not implement the num_pos method" );
+  static_assert( has_create_pi_v<NtkDest>, "NtkDest does not implement the create_pi method" );
+  static_assert( has_create_po_v<NtkDest>, "NtkDest does not implement the create_po method" );
+  static_assert( has_create_xor_v<NtkDest>, "NtkDest does not implement the create_xor method" );
+
+  /* both networks must have same number of inputs and outputs */
+  if ( ( ntk1.num_pis() != ntk2.num_pis() ) || ( ntk1.num_pos() != ntk2.num_pos() ) )
+  {
+    return std::nullopt;
+  }
+
+  /* create primary inputs */
+  NtkDest dest;
+  std::vector<signal<NtkDest>> pis;
+  for ( auto i = 0u; i < ntk1.num_pis(); ++i )
+  {
+    pis.push_back( dest.create_pi() );
+  }
+
+  /* copy networks */
+  const auto pos1 = cleanup_dangling( ntk1, dest, pis.begin(), pis.end() );
+  const auto pos2 = cleanup_dangling( ntk2, dest, pis.begin(), pis.end() );
+
+  /* create XOR of output pairs */
+  for ( auto i = 0u; i < pos1.size(); ++i )
+  {
+    dest.create_po( dest.create_xor( pos1[i], pos2[i] ) );
+  }
+
+  return dest;
+}
+
 } // namespace mockturtle
\ No newline at end of file
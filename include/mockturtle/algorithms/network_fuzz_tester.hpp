@@ -35,6 +35,7 @@
 #include "../io/verilog_reader.hpp"
 #include "../io/write_aiger.hpp"
 #include "../io/write_verilog.hpp"
+#include "../utils/forked_job_pool.hpp"
 #include "../utils/stopwatch.hpp"
 
 #include <array>
@@ -42,6 +43,8 @@
 #include <fmt/format.h>
 #include <lorina/lorina.hpp>
 #include <optional>
+#include <thread>
+#include <unordered_map>
 
 namespace mockturtle
 {
@@ -67,6 +70,28 @@ struct fuzz_tester_params
 
   /*! \brief Timeout in seconds: nullopt means infinity. */
   std::optional<uint64_t> timeout{ std::nullopt };
+
+  /*! \brief Number of networks tested concurrently (0 = all hardware threads).
+   *
+   * With more than one worker, every network is tested in a forked child
+   * process and written into its own file, named by inserting the index
+   * of the worker in front of the extension of `filename` (and of
+   * `outputfile`), e.g. `fuzz_test_2.v`.  The first network that fails
+   * is also written into `filename`.  A command must then write to the
+   * output file given as its second argument (see `network_fuzz_tester`).
+   * Not supported on Windows.
+   */
+  uint32_t num_workers{ 1u };
+
+  /*! \brief Test every network in a forked child process, also with a single worker.
+   *
+   * Crashes and timeouts of a test then do not terminate the fuzz tester,
+   * they are reported as failures.  Not supported on Windows.
+   */
+  bool isolate{ false };
+
+  /*! \brief Timeout in seconds for testing one network in a child process: nullopt means infinity. */
+  std::optional<uint64_t> candidate_timeout{ std::nullopt };
 }; /* fuzz_tester_params */
 
 /*! \brief Network fuzz tester
@@ -91,7 +116,16 @@ struct fuzz_tester_params
  * as input (not supported on Windows platform). If the command exits
  * normally (with return value 0), CEC will be performed on the output
  * file; otherwise (segfault, assertion fail, or return value is not 0),
- * the fuzzer is terminated.
+ * the fuzzer is terminated.  If `outputfile` is set and several workers
+ * are used, the command has to take the name of the output file as a
+ * second argument, as each worker has its own output file.  Lambda
+ * functions of type (1) can get the current files from `input_file` and
+ * `output_file`.
+ *
+ * When `num_workers` is larger than 1 or `isolate` is set, the networks
+ * are tested in forked child processes, such that a segmentation fault,
+ * an assertion failure, or a timeout (`candidate_timeout`) in one test
+ * is reported as a failure instead of terminating the fuzzer.
  *
   \verbatim embed:rst
 
@@ -125,11 +159,25 @@ class network_fuzz_tester
 {
 public:
   explicit network_fuzz_tester( NetworkGenerator& gen, fuzz_tester_params const ps = {} )
-      : gen( gen ), ps( ps )
+      : gen( gen ), ps( ps ), current_file( ps.filename ), current_output( ps.outputfile )
   {}
 
 #ifndef _MSC_VER
   uint64_t run( std::function<std::string( std::string const& )>&& make_command )
+  {
+    if ( ps.outputfile && ps.num_workers != 1u )
+    {
+      fmt::print( "[e] with several workers, the command must take the name of the output file as second argument\n" );
+      return 0;
+    }
+
+    std::function<std::string( std::string const&, std::string const& )> make_command_with_output = [&]( std::string const& input, std::string const& ) {
+      return make_command( input );
+    };
+    return run( make_callback( make_command_with_output ) );
+  }
+
+  uint64_t run( std::function<std::string( std::string const&, std::string const& )>&& make_command )
   {
     return run( make_callback( make_command ) );
   }
@@ -137,6 +185,13 @@ public:
 
   uint64_t run( std::function<bool( Ntk )>&& fn )
   {
+#ifndef _MSC_VER
+    if ( ps.num_workers != 1u || ps.isolate )
+    {
+      return run_isolated( fn );
+    }
+#endif
+
     uint64_t counter{ 0 };
     stopwatch<>::duration time{ 0 };
     while ( ( !ps.num_iterations || counter < ps.num_iterations ) &&
@@ -147,16 +202,8 @@ public:
       fmt::print( "[i] create network #{}: I/O = {}/{} gates = {} nodes = {}, write into `{}`\n",
                   ++counter, ntk.num_pis(), ntk.num_pos(), ntk.num_gates(), ntk.size(), ps.filename );
 
-      switch ( ps.file_format )
+      if ( !write_network( ntk, ps.filename ) )
       {
-      case fuzz_tester_params::verilog:
-        write_verilog( ntk, ps.filename );
-        break;
-      case fuzz_tester_params::aiger:
-        write_aiger( ntk, ps.filename );
-        break;
-      default:
-        fmt::print( "[w] unsupported format\n" );
         return 0;
       }
 
@@ -175,13 +222,116 @@ public:
     return 0;
   }
 
+  /*! \brief Returns the file into which the network under test is written. */
+  std::string const& input_file() const
+  {
+    return current_file;
+  }
+
+  /*! \brief Returns the file that is compared with the network under test, if `outputfile` is set. */
+  std::optional<std::string> const& output_file() const
+  {
+    return current_output;
+  }
+
 private:
+  bool write_network( Ntk const& ntk, std::string const& filename )
+  {
+    switch ( ps.file_format )
+    {
+    case fuzz_tester_params::verilog:
+      write_verilog( ntk, filename );
+      return true;
+    case fuzz_tester_params::aiger:
+      write_aiger( ntk, filename );
+      return true;
+    default:
+      fmt::print( "[w] unsupported format\n" );
+      return false;
+    }
+  }
+
 #ifndef _MSC_VER
-  inline std::function<bool( Ntk )> make_callback( std::function<std::string( std::string const& )>& make_command )
+  uint64_t run_isolated( std::function<bool( Ntk )> const& fn )
+  {
+    uint32_t const num_workers = ps.num_workers == 0u ? std::max( 1u, std::thread::hardware_concurrency() ) : ps.num_workers;
+    forked_job_pool pool( num_workers, ps.candidate_timeout );
+
+    /* networks are generated in the parent, such that the sequence does not depend on the number of workers */
+    std::unordered_map<uint64_t, Ntk> running;
+    uint64_t counter{ 0 };
+    uint64_t failing{ 0 };
+    auto const start = stopwatch<>::clock::now();
+    while ( true )
+    {
+      bool const more = failing == 0 && ( !ps.num_iterations || counter < ps.num_iterations ) &&
+                        ( !ps.timeout || to_seconds( stopwatch<>::clock::now() - start ) < ps.timeout );
+      auto const slot = pool.free_slot();
+      if ( more && slot )
+      {
+        auto ntk = gen.generate();
+        auto const filename = detail::filename_with_suffix( ps.filename, fmt::format( "_{}", *slot ) );
+        fmt::print( "[i] create network #{}: I/O = {}/{} gates = {} nodes = {}, write into `{}`\n",
+                    ++counter, ntk.num_pis(), ntk.num_pos(), ntk.num_gates(), ntk.size(), filename );
+        if ( !write_network( ntk, filename ) )
+        {
+          return 0;
+        }
+
+        bool const started = pool.start( *slot, counter, [&]() {
+          current_file = filename;
+          if ( ps.outputfile )
+          {
+            current_output = detail::filename_with_suffix( *ps.outputfile, fmt::format( "_{}", *slot ) );
+          }
+          return fn( ntk ) && ( !current_output || abc_cec() );
+        } );
+        if ( !started )
+        {
+          fmt::print( "[e] could not fork a process to test network #{}\n", counter );
+          return 0;
+        }
+        running.emplace( counter, ntk );
+        continue;
+      }
+
+      if ( pool.num_running() == 0u )
+      {
+        break;
+      }
+
+      /* after a failure, the running tests are completed to report the first failing network */
+      auto const [id, outcome] = pool.wait_any();
+      if ( outcome == forked_job_outcome::error )
+      {
+        fmt::print( "[e] could not retrieve the result of network #{}\n", id );
+        return 0;
+      }
+      if ( outcome != forked_job_outcome::passed )
+      {
+        fmt::print( "[e] network #{} {}\n", id,
+                    outcome == forked_job_outcome::failed ? "failed" : ( outcome == forked_job_outcome::crashed ? "crashed" : "timed out" ) );
+        if ( failing == 0 || id < failing )
+        {
+          failing = id;
+          write_network( running.at( id ), ps.filename );
+        }
+      }
+      running.erase( id );
+    }
+
+    if ( failing != 0 )
+    {
+      fmt::print( "[e] first failing network #{} is written into `{}`\n", failing, ps.filename );
+    }
+    return failing;
+  }
+
+  inline std::function<bool( Ntk )> make_callback( std::function<std::string( std::string const&, std::string const& )> const& make_command )
   {
     std::function<bool( Ntk )> fn = [&]( Ntk ntk ) -> bool {
       (void)ntk;
-      int status = std::system( make_command( ps.filename ).c_str() );
+      int status = std::system( make_command( current_file, current_output.value_or( "" ) ).c_str() );
       if ( status < 0 )
       {
         std::cout << "[e] Unexpected error when calling command: " << strerror( errno ) << '\n';
@@ -193,7 +343,7 @@ private:
         {
           if ( WEXITSTATUS( status ) == 0 ) // normal
           {
-            if ( ps.outputfile )
+            if ( current_output )
               return abc_cec();
             return true;
           }
@@ -219,7 +369,7 @@ private:
 
   inline bool abc_cec()
   {
-    std::string command = fmt::format( "abc -q \"cec -n {} {}\"", ps.filename, *ps.outputfile );
+    std::string command = fmt::format( "abc -q \"cec -n {} {}\"", current_file, *current_output );
 
     std::array<char, 128> buffer;
     std::string result;
@@ -255,6 +405,10 @@ private:
 private:
   NetworkGenerator& gen;
   fuzz_tester_params const ps;
+
+  /* files of the network under test, differ from `ps` in child processes */
+  std::string current_file;
+  std::optional<std::string> current_output;
 }; /* network_fuzz_tester */
 
 } /* namespace mockturtle */
\ No newline at end of file
@@ -0,0 +1,355 @@
+/* mockturtle: C++ logic network library
+ * Copyright (C) 2018-2022  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*!
+  \file node_reordering.hpp
+  \brief Renumbers the nodes of a network for memory locality
+*/
+
+#pragma once
+
+#include "../traits.hpp"
+#include "../utils/node_map.hpp"
+#include "../utils/stopwatch.hpp"
+#include "../views/depth_view.hpp"
+#include "cleanup.hpp"
+
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+#include <vector>
+
+namespace mockturtle
+{
+
+/*! \brief Order in which the gates are stored after reordering. */
+enum class node_reordering_strategy
+{
+  /*! \brief Post-order DFS from the combinational outputs, in output order. */
+  dfs,
+  /*! \brief Level by level from the inputs, by index within a level. */
+  level,
+  /*! \brief Post-order DFS from the combinational outputs, visiting the
+   * deepest fanin first.  Gates of the same transitive fanin cone tend to
+   * be stored next to each other, which helps cut-based passes. */
+  locality
+};
+
+/*! \brief Parameters for node_reordering.
+ *
+ * The data structure `node_reordering_params` holds configurable parameters
+ * with default arguments for `node_reordering`.
+ */
+struct node_reordering_params
+{
+  /*! \brief Order of the gates in the new storage. */
+  node_reordering_strategy strategy{ node_reordering_strategy::dfs };
+
+  /*! \brief Be verbose. */
+  bool verbose{ false };
+};
+
+/*! \brief Statistics for node_reordering.
+ *
+ * The data structure `node_reordering_stats` provides data collected by
+ * running `node_reordering`.
+ */
+struct node_reordering_stats
+{
+  /*! \brief Total runtime. */
+  stopwatch<>::duration time_total{ 0 };
+
+  /*! \brief Average absolute index distance between a gate and its fanins before reordering. */
+  double distance_before{ 0 };
+
+  /*! \brief Average absolute index distance between a gate and its fanins after reordering. */
+  double distance_after{ 0 };
+
+  void report() const
+  {
+    std::cout << fmt::format( "[i] total time      = {:>5.2f} secs\n", to_seconds( time_total ) );
+    std::cout << fmt::format( "[i] fanin distance  = {:>8.2f} -> {:>8.2f}\n", distance_before, distance_after );
+  }
+};
+
+namespace detail
+{
+
+template<class Ntk>
+class node_reordering_impl
+{
+public:
+  using node = typename Ntk::node;
+  using signal = typename Ntk::signal;
+
+public:
+  node_reordering_impl( Ntk const& ntk, node_reordering_params const& ps, node_reordering_stats& st )
+      : ntk( ntk ), ps( ps ), st( st )
+  {
+  }
+
+  Ntk run()
+  {
+    stopwatch t( st.time_total );
+
+    st.distance_before = fanin_distance( ntk );
+
+    std::vector<node> order;
+    switch ( ps.strategy )
+    {
+    default:
+    case node_reordering_strategy::dfs:
+      order = dfs_order( false );
+      break;
+    case node_reordering_strategy::level:
+      order = level_order();
+      break;
+    case node_reordering_strategy::locality:
+      order = dfs_order( true );
+      break;
+    }
+
+    Ntk dest;
+    std::vector<signal> cis;
+    clone_inputs( ntk, dest, cis );
+
+    node_map<signal, Ntk> old_to_new( ntk );
+    old_to_new[ntk.get_constant( false )] = dest.get_constant( false );
+    if ( ntk.get_node( ntk.get_constant( true ) ) != ntk.get_node( ntk.get_constant( false ) ) )
+    {
+      old_to_new[ntk.get_constant( true )] = dest.get_constant( true );
+    }
+    auto it = cis.begin();
+    ntk.foreach_pi( [&]( auto const& n ) {
+      old_to_new[n] = *it++;
+    } );
+    if constexpr ( has_foreach_ro_v<Ntk> )
+    {
+      ntk.foreach_ro( [&]( auto const& n ) {
+        old_to_new[n] = *it++;
+      } );
+    }
+
+    for ( auto const& n : order )
+    {
+      cleanup_copy_gate( ntk, dest, n, old_to_new );
+    }
+
+    clone_outputs( ntk, dest, old_to_new );
+
+    st.distance_after = fanin_distance( dest );
+
+    return dest;
+  }
+
+private:
+  /* gates in the TFI of the COs, in DFS post-order */
+  std::vector<node> dfs_order( bool deepest_first )
+  {
+    std::vector<node> order;
+    order.reserve( ntk.num_gates() );
+
+    std::vector<uint32_t> levels;
+    if ( deepest_first )
+    {
+      depth_view<Ntk> d_ntk{ ntk };
+      levels.resize( ntk.size() );
+      ntk.foreach_node( [&]( auto const& n ) {
+        levels[ntk.node_to_index( n )] = d_ntk.level( n );
+      } );
+    }
+
+    ntk.incr_trav_id();
+    std::vector<std::pair<node, std::vector<node>>> stack;
+    ntk.foreach_co( [&]( auto const& f ) {
+      push( ntk.get_node( f ), stack, levels, deepest_first );
+      while ( !stack.empty() )
+      {
+        auto& [n, fanins] = stack.back();
+        if ( !fanins.empty() )
+        {
+          auto const child = fanins.back();
+          fanins.pop_back();
+          push( child, stack, levels, deepest_first );
+          continue;
+        }
+        order.emplace_back( n );
+        stack.pop_back();
+      }
+    } );
+
+    return order;
+  }
+
+  void push( node const& n, std::vector<std::pair<node, std::vector<node>>>& stack, std::vector<uint32_t> const& levels, bool deepest_first )
+  {
+    if ( ntk.visited( n ) == ntk.trav_id() )
+      return;
+    ntk.set_visited( n, ntk.trav_id() );
+    if ( ntk.is_constant( n ) || ntk.is_ci( n ) )
+      return;
+
+    std::vector<node> fanins;
+    ntk.foreach_fanin( n, [&]( auto const& f ) {
+      fanins.emplace_back( ntk.get_node( f ) );
+    } );
+
+    /* fanins are popped from the back */
+    if ( deepest_first )
+    {
+      std::stable_sort( fanins.begin(), fanins.end(), [&]( auto const& a, auto const& b ) {
+        return levels[ntk.node_to_index( a )] < levels[ntk.node_to_index( b )];
+      } );
+    }
+    else
+    {
+      std::reverse( fanins.begin(), fanins.end() );
+    }
+    stack.emplace_back( n, std::move( fanins ) );
+  }
+
+  /* gates in the TFI of the COs, sorted by level */
+  std::vector<node> level_order()
+  {
+    auto order = dfs_order( false );
+
+    depth_view<Ntk> d_ntk{ ntk };
+    std::stable_sort( order.begin(), order.end(), [&]( auto const& a, auto const& b ) {
+      if ( d_ntk.level( a ) != d_ntk.level( b ) )
+        return d_ntk.level( a ) < d_ntk.level( b );
+      return ntk.node_to_index( a ) < ntk.node_to_index( b );
+    } );
+
+    return order;
+  }
+
+  static double fanin_distance( Ntk const& net )
+  {
+    uint64_t sum{ 0 };
+    uint64_t count{ 0 };
+    net.foreach_gate( [&]( auto const& n ) {
+      auto const i = net.node_to_index( n );
+      net.foreach_fanin( n, [&]( auto const& f ) {
+        auto const j = net.node_to_index( net.get_node( f ) );
+        sum += i > j ? i - j : j - i;
+        ++count;
+      } );
+    } );
+    return count == 0 ? 0.0 : static_cast<double>( sum ) / count;
+  }
+
+private:
+  Ntk const& ntk;
+  node_reordering_params const& ps;
+  node_reordering_stats& st;
+};
+
+} /* namespace detail */
+
+/*! \brief Renumbers the nodes of a network.
+ *
+ * After many rounds of local rewriting, the indices of connected nodes are
+ * scattered in the storage, which hurts the memory locality of all passes
+ * that iterate over the gates.  This function rebuilds the network such that
+ * the gates are stored in the order given by `ps.strategy`.  The constants,
+ * the primary inputs, the registers, the outputs, and the names are kept in
+ * the same order.  As in `cleanup_dangling`, dangling and dead nodes are
+ * removed.
+ *
+   \verbatim embed:rst
+
+   .. note::
+
+      This method returns the reordered network as a return value.  It does
+      *not* modify the input network.
+   \endverbatim
+ *
+ * **Required network functions:**
+ * - `get_node`
+ * - `node_to_index`
+ * - `get_constant`
+ * - `create_pi`
+ * - `create_po`
+ * - `create_not`
+ * - `clone_node`
+ * - `is_complemented`
+ * - `is_constant`
+ * - `is_ci`
+ * - `foreach_node`
+ * - `foreach_pi`
+ * - `foreach_co`
+ * - `foreach_fanin`
+ * - `visited`
+ * - `set_visited`
+ * - `incr_trav_id`
+ * - `trav_id`
+ *
+ * \param ntk Network
+ * \param ps Reordering params
+ * \param pst Reordering statistics
+ */
+template<class Ntk>
+[[nodiscard]] Ntk node_reordering( Ntk const& ntk, node_reordering_params const& ps = {}, node_reordering_stats* pst = nullptr )
+{
+  static_assert( is_network_type_v<Ntk>, "Ntk is not a network type" );
+  static_assert( has_get_node_v<Ntk>, "Ntk does not implement the get_node method" );
+  static_assert( has_node_to_index_v<Ntk>, "Ntk does not implement the node_to_index method" );
+  static_assert( has_get_constant_v<Ntk>, "Ntk does not implement the get_constant method" );
+  static_assert( has_create_pi_v<Ntk>, "Ntk does not implement the create_pi method" );
+  static_assert( has_create_po_v<Ntk>, "Ntk does not implement the create_po method" );
+  static_assert( has_create_not_v<Ntk>, "Ntk does not implement the create_not method" );
+  static_assert( has_clone_node_v<Ntk>, "Ntk does not implement the clone_node method" );
+  static_assert( has_is_complemented_v<Ntk>, "Ntk does not implement the is_complemented method" );
+  static_assert( has_is_constant_v<Ntk>, "Ntk does not implement the is_constant method" );
+  static_assert( has_is_ci_v<Ntk>, "Ntk does not implement the is_ci method" );
+  static_assert( has_foreach_node_v<Ntk>, "Ntk does not implement the foreach_node method" );
+  static_assert( has_foreach_pi_v<Ntk>, "Ntk does not implement the foreach_pi method" );
+  static_assert( has_foreach_co_v<Ntk>, "Ntk does not implement the foreach_co method" );
+  static_assert( has_foreach_fanin_v<Ntk>, "Ntk does not implement the foreach_fanin method" );
+  static_assert( has_visited_v<Ntk>, "Ntk does not implement the visited method" );
+  static_assert( has_set_visited_v<Ntk>, "Ntk does not implement the set_visited method" );
+  static_assert( has_incr_trav_id_v<Ntk>, "Ntk does not implement the incr_trav_id method" );
+  static_assert( has_trav_id_v<Ntk>, "Ntk does not implement the trav_id method" );
+
+  node_reordering_stats st;
+  detail::node_reordering_impl<Ntk> p( ntk, ps, st );
+  auto dest = p.run();
+
+  if ( ps.verbose )
+  {
+    st.report();
+  }
+
+  if ( pst )
+  {
+    *pst = st;
+  }
+
+  return dest;
+}
+
+} /* namespace mockturtle */
@@ -41,8 +41,15 @@
 #include "simulation.hpp"
 #include <bill/sat/interface/abc_bsat2.hpp>
 #include <bill/sat/interface/z3.hpp>
+#include <fmt/format.h>
 #include <kitty/partial_truth_table.hpp>
+#include <algorithm>
+#include <iostream>
+#include <limits>
 #include <random>
+#include <thread>
+#include <utility>
+#include <vector>
 
 namespace mockturtle
 {
@@ -74,6 +81,17 @@ struct pattern_generation_params
 
   /*! \brief Maximum number of clauses of the SAT solver. (incremental CNF construction) */
   uint32_t max_clauses{ 1000 };
+
+  /*! \brief Number of threads for stuck-at checking (0 = all hardware threads).
+   *
+   * The gates are split into contiguous ranges, each checked by a worker
+   * with its own copy of the network, simulator and validator.  The
+   * generated patterns are merged in the order of the ranges, so that the
+   * result only depends on the number of threads.  Requires a network
+   * that implements `clone`, otherwise the check runs in a single thread.
+   * The observability check always runs in a single thread.
+   */
+  uint32_t num_threads{ 1u };
 };
 
 struct pattern_generation_stats
@@ -104,6 +122,30 @@ struct pattern_generation_stats
 
   /*! \brief Number of unobservable nodes (node for which an observable pattern can not be found). */
   uint32_t unobservable_node{ 0 };
+
+  /*! \brief Generated patterns per second of total time. */
+  double patterns_per_second() const
+  {
+    auto const seconds = to_seconds( time_total );
+    return seconds > 0 ? num_generated_patterns / seconds : 0.0;
+  }
+
+  void report() const
+  {
+    // clang-format off
+    std::cout <<              "[i] Pattern generation\n";
+    std::cout <<              "[i] ========  Stats  ========\n";
+    std::cout << fmt::format( "[i] #patterns     = {:8d} ({:.1f} / sec)\n", num_generated_patterns, patterns_per_second() );
+    std::cout << fmt::format( "[i] #constant     = {:8d}\n", num_constant );
+    std::cout << fmt::format( "[i] #unobservable = {:8d}\n", unobservable_node );
+    std::cout <<              "[i] ======== Runtime ========\n";
+    std::cout << fmt::format( "[i] total        : {:>5.2f} secs\n", to_seconds( time_total ) );
+    std::cout << fmt::format( "[i]   simulation : {:>5.2f} secs\n", to_seconds( time_sim ) );
+    std::cout << fmt::format( "[i]   SAT solving: {:>5.2f} secs\n", to_seconds( time_sat ) );
+    std::cout << fmt::format( "[i]   ODC        : {:>5.2f} secs\n", to_seconds( time_odc ) );
+    std::cout <<              "[i] =========================\n\n";
+    // clang-format on
+  }
 };
 
 namespace detail
@@ -116,6 +158,8 @@ public:
   using node = typename Ntk::node;
   using signal = typename Ntk::signal;
   using TT = incomplete_node_map<kitty::partial_truth_table, Ntk>;
+  /* a generated pattern with its care bits (empty for `partial_simulator`) */
+  using recorded_pattern = std::pair<std::vector<bool>, std::vector<bool>>;
 
   explicit patgen_impl( Ntk& ntk, Simulator& sim, pattern_generation_params const& ps, validator_params& vps, pattern_generation_stats& st )
       : ntk( ntk ), ps( ps ), st( st ), vps( vps ), validator( ntk, vps ),
@@ -138,7 +182,22 @@ public:
 
     if ( ps.num_stuck_at > 0 )
     {
-      stuck_at_check();
+      uint32_t const num_threads = ps.num_threads == 0u ? std::max( 1u, std::thread::hardware_concurrency() ) : ps.num_threads;
+      if constexpr ( can_run_parallel() )
+      {
+        if ( num_threads > 1u && ntk.num_gates() > 1u )
+        {
+          stuck_at_check_parallel( std::min( num_threads, ntk.num_gates() ) );
+        }
+        else
+        {
+          stuck_at_check();
+        }
+      }
+      else
+      {
+        stuck_at_check();
+      }
       if constexpr ( std::is_same_v<Simulator, bit_packed_simulator> )
       {
         sim.pack_bits();
@@ -182,7 +241,118 @@ public:
     }
   }
 
+  /* runs the stuck-at check on the gates with index in [begin, end) and records the generated patterns */
+  void run_stuck_at_range( uint32_t begin, uint32_t end )
+  {
+    gate_begin = begin;
+    gate_end = end;
+    record_patterns = true;
+
+    call_with_stopwatch( st.time_sim, [&]() {
+      simulate_nodes<Ntk>( ntk, tts, sim, true );
+    } );
+    stuck_at_check();
+  }
+
+  std::vector<recorded_pattern>& recorded_patterns()
+  {
+    return recorded;
+  }
+
+  std::vector<signal> const& constant_nodes() const
+  {
+    return const_nodes;
+  }
+
 private:
+  static constexpr bool can_run_parallel()
+  {
+    if constexpr ( has_clone_v<Ntk> && !has_EXCDC_interface_v<Ntk> )
+    {
+      return std::is_constructible_v<Ntk, decltype( std::declval<Ntk const&>().clone() )>;
+    }
+    else
+    {
+      return false;
+    }
+  }
+
+  void stuck_at_check_parallel( uint32_t num_threads )
+  {
+    using base_ntk_t = decltype( std::declval<Ntk const&>().clone() );
+
+    /* workers do not show progress, each writes into its own slot */
+    pattern_generation_params worker_ps = ps;
+    worker_ps.progress = false;
+    std::vector<pattern_generation_stats> worker_st( num_threads );
+    std::vector<std::vector<recorded_pattern>> worker_patterns( num_threads );
+    std::vector<std::vector<signal>> worker_const( num_threads );
+
+    /* the copies are made upfront, such that workers only read shared data */
+    std::vector<base_ntk_t> copies;
+    copies.reserve( num_threads );
+    for ( auto t = 0u; t < num_threads; ++t )
+    {
+      copies.emplace_back( ntk.clone() );
+    }
+
+    uint32_t const num_gates = ntk.num_gates();
+    auto const run_worker = [&]( uint32_t t ) {
+      Ntk worker_ntk{ copies[t] };
+      Simulator worker_sim = sim;
+      validator_params worker_vps = vps;
+      patgen_impl<Ntk, Simulator, use_odc, false> worker( worker_ntk, worker_sim, worker_ps, worker_vps, worker_st[t] );
+      uint32_t const begin = static_cast<uint32_t>( uint64_t( num_gates ) * t / num_threads );
+      uint32_t const end = t + 1 == num_threads ? std::numeric_limits<uint32_t>::max() : static_cast<uint32_t>( uint64_t( num_gates ) * ( t + 1 ) / num_threads );
+      worker.run_stuck_at_range( begin, end );
+      worker_patterns[t] = std::move( worker.recorded_patterns() );
+      worker_const[t] = worker.constant_nodes();
+    };
+
+    std::vector<std::thread> threads;
+    threads.reserve( num_threads );
+    for ( auto t = 0u; t < num_threads; ++t )
+    {
+      threads.emplace_back( run_worker, t );
+    }
+    for ( auto& thread : threads )
+    {
+      thread.join();
+    }
+
+    /* merge in the order of the ranges; the times are summed over the workers */
+    for ( auto t = 0u; t < num_threads; ++t )
+    {
+      for ( auto const& [pattern, care] : worker_patterns[t] )
+      {
+        if constexpr ( std::is_same_v<Simulator, bit_packed_simulator> )
+        {
+          sim.add_pattern( pattern, care );
+        }
+        else
+        {
+          sim.add_pattern( pattern );
+        }
+      }
+      /* `clone` keeps the node indices, signals of the copies are valid in `ntk` */
+      const_nodes.insert( const_nodes.end(), worker_const[t].begin(), worker_const[t].end() );
+
+      st.time_sim += worker_st[t].time_sim;
+      st.time_sat += worker_st[t].time_sat;
+      st.time_odc += worker_st[t].time_odc;
+      st.num_constant += worker_st[t].num_constant;
+      st.num_generated_patterns += worker_st[t].num_generated_patterns;
+      st.unobservable_type1 += worker_st[t].unobservable_type1;
+      st.unobservable_node += worker_st[t].unobservable_node;
+    }
+
+    /* the merged patterns span several blocks, re-simulate the whole network */
+    call_with_stopwatch( st.time_sim, [&]() {
+      tts.reset();
+      simulate_nodes<Ntk>( ntk, tts, sim, true );
+    } );
+  }
+
   void stuck_at_check()
   {
     progress_bar pbar{ ntk.size(), "patgen-sa |{0}| node = {1:>4} #pat = {2:>4}", ps.progress };
@@ -190,6 +360,10 @@ private:
     kitty::partial_truth_table zero = sim.compute_constant( false );
 
     ntk.foreach_gate( [&]( auto const& n, auto i ) {
+      if ( i < gate_begin || i >= gate_end )
+      {
+        return true; /* gate of another worker */
+      }
       pbar( i, i, sim.num_bits() );
 
       if ( tts[n].num_bits() != sim.num_bits() )
@@ -408,12 +582,21 @@ private:
   {
     if constexpr ( std::is_same_v<Simulator, bit_packed_simulator> )
     {
-      sim.add_pattern( pattern, compute_support( n ) );
+      auto const care = compute_support( n );
+      sim.add_pattern( pattern, care );
+      if ( record_patterns )
+      {
+        recorded.emplace_back( pattern, care );
+      }
     }
     else
     {
       (void)n;
       sim.add_pattern( pattern );
+      if ( record_patterns )
+      {
+        recorded.emplace_back( pattern, std::vector<bool>{} );
+      }
     }
 
     if constexpr ( has_EXCDC_interface_v<Ntk> )
@@ -543,6 +726,12 @@ private:
   std::vector<signal> const_nodes;
 
   Simulator& sim;
+
+  /* range of gate indices checked in `stuck_at_check` */
+  uint32_t gate_begin{ 0u };
+  uint32_t gate_end{ std::numeric_limits<uint32_t>::max() };
+  bool record_patterns{ false };
+  std::vector<recorded_pattern> recorded;
 };
 
 } /* namespace detail */
@@ -49,6 +49,7 @@
 #include "detail/mffc_utils.hpp"
 #include "dont_cares.hpp"
 #include "simulation.hpp"
+#include "window_simulation.hpp"
 
 #include <fmt/format.h>
 #include <kitty/dynamic_truth_table.hpp>
@@ -152,6 +153,8 @@ public:
     rps.max_leaves = ps.max_pis;
     reconvergence_driven_cut_statistics rst;
     detail::reconvergence_driven_cut_impl<Ntk, false, false> reconv_cuts( ntk, rps, rst );
+    batched_window_simulator<Ntk> win_sim( ntk );
+    std::vector<node<Ntk>> leaf_nodes;
 
     color_view<Ntk> color_ntk{ ntk };
 
@@ -182,15 +185,13 @@ public:
       if ( mffc.num_pis() <= ps.max_pis )
       {
         /* use MFFC */
+        leaf_nodes.clear();
         mffc.foreach_pi( [&]( auto const& m, auto j ) {
           leaves[j] = ntk.make_signal( m );
+          leaf_nodes.emplace_back( m );
         } );
 
         num_leaves = mffc.num_pis();
-
-        default_simulator<kitty::dynamic_truth_table> sim( mffc.num_pis() );
-        tt = call_with_stopwatch( st.time_simulation,
-                                  [&]() { return simulate<kitty::dynamic_truth_table>( mffc, sim )[0]; } );
       }
       else
       {
@@ -205,13 +206,24 @@ public:
         {
           leaves[j] = ntk.make_signal( extended_leaves[j] );
         }
-
-        cut_view<Ntk> cut( ntk, extended_leaves, ntk.make_signal( n ) );
-        default_simulator<kitty::dynamic_truth_table> sim( num_leaves );
-        tt = call_with_stopwatch( st.time_simulation,
-                                  [&]() { return simulate<kitty::dynamic_truth_table>( cut, sim )[0]; } );
+        leaf_nodes = extended_leaves;
       }
 
+      tt = call_with_stopwatch( st.time_simulation, [&]() {
+        /* the batched simulator is limited to 16 leaves */
+        if ( num_leaves > batched_window_simulator<Ntk>::max_num_leaves )
+        {
+          cut_view<Ntk> cut( ntk, leaf_nodes, ntk.make_signal( n ) );
+          default_simulator<kitty::dynamic_truth_table> sim( num_leaves );
+          return simulate<kitty::dynamic_truth_table>( cut, sim )[0];
+        }
+
+        win_sim.clear();
+        auto const window = win_sim.add_window( leaf_nodes, { ntk.make_signal( n ) } );
+        win_sim.run();
+        return win_sim.root_function( window, 0 );
+      } );
+
       signal<Ntk> new_f;
       bool resynthesized{ false };
 
@@ -37,6 +37,7 @@
 #pragma once
 
 #include "../traits.hpp"
+#include "../utils/memory_usage.hpp"
 #include "../utils/progress_bar.hpp"
 #include "../utils/stopwatch.hpp"
 #include "../views/depth_view.hpp"
@@ -148,6 +149,9 @@ struct resubstitution_stats
   /*! \brief Initial network size (before resubstitution). */
   uint64_t initial_size{ 0 };
 
+  /*! \brief Memory of the network and its views at the end (bytes). */
+  uint64_t memory_footprint{ 0 };
+
   void report() const
   {
     // clang-format off
@@ -160,6 +164,11 @@ struct resubstitution_stats
     fmt::print( "[i]       DivCollector: {:>5.2f} secs\n", to_seconds( time_divs ) );
     fmt::print( "[i]       ResubEngine : {:>5.2f} secs\n", to_seconds( time_resub ) );
     fmt::print( "[i]       callback    : {:>5.2f} secs\n", to_seconds( time_callback ) );
+    if ( memory_footprint > 0u )
+    {
+      fmt::print( "[i]     ======== Memory  ========\n" );
+      fmt::print( "[i]     footprint     : {:>5.2f} MB\n", memory_footprint / 1048576.0 );
+    }
     fmt::print( "[i]     =========================\n\n" );
     // clang-format on
   }
@@ -640,12 +649,12 @@ public:
 
   void run( resub_callback_t const& callback = substitute_fn<Ntk> )
   {
-    stopwatch t( st.time_total );
+    stopwatch t( st.time_total, "resubstitution" );
 
     /* start the managers */
     DivCollector collector( ntk, ps, collector_st );
     ResubEngine resub_engine( ntk, ps, engine_st );
-    call_with_stopwatch( st.time_resub, [&]() {
+    call_with_stopwatch( st.time_resub, "resubstitution_init", [&]() {
       resub_engine.init();
     } );
 
@@ -705,6 +714,8 @@ public:
 
       return true; /* next */
     } );
+    trace_counter( "gates", ntk.num_gates() );
+    st.memory_footprint = memory_footprint( ntk );
   }
 
 private:
@@ -33,6 +33,7 @@
 #pragma once
 
 #include "../../utils/index_list/index_list.hpp"
+#include "../../utils/signature_matrix.hpp"
 
 #include <fmt/format.h>
 #include <kitty/kitty.hpp>
@@ -92,7 +93,6 @@ public:
   {
     static_assert( std::is_same_v<typename static_params::base_type, mig_resyn_static_params>, "Invalid static_params type" );
     static_assert( !static_params::preserve_depth && static_params::uniform_div_cost, "Advanced resynthesis is not implemented for this solver" );
-    divisors.reserve( static_params::reserve );
   }
 
   template<class iterator_type, class truth_table_storage_type>
@@ -100,22 +100,31 @@ public:
   {
     (void)care;
     (void)max_level;
-    divisors.clear();
     index_list.clear();
 
     num_bits = target.num_bits();
-    divisors.emplace_back( ~target );
-    divisors.emplace_back( target );
+    divisors.reset( num_bits );
+    divisors.reserve( 2 * static_params::reserve + 1 );
+    divisors.add_row( target );
+    divisors.add_row( target );
+    auto* not_target = divisors.row( 0 );
+    divisors.assign( 0, [&]( auto w ) { return ~not_target[w]; } );
 
     while ( begin != end )
     {
       auto const& tt = tts[*begin];
       assert( tt.num_bits() == target.num_bits() );
-      divisors.emplace_back( tt ^ divisors[0] ); // tt XNOR target = tt XOR ~target
-      divisors.emplace_back( tt ^ target );      // ~tt XNOR target = tt XOR target
+      auto const r = divisors.add_row( tt );
+      divisors.add_row();
+      auto* words = divisors.row( r );
+      auto const* t = divisors.row( 1 );
+      divisors.assign( r + 1, [&]( auto w ) { return words[w] ^ t[w]; } );    // ~tt XNOR target = tt XOR target
+      divisors.assign( r, [&]( auto w ) { return ~( words[w] ^ t[w] ); } ); // tt XNOR target
       index_list.add_inputs();
       ++begin;
     }
+    num_divisors = divisors.num_rows();
+    divisors.add_row(); /* function of the current topmost node */
 
     return compute_function( max_size );
   }
@@ -125,9 +134,10 @@ private:
   {
     uint64_t max_score = 0u;
     max_i = 0u;
-    for ( auto i = 0u; i < divisors.size(); ++i )
+    for ( auto i = 0u; i < num_divisors; ++i )
     {
-      uint32_t score = kitty::count_ones( divisors.at( i ) );
+      auto const* d = divisors.row( i );
+      uint32_t score = divisors.count_ones( [&]( auto w ) { return d[w]; } );
       if ( score > max_score )
       {
         max_score = score;
@@ -149,7 +159,7 @@ private:
     {
       return std::nullopt;
     }
-    size_limit = divisors.size() + num_inserts * 2;
+    size_limit = num_divisors + num_inserts * 2;
 
     return bottom_up_approach();
   }
@@ -157,23 +167,25 @@ private:
   std::optional<mig_index_list> bottom_up_approach()
   {
     // maj_nodes.emplace_back( maj_node{uint32_t( divisors.size() ), {max_i}} );
-    TT const& function_i = divisors.at( max_i );
-    current_lit = divisors.size();
-    return bottom_up_approach_rec( function_i );
+    auto const* d = divisors.row( max_i );
+    divisors.assign( num_divisors, [&]( auto w ) { return d[w]; } );
+    current_lit = num_divisors;
+    return bottom_up_approach_rec();
   }
 
-  std::optional<mig_index_list> bottom_up_approach_rec( TT const& function_i )
+  /* the function of the current topmost node is stored in row `num_divisors` */
+  std::optional<mig_index_list> bottom_up_approach_rec()
   {
     /* THINK: Should we consider reusing newly-built nodes (nodes in maj_nodes) in addition to divisors? */
+    auto const* function_i = divisors.row( num_divisors );
 
     /* the second fanin: 2 * #newly-covered-bits + 1 * #cover-again-bits */
     uint64_t max_score = 0u;
     max_j = 0u;
-    auto const not_covered_by_i = ~function_i;
-    for ( auto j = 0u; j < divisors.size(); ++j )
+    for ( auto j = 0u; j < num_divisors; ++j )
     {
-      auto const covered_by_j = divisors.at( j );
-      uint32_t score = kitty::count_ones( covered_by_j ) + kitty::count_ones( not_covered_by_i & covered_by_j );
+      auto const* covered_by_j = divisors.row( j );
+      uint32_t score = divisors.count_ones( [&]( auto w ) { return covered_by_j[w]; } ) + divisors.count_ones( [&]( auto w ) { return ~function_i[w] & covered_by_j[w]; } );
       if ( score > max_score && ( j >> 1 ) != ( max_i >> 1 ) )
       {
         max_score = score;
@@ -185,10 +197,11 @@ private:
     /* the third fanin: only care about the disagreed bits */
     max_score = 0u;
     max_k = 0u;
-    auto const disagree_in_ij = function_i ^ divisors.at( max_j );
-    for ( auto k = 0u; k < divisors.size(); ++k )
+    auto const* function_j = divisors.row( max_j );
+    for ( auto k = 0u; k < num_divisors; ++k )
     {
-      uint32_t score = kitty::count_ones( divisors.at( k ) & disagree_in_ij );
+      auto const* function_k = divisors.row( k );
+      uint32_t score = divisors.count_ones( [&]( auto w ) { return function_k[w] & ( function_i[w] ^ function_j[w] ); } );
       if ( score > max_score && ( k >> 1 ) != ( max_i >> 1 ) && ( k >> 1 ) != ( max_j >> 1 ) )
       {
         max_score = score;
@@ -198,8 +211,9 @@ private:
     // maj_nodes.back().fanins.emplace_back( max_k );
     index_list.add_maj( max_i, max_j, max_k );
 
-    auto const current_function = kitty::ternary_majority( function_i, divisors.at( max_j ), divisors.at( max_k ) );
-    if ( kitty::is_const0( ~current_function ) )
+    auto const* function_k = divisors.row( max_k );
+    divisors.assign( num_divisors, [&]( auto w ) { return ( function_i[w] & function_j[w] ) | ( function_i[w] & function_k[w] ) | ( function_j[w] & function_k[w] ); } );
+    if ( divisors.is_const0( [&]( auto w ) { return ~function_i[w]; } ) )
     {
       index_list.add_output( current_lit );
       return index_list;
@@ -209,7 +223,7 @@ private:
       // maj_nodes.emplace_back( maj_node{maj_nodes.back().id + 2u, {maj_nodes.back().id}} );
       max_i = current_lit;
       current_lit += 2;
-      return bottom_up_approach_rec( current_function );
+      return bottom_up_approach_rec();
     }
     else
     {
@@ -220,11 +234,13 @@ private:
 private:
   uint32_t size_limit;
   uint32_t num_bits;
+  uint32_t num_divisors;
   uint32_t current_lit; /* literal of the current topmost node */
 
   uint32_t max_i, max_j, max_k;
 
-  std::vector<TT> divisors;
+  /* rows 0 and 1 are the constants, followed by two rows per divisor and the current function */
+  signature_matrix<signature_width_v<TT>> divisors;
   index_list_t index_list;
 
   stats& st;
@@ -35,12 +35,14 @@
 
 #include "../../utils/index_list/index_list.hpp"
 #include "../../utils/node_map.hpp"
+#include "../../utils/signature_matrix.hpp"
 #include "../../utils/stopwatch.hpp"
 
 #include <fmt/format.h>
 #include <kitty/kitty.hpp>
 
 #include <algorithm>
+#include <array>
 #include <optional>
 #include <type_traits>
 #include <vector>
@@ -61,9 +63,6 @@ struct xag_resyn_static_params
   /*! \brief Whether to consider single XOR gates (i.e., using XAGs instead of AIGs). */
   static constexpr bool use_xor{ true };
 
-  /*! \brief Whether to copy truth tables. */
-  static constexpr bool copy_tts{ false };
-
   /*! \brief Whether to preserve depth. */
   static constexpr bool preserve_depth{ false };
 
@@ -243,13 +242,14 @@ public:
   {
     static_assert( std::is_same_v<typename static_params::base_type, xag_resyn_static_params>, "Invalid static_params type" );
     static_assert( !( static_params::uniform_div_cost && static_params::preserve_depth ), "If depth is to be preserved, divisor depth cost must be provided (usually not uniform)" );
-    divisors.reserve( static_params::reserve );
   }
 
   /*! \brief Perform XAG resynthesis.
    *
    * `tts[*begin]` must be of type `TT`.
-   * Moreover, if `static_params::copy_tts = false`, `*begin` must be of type `static_params::node_type`.
+   *
+   * The divisor functions are copied into a flat signature matrix owned by
+   * the engine, whose memory is reused across calls.
    *
    * \param target Truth table of the target function.
    * \param care Truth table of the care set.
@@ -262,23 +262,19 @@ public:
            bool enabled = static_params::uniform_div_cost && !static_params::preserve_depth, typename = std::enable_if_t<enabled>>
   std::optional<index_list_t> operator()( TT const& target, TT const& care, iterator_type begin, iterator_type end, typename static_params::truth_table_storage_type const& tts, uint32_t max_size = std::numeric_limits<uint32_t>::max() )
   {
-    static_assert( static_params::copy_tts || std::is_same_v<typename std::iterator_traits<iterator_type>::value_type, typename static_params::node_type>, "iterator_type does not dereference to static_params::node_type" );
-
-    ptts = &tts;
-    on_off_sets[0] = ~target & care;
-    on_off_sets[1] = target & care;
-
-    divisors.resize( 1 ); /* clear previous data and reserve 1 dummy node for constant */
+    on_off_sets.reset( target.num_bits() );
+    on_off_sets.add_row();
+    on_off_sets.add_row();
+    on_off_sets.add_row(); /* scratch row */
+    on_off_sets.assign( 0, [&]( auto w ) { return ~target.cbegin()[w] & care.cbegin()[w]; } );
+    on_off_sets.assign( 1, [&]( auto w ) { return target.cbegin()[w] & care.cbegin()[w]; } );
+
+    divisors.reset( target.num_bits() );
+    divisors.reserve( static_params::reserve );
+    divisors.add_row(); /* reserve 1 dummy row for constant */
     while ( begin != end )
     {
-      if constexpr ( static_params::copy_tts )
-      {
-        divisors.emplace_back( ( *ptts )[*begin] );
-      }
-      else
-      {
-        divisors.emplace_back( *begin );
-      }
+      divisors.add_row( tts[*begin] );
       ++begin;
     }
 
@@ -299,7 +295,7 @@ private:
   std::optional<index_list_t> compute_function( uint32_t num_inserts )
   {
     index_list.clear();
-    index_list.add_inputs( divisors.size() - 1 );
+    index_list.add_inputs( divisors.num_rows() - 1 );
     auto const lit = compute_function_rec( num_inserts );
     if ( lit )
     {
@@ -461,7 +457,8 @@ private:
        */
       uint32_t const lit = on_off_div ? pos_unate_lits[0].lit : neg_unate_lits[0].lit;
       call_with_stopwatch( st.time_divide, [&]() {
-        on_off_sets[on_off_div] &= lit & 0x1 ? get_div( lit >> 1 ) : ~get_div( lit >> 1 );
+        auto* set = on_off_sets.row( on_off_div );
+        on_off_sets.assign( on_off_div, [&]( auto w ) { return set[w] & lit_word( lit ^ 0x1, w ); } );
       } );
 
       auto const res_remain_div = compute_function_rec( num_inserts - 1 );
@@ -475,21 +472,9 @@ private:
     {
       fanin_pair const pair = on_off_pair ? pos_unate_pairs[0] : neg_unate_pairs[0];
       call_with_stopwatch( st.time_divide, [&]() {
-        if constexpr ( static_params::use_xor )
-        {
-          if ( pair.lit1 > pair.lit2 ) /* XOR pair: ~(lit1 ^ lit2) = ~lit1 ^ lit2 */
-          {
-            on_off_sets[on_off_pair] &= ( pair.lit1 & 0x1 ? get_div( pair.lit1 >> 1 ) : ~get_div( pair.lit1 >> 1 ) ) ^ ( pair.lit2 & 0x1 ? ~get_div( pair.lit2 >> 1 ) : get_div( pair.lit2 >> 1 ) );
-          }
-          else /* AND pair: ~(lit1 & lit2) = ~lit1 | ~lit2 */
-          {
-            on_off_sets[on_off_pair] &= ( pair.lit1 & 0x1 ? get_div( pair.lit1 >> 1 ) : ~get_div( pair.lit1 >> 1 ) ) | ( pair.lit2 & 0x1 ? get_div( pair.lit2 >> 1 ) : ~get_div( pair.lit2 >> 1 ) );
-          }
-        }
-        else /* AND pair: ~(lit1 & lit2) = ~lit1 | ~lit2 */
-        {
-          on_off_sets[on_off_pair] &= ( pair.lit1 & 0x1 ? get_div( pair.lit1 >> 1 ) : ~get_div( pair.lit1 >> 1 ) ) | ( pair.lit2 & 0x1 ? get_div( pair.lit2 >> 1 ) : ~get_div( pair.lit2 >> 1 ) );
-        }
+        /* XOR pair: ~(lit1 ^ lit2); AND pair: ~(lit1 & lit2) */
+        auto* set = on_off_sets.row( on_off_pair );
+        on_off_sets.assign( on_off_pair, [&]( auto w ) { return set[w] & ~pair_word( pair, w ); } );
       } );
 
       auto const res_remain_pair = compute_function_rec( num_inserts - 2 );
@@ -519,8 +504,10 @@ private:
    */
   std::optional<uint32_t> find_one_unate()
   {
-    num_bits[0] = kitty::count_ones( on_off_sets[0] ); /* off-set */
-    num_bits[1] = kitty::count_ones( on_off_sets[1] ); /* on-set */
+    auto const* off_set = on_off_sets.row( 0 );
+    auto const* on_set = on_off_sets.row( 1 );
+    num_bits[0] = on_off_sets.count_ones( [&]( auto w ) { return off_set[w]; } ); /* off-set */
+    num_bits[1] = on_off_sets.count_ones( [&]( auto w ) { return on_set[w]; } );  /* on-set */
     if ( num_bits[0] == 0 )
     {
       return 1;
@@ -530,28 +517,31 @@ private:
       return 0;
     }
 
-    for ( auto v = 1u; v < divisors.size(); ++v )
+    for ( auto v = 1u; v < divisors.num_rows(); ++v )
     {
+      /* bits 0-3: d & off, ~d & off, d & on, ~d & on are empty */
+      auto const empty = divisors.empty_intersections( divisors.row( v ), off_set, on_set );
+
       bool unateness[4] = { false, false, false, false };
       /* check intersection with off-set */
-      if ( kitty::intersection_is_empty<TT, 1, 1>( get_div( v ), on_off_sets[0] ) )
+      if ( empty & 1u )
       {
         pos_unate_lits.emplace_back( v << 1 );
         unateness[0] = true;
       }
-      else if ( kitty::intersection_is_empty<TT, 0, 1>( get_div( v ), on_off_sets[0] ) )
+      else if ( empty & 2u )
       {
         pos_unate_lits.emplace_back( v << 1 | 0x1 );
         unateness[1] = true;
       }
 
       /* check intersection with on-set */
-      if ( kitty::intersection_is_empty<TT, 1, 1>( get_div( v ), on_off_sets[1] ) )
+      if ( empty & 4u )
       {
         neg_unate_lits.emplace_back( v << 1 );
         unateness[2] = true;
       }
-      else if ( kitty::intersection_is_empty<TT, 0, 1>( get_div( v ), on_off_sets[1] ) )
+      else if ( empty & 8u )
       {
         neg_unate_lits.emplace_back( v << 1 | 0x1 );
         unateness[3] = true;
@@ -587,9 +577,10 @@ private:
    */
   void sort_unate_lits( std::vector<unate_lit>& unate_lits, uint32_t on_off )
   {
+    auto const* set = on_off_sets.row( on_off );
     for ( auto& l : unate_lits )
     {
-      l.score = kitty::count_ones( ( l.lit & 0x1 ? ~get_div( l.lit >> 1 ) : get_div( l.lit >> 1 ) ) & on_off_sets[on_off] );
+      l.score = divisors.count_ones( [&]( auto w ) { return lit_word( l.lit, w ) & set[w]; } );
     }
     std::stable_sort( unate_lits.begin(), unate_lits.end(), [&]( unate_lit const& l1, unate_lit const& l2 ) {
       return l1.score > l2.score; // descending order
@@ -598,17 +589,10 @@ private:
 
   void sort_unate_pairs( std::vector<fanin_pair>& unate_pairs, uint32_t on_off )
   {
+    auto const* set = on_off_sets.row( on_off );
     for ( auto& p : unate_pairs )
     {
-      if constexpr ( static_params::use_xor )
-      {
-        p.score = ( p.lit1 > p.lit2 ) ? kitty::count_ones( ( ( p.lit1 & 0x1 ? ~get_div( p.lit1 >> 1 ) : get_div( p.lit1 >> 1 ) ) ^ ( p.lit2 & 0x1 ? ~get_div( p.lit2 >> 1 ) : get_div( p.lit2 >> 1 ) ) ) & on_off_sets[on_off] )
-                                      : kitty::count_ones( ( p.lit1 & 0x1 ? ~get_div( p.lit1 >> 1 ) : get_div( p.lit1 >> 1 ) ) & ( p.lit2 & 0x1 ? ~get_div( p.lit2 >> 1 ) : get_div( p.lit2 >> 1 ) ) & on_off_sets[on_off] );
-      }
-      else
-      {
-        p.score = kitty::count_ones( ( p.lit1 & 0x1 ? ~get_div( p.lit1 >> 1 ) : get_div( p.lit1 >> 1 ) ) & ( p.lit2 & 0x1 ? ~get_div( p.lit2 >> 1 ) : get_div( p.lit2 >> 1 ) ) & on_off_sets[on_off] );
-      }
+      p.score = divisors.count_ones( [&]( auto w ) { return pair_word( p, w ) & set[w]; } );
     }
     std::stable_sort( unate_pairs.begin(), unate_pairs.end(), [&]( fanin_pair const& p1, fanin_pair const& p2 ) {
       return p1.score > p2.score; // descending order
@@ -621,6 +605,7 @@ private:
    */
   std::optional<uint32_t> find_div_div( std::vector<unate_lit>& unate_lits, uint32_t on_off )
   {
+    auto const* set = on_off_sets.row( on_off );
     for ( auto i = 0u; i < unate_lits.size(); ++i )
     {
       uint32_t const& lit1 = unate_lits[i].lit;
@@ -635,9 +620,7 @@ private:
         {
           break;
         }
-        auto const ntt1 = lit1 & 0x1 ? get_div( lit1 >> 1 ) : ~get_div( lit1 >> 1 );
-        auto const ntt2 = lit2 & 0x1 ? get_div( lit2 >> 1 ) : ~get_div( lit2 >> 1 );
-        if ( kitty::intersection_is_empty( ntt1, ntt2, on_off_sets[on_off] ) )
+        if ( divisors.is_const0( [&]( auto w ) { return lit_word( lit1 ^ 0x1, w ) & lit_word( lit2 ^ 0x1, w ) & set[w]; } ) )
         {
           auto const new_lit = index_list.add_and( ( lit1 ^ 0x1 ), ( lit2 ^ 0x1 ) );
           return new_lit + on_off;
@@ -649,6 +632,7 @@ private:
 
   std::optional<uint32_t> find_div_pair( std::vector<unate_lit>& unate_lits, std::vector<fanin_pair>& unate_pairs, uint32_t on_off )
   {
+    auto const* set = on_off_sets.row( on_off );
     for ( auto i = 0u; i < unate_lits.size(); ++i )
     {
       uint32_t const& lit1 = unate_lits[i].lit;
@@ -659,25 +643,8 @@ private:
         {
           break;
         }
-        auto const ntt1 = lit1 & 0x1 ? get_div( lit1 >> 1 ) : ~get_div( lit1 >> 1 );
-        TT ntt2;
-        if constexpr ( static_params::use_xor )
-        {
-          if ( pair2.lit1 > pair2.lit2 )
-          {
-            ntt2 = ( pair2.lit1 & 0x1 ? get_div( pair2.lit1 >> 1 ) : ~get_div( pair2.lit1 >> 1 ) ) ^ ( pair2.lit2 & 0x1 ? ~get_div( pair2.lit2 >> 1 ) : get_div( pair2.lit2 >> 1 ) );
-          }
-          else
-          {
-            ntt2 = ( pair2.lit1 & 0x1 ? get_div( pair2.lit1 >> 1 ) : ~get_div( pair2.lit1 >> 1 ) ) | ( pair2.lit2 & 0x1 ? get_div( pair2.lit2 >> 1 ) : ~get_div( pair2.lit2 >> 1 ) );
-          }
-        }
-        else
-        {
-          ntt2 = ( pair2.lit1 & 0x1 ? get_div( pair2.lit1 >> 1 ) : ~get_div( pair2.lit1 >> 1 ) ) | ( pair2.lit2 & 0x1 ? get_div( pair2.lit2 >> 1 ) : ~get_div( pair2.lit2 >> 1 ) );
-        }
 
-        if ( kitty::intersection_is_empty( ntt1, ntt2, on_off_sets[on_off] ) )
+        if ( divisors.is_const0( [&]( auto w ) { return lit_word( lit1 ^ 0x1, w ) & ~pair_word( pair2, w ) & set[w]; } ) )
         {
           uint32_t new_lit1;
           if constexpr ( static_params::use_xor )
@@ -705,6 +672,7 @@ private:
 
   std::optional<uint32_t> find_pair_pair( std::vector<fanin_pair>& unate_pairs, uint32_t on_off )
   {
+    auto const* set = on_off_sets.row( on_off );
     for ( auto i = 0u; i < unate_pairs.size(); ++i )
     {
       fanin_pair const& pair1 = unate_pairs[i];
@@ -719,33 +687,8 @@ private:
         {
           break;
         }
-        TT ntt1, ntt2;
-        if constexpr ( static_params::use_xor )
-        {
-          if ( pair1.lit1 > pair1.lit2 )
-          {
-            ntt1 = ( pair1.lit1 & 0x1 ? get_div( pair1.lit1 >> 1 ) : ~get_div( pair1.lit1 >> 1 ) ) ^ ( pair1.lit2 & 0x1 ? ~get_div( pair1.lit2 >> 1 ) : get_div( pair1.lit2 >> 1 ) );
-          }
-          else
-          {
-            ntt1 = ( pair1.lit1 & 0x1 ? get_div( pair1.lit1 >> 1 ) : ~get_div( pair1.lit1 >> 1 ) ) | ( pair1.lit2 & 0x1 ? get_div( pair1.lit2 >> 1 ) : ~get_div( pair1.lit2 >> 1 ) );
-          }
-          if ( pair2.lit1 > pair2.lit2 )
-          {
-            ntt2 = ( pair2.lit1 & 0x1 ? get_div( pair2.lit1 >> 1 ) : ~get_div( pair2.lit1 >> 1 ) ) ^ ( pair2.lit2 & 0x1 ? ~get_div( pair2.lit2 >> 1 ) : get_div( pair2.lit2 >> 1 ) );
-          }
-          else
-          {
-            ntt2 = ( pair2.lit1 & 0x1 ? get_div( pair2.lit1 >> 1 ) : ~get_div( pair2.lit1 >> 1 ) ) | ( pair2.lit2 & 0x1 ? get_div( pair2.lit2 >> 1 ) : ~get_div( pair2.lit2 >> 1 ) );
-          }
-        }
-        else
-        {
-          ntt1 = ( pair1.lit1 & 0x1 ? get_div( pair1.lit1 >> 1 ) : ~get_div( pair1.lit1 >> 1 ) ) | ( pair1.lit2 & 0x1 ? get_div( pair1.lit2 >> 1 ) : ~get_div( pair1.lit2 >> 1 ) );
-          ntt2 = ( pair2.lit1 & 0x1 ? get_div( pair2.lit1 >> 1 ) : ~get_div( pair2.lit1 >> 1 ) ) | ( pair2.lit2 & 0x1 ? get_div( pair2.lit2 >> 1 ) : ~get_div( pair2.lit2 >> 1 ) );
-        }
 
-        if ( kitty::intersection_is_empty( ntt1, ntt2, on_off_sets[on_off] ) )
+        if ( divisors.is_const0( [&]( auto w ) { return ~pair_word( pair1, w ) & ~pair_word( pair2, w ) & set[w]; } ) )
         {
           uint32_t fanin_lit1, fanin_lit2;
           if constexpr ( static_params::use_xor )
@@ -782,32 +725,40 @@ private:
 
   std::optional<uint32_t> find_xor()
   {
+    auto const* off_set = on_off_sets.row( 0 );
+    auto const* on_set = on_off_sets.row( 1 );
+
     /* collect XOR-type pairs (d1 ^ d2) & off = 0 or ~(d1 ^ d2) & on = 0, selecting d1, d2 from binate_divs */
     for ( auto i = 0u; i < binate_divs.size(); ++i )
     {
       for ( auto j = i + 1; j < binate_divs.size(); ++j )
       {
-        auto const tt_xor = get_div( binate_divs[i] ) ^ get_div( binate_divs[j] );
+        auto const* d1 = divisors.row( binate_divs[i] );
+        auto const* d2 = divisors.row( binate_divs[j] );
+        on_off_sets.assign( 2, [&]( auto w ) { return d1[w] ^ d2[w]; } );
+        /* bits 0-3: xor & off, ~xor & off, xor & on, ~xor & on are empty */
+        auto const empty = divisors.empty_intersections( on_off_sets.row( 2 ), off_set, on_set );
+
         bool unateness[4] = { false, false, false, false };
         /* check intersection with off-set; additionally check intersection with on-set is not empty (otherwise it's useless) */
-        if ( kitty::intersection_is_empty<TT, 1, 1>( tt_xor, on_off_sets[0] ) && !kitty::intersection_is_empty<TT, 1, 1>( tt_xor, on_off_sets[1] ) )
+        if ( ( empty & 1u ) && !( empty & 4u ) )
         {
           pos_unate_pairs.emplace_back( binate_divs[i] << 1, binate_divs[j] << 1, true );
           unateness[0] = true;
         }
-        if ( kitty::intersection_is_empty<TT, 0, 1>( tt_xor, on_off_sets[0] ) && !kitty::intersection_is_empty<TT, 0, 1>( tt_xor, on_off_sets[1] ) )
+        if ( ( empty & 2u ) && !( empty & 8u ) )
         {
           pos_unate_pairs.emplace_back( ( binate_divs[i] << 1 ) + 1, binate_divs[j] << 1, true );
           unateness[1] = true;
         }
 
         /* check intersection with on-set; additionally check intersection with off-set is not empty (otherwise it's useless) */
-        if ( kitty::intersection_is_empty<TT, 1, 1>( tt_xor, on_off_sets[1] ) && !kitty::intersection_is_empty<TT, 1, 1>( tt_xor, on_off_sets[0] ) )
+        if ( ( empty & 4u ) && !( empty & 1u ) )
         {
           neg_unate_pairs.emplace_back( binate_divs[i] << 1, binate_divs[j] << 1, true );
           unateness[2] = true;
         }
-        if ( kitty::intersection_is_empty<TT, 0, 1>( tt_xor, on_off_sets[1] ) && !kitty::intersection_is_empty<TT, 0, 1>( tt_xor, on_off_sets[0] ) )
+        if ( ( empty & 8u ) && !( empty & 2u ) )
         {
           neg_unate_pairs.emplace_back( ( binate_divs[i] << 1 ) + 1, binate_divs[j] << 1, true );
           unateness[3] = true;
@@ -845,36 +796,49 @@ private:
   template<bool pol1, bool pol2>
   void collect_unate_pairs_detail( uint32_t div1, uint32_t div2 )
   {
+    auto const* off_set = on_off_sets.row( 0 );
+    auto const* on_set = on_off_sets.row( 1 );
+    auto const lit1 = ( div1 << 1 ) + (uint32_t)( !pol1 );
+    auto const lit2 = ( div2 << 1 ) + (uint32_t)( !pol2 );
+
     /* check intersection with off-set; additionally check intersection with on-set is not empty (otherwise it's useless) */
-    if ( kitty::intersection_is_empty<TT, pol1, pol2>( get_div( div1 ), get_div( div2 ), on_off_sets[0] ) && !kitty::intersection_is_empty<TT, pol1, pol2>( get_div( div1 ), get_div( div2 ), on_off_sets[1] ) )
+    if ( divisors.is_const0( [&]( auto w ) { return lit_word( lit1, w ) & lit_word( lit2, w ) & off_set[w]; } ) && !divisors.is_const0( [&]( auto w ) { return lit_word( lit1, w ) & lit_word( lit2, w ) & on_set[w]; } ) )
     {
-      pos_unate_pairs.emplace_back( ( div1 << 1 ) + (uint32_t)( !pol1 ), ( div2 << 1 ) + (uint32_t)( !pol2 ) );
+      pos_unate_pairs.emplace_back( lit1, lit2 );
     }
     /* check intersection with on-set; additionally check intersection with off-set is not empty (otherwise it's useless) */
-    else if ( kitty::intersection_is_empty<TT, pol1, pol2>( get_div( div1 ), get_div( div2 ), on_off_sets[1] ) && !kitty::intersection_is_empty<TT, pol1, pol2>( get_div( div1 ), get_div( div2 ), on_off_sets[0] ) )
+    else if ( divisors.is_const0( [&]( auto w ) { return lit_word( lit1, w ) & lit_word( lit2, w ) & on_set[w]; } ) && !divisors.is_const0( [&]( auto w ) { return lit_word( lit1, w ) & lit_word( lit2, w ) & off_set[w]; } ) )
     {
-      neg_unate_pairs.emplace_back( ( div1 << 1 ) + (uint32_t)( !pol1 ), ( div2 << 1 ) + (uint32_t)( !pol2 ) );
+      neg_unate_pairs.emplace_back( lit1, lit2 );
     }
   }
 
-  inline TT const& get_div( uint32_t idx ) const
+  /* word `w` of the function of literal `lit` */
+  inline uint64_t lit_word( uint32_t lit, uint32_t w ) const
   {
-    if constexpr ( static_params::copy_tts )
-    {
-      return divisors[idx];
-    }
-    else
+    return divisors.row( lit >> 1 )[w] ^ ( uint64_t( 0 ) - ( lit & 0x1 ) );
+  }
+
+  /* word `w` of the function of a pair (XOR if `lit1 > lit2` and XORs are used, AND otherwise) */
+  inline uint64_t pair_word( fanin_pair const& p, uint32_t w ) const
+  {
+    if constexpr ( static_params::use_xor )
     {
-      return ( *ptts )[divisors[idx]];
+      if ( p.lit1 > p.lit2 )
+      {
+        return lit_word( p.lit1, w ) ^ lit_word( p.lit2, w );
+      }
     }
+    return lit_word( p.lit1, w ) & lit_word( p.lit2, w );
   }
 
 private:
-  std::array<TT, 2> on_off_sets;
+  /* off-set, on-set, and one scratch row */
+  signature_matrix<signature_width_v<TT>> on_off_sets;
   std::array<uint32_t, 2> num_bits; /* number of bits in on-set and off-set */
 
-  const typename static_params::truth_table_storage_type* ptts;
-  std::vector<std::conditional_t<static_params::copy_tts, TT, typename static_params::node_type>> divisors;
+  /* divisor functions, row 0 is a dummy for the constant */
+  signature_matrix<signature_width_v<TT>> divisors;
 
   index_list_t index_list;
 
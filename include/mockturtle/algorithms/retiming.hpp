@@ -32,8 +32,10 @@
 
 #pragma once
 
+#include <algorithm>
 #include <cstdint>
 #include <limits>
+#include <vector>
 
 #include "../utils/node_map.hpp"
 #include "../utils/stopwatch.hpp"
@@ -59,6 +61,14 @@ struct retime_params
   /*! \brief Retiming max iterations. */
   uint32_t iterations{ UINT32_MAX };
 
+  /*! \brief Maximum clock period in unit gate delays (0 for no constraint).
+   *
+   * Registers are only moved if no combinational path between registers,
+   * primary inputs, and primary outputs becomes longer than `max_period`.
+   * Paths that are longer in the initial network are not shortened.
+   */
+  uint32_t max_period{ 0 };
+
   /*! \brief Be verbose */
   bool verbose{ false };
 };
@@ -97,6 +107,33 @@ public:
   using signal = typename Ntk::signal;
   static constexpr uint32_t sink_node = UINT32_MAX;
 
+private:
+  /* compressed adjacency lists indexed by node index */
+  struct adjacency
+  {
+    std::vector<uint32_t> offsets;
+    std::vector<uint32_t> nodes;
+
+    uint32_t begin( uint32_t index ) const { return offsets[index]; }
+    uint32_t end( uint32_t index ) const { return offsets[index + 1u]; }
+  };
+
+  enum class flow_state : uint8_t
+  {
+    enter,
+    scan_free,
+    scan_augment,
+    backtrack
+  };
+
+  struct flow_frame
+  {
+    uint32_t index;
+    uint32_t pivot;
+    uint32_t pos;
+    flow_state state;
+  };
+
 public:
   explicit retime_impl( Ntk& ntk, retime_params const& ps, retime_stats& st )
       : _ntk( ntk ),
@@ -139,6 +176,7 @@ private:
   {
     auto const num_registers_pre = _ntk.num_registers();
 
+    build_adjacency();
     init_values<forward>();
 
     auto min_cut = max_flow<forward>( iteration );
@@ -172,12 +210,12 @@ private:
       uint32_t local_flow;
       if constexpr ( forward )
       {
-        local_flow = max_flow_forwards_compute_rec( _ntk.fanout( n )[0] );
+        local_flow = find_augmenting_path( _ntk.fanout( n )[0], _fanouts, _fanins );
       }
       else
       {
         node fanin = _ntk.get_node( _ntk.get_fanin0( n ) );
-        local_flow = max_flow_backwards_compute_rec( fanin );
+        local_flow = find_augmenting_path( fanin, _fanins, _fanouts );
       }
 
       flow += local_flow;
@@ -194,12 +232,12 @@ private:
       uint32_t local_flow;
       if constexpr ( forward )
       {
-        local_flow = max_flow_forwards_compute_rec( _ntk.fanout( n )[0] );
+        local_flow = find_augmenting_path( _ntk.fanout( n )[0], _fanouts, _fanins );
       }
       else
       {
         node fanin = _ntk.get_node( _ntk.get_fanin0( n ) );
-        local_flow = max_flow_backwards_compute_rec( fanin );
+        local_flow = find_augmenting_path( fanin, _fanins, _fanouts );
       }
 
       assert( local_flow == 0 );
@@ -215,152 +253,174 @@ private:
     return min_cut;
   }
 
-  uint32_t max_flow_forwards_compute_rec( node const& n )
+  /* fanouts and non-constant fanins of all nodes; the network does not
+   * change until the registers are moved */
+  void build_adjacency()
   {
-    uint32_t found_path = 0;
-
-    if ( _ntk.visited( n ) == _ntk.trav_id() )
-      return 0;
+    auto const size = static_cast<uint32_t>( _ntk.size() );
+    _fanouts.offsets.assign( size + 1u, 0u );
+    _fanins.offsets.assign( size + 1u, 0u );
 
-    _ntk.set_visited( n, _ntk.trav_id() );
-
-    /* node is not in a flow path */
-    if ( _flow_path[n] == 0 )
-    {
-      /* cut boundary (sink) */
-      if ( _ntk.value( n ) )
-      {
-        _flow_path[n] = sink_node;
-        return 1;
-      }
-
-      _ntk.foreach_fanout( n, [&]( auto const& f ) {
-        /* there is a path for flow */
-        if ( max_flow_forwards_compute_rec( f ) )
-        {
-          _flow_path[n] = _ntk.node_to_index( f );
-          found_path = 1;
-          return false;
-        }
-        return true;
+    _ntk.foreach_node( [&]( auto const& n ) {
+      auto const index = _ntk.node_to_index( n );
+      _ntk.foreach_fanout( n, [&]( auto const& ) {
+        ++_fanouts.offsets[index + 1u];
+      } );
+      _ntk.foreach_fanin( n, [&]( auto const& f ) {
+        if ( !_ntk.is_constant( _ntk.get_node( f ) ) )
+          ++_fanins.offsets[index + 1u];
       } );
-
-      return found_path;
-    }
-
-    /* path has flow already, find alternative path from fanin with flow */
-    node fanin_flow = 0;
-    _ntk.foreach_fanin( n, [&]( auto const& f ) {
-      if ( _ntk.is_constant( _ntk.get_node( f ) ) )
-        return true;
-      if ( _flow_path[f] == _ntk.node_to_index( n ) )
-      {
-        fanin_flow = _ntk.get_node( f );
-        return false;
-      }
-      return true;
-    } );
-
-    if ( fanin_flow == 0 )
-      return 0;
-
-    /* augment path */
-    _ntk.foreach_fanout( fanin_flow, [&]( auto const& f ) {
-      /* there is a path for flow */
-      if ( max_flow_forwards_compute_rec( f ) )
-      {
-        _flow_path[fanin_flow] = _ntk.node_to_index( f );
-        found_path = 1;
-        return false;
-      }
-      return true;
     } );
-
-    if ( found_path )
-      return 1;
-
-    if ( max_flow_forwards_compute_rec( fanin_flow ) )
+    for ( auto i = 0u; i < size; ++i )
     {
-      _flow_path[fanin_flow] = 0;
-      return 1;
+      _fanouts.offsets[i + 1u] += _fanouts.offsets[i];
+      _fanins.offsets[i + 1u] += _fanins.offsets[i];
     }
+    _fanouts.nodes.resize( _fanouts.offsets[size] );
+    _fanins.nodes.resize( _fanins.offsets[size] );
 
-    return 0;
+    _ntk.foreach_node( [&]( auto const& n ) {
+      auto const index = _ntk.node_to_index( n );
+      auto fo = _fanouts.offsets[index];
+      _ntk.foreach_fanout( n, [&]( auto const& f ) {
+        _fanouts.nodes[fo++] = static_cast<uint32_t>( _ntk.node_to_index( f ) );
+      } );
+      auto fi = _fanins.offsets[index];
+      _ntk.foreach_fanin( n, [&]( auto const& f ) {
+        if ( !_ntk.is_constant( _ntk.get_node( f ) ) )
+          _fanins.nodes[fi++] = static_cast<uint32_t>( _ntk.node_to_index( _ntk.get_node( f ) ) );
+      } );
+    } );
   }
 
-  uint32_t max_flow_backwards_compute_rec( node const& n )
+  /*! \brief Searches an augmenting path from `n` to a sink.
+   *
+   * Depth-first search with an explicit stack.  The flow follows the
+   * `next` edges (fanouts for forward retiming, fanins for backward
+   * retiming).  A node that already carries flow can only be left by
+   * redirecting the flow of its predecessor on the flow path (found
+   * among the `prev` edges), either to another successor of the
+   * predecessor or backwards through the predecessor.  Visited marks
+   * are kept as long as no path is found, since the residual graph does
+   * not change meanwhile.
+   */
+  bool find_augmenting_path( node const& n, adjacency const& next, adjacency const& prev )
   {
-    uint32_t found_path = 0;
+    _flow_stack.clear();
+    _flow_stack.push_back( { static_cast<uint32_t>( _ntk.node_to_index( n ) ), 0u, 0u, flow_state::enter } );
 
-    if ( _ntk.visited( n ) == _ntk.trav_id() )
-      return 0;
-
-    _ntk.set_visited( n, _ntk.trav_id() );
-
-    /* node is not in a flow path */
-    if ( _flow_path[n] == 0 )
+    bool found = false;
+    while ( !_flow_stack.empty() )
     {
-      /* cut boundary (sink) */
-      if ( _ntk.value( n ) )
+      auto& frame = _flow_stack.back();
+      switch ( frame.state )
       {
-        _flow_path[n] = sink_node;
-        return 1;
-      }
-
-      _ntk.foreach_fanin( n, [&]( auto const& f ) {
-        if ( _ntk.is_constant( _ntk.get_node( f ) ) )
-          return true;
-        /* there is a path for flow */
-        if ( max_flow_backwards_compute_rec( _ntk.get_node( f ) ) )
+      case flow_state::enter:
+      {
+        auto const g = _ntk.index_to_node( frame.index );
+        if ( _ntk.visited( g ) == _ntk.trav_id() )
         {
-          _flow_path[n] = _ntk.node_to_index( _ntk.get_node( f ) );
-          found_path = 1;
-          return false;
+          found = false;
+          _flow_stack.pop_back();
+          continue;
         }
-        return true;
-      } );
+        _ntk.set_visited( g, _ntk.trav_id() );
 
-      return found_path;
-    }
+        /* node is not in a flow path */
+        if ( _flow_path[g] == 0 )
+        {
+          /* cut boundary (sink) */
+          if ( _ntk.value( g ) )
+          {
+            _flow_path[g] = sink_node;
+            found = true;
+            _flow_stack.pop_back();
+            continue;
+          }
+          frame.pivot = frame.index;
+          frame.state = flow_state::scan_free;
+        }
+        else
+        {
+          /* path has flow already, find alternative path from the predecessor with flow */
+          auto pivot = frame.index;
+          for ( auto i = prev.begin( frame.index ); i < prev.end( frame.index ); ++i )
+          {
+            if ( _flow_path[_ntk.index_to_node( prev.nodes[i] )] == frame.index )
+            {
+              pivot = prev.nodes[i];
+              break;
+            }
+          }
+          if ( pivot == frame.index )
+          {
+            found = false;
+            _flow_stack.pop_back();
+            continue;
+          }
+          frame.pivot = pivot;
+          frame.state = flow_state::scan_augment;
+        }
 
-    /* path has flow already, find alternative path from fanout with flow */
-    node fanout_flow = 0;
-    _ntk.foreach_fanout( n, [&]( auto const& f ) {
-      if ( _flow_path[f] == _ntk.node_to_index( n ) )
-      {
-        fanout_flow = _ntk.get_node( f );
-        return false;
+        /* start scanning the successors of the pivot */
+        frame.pos = next.begin( frame.pivot );
+        if ( frame.pos < next.end( frame.pivot ) )
+        {
+          auto const child = next.nodes[frame.pos];
+          _flow_stack.push_back( { child, 0u, 0u, flow_state::enter } );
+        }
+        else if ( frame.state == flow_state::scan_free )
+        {
+          found = false;
+          _flow_stack.pop_back();
+        }
+        else
+        {
+          frame.state = flow_state::backtrack;
+          auto const child = frame.pivot;
+          _flow_stack.push_back( { child, 0u, 0u, flow_state::enter } );
+        }
+        continue;
       }
-      return true;
-    } );
 
-    if ( fanout_flow == 0 )
-      return 0;
+      case flow_state::scan_free:
+      case flow_state::scan_augment:
+        /* the search from the successor at `pos` has returned */
+        if ( found )
+        {
+          _flow_path[_ntk.index_to_node( frame.pivot )] = next.nodes[frame.pos];
+          _flow_stack.pop_back();
+          continue;
+        }
+        if ( ++frame.pos < next.end( frame.pivot ) )
+        {
+          auto const child = next.nodes[frame.pos];
+          _flow_stack.push_back( { child, 0u, 0u, flow_state::enter } );
+        }
+        else if ( frame.state == flow_state::scan_free )
+        {
+          _flow_stack.pop_back();
+        }
+        else
+        {
+          /* push back the flow through the predecessor */
+          frame.state = flow_state::backtrack;
+          auto const child = frame.pivot;
+          _flow_stack.push_back( { child, 0u, 0u, flow_state::enter } );
+        }
+        continue;
 
-    /* augment path */
-    _ntk.foreach_fanin( fanout_flow, [&]( auto const& f ) {
-      if ( _ntk.is_constant( _ntk.get_node( f ) ) )
-        return true;
-      /* there is a path for flow */
-      if ( max_flow_backwards_compute_rec( _ntk.get_node( f ) ) )
-      {
-        _flow_path[fanout_flow] = _ntk.node_to_index( _ntk.get_node( f ) );
-        found_path = 1;
-        return false;
+      case flow_state::backtrack:
+        if ( found )
+        {
+          _flow_path[_ntk.index_to_node( frame.pivot )] = 0;
+        }
+        _flow_stack.pop_back();
+        continue;
       }
-      return true;
-    } );
-
-    if ( found_path )
-      return 1;
-
-    if ( max_flow_backwards_compute_rec( fanout_flow ) )
-    {
-      _flow_path[fanout_flow] = 0;
-      return 1;
     }
 
-    return 0;
+    return found;
   }
 
   std::vector<node> get_min_cut()
@@ -436,22 +496,31 @@ private:
 
   void collect_cut_nodes_tfi( node const& n, std::vector<node>& min_cut )
   {
-    if ( _ntk.visited( n ) == _ntk.trav_id() )
-      return;
+    /* children are pushed in reverse order to keep the depth-first order */
+    _node_stack.clear();
+    _node_stack.push_back( static_cast<uint32_t>( _ntk.node_to_index( n ) ) );
+    while ( !_node_stack.empty() )
+    {
+      auto const index = _node_stack.back();
+      _node_stack.pop_back();
 
-    _ntk.set_visited( n, _ntk.trav_id() );
+      auto const g = _ntk.index_to_node( index );
+      if ( _ntk.visited( g ) == _ntk.trav_id() )
+        continue;
 
-    if ( _ntk.value( n ) )
-    {
-      min_cut.push_back( n );
-      return;
-    }
+      _ntk.set_visited( g, _ntk.trav_id() );
 
-    _ntk.foreach_fanin( n, [&]( auto const& f ) {
-      if ( _ntk.is_constant( _ntk.get_node( f ) ) )
-        return;
-      collect_cut_nodes_tfi( _ntk.get_node( f ), min_cut );
-    } );
+      if ( _ntk.value( g ) )
+      {
+        min_cut.push_back( g );
+        continue;
+      }
+
+      for ( auto i = _fanins.end( index ); i > _fanins.begin( index ); --i )
+      {
+        _node_stack.push_back( _fanins.nodes[i - 1u] );
+      }
+    }
   }
 
   template<bool forward>
@@ -482,6 +551,12 @@ private:
         rec_mark_tfo( n );
       } );
 
+      /* exclude nodes that would exceed the clock period */
+      if ( _ps.max_period > 0 )
+      {
+        mark_critical<forward>();
+      }
+
       /* mark childrens of marked nodes */
       std::vector<node> to_mark;
       to_mark.reserve( 200 );
@@ -520,9 +595,100 @@ private:
       _ntk.foreach_po( [&]( auto const& f ) {
         rec_mark_tfi( _ntk.get_node( f ) );
       } );
+
+      /* exclude nodes that would exceed the clock period */
+      if ( _ps.max_period > 0 )
+      {
+        mark_critical<forward>();
+      }
     }
   }
 
+  /*! \brief Marks the nodes that cannot be crossed by the registers.
+   *
+   * Forward retiming moves the registers past the nodes in their
+   * transitive fanout, such that the logic between the register input
+   * and a moved node becomes a single combinational path.  Its length is
+   * the arrival time of the node when the registers are transparent
+   * once, i.e., when a register output arrives with its register input.
+   * Backward retiming is the dual with departure times.
+   */
+  template<bool forward>
+  void mark_critical()
+  {
+    auto const& edges = forward ? _fanins : _fanouts;
+
+    /* levels without crossing registers */
+    compute_levels<forward>( _levels, edges, []( uint32_t ) { return 0u; } );
+
+    /* levels crossing one register */
+    compute_levels<forward>( _levels_transparent, edges, [&]( uint32_t index ) {
+      /* box output <- register <- box input, or box input -> register -> box output */
+      auto const g = _ntk.index_to_node( index );
+      if ( forward ? !_ntk.is_box_output( g ) : !_ntk.is_box_input( g ) )
+        return 0u;
+      if ( edges.begin( index ) == edges.end( index ) )
+        return 0u;
+      auto const reg = edges.nodes[edges.begin( index )];
+      if ( edges.begin( reg ) == edges.end( reg ) )
+        return 0u;
+      return _levels[edges.nodes[edges.begin( reg )]];
+    } );
+
+    _ntk.foreach_node( [&]( auto const& n ) {
+      if ( _levels_transparent[_ntk.node_to_index( n )] > _ps.max_period )
+        _ntk.set_value( n, 1 );
+    } );
+  }
+
+  /* longest paths in unit gate delays along `edges` (fanins for arrival
+   * times, fanouts for departure times); the traversal stops at the
+   * combinational inputs (outputs), whose level is given by `boundary` */
+  template<bool forward, typename Fn>
+  void compute_levels( std::vector<uint32_t>& levels, adjacency const& edges, Fn&& boundary )
+  {
+    constexpr auto unknown = std::numeric_limits<uint32_t>::max();
+    levels.assign( _ntk.size(), unknown );
+
+    _ntk.foreach_node( [&]( auto const& n ) {
+      auto const root = static_cast<uint32_t>( _ntk.node_to_index( n ) );
+      if ( levels[root] != unknown )
+        return;
+
+      _level_stack.clear();
+      _level_stack.emplace_back( root, edges.begin( root ) );
+      while ( !_level_stack.empty() )
+      {
+        auto const [index, pos] = _level_stack.back();
+        auto const g = _ntk.index_to_node( index );
+
+        if ( forward ? _ntk.is_ci( g ) : _ntk.is_co( g ) )
+        {
+          levels[index] = boundary( index );
+          _level_stack.pop_back();
+          continue;
+        }
+
+        if ( pos < edges.end( index ) )
+        {
+          ++_level_stack.back().second;
+          auto const child = edges.nodes[pos];
+          if ( levels[child] == unknown )
+            _level_stack.emplace_back( child, edges.begin( child ) );
+          continue;
+        }
+
+        uint32_t level = 0;
+        for ( auto i = edges.begin( index ); i < edges.end( index ); ++i )
+        {
+          level = std::max( level, levels[edges.nodes[i]] );
+        }
+        levels[index] = level + ( _ntk.is_node( g ) ? 1u : 0u );
+        _level_stack.pop_back();
+      }
+    } );
+  }
+
   template<bool forward>
   void update_registers_position( std::vector<node> const& min_cut, uint32_t iteration )
   {
@@ -630,26 +796,35 @@ private:
 
   void rec_mark_tfo( node const& n )
   {
-    if ( _ntk.value( n ) )
-      return;
-
-    _ntk.set_value( n, 1 );
-    _ntk.foreach_fanout( n, [&]( auto const& f ) {
-      rec_mark_tfo( f );
-    } );
+    mark_reachable( n, _fanouts );
   }
 
   void rec_mark_tfi( node const& n )
   {
-    if ( _ntk.value( n ) )
-      return;
+    mark_reachable( n, _fanins );
+  }
 
-    _ntk.set_value( n, 1 );
-    _ntk.foreach_fanin( n, [&]( auto const& f ) {
-      if ( _ntk.is_constant( _ntk.get_node( f ) ) )
-        return;
-      rec_mark_tfi( _ntk.get_node( f ) );
-    } );
+  /* sets the value of all unmarked nodes reachable from `n` along `edges`
+   * without crossing marked nodes */
+  void mark_reachable( node const& n, adjacency const& edges )
+  {
+    _node_stack.clear();
+    _node_stack.push_back( static_cast<uint32_t>( _ntk.node_to_index( n ) ) );
+    while ( !_node_stack.empty() )
+    {
+      auto const index = _node_stack.back();
+      _node_stack.pop_back();
+
+      auto const g = _ntk.index_to_node( index );
+      if ( _ntk.value( g ) )
+        continue;
+
+      _ntk.set_value( g, 1 );
+      for ( auto i = edges.begin( index ); i < edges.end( index ); ++i )
+      {
+        _node_stack.push_back( edges.nodes[i] );
+      }
+    }
   }
 
   template<bool forward>
@@ -737,6 +912,15 @@ private:
   retime_stats& _st;
 
   node_map<uint32_t, Ntk> _flow_path;
+
+  /* scratch data reused across iterations */
+  adjacency _fanouts;
+  adjacency _fanins;
+  std::vector<flow_frame> _flow_stack;
+  std::vector<uint32_t> _node_stack;
+  std::vector<std::pair<uint32_t, uint32_t>> _level_stack;
+  std::vector<uint32_t> _levels;
+  std::vector<uint32_t> _levels_transparent;
 };
 
 } /* namespace detail */
@@ -747,8 +931,13 @@ private:
  * The only supported network type is the `generic_network`.
  * The algorithm excecutes the retiming inplace.
  * 
- * Currently, only area-based retiming is implemented. Mixed register types
- * such as (active high/low, rising/falling edge) are not supported yet.
+ * Currently, only area-based retiming is implemented, optionally under a
+ * clock period constraint in unit gate delays (`max_period`). Mixed register
+ * types such as (active high/low, rising/falling edge) are not supported yet.
+ *
+ * The minimum cuts are computed with non-recursive augmenting path searches
+ * on compressed adjacency lists, hence also very deep networks can be
+ * retimed.
  *
  * **Required network functions:**
  * - `size`
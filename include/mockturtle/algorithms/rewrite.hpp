@@ -34,6 +34,8 @@
 
 #include "../traits.hpp"
 #include "../utils/cost_functions.hpp"
+#include "../utils/cut_store.hpp"
+#include "../utils/memory_usage.hpp"
 #include "../utils/node_map.hpp"
 #include "../utils/stopwatch.hpp"
 #include "../views/color_view.hpp"
@@ -43,6 +45,7 @@
 #include "cleanup.hpp"
 #include "cut_enumeration.hpp"
 #include "cut_enumeration/rewrite_cut.hpp"
+#include "dont_cares.hpp"
 #include "reconv_cut.hpp"
 #include "simulation.hpp"
 
@@ -107,28 +110,33 @@ struct rewrite_stats
   /*! \brief Candidates */
   uint32_t candidates{ 0 };
 
+  /*! \brief Memory of the network and the cut store at the end (bytes). */
+  uint64_t memory_footprint{ 0 };
+
   void report() const
   {
     std::cout << fmt::format( "[i] total time       = {:>5.2f} secs\n", to_seconds( time_total ) );
+    if ( memory_footprint > 0u )
+    {
+      std::cout << fmt::format( "[i] memory footprint = {:>5.2f} MB\n", memory_footprint / 1048576.0 );
+    }
   }
 };
 
 namespace detail
 {
 
-template<class Ntk, class Library, class NodeCostFn>
+template<class Ntk, class Library, class NodeCostFn, class CutStore>
 class rewrite_impl
 {
   static constexpr uint32_t num_vars = 4u;
   static constexpr uint32_t max_window_size = 8u;
-  using network_cuts_t = dynamic_network_cuts<Ntk, num_vars, true, cut_enumeration_rewrite_cut>;
-  using cut_manager_t = detail::dynamic_cut_enumeration_impl<Ntk, num_vars, true, cut_enumeration_rewrite_cut>;
-  using cut_t = typename network_cuts_t::cut_t;
+  using cut_t = typename CutStore::cut_t;
   using node_data = typename Ntk::storage::element_type::node_type;
 
 public:
-  rewrite_impl( Ntk& ntk, Library&& library, rewrite_params const& ps, rewrite_stats& st, NodeCostFn const& cost_fn )
-      : ntk( ntk ), library( library ), ps( ps ), st( st ), cost_fn( cost_fn ), required( ntk, UINT32_MAX )
+  rewrite_impl( Ntk& ntk, Library&& library, CutStore& cuts, rewrite_params const& ps, rewrite_stats& st, NodeCostFn const& cost_fn )
+      : ntk( ntk ), library( library ), cuts( cuts ), ps( ps ), st( st ), cost_fn( cost_fn ), required( ntk, UINT32_MAX )
   {
     register_events();
   }
@@ -145,7 +153,7 @@ public:
 
   void run()
   {
-    stopwatch t( st.time_total );
+    stopwatch t( st.time_total, "rewrite" );
 
     ntk.incr_trav_id();
 
@@ -161,19 +169,12 @@ public:
 
     st.estimated_gain = _estimated_gain;
     st.candidates = _candidates;
+    trace_counter( "gates", ntk.num_gates() );
   }
 
 private:
   void perform_rewriting()
   {
-    /* initialize the cut manager */
-    cut_enumeration_stats cst;
-    network_cuts_t cuts( ntk.size() + ( ntk.size() >> 1 ) );
-    cut_manager_t cut_manager( ntk, ps.cut_enumeration_ps, cst, cuts );
-
-    /* initialize cuts for constant nodes and PIs */
-    cut_manager.init_cuts();
-
     auto& db = library.get_database();
 
     std::array<signal<Ntk>, num_vars> leaves;
@@ -204,11 +205,11 @@ private:
         }
       }
 
-      cut_manager.clear_cuts( n );
-      cut_manager.compute_cuts( n );
+      /* recompute the cuts of the node to update the cut costs */
+      auto const& node_cuts = cuts.recompute( n );
 
       uint32_t cut_index = 0;
-      for ( auto& cut : cuts.cuts( ntk.node_to_index( n ) ) )
+      for ( auto& cut : node_cuts )
       {
         /* skip trivial cut */
         if ( ( cut->size() == 1 && *cut->begin() == ntk.node_to_index( n ) ) )
@@ -218,7 +219,7 @@ private:
         }
 
         /* Boolean matching */
-        auto config = kitty::exact_npn_canonization( cuts.truth_table( *cut ) );
+        auto const& config = cuts.npn_class( *cut );
         auto tt_npn = std::get<0>( config );
         auto neg = std::get<1>( config );
         auto perm = std::get<2>( config );
@@ -327,22 +328,14 @@ private:
             assert( ntk.level( ntk.get_node( new_f ) ) <= required[n] );
           }
         }
-
-        clear_cuts_fanout_rec( cuts, cut_manager, ntk.get_node( new_f ) );
       }
     } );
+
+    st.memory_footprint = memory_footprint( ntk, cuts, required );
   }
 
   void perform_rewriting_dc()
   {
-    /* initialize the cut manager */
-    cut_enumeration_stats cst;
-    network_cuts_t cuts( ntk.size() + ( ntk.size() >> 1 ) );
-    cut_manager_t cut_manager( ntk, ps.cut_enumeration_ps, cst, cuts );
-
-    /* initialize cuts for constant nodes and PIs */
-    cut_manager.init_cuts();
-
     auto& db = library.get_database();
 
     std::array<signal<Ntk>, num_vars> leaves;
@@ -350,13 +343,8 @@ private:
     std::array<uint8_t, num_vars> permutation;
     signal<Ntk> best_signal;
 
-    reconvergence_driven_cut_parameters rps;
-    rps.max_leaves = ps.window_size;
-    reconvergence_driven_cut_statistics rst;
-    detail::reconvergence_driven_cut_impl<Ntk, false, has_level_v<Ntk>> reconv_cuts( ntk, rps, rst );
-    unordered_node_map<kitty::static_truth_table<max_window_size>, Ntk> tts( ntk );
-
-    color_view<Ntk> color_ntk{ ntk };
+    dont_care_manager<Ntk, kitty::static_truth_table<max_window_size>, has_level_v<Ntk>> dcs( ntk, ps.window_size );
+    std::array<node<Ntk>, num_vars> cut_leaves;
     std::array<uint32_t, num_vars> divisors;
     for ( uint32_t i = 0; i < num_vars; ++i )
     {
@@ -386,21 +374,14 @@ private:
         }
       }
 
-      cut_manager.clear_cuts( n );
-      cut_manager.compute_cuts( n );
+      /* recompute the cuts of the node to update the cut costs */
+      auto const& node_cuts = cuts.recompute( n );
 
       /* compute window */
-      std::vector<node<Ntk>> roots = { n };
-      auto const extended_leaves = reconv_cuts.run( roots ).first;
-      std::vector<node<Ntk>> gates{ collect_nodes( color_ntk, extended_leaves, roots ) };
-      window_view window_ntk{ color_ntk, extended_leaves, roots, gates };
-
-      default_simulator<kitty::static_truth_table<max_window_size>> sim;
-      tts.reset();
-      simulate_nodes_with_node_map<kitty::static_truth_table<max_window_size>>( window_ntk, tts, sim );
+      dcs.set_window( { n } );
 
       uint32_t cut_index = 0;
-      for ( auto& cut : cuts.cuts( ntk.node_to_index( n ) ) )
+      for ( auto& cut : node_cuts )
       {
         /* skip trivial cut */
         if ( ( cut->size() == 1 && *cut->begin() == ntk.node_to_index( n ) ) )
@@ -410,41 +391,22 @@ private:
         }
 
         /* Boolean matching */
-        auto config = kitty::exact_npn_canonization( cuts.truth_table( *cut ) );
+        auto const& config = cuts.npn_class( *cut );
         auto tt_npn = std::get<0>( config );
         auto neg = std::get<1>( config );
         auto perm = std::get<2>( config );
 
         kitty::static_truth_table<num_vars> care;
 
-        bool containment = true;
+        auto num_leaves = 0u;
         for ( auto const& l : *cut )
         {
-          if ( color_ntk.color( ntk.index_to_node( l ) ) != color_ntk.current_color() )
-          {
-            containment = false;
-            break;
-          }
+          cut_leaves[num_leaves++] = ntk.index_to_node( l );
         }
 
-        if ( containment )
-        {
-          /* compute care set */
-          for ( auto i = 0u; i < ( 1u << window_ntk.num_pis() ); ++i )
-          {
-            uint32_t entry{ 0u };
-            auto j = 0u;
-            for ( auto const& l : *cut )
-            {
-              entry |= kitty::get_bit( tts[l], i ) << j;
-              ++j;
-            }
-            kitty::set_bit( care, entry );
-          }
-        }
-        else
+        /* compute care set, completely specified if the cut is not in the window */
+        if ( !dcs.compute_care( cut_leaves.begin(), cut_leaves.begin() + num_leaves, care ) )
         {
-          /* completely specified */
           care = ~care;
         }
 
@@ -553,10 +515,10 @@ private:
             assert( ntk.level( ntk.get_node( new_f ) ) <= required[n] );
           }
         }
-
-        clear_cuts_fanout_rec( cuts, cut_manager, ntk.get_node( new_f ) );
       }
     } );
+
+    st.memory_footprint = memory_footprint( ntk, cuts, required );
   }
 
   int32_t measure_mffc_ref( node<Ntk> const& n, cut_t const* cut )
@@ -786,18 +748,6 @@ private:
     } );
   }
 
-  void clear_cuts_fanout_rec( network_cuts_t& cuts, cut_manager_t& cut_manager, node<Ntk> const& n )
-  {
-    ntk.foreach_fanout( n, [&]( auto const& g ) {
-      auto const index = ntk.node_to_index( g );
-      if ( cuts.cuts( index ).size() > 0 )
-      {
-        cut_manager.clear_cuts( g );
-        clear_cuts_fanout_rec( cuts, cut_manager, g );
-      }
-    } );
-  }
-
 private:
   void register_events()
   {
@@ -860,6 +810,7 @@ private:
 private:
   Ntk& ntk;
   Library&& library;
+  CutStore& cuts;
   rewrite_params const& ps;
   rewrite_stats& st;
   NodeCostFn cost_fn;
@@ -875,6 +826,23 @@ private:
   std::shared_ptr<typename network_events<Ntk>::delete_event_type> delete_event;
 };
 
+/* calls `fn` with the views of `ntk` required by rewrite */
+template<class Ntk, class NodeCostFn, class Fn>
+void rewrite_on_views( Ntk& ntk, rewrite_params const& ps, Fn&& fn )
+{
+  if ( ps.preserve_depth || ps.use_dont_cares )
+  {
+    depth_view<Ntk, NodeCostFn> depth_ntk{ ntk };
+    fanout_view<depth_view<Ntk, NodeCostFn>> fanout_ntk{ depth_ntk };
+    fn( fanout_ntk );
+  }
+  else
+  {
+    fanout_view<Ntk> fanout_ntk{ ntk };
+    fn( fanout_ntk );
+  }
+}
+
 } /* namespace detail */
 
 /*! \brief Boolean rewrite.
@@ -918,24 +886,73 @@ void rewrite( Ntk& ntk, Library&& library, rewrite_params const& ps = {}, rewrit
 
   rewrite_stats st;
 
-  if ( ps.preserve_depth || ps.use_dont_cares )
-  {
-    using depth_view_t = depth_view<Ntk, NodeCostFn>;
-    depth_view_t depth_ntk{ ntk };
-    using fanout_view_t = fanout_view<depth_view_t>;
-    fanout_view_t fanout_view{ depth_ntk };
+  detail::rewrite_on_views<Ntk, NodeCostFn>( ntk, ps, [&]( auto& view ) {
+    using view_t = std::decay_t<decltype( view )>;
+
+    /* cuts in the TFO of substituted nodes are invalidated by events */
+    cut_store<view_t, 4u, cut_enumeration_rewrite_cut> cuts( view, ps.cut_enumeration_ps );
 
-    detail::rewrite_impl<fanout_view_t, Library, NodeCostFn> p( fanout_view, library, ps, st, cost_fn );
+    detail::rewrite_impl<view_t, Library, NodeCostFn, decltype( cuts )> p( view, library, cuts, ps, st, cost_fn );
     p.run();
+  } );
+
+  if ( ps.verbose )
+  {
+    st.report();
   }
-  else
+
+  if ( pst )
   {
-    using fanout_view_t = fanout_view<Ntk>;
-    fanout_view_t fanout_view{ ntk };
+    *pst = st;
+  }
+
+  ntk = cleanup_dangling( ntk );
+}
 
-    detail::rewrite_impl<fanout_view_t, Library, NodeCostFn> p( fanout_view, library, ps, st, cost_fn );
+/*! \brief Boolean rewrite with a cut store owned by the caller.
+ *
+ * Same as the function above, but the cuts are taken from `cuts`, which may
+ * be shared with other passes (e.g., `balancing`) or with further calls of
+ * rewrite.  The store must be attached to a view of `ntk` (e.g.,
+ * `fanout_view<Ntk>`) and be compatible with `ps.cut_enumeration_ps` (see
+ * `cut_store::is_compatible`).
+ *
+ * Rewrite recomputes the cuts of each node it visits, since their costs
+ * depend on fanout sizes, but keeps the cuts of all other nodes and reuses
+ * the NPN classes computed by earlier calls.  Unlike the function above,
+ * this function does not call `cleanup_dangling` at the end, as it renumbers
+ * the nodes and would invalidate the store.
+ *
+ * \param ntk Input network (will be changed in-place)
+ * \param library Exact library containing pre-computed structures
+ * \param cuts Cut store attached to `ntk`
+ * \param ps Rewrite params
+ * \param pst Rewrite statistics
+ * \param cost_fn Node cost function (a functor with signature `uint32_t(Ntk const&, node<Ntk> const&)`)
+ */
+template<class Ntk, class Library, class NodeCostFn = unit_cost<Ntk>, class StoreNtk>
+void rewrite( Ntk& ntk, Library&& library, cut_store<StoreNtk, 4u, cut_enumeration_rewrite_cut>& cuts, rewrite_params const& ps = {}, rewrite_stats* pst = nullptr, NodeCostFn const& cost_fn = {} )
+{
+  static_assert( is_network_type_v<Ntk>, "Ntk is not a network type" );
+  static_assert( has_get_node_v<Ntk>, "Ntk does not implement the get_node method" );
+  static_assert( has_size_v<Ntk>, "Ntk does not implement the size method" );
+  static_assert( has_make_signal_v<Ntk>, "Ntk does not implement the make_signal method" );
+  static_assert( has_foreach_gate_v<Ntk>, "Ntk does not implement the foreach_gate method" );
+  static_assert( has_substitute_node_v<Ntk>, "Ntk does not implement the substitute_node method" );
+  static_assert( has_clear_visited_v<Ntk>, "Ntk does not implement the clear_visited method" );
+  static_assert( has_clear_values_v<Ntk>, "Ntk does not implement the clear_values method" );
+  static_assert( has_fanout_size_v<Ntk>, "Ntk does not implement the fanout_size method" );
+  static_assert( has_set_value_v<Ntk>, "Ntk does not implement the set_value method" );
+  static_assert( has_foreach_node_v<Ntk>, "Ntk does not implement the foreach_node method" );
+  assert( cuts.is_compatible( ps.cut_enumeration_ps ) && "cut store is not compatible with the cut enumeration parameters" );
+
+  rewrite_stats st;
+
+  detail::rewrite_on_views<Ntk, NodeCostFn>( ntk, ps, [&]( auto& view ) {
+    using view_t = std::decay_t<decltype( view )>;
+    detail::rewrite_impl<view_t, Library, NodeCostFn, std::decay_t<decltype( cuts )>> p( view, library, cuts, ps, st, cost_fn );
     p.run();
-  }
+  } );
 
   if ( ps.verbose )
   {
@@ -946,8 +963,6 @@ void rewrite( Ntk& ntk, Library&& library, rewrite_params const& ps = {}, rewrit
   {
     *pst = st;
   }
-
-  ntk = cleanup_dangling( ntk );
 }
 
-} /* namespace mockturtle */
\ No newline at end of file
+} /* namespace mockturtle */
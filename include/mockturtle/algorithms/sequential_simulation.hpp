@@ -0,0 +1,739 @@
+/* mockturtle: C++ logic network library
+ * Copyright (C) 2018-2022  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*!
+  \file sequential_simulation.hpp
+  \brief Cycle-accurate bit-parallel simulation of sequential networks
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#include "../traits.hpp"
+#include "../utils/stopwatch.hpp"
+
+#include <fmt/format.h>
+#include <kitty/detail/mscfix.hpp>
+#include <kitty/partial_truth_table.hpp>
+
+namespace mockturtle
+{
+
+/*! \brief Parameters for sequential simulation.
+ *
+ * The data structure `sequential_simulation_params` holds configurable
+ * parameters with default arguments for `sequential_simulator`.
+ */
+struct sequential_simulation_params
+{
+  /*! \brief Number of 64-bit words per node, i.e., 64 traces per word. */
+  uint32_t num_words{ 1u };
+
+  /*! \brief Seed for random input values and random initial states. */
+  uint64_t seed{ 1u };
+
+  /*! \brief Start registers without a defined initial value (`init` other
+   * than 0 or 1) in a random state, otherwise they start at 0.
+   */
+  bool random_unknown_init{ true };
+
+  /*! \brief Count value changes between consecutive cycles. */
+  bool count_toggles{ false };
+
+  /*! \brief Number of threads simulating blocks of traces (0 uses all cores). */
+  uint32_t num_threads{ 1u };
+};
+
+/*! \brief Statistics for sequential simulation. */
+struct sequential_simulation_stats
+{
+  /*! \brief Total simulation time. */
+  stopwatch<>::duration time_total{ 0 };
+
+  /*! \brief Number of simulated cycles since the last reset. */
+  uint64_t num_cycles{ 0 };
+
+  /*! \brief Number of independent traces. */
+  uint32_t num_traces{ 0 };
+
+  /*! \brief Number of blocks of traces simulated independently. */
+  uint32_t num_blocks{ 0 };
+
+  void report() const
+  {
+    std::cout << fmt::format( "[i] traces     = {:>8} in {} blocks\n", num_traces, num_blocks );
+    std::cout << fmt::format( "[i] cycles     = {:>8}\n", num_cycles );
+    std::cout << fmt::format( "[i] total time = {:>5.2f} secs\n", to_seconds( time_total ) );
+  }
+};
+
+namespace detail
+{
+
+inline uint64_t splitmix64( uint64_t x )
+{
+  x += 0x9e3779b97f4a7c15ull;
+  x = ( x ^ ( x >> 30 ) ) * 0xbf58476d1ce4e5b9ull;
+  x = ( x ^ ( x >> 27 ) ) * 0x94d049bb133111ebull;
+  return x ^ ( x >> 31 );
+}
+
+/* random word that only depends on its position in the simulation, such that
+ * results do not depend on how the traces are split into blocks */
+inline uint64_t trace_random_word( uint64_t seed, uint64_t cycle, uint32_t input, uint32_t word )
+{
+  return splitmix64( splitmix64( seed ^ splitmix64( cycle ) ) ^ ( ( uint64_t( input ) << 32 ) | word ) );
+}
+
+} // namespace detail
+
+/*! \brief Cycle-accurate bit-parallel simulator for sequential networks.
+ *
+ * Each node holds `num_words` 64-bit words, and bit `j` of word `k` is the
+ * value of the node in trace `64 * k + j`, such that `64 * num_words`
+ * independent traces are simulated at once.  In each cycle, the register
+ * outputs take the values of the register inputs in the previous cycle (or
+ * their initial values after `reset`), the primary inputs are assigned, and
+ * the combinational logic is evaluated in topological order with word-level
+ * loops, which compilers vectorize.  AND, XOR, MAJ, and XOR3 gates are
+ * evaluated directly; other gates fall back to `compute`.
+ *
+ * The initial state of a register is taken from its `register_t`: `init`
+ * values 0 and 1 set all traces, other values (don't care or unknown)
+ * start in a random state per trace.  Input values are given by a function
+ * `fn( cycle, pi_index, word )` returning one word, or are random.
+ *
+ * Values of the current and of the previous cycle are kept, hence
+ * observers can read both and toggles can be counted per node.  The traces
+ * are split into blocks of words: `run` simulates the blocks independently,
+ * in parallel if `num_threads` is larger than 1.  Random values only depend
+ * on the seed, the cycle, and the word, so the results are the same for any
+ * number of threads.
+ *
+   \verbatim embed:rst
+
+   Example
+
+   .. code-block:: c++
+
+      sequential<aig_network> aig = ...;
+
+      sequential_simulation_params ps;
+      ps.num_words = 16u;
+      ps.count_toggles = true;
+      sequential_simulator sim( aig, ps );
+
+      // 1024 random traces of 1000 cycles
+      sim.run( 1000u, [&]( uint32_t cycle, auto const& block ) {
+        if ( block.po_value( 0, 0 ) != 0u )
+          std::cout << "output 0 is 1 in cycle " << cycle << " of some trace\n";
+      } );
+
+      auto const activities = sim.switching_activities();
+   \endverbatim
+ *
+ * **Required network functions:**
+ * - `size`
+ * - `get_node`
+ * - `node_to_index`
+ * - `is_complemented`
+ * - `foreach_pi`
+ * - `foreach_po`
+ * - `foreach_ro`
+ * - `foreach_ri`
+ * - `foreach_gate`
+ * - `foreach_fanin`
+ * - `fanin_size`
+ * - `num_pis`
+ * - `index_to_node`
+ * - `num_registers`
+ * - `register_at`
+ * - `compute` (for gates that are not AND, XOR, MAJ, or XOR3)
+ */
+template<class Ntk>
+class sequential_simulator
+{
+public:
+  using node = typename Ntk::node;
+  using signal = typename Ntk::signal;
+
+private:
+  enum class gate_kind : uint8_t
+  {
+    and2,
+    xor2,
+    maj3,
+    xor3,
+    generic
+  };
+
+  struct gate_entry
+  {
+    gate_kind kind;
+    uint32_t index;
+    uint32_t first_fanin;
+    uint32_t num_fanins;
+  };
+
+  struct block_state
+  {
+    uint32_t first_word;
+    uint32_t num_words;
+    std::vector<uint64_t> values[2];
+    std::vector<uint64_t> toggles;
+  };
+
+public:
+  /*! \brief Read access to the values of a block of traces.
+   *
+   * Word `w` refers to word `first_word() + w` of the simulator.
+   */
+  class block_view
+  {
+  public:
+    uint32_t first_word() const { return block.first_word; }
+    uint32_t num_words() const { return block.num_words; }
+
+    /*! \brief Value of a signal in the current cycle. */
+    uint64_t value( signal const& f, uint32_t w ) const
+    {
+      return sim.word( block.values[cur], f, w, block.num_words );
+    }
+
+    /*! \brief Value of a signal in the previous cycle. */
+    uint64_t previous_value( signal const& f, uint32_t w ) const
+    {
+      return sim.word( block.values[cur ^ 1u], f, w, block.num_words );
+    }
+
+    /*! \brief Value of a primary output in the current cycle. */
+    uint64_t po_value( uint32_t index, uint32_t w ) const
+    {
+      return value( sim.pos[index], w );
+    }
+
+    /*! \brief Value of a register input, i.e., the next state. */
+    uint64_t ri_value( uint32_t index, uint32_t w ) const
+    {
+      return value( sim.ris[index], w );
+    }
+
+  private:
+    block_view( sequential_simulator const& sim, block_state const& block, uint32_t cur )
+        : sim( sim ), block( block ), cur( cur )
+    {
+    }
+
+    sequential_simulator const& sim;
+    block_state const& block;
+    uint32_t cur;
+
+    friend class sequential_simulator;
+  };
+
+public:
+  explicit sequential_simulator( Ntk const& ntk, sequential_simulation_params const& ps = {} )
+      : ntk( ntk ), ps( ps )
+  {
+    static_assert( is_network_type_v<Ntk>, "Ntk is not a network type" );
+    static_assert( has_size_v<Ntk>, "Ntk does not implement the size method" );
+    static_assert( has_get_node_v<Ntk>, "Ntk does not implement the get_node method" );
+    static_assert( has_node_to_index_v<Ntk>, "Ntk does not implement the node_to_index method" );
+    static_assert( has_is_complemented_v<Ntk>, "Ntk does not implement the is_complemented method" );
+    static_assert( has_foreach_pi_v<Ntk>, "Ntk does not implement the foreach_pi method" );
+    static_assert( has_foreach_po_v<Ntk>, "Ntk does not implement the foreach_po method" );
+    static_assert( has_foreach_ro_v<Ntk>, "Ntk does not implement the foreach_ro method" );
+    static_assert( has_foreach_ri_v<Ntk>, "Ntk does not implement the foreach_ri method" );
+    static_assert( has_foreach_gate_v<Ntk>, "Ntk does not implement the foreach_gate method" );
+    static_assert( has_foreach_fanin_v<Ntk>, "Ntk does not implement the foreach_fanin method" );
+    static_assert( has_fanin_size_v<Ntk>, "Ntk does not implement the fanin_size method" );
+    static_assert( has_num_registers_v<Ntk>, "Ntk does not implement the num_registers method" );
+    static_assert( has_index_to_node_v<Ntk>, "Ntk does not implement the index_to_node method" );
+    assert( ps.num_words > 0u );
+
+    ntk.foreach_pi( [&]( auto const& n ) {
+      pis.emplace_back( static_cast<uint32_t>( ntk.node_to_index( n ) ) );
+    } );
+    ntk.foreach_ro( [&]( auto const& n ) {
+      ros.emplace_back( static_cast<uint32_t>( ntk.node_to_index( n ) ) );
+    } );
+    ntk.foreach_po( [&]( auto const& f ) {
+      pos.emplace_back( f );
+    } );
+    ntk.foreach_ri( [&]( auto const& f ) {
+      ris.emplace_back( f );
+    } );
+    ntk.foreach_gate( [&]( auto const& n ) {
+      gate_entry g;
+      g.kind = gate_kind_of( n );
+      g.index = static_cast<uint32_t>( ntk.node_to_index( n ) );
+      g.first_fanin = static_cast<uint32_t>( fanins.size() );
+      g.num_fanins = 0u;
+      ntk.foreach_fanin( n, [&]( auto const& f ) {
+        fanins.emplace_back( literal( f ) );
+        ++g.num_fanins;
+      } );
+      gates.emplace_back( g );
+    } );
+
+    uint32_t num_threads = ps.num_threads == 0u ? std::max( 1u, std::thread::hardware_concurrency() ) : ps.num_threads;
+    uint32_t const num_blocks = std::min( num_threads, ps.num_words );
+    for ( auto b = 0u; b < num_blocks; ++b )
+    {
+      auto& block = blocks.emplace_back();
+      block.first_word = static_cast<uint32_t>( uint64_t( ps.num_words ) * b / num_blocks );
+      block.num_words = static_cast<uint32_t>( uint64_t( ps.num_words ) * ( b + 1u ) / num_blocks ) - block.first_word;
+    }
+    st.num_traces = 64u * ps.num_words;
+    st.num_blocks = num_blocks;
+
+    reset();
+  }
+
+  /*! \brief Sets the registers to their initial values and clears the toggle counts. */
+  void reset()
+  {
+    current = 0u;
+    st.num_cycles = 0u;
+    for ( auto& block : blocks )
+    {
+      for ( auto& values : block.values )
+      {
+        values.assign( static_cast<std::size_t>( ntk.size() ) * block.num_words, 0u );
+      }
+      block.toggles.assign( ps.count_toggles ? ntk.size() : 0u, 0u );
+
+      for ( auto r = 0u; r < ros.size(); ++r )
+      {
+        auto const init = ntk.register_at( r ).init;
+        for ( auto w = 0u; w < block.num_words; ++w )
+        {
+          uint64_t word = 0u;
+          if ( init == 1u )
+          {
+            word = ~uint64_t( 0 );
+          }
+          else if ( init != 0u && ps.random_unknown_init )
+          {
+            word = detail::trace_random_word( ps.seed, ~uint64_t( 0 ), r, block.first_word + w );
+          }
+          initial_state( block, r, w ) = word;
+        }
+      }
+    }
+  }
+
+  /*! \brief Number of independent traces. */
+  uint32_t num_traces() const
+  {
+    return 64u * ps.num_words;
+  }
+
+  /*! \brief Simulates one cycle with random input values. */
+  void step()
+  {
+    step( random_inputs() );
+  }
+
+  /*! \brief Simulates one cycle.
+   *
+   * The input values are given by `fn( cycle, pi_index, word )`, which
+   * returns the value of the primary input in the traces of `word`.
+   */
+  template<class InputFn>
+  void step( InputFn&& fn )
+  {
+    stopwatch t( st.time_total );
+    for ( auto& block : blocks )
+    {
+      simulate_cycle( block, st.num_cycles, fn, current );
+    }
+    ++st.num_cycles;
+    current ^= 1u;
+  }
+
+  /*! \brief Simulates several cycles with random input values.
+   *
+   * After each cycle, `observer( cycle, block )` is called for each block
+   * of traces with a `block_view`.  If several threads are used, the
+   * observer is called concurrently for different blocks.
+   */
+  template<class Observer>
+  void run( uint32_t num_cycles, Observer&& observer )
+  {
+    run( num_cycles, random_inputs(), observer );
+  }
+
+  /*! \brief Simulates several cycles.
+   *
+   * The input values are given by `fn( cycle, pi_index, word )`, which may
+   * be called concurrently for different words.
+   */
+  template<class InputFn, class Observer>
+  void run( uint32_t num_cycles, InputFn&& fn, Observer&& observer )
+  {
+    stopwatch t( st.time_total );
+    if ( num_cycles == 0u )
+    {
+      return;
+    }
+
+    auto const first_cycle = st.num_cycles;
+    auto const simulate_block = [&]( block_state& block ) {
+      auto cur = current;
+      for ( auto c = 0u; c < num_cycles; ++c )
+      {
+        simulate_cycle( block, first_cycle + c, fn, cur );
+        observer( static_cast<uint32_t>( first_cycle + c ), block_view( *this, block, cur ) );
+        cur ^= 1u;
+      }
+    };
+
+    if ( blocks.size() == 1u )
+    {
+      simulate_block( blocks.front() );
+    }
+    else
+    {
+      std::vector<std::thread> threads;
+      for ( auto& block : blocks )
+      {
+        threads.emplace_back( simulate_block, std::ref( block ) );
+      }
+      for ( auto& thread : threads )
+      {
+        thread.join();
+      }
+    }
+
+    st.num_cycles += num_cycles;
+    current ^= num_cycles & 1u;
+  }
+
+  /*! \brief Value of a signal in the current cycle for the traces of `word`. */
+  uint64_t value( signal const& f, uint32_t word ) const
+  {
+    auto const& block = block_of( word );
+    return this->word( block.values[current ^ 1u], f, word - block.first_word, block.num_words );
+  }
+
+  /*! \brief Value of a primary output in the current cycle. */
+  uint64_t po_value( uint32_t index, uint32_t word ) const
+  {
+    return value( pos[index], word );
+  }
+
+  /*! \brief Value of a register input, i.e., the next state. */
+  uint64_t ri_value( uint32_t index, uint32_t word ) const
+  {
+    return value( ris[index], word );
+  }
+
+  /*! \brief Value of a signal in the current cycle over all traces. */
+  kitty::partial_truth_table signature( signal const& f ) const
+  {
+    kitty::partial_truth_table tt( num_traces() );
+    for ( auto w = 0u; w < ps.num_words; ++w )
+    {
+      tt._bits[w] = value( f, w );
+    }
+    return tt;
+  }
+
+  /*! \brief Number of value changes of each node over all traces, indexed by node index.
+   *
+   * Requires `count_toggles`.
+   */
+  std::vector<uint64_t> toggles() const
+  {
+    std::vector<uint64_t> sum( ps.count_toggles ? ntk.size() : 0u, 0u );
+    for ( auto const& block : blocks )
+    {
+      for ( auto i = 0u; i < block.toggles.size(); ++i )
+      {
+        sum[i] += block.toggles[i];
+      }
+    }
+    return sum;
+  }
+
+  /*! \brief Average number of value changes per cycle of each node, indexed by node index.
+   *
+   * The result can be passed as `switching_activities` to the mappers.
+   * Requires `count_toggles`.
+   */
+  std::vector<float> switching_activities() const
+  {
+    auto const sum = toggles();
+    std::vector<float> activities( sum.size(), 0.0f );
+    if ( st.num_cycles < 2u )
+    {
+      return activities;
+    }
+
+    double const transitions = static_cast<double>( st.num_cycles - 1u ) * num_traces();
+    for ( auto i = 0u; i < sum.size(); ++i )
+    {
+      activities[i] = static_cast<float>( sum[i] / transitions );
+    }
+    return activities;
+  }
+
+  /*! \brief Returns the statistics. */
+  sequential_simulation_stats const& stats() const
+  {
+    return st;
+  }
+
+private:
+  uint32_t literal( signal const& f ) const
+  {
+    return ( static_cast<uint32_t>( ntk.node_to_index( ntk.get_node( f ) ) ) << 1 ) | ( ntk.is_complemented( f ) ? 1u : 0u );
+  }
+
+  gate_kind gate_kind_of( node const& n ) const
+  {
+    if constexpr ( has_is_and_v<Ntk> )
+    {
+      if ( ntk.is_and( n ) && ntk.fanin_size( n ) == 2u )
+      {
+        return gate_kind::and2;
+      }
+    }
+    if constexpr ( has_is_xor_v<Ntk> )
+    {
+      if ( ntk.is_xor( n ) && ntk.fanin_size( n ) == 2u )
+      {
+        return gate_kind::xor2;
+      }
+    }
+    if constexpr ( has_is_maj_v<Ntk> )
+    {
+      if ( ntk.is_maj( n ) && ntk.fanin_size( n ) == 3u )
+      {
+        return gate_kind::maj3;
+      }
+    }
+    if constexpr ( has_is_xor3_v<Ntk> )
+    {
+      if ( ntk.is_xor3( n ) && ntk.fanin_size( n ) == 3u )
+      {
+        return gate_kind::xor3;
+      }
+    }
+    return gate_kind::generic;
+  }
+
+  auto random_inputs() const
+  {
+    return [seed = ps.seed]( uint64_t cycle, uint32_t pi_index, uint32_t word ) {
+      return detail::trace_random_word( seed, cycle, pi_index, word );
+    };
+  }
+
+  uint64_t word( std::vector<uint64_t> const& values, signal const& f, uint32_t w, uint32_t num_words ) const
+  {
+    auto const lit = literal( f );
+    auto const v = values[static_cast<std::size_t>( lit >> 1 ) * num_words + w];
+    return ( lit & 1u ) ? ~v : v;
+  }
+
+  /* the initial state is stored in the register output slots of the
+   * previous cycle, from where the first cycle copies it */
+  uint64_t& initial_state( block_state& block, uint32_t r, uint32_t w )
+  {
+    return block.values[1][static_cast<std::size_t>( ros[r] ) * block.num_words + w];
+  }
+
+  block_state const& block_of( uint32_t word ) const
+  {
+    assert( word < ps.num_words );
+    auto it = std::upper_bound( blocks.begin(), blocks.end(), word, []( uint32_t w, block_state const& b ) { return w < b.first_word; } );
+    return *( it - 1 );
+  }
+
+  /* computes the values of cycle `cycle` into `block.values[cur]` from the values of the previous cycle */
+  template<class InputFn>
+  void simulate_cycle( block_state& block, uint64_t cycle, InputFn&& fn, uint32_t cur )
+  {
+    auto const nw = block.num_words;
+    auto* values = block.values[cur].data();
+    auto const* prev = block.values[cur ^ 1u].data();
+    auto const slot = [&]( uint32_t index ) { return values + static_cast<std::size_t>( index ) * nw; };
+
+    /* constant node */
+    std::fill( values, values + nw, uint64_t( 0 ) );
+
+    /* registers take the values of their inputs in the previous cycle */
+    if ( cycle == 0u )
+    {
+      for ( auto r = 0u; r < ros.size(); ++r )
+      {
+        std::copy( prev + static_cast<std::size_t>( ros[r] ) * nw, prev + static_cast<std::size_t>( ros[r] + 1u ) * nw, slot( ros[r] ) );
+      }
+    }
+    else
+    {
+      for ( auto r = 0u; r < ros.size(); ++r )
+      {
+        auto const lit = literal( ris[r] );
+        auto const* src = prev + static_cast<std::size_t>( lit >> 1 ) * nw;
+        auto const mask = ( lit & 1u ) ? ~uint64_t( 0 ) : uint64_t( 0 );
+        auto* dst = slot( ros[r] );
+        for ( auto k = 0u; k < nw; ++k )
+        {
+          dst[k] = src[k] ^ mask;
+        }
+      }
+    }
+
+    for ( auto i = 0u; i < pis.size(); ++i )
+    {
+      auto* dst = slot( pis[i] );
+      for ( auto k = 0u; k < nw; ++k )
+      {
+        dst[k] = fn( cycle, i, block.first_word + k );
+      }
+    }
+
+    for ( auto const& gate : gates )
+    {
+      auto* value = slot( gate.index );
+      auto const operand = [&]( uint32_t i ) { return values + static_cast<std::size_t>( fanins[gate.first_fanin + i] >> 1 ) * nw; };
+      auto const mask = [&]( uint32_t i ) { return ( fanins[gate.first_fanin + i] & 1u ) ? ~uint64_t( 0 ) : uint64_t( 0 ); };
+
+      switch ( gate.kind )
+      {
+      case gate_kind::and2:
+      {
+        auto const *a = operand( 0 ), *b = operand( 1 );
+        auto const ma = mask( 0 ), mb = mask( 1 );
+        for ( auto k = 0u; k < nw; ++k )
+        {
+          value[k] = ( a[k] ^ ma ) & ( b[k] ^ mb );
+        }
+      }
+      break;
+      case gate_kind::xor2:
+      {
+        auto const *a = operand( 0 ), *b = operand( 1 );
+        auto const m = mask( 0 ) ^ mask( 1 );
+        for ( auto k = 0u; k < nw; ++k )
+        {
+          value[k] = a[k] ^ b[k] ^ m;
+        }
+      }
+      break;
+      case gate_kind::maj3:
+      {
+        auto const *a = operand( 0 ), *b = operand( 1 ), *c = operand( 2 );
+        auto const ma = mask( 0 ), mb = mask( 1 ), mc = mask( 2 );
+        for ( auto k = 0u; k < nw; ++k )
+        {
+          auto const x = a[k] ^ ma, y = b[k] ^ mb, z = c[k] ^ mc;
+          value[k] = ( x & y ) | ( x & z ) | ( y & z );
+        }
+      }
+      break;
+      case gate_kind::xor3:
+      {
+        auto const *a = operand( 0 ), *b = operand( 1 ), *c = operand( 2 );
+        auto const m = mask( 0 ) ^ mask( 1 ) ^ mask( 2 );
+        for ( auto k = 0u; k < nw; ++k )
+        {
+          value[k] = a[k] ^ b[k] ^ c[k] ^ m;
+        }
+      }
+      break;
+      case gate_kind::generic:
+        simulate_generic( gate, values, nw, value );
+        break;
+      }
+    }
+
+    if ( ps.count_toggles && cycle > 0u )
+    {
+      for ( auto i = 0u; i < block.toggles.size(); ++i )
+      {
+        auto const* a = values + static_cast<std::size_t>( i ) * nw;
+        auto const* b = prev + static_cast<std::size_t>( i ) * nw;
+        uint64_t count{ 0u };
+        for ( auto k = 0u; k < nw; ++k )
+        {
+          count += __builtin_popcountll( a[k] ^ b[k] );
+        }
+        block.toggles[i] += count;
+      }
+    }
+  }
+
+  void simulate_generic( gate_entry const& gate, uint64_t const* values, uint32_t nw, uint64_t* value ) const
+  {
+    if constexpr ( has_compute_v<Ntk, kitty::partial_truth_table> )
+    {
+      std::vector<kitty::partial_truth_table> fanin_values( gate.num_fanins, kitty::partial_truth_table( 64u * nw ) );
+      for ( auto i = 0u; i < gate.num_fanins; ++i )
+      {
+        auto const lit = fanins[gate.first_fanin + i];
+        auto const* fv = values + static_cast<std::size_t>( lit >> 1 ) * nw;
+        auto const mask = ( lit & 1u ) ? ~uint64_t( 0 ) : uint64_t( 0 );
+        std::transform( fv, fv + nw, fanin_values[i]._bits.begin(), [&]( auto word ) { return word ^ mask; } );
+      }
+      auto const tt = ntk.compute( ntk.index_to_node( gate.index ), fanin_values.begin(), fanin_values.end() );
+      std::copy( tt.cbegin(), tt.cend(), value );
+    }
+    else
+    {
+      (void)gate;
+      (void)values;
+      (void)nw;
+      (void)value;
+      assert( false && "network does not implement the compute method" );
+    }
+  }
+
+private:
+  Ntk const& ntk;
+  sequential_simulation_params const ps;
+  sequential_simulation_stats st;
+
+  std::vector<uint32_t> pis;
+  std::vector<uint32_t> ros;
+  std::vector<signal> pos;
+  std::vector<signal> ris;
+  std::vector<gate_entry> gates;
+  std::vector<uint32_t> fanins; /* index << 1 | complement */
+
+  std::vector<block_state> blocks;
+  uint32_t current{ 0u }; /* buffer written in the next cycle, the other one holds the current cycle */
+};
+
+} /* namespace mockturtle */
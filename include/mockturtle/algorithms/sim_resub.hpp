@@ -368,15 +368,15 @@ void sim_resubstitution_run( Ntk& ntk, resubstitution_params const& ps, resubsti
 template<class Ntk>
 void sim_resubstitution( Ntk& ntk, resubstitution_params const& ps = {}, resubstitution_stats* pst = nullptr )
 {
-  static_assert( std::is_same_v<typename Ntk::base_type, aig_network> 
-                 || std::is_same_v<typename Ntk::base_type, xag_network>
-                 || std::is_same_v<typename Ntk::base_type, mig_network>, "Currently only supports AIG, XAG, and MIG" );
+  static_assert( is_aig_network_type_v<typename Ntk::base_type>
+                 || is_xag_network_type_v<typename Ntk::base_type>
+                 || is_mig_network_type_v<typename Ntk::base_type>, "Currently only supports AIG, XAG, and MIG" );
 
   using resub_view_t = fanout_view<depth_view<Ntk>>;
   depth_view<Ntk> depth_view{ ntk };
   resub_view_t resub_view{ depth_view };
 
-  if constexpr ( std::is_same_v<typename Ntk::base_type, aig_network> )
+  if constexpr ( is_aig_network_type_v<typename Ntk::base_type> )
   {
     using resyn_engine_t = xag_resyn_decompose<kitty::partial_truth_table, aig_resyn_static_params_for_sim_resub<resub_view_t>>;
 
@@ -393,7 +393,7 @@ void sim_resubstitution( Ntk& ntk, resubstitution_params const& ps = {}, resubst
       detail::sim_resubstitution_run<resub_view_t, resub_impl_t>( resub_view, ps, pst );
     }
   }
-  else if constexpr ( std::is_same_v<typename Ntk::base_type, xag_network> )
+  else if constexpr ( is_xag_network_type_v<typename Ntk::base_type> )
   {
     using resyn_engine_t = xag_resyn_decompose<kitty::partial_truth_table, xag_resyn_static_params_for_sim_resub<resub_view_t>>;
 
@@ -410,7 +410,7 @@ void sim_resubstitution( Ntk& ntk, resubstitution_params const& ps = {}, resubst
       detail::sim_resubstitution_run<resub_view_t, resub_impl_t>( resub_view, ps, pst );
     }
   }
-  else if constexpr ( std::is_same_v<typename Ntk::base_type, mig_network> )
+  else if constexpr ( is_mig_network_type_v<typename Ntk::base_type> )
   {
     using resyn_engine_t = mig_resyn_topdown<kitty::partial_truth_table, mig_resyn_static_params>;
 
@@ -0,0 +1,466 @@
+/* mockturtle: C++ logic network library
+ * Copyright (C) 2018-2022  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*!
+  \file switching_activity.hpp
+  \brief Switching activity estimation by toggle counting
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <bitset>
+#include <cassert>
+#include <cstdint>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../traits.hpp"
+#include "../utils/stopwatch.hpp"
+#include "simulation.hpp"
+
+#include <fmt/format.h>
+#include <kitty/bit_operations.hpp>
+#include <kitty/constructors.hpp>
+#include <kitty/partial_truth_table.hpp>
+
+namespace mockturtle
+{
+
+/*! \brief Parameters for switching activity estimation.
+ *
+ * The data structure `switching_activity_params` holds configurable
+ * parameters with default arguments for `switching_activity_engine` and
+ * `compute_switching_activity`.
+ */
+struct switching_activity_params
+{
+  /*! \brief Number of simulated clock cycles (ignored for input traces). */
+  uint32_t num_cycles{ 2048u };
+
+  /*! \brief Probability of each primary input to be 1 (default 0.5). */
+  std::vector<double> input_probabilities{};
+
+  /*! \brief Probability of each primary input to toggle between two
+   * consecutive cycles (default `2p(1-p)`, i.e., no temporal correlation).
+   */
+  std::vector<double> input_toggle_rates{};
+
+  /*! \brief Seed for the random input sequences. */
+  uint32_t seed{ 1u };
+
+  /*! \brief Number of threads simulating blocks of cycles (0 uses all cores). */
+  uint32_t num_threads{ 1u };
+
+  /*! \brief Be verbose. */
+  bool verbose{ false };
+};
+
+/*! \brief Statistics for switching activity estimation. */
+struct switching_activity_stats
+{
+  /*! \brief Total runtime. */
+  stopwatch<>::duration time_total{ 0 };
+
+  /*! \brief Runtime for simulation. */
+  stopwatch<>::duration time_simulation{ 0 };
+
+  /*! \brief Number of simulated cycles. */
+  uint32_t num_cycles{ 0 };
+
+  /*! \brief Number of blocks of cycles simulated independently. */
+  uint32_t num_blocks{ 0 };
+
+  /*! \brief Number of times the activities have been computed. */
+  uint32_t num_updates{ 0 };
+
+  void report() const
+  {
+    std::cout << fmt::format( "[i] cycles     = {:>8} in {} blocks\n", num_cycles, num_blocks );
+    std::cout << fmt::format( "[i] updates    = {:>8}\n", num_updates );
+    std::cout << fmt::format( "[i] simulation = {:>5.2f} secs\n", to_seconds( time_simulation ) );
+    std::cout << fmt::format( "[i] total time = {:>5.2f} secs\n", to_seconds( time_total ) );
+  }
+};
+
+namespace detail
+{
+
+/* number of value changes between consecutive bits of `tt` */
+inline uint64_t count_toggles( kitty::partial_truth_table const& tt )
+{
+  if ( tt.num_bits() < 2u )
+  {
+    return 0u;
+  }
+
+  uint64_t const num_transitions = tt.num_bits() - 1u;
+  uint64_t toggles{ 0u };
+  for ( auto k = 0u; uint64_t( k ) << 6 < num_transitions; ++k )
+  {
+    uint64_t const word = tt._bits[k];
+    uint64_t const next = k + 1u < tt._bits.size() ? tt._bits[k + 1u] : 0u;
+    uint64_t changes = word ^ ( ( word >> 1 ) | ( next << 63 ) );
+
+    uint64_t const remaining = num_transitions - ( uint64_t( k ) << 6 );
+    if ( remaining < 64u )
+    {
+      changes &= ( uint64_t( 1 ) << remaining ) - 1u;
+    }
+    toggles += std::bitset<64>( changes ).count();
+  }
+  return toggles;
+}
+
+/* copies `length` bits starting at the word-aligned position `first` */
+inline kitty::partial_truth_table slice_cycles( kitty::partial_truth_table const& tt, uint32_t first, uint32_t length )
+{
+  assert( ( first & 63u ) == 0u );
+
+  kitty::partial_truth_table block( length );
+  std::copy_n( tt._bits.begin() + ( first >> 6 ), block.num_blocks(), block._bits.begin() );
+  block.mask_bits();
+  return block;
+}
+
+} /* namespace detail */
+
+/*! \brief Switching activity engine.
+ *
+ * Estimates the switching activity of each node, i.e., the probability
+ * that its value changes between two consecutive clock cycles.  The
+ * network is simulated on a sequence of input vectors, where bit `t` of a
+ * simulation signature is the value in cycle `t`, and the changes between
+ * consecutive bits are counted.  Hence, spatial correlations due to
+ * reconvergence and temporal correlations of the inputs are taken into
+ * account, which is not the case for the estimation `2p(1-p)` from signal
+ * probabilities.
+ *
+ * The input sequence is either generated randomly from the input
+ * statistics in `switching_activity_params`, or given as a trace with
+ * `set_input_trace` or `read_input_trace`.  The cycles are split into
+ * blocks that are simulated in parallel.
+ *
+ * The activities are cached, and only recomputed when the network has
+ * changed its size or after `invalidate` is called, so that the same
+ * engine can serve several mapping runs.
+ *
+   \verbatim embed:rst
+
+   Example
+
+   .. code-block:: c++
+
+      switching_activity_params ps;
+      ps.input_probabilities = std::vector<double>( aig.num_pis(), 0.2 );
+      switching_activity_engine engine( aig, ps );
+
+      emap_params mps;
+      mps.eswp_rounds = 2;
+      mps.switching_activities = engine.activities();
+      auto const res = emap_klut( aig, lib, mps );
+   \endverbatim
+ *
+ * **Required network functions:**
+ * - `size`
+ * - `num_pis`
+ * - `foreach_node`
+ * - `node_to_index`
+ * - `get_constant`
+ * - `constant_value`
+ * - `get_node`
+ * - `foreach_pi`
+ * - `foreach_gate`
+ * - `fanin_size`
+ * - `num_pos`
+ * - `compute<kitty::partial_truth_table>`
+ */
+template<class Ntk>
+class switching_activity_engine
+{
+public:
+  using node = typename Ntk::node;
+
+public:
+  explicit switching_activity_engine( Ntk const& ntk, switching_activity_params const& ps = {} )
+      : ntk( ntk ), ps( ps )
+  {
+    static_assert( is_network_type_v<Ntk>, "Ntk is not a network type" );
+    static_assert( has_size_v<Ntk>, "Ntk does not implement the size method" );
+    static_assert( has_num_pis_v<Ntk>, "Ntk does not implement the num_pis method" );
+    static_assert( has_foreach_node_v<Ntk>, "Ntk does not implement the foreach_node method" );
+    static_assert( has_node_to_index_v<Ntk>, "Ntk does not implement the node_to_index method" );
+    static_assert( has_foreach_pi_v<Ntk>, "Ntk does not implement the foreach_pi method" );
+    static_assert( has_foreach_gate_v<Ntk>, "Ntk does not implement the foreach_gate method" );
+    static_assert( has_compute_v<Ntk, kitty::partial_truth_table>, "Ntk does not implement the compute method for kitty::partial_truth_table" );
+  }
+
+  /*! \brief Sets the input sequence.
+   *
+   * Bit `t` of `trace[i]` is the value of the `i`-th primary input in cycle
+   * `t`.  All signatures must have the same length.
+   */
+  void set_input_trace( std::vector<kitty::partial_truth_table> const& trace )
+  {
+    assert( trace.size() == ntk.num_pis() );
+    inputs = trace;
+    has_trace = true;
+    invalidate();
+  }
+
+  /*! \brief Reads the input sequence from a file.
+   *
+   * The file has the format of simulation pattern files (see
+   * `write_patterns`): one line per primary input, containing its
+   * signature over all cycles in hexadecimal.
+   *
+   * \return false if the file cannot be read or does not match the network
+   */
+  bool read_input_trace( std::string const& filename )
+  {
+    std::ifstream in( filename, std::ifstream::in );
+    if ( !in.good() )
+    {
+      return false;
+    }
+
+    std::vector<kitty::partial_truth_table> trace;
+    std::string line;
+    while ( std::getline( in, line ) )
+    {
+      if ( line.empty() )
+        continue;
+      trace.emplace_back( static_cast<uint32_t>( line.length() * 4 ) );
+      kitty::create_from_hex_string( trace.back(), line );
+    }
+
+    if ( trace.size() != ntk.num_pis() || std::any_of( trace.begin(), trace.end(), [&]( auto const& tt ) { return tt.num_bits() != trace.front().num_bits(); } ) )
+    {
+      return false;
+    }
+    set_input_trace( trace );
+    return true;
+  }
+
+  /*! \brief Forces a recomputation at the next query. */
+  void invalidate()
+  {
+    sw_map.clear();
+  }
+
+  /*! \brief Returns the switching activity of each node, indexed by node index. */
+  std::vector<float> const& activities()
+  {
+    if ( sw_map.size() != ntk.size() )
+    {
+      compute();
+    }
+    return sw_map;
+  }
+
+  /*! \brief Returns the switching activity of a node. */
+  float activity( node const& n )
+  {
+    return activities()[ntk.node_to_index( n )];
+  }
+
+  /*! \brief Returns the statistics. */
+  switching_activity_stats const& stats() const
+  {
+    return st;
+  }
+
+private:
+  void compute()
+  {
+    stopwatch t( st.time_total );
+
+    if ( !has_trace )
+    {
+      generate_inputs();
+    }
+
+    uint32_t const num_cycles = inputs.empty() ? ps.num_cycles : inputs.front().num_bits();
+    sw_map.assign( ntk.size(), 0.0f );
+    ++st.num_updates;
+    st.num_cycles = num_cycles;
+    st.num_blocks = 0u;
+
+    if ( num_cycles < 2u || inputs.empty() )
+    {
+      return;
+    }
+
+    /* blocks start at word boundaries and overlap by one cycle to count the toggle between them */
+    uint32_t num_threads = ps.num_threads == 0u ? std::max( 1u, std::thread::hardware_concurrency() ) : ps.num_threads;
+    uint32_t const block_size = std::max( 64u, ( ( num_cycles - 1u ) / num_threads + 63u ) & ~63u );
+    uint32_t const num_blocks = ( num_cycles - 2u ) / block_size + 1u;
+    num_threads = std::min( num_threads, num_blocks );
+    st.num_blocks = num_blocks;
+
+    std::vector<std::vector<uint64_t>> toggles( num_threads, std::vector<uint64_t>( ntk.size(), 0u ) );
+    auto const simulate_blocks = [&]( uint32_t thread_id ) {
+      for ( auto b = thread_id; b < num_blocks; b += num_threads )
+      {
+        uint32_t const first = b * block_size;
+        uint32_t const length = std::min( block_size + 1u, num_cycles - first );
+
+        std::vector<kitty::partial_truth_table> patterns;
+        patterns.reserve( inputs.size() );
+        for ( auto const& tt : inputs )
+        {
+          patterns.emplace_back( detail::slice_cycles( tt, first, length ) );
+        }
+
+        partial_simulator sim( patterns );
+        auto const tts = simulate_nodes<kitty::partial_truth_table>( ntk, sim );
+        ntk.foreach_node( [&]( auto const& n ) {
+          if constexpr ( has_is_crossing_v<Ntk> )
+          {
+            if ( ntk.is_crossing( n ) )
+              return;
+          }
+          toggles[thread_id][ntk.node_to_index( n )] += detail::count_toggles( tts[n] );
+        } );
+      }
+    };
+
+    {
+      stopwatch t_sim( st.time_simulation );
+      if ( num_threads == 1u )
+      {
+        simulate_blocks( 0u );
+      }
+      else
+      {
+        std::vector<std::thread> threads;
+        for ( auto i = 0u; i < num_threads; ++i )
+        {
+          threads.emplace_back( simulate_blocks, i );
+        }
+        for ( auto& thread : threads )
+        {
+          thread.join();
+        }
+      }
+    }
+
+    for ( auto i = 0u; i < sw_map.size(); ++i )
+    {
+      uint64_t sum{ 0u };
+      for ( auto const& tgs : toggles )
+      {
+        sum += tgs[i];
+      }
+      sw_map[i] = static_cast<float>( static_cast<double>( sum ) / ( num_cycles - 1u ) );
+    }
+  }
+
+  /* random input sequences following a two-state Markov chain per input */
+  void generate_inputs()
+  {
+    inputs.clear();
+    if ( ps.num_cycles == 0u )
+    {
+      return;
+    }
+
+    for ( auto i = 0u; i < ntk.num_pis(); ++i )
+    {
+      inputs.emplace_back( ps.num_cycles );
+      auto& tt = inputs.back();
+
+      double const p = i < ps.input_probabilities.size() ? ps.input_probabilities[i] : 0.5;
+      double const a = i < ps.input_toggle_rates.size() ? ps.input_toggle_rates[i] : 2.0 * p * ( 1.0 - p );
+
+      /* uncorrelated uniform inputs are random words */
+      if ( p == 0.5 && a == 0.5 )
+      {
+        kitty::create_random( tt, ps.seed + i );
+        tt.mask_bits();
+        continue;
+      }
+
+      /* transition probabilities keeping the stationary probability `p` */
+      double const rise = p < 1.0 ? std::min( 1.0, a / ( 2.0 * ( 1.0 - p ) ) ) : 0.0;
+      double const fall = p > 0.0 ? std::min( 1.0, a / ( 2.0 * p ) ) : 0.0;
+
+      std::default_random_engine gen( ps.seed + i );
+      std::uniform_real_distribution<double> dist( 0.0, 1.0 );
+      bool value = dist( gen ) < p;
+      for ( auto t = 0u; t < ps.num_cycles; ++t )
+      {
+        if ( value )
+        {
+          kitty::set_bit( tt, t );
+        }
+        value = value ? dist( gen ) >= fall : dist( gen ) < rise;
+      }
+    }
+  }
+
+private:
+  Ntk const& ntk;
+  switching_activity_params const ps;
+  switching_activity_stats st;
+
+  std::vector<kitty::partial_truth_table> inputs;
+  bool has_trace{ false };
+  std::vector<float> sw_map;
+};
+
+/*! \brief Computes the switching activity of each node.
+ *
+ * Convenience function for a single use of `switching_activity_engine`.
+ *
+ * \param ntk Network
+ * \param ps Parameters
+ * \param pst Statistics
+ * \return Switching activity of each node, indexed by node index
+ */
+template<class Ntk>
+std::vector<float> compute_switching_activity( Ntk const& ntk, switching_activity_params const& ps = {}, switching_activity_stats* pst = nullptr )
+{
+  switching_activity_engine<Ntk> engine( ntk, ps );
+  auto sw_map = engine.activities();
+
+  if ( ps.verbose )
+  {
+    engine.stats().report();
+  }
+
+  if ( pst )
+  {
+    *pst = engine.stats();
+  }
+
+  return sw_map;
+}
+
+} /* namespace mockturtle */
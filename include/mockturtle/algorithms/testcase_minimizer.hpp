@@ -36,13 +36,19 @@
 #include "../io/write_verilog.hpp"
 #include "../networks/aig.hpp"
 #include "../utils/debugging_utils.hpp"
+#include "../utils/forked_job_pool.hpp"
 #include "../views/color_view.hpp"
 #include "cleanup.hpp"
 
+#include <algorithm>
 #include <fmt/format.h>
+#include <iterator>
 #include <lorina/lorina.hpp>
 #include <optional>
+#include <set>
+#include <thread>
 #include <utility>
+#include <vector>
 
 namespace mockturtle
 {
@@ -77,6 +83,28 @@ struct testcase_minimizer_params
 
   /*! \brief Seed of the random generator. */
   uint64_t seed{ 0xcafeaffe };
+
+  /*! \brief Number of reductions tested concurrently (0 = all hardware threads).
+   *
+   * With more than one worker, each step derives this number of reduced
+   * testcases from the current one and tests them in forked child
+   * processes.  The first of them (in the order of derivation) that still
+   * triggers the buggy behavior is kept.  Not supported on Windows.
+   */
+  uint32_t num_workers{ 1u };
+
+  /*! \brief Test every reduction in a forked child process, also with a single worker.
+   *
+   * A crash of the script then counts as observing the buggy behavior
+   * instead of terminating the minimizer.  Not supported on Windows.
+   */
+  bool isolate{ false };
+
+  /*! \brief Timeout in seconds for testing one reduction in a child process: nullopt means infinity.
+   *
+   * A reduction that times out is treated as not triggering the buggy behavior.
+   */
+  std::optional<uint64_t> candidate_timeout{ std::nullopt };
 }; /* testcase_minimizer_params */
 
 /*! \brief Debugging testcase minimizer
@@ -100,7 +128,10 @@ struct testcase_minimizer_params
  * command segfaults or an assertion fails, it is treated as observing
  * the buggy behavior.
  *
- *
+ * When `num_workers` is larger than 1 or `isolate` is set, the reductions
+ * are tested in forked child processes, several at a time.  Crashes
+ * inside the lambda function are then also treated as observing the
+ * buggy behavior, and `candidate_timeout` stops tests that hang.
  *
   \verbatim embed:rst
 
@@ -157,6 +188,15 @@ public:
       return;
     }
 
+#ifndef _MSC_VER
+    if ( ps.num_workers != 1u || ps.isolate )
+    {
+      run_isolated( [&]( Ntk const& candidate, uint32_t ) { return fn( candidate ); },
+                    [&]( Ntk const& candidate, uint32_t ) { return fn( candidate ); } );
+      return;
+    }
+#endif
+
     if ( !test( fn ) )
     {
       fmt::print( "[e] The initial test case does not trigger the buggy behavior\n" );
@@ -208,6 +248,17 @@ public:
       return;
     }
 
+    if ( ps.num_workers != 1u || ps.isolate )
+    {
+      auto const test_candidate = [&]( Ntk const& candidate, uint32_t j ) {
+        auto const filename = fmt::format( "tmp_{}", j );
+        write_network( candidate, filename );
+        return !test_inner( make_command, filename );
+      };
+      run_isolated( [&]( Ntk const&, uint32_t ) { return !test_inner( make_command, ps.init_case ); }, test_candidate );
+      return;
+    }
+
     if ( !test( make_command, ps.init_case ) )
     {
       fmt::print( "[e] The initial test case does not trigger the buggy behavior\n" );
@@ -283,20 +334,136 @@ private:
   }
 
   void write_testcase( std::string const& filename )
+  {
+    write_network( ntk, filename );
+  }
+
+  void write_network( Ntk const& candidate, std::string const& filename )
   {
     switch ( ps.file_format )
     {
     case testcase_minimizer_params::verilog:
-      write_verilog( ntk, ps.path + "/" + filename + file_extension );
+      write_verilog( candidate, ps.path + "/" + filename + file_extension );
       break;
     case testcase_minimizer_params::aiger:
-      write_aiger( ntk, ps.path + "/" + filename + file_extension );
+      write_aiger( candidate, ps.path + "/" + filename + file_extension );
       break;
     default:
       fmt::print( "[e] Unsupported format\n" );
     }
   }
 
+#ifndef _MSC_VER
+  /* `test_initial` and `test_candidate` return true if the script runs normally on the network */
+  void run_isolated( std::function<bool( Ntk const&, uint32_t )> const& test_initial, std::function<bool( Ntk const&, uint32_t )> const& test_candidate )
+  {
+    uint32_t const num_workers = ps.num_workers == 0u ? std::max( 1u, std::thread::hardware_concurrency() ) : ps.num_workers;
+    forked_job_pool pool( num_workers, ps.candidate_timeout );
+
+    auto const initial = test_candidates( pool, { ntk }, test_initial ).front();
+    if ( initial == forked_job_outcome::error )
+    {
+      fmt::print( "[e] Could not test the initial test case in a child process\n" );
+      return;
+    }
+    if ( !triggers( initial ) )
+    {
+      fmt::print( "[e] The initial test case does not trigger the buggy behavior\n" );
+      return;
+    }
+
+    uint32_t counter{ 0 };
+    bool done{ false };
+    while ( !done && ( !ps.num_iterations || counter < ps.num_iterations ) )
+    {
+      /* derive reductions from the same testcase; `sampled` makes them pick different parts.  Each
+       * reduction counts as a failed attempt of its stage, unless one of them triggers the bug */
+      Ntk const base = cleanup_dangling( ntk );
+      std::vector<Ntk> candidates;
+      while ( candidates.size() < num_workers && ( !ps.num_iterations || counter < ps.num_iterations ) )
+      {
+        ++counter;
+        ntk = cleanup_dangling( base );
+        if ( !reduce() )
+        {
+          done = true;
+          break;
+        }
+        ++stage_counter;
+        if ( ntk.num_gates() == 0 )
+        {
+          continue;
+        }
+        candidates.emplace_back( ntk );
+      }
+      ntk = base;
+
+      auto const outcomes = test_candidates( pool, candidates, test_candidate );
+      auto const it = std::find_if( outcomes.begin(), outcomes.end(), [&]( auto outcome ) { return outcome == forked_job_outcome::error || triggers( outcome ); } );
+      if ( it != outcomes.end() && *it == forked_job_outcome::error )
+      {
+        fmt::print( "[e] Could not test the reductions in child processes\n" );
+        break;
+      }
+      if ( it != outcomes.end() )
+      {
+        ntk = candidates[std::distance( outcomes.begin(), it )];
+        fmt::print( "[i] Testcase with I/O = {}/{} gates = {} triggers the buggy behavior\n", ntk.num_pis(), ntk.num_pos(), ntk.num_gates() );
+        write_testcase( ps.minimized_case );
+        stage_counter = 0;
+        sampled.clear();
+      }
+    }
+    if ( done )
+    {
+      write_testcase( ps.minimized_case );
+    }
+
+    if ( init_PIs != ntk.num_pis() || init_POs != ntk.num_pos() || init_gates != ntk.num_gates() )
+    {
+      fmt::print( "[i] Minimized the testcase from I/O = {}/{} gates = {}\n", init_PIs, init_POs, init_gates );
+      fmt::print( "                             to I/O = {}/{} gates = {}\n", ntk.num_pis(), ntk.num_pos(), ntk.num_gates() );
+    }
+  }
+
+  /* a failing or crashing test triggers the buggy behavior */
+  static bool triggers( forked_job_outcome outcome )
+  {
+    return outcome == forked_job_outcome::failed || outcome == forked_job_outcome::crashed;
+  }
+
+  /* tests the candidates in child processes and returns their outcomes; after
+   * an error, no further candidates are started and their outcome is `error` */
+  std::vector<forked_job_outcome> test_candidates( forked_job_pool& pool, std::vector<Ntk> const& candidates, std::function<bool( Ntk const&, uint32_t )> const& test_fn )
+  {
+    std::vector<forked_job_outcome> outcomes( candidates.size(), forked_job_outcome::error );
+    uint32_t next{ 0 };
+    bool error{ false };
+    while ( ( !error && next < candidates.size() ) || pool.num_running() > 0u )
+    {
+      if ( auto const slot = pool.free_slot(); slot && !error && next < candidates.size() )
+      {
+        auto const j = next++;
+        if ( !pool.start( *slot, j, [&]() { return test_fn( candidates[j], *slot ); } ) )
+        {
+          fmt::print( "[e] Could not fork a process to test a reduction\n" );
+          error = true;
+        }
+        continue;
+      }
+
+      auto const [j, outcome] = pool.wait_any();
+      outcomes[j] = outcome;
+      error |= outcome == forked_job_outcome::error;
+      if ( ps.verbose && outcome == forked_job_outcome::timed_out )
+      {
+        fmt::print( "[i] Testing reduction {} timed out\n", j );
+      }
+    }
+    return outcomes;
+  }
+#endif
+
   bool test( std::function<bool( Ntk )> const& fn )
   {
     ntk_backup = cleanup_dangling( ntk );
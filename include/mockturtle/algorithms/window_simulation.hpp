@@ -0,0 +1,514 @@
+/* mockturtle: C++ logic network library
+ * Copyright (C) 2018-2022  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*!
+  \file window_simulation.hpp
+  \brief Batched exhaustive simulation of windows
+*/
+
+#pragma once
+
+#include "../traits.hpp"
+#include "../utils/node_map.hpp"
+
+#include <kitty/constructors.hpp>
+#include <kitty/detail/constants.hpp>
+#include <kitty/dynamic_truth_table.hpp>
+#include <kitty/static_truth_table.hpp>
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace mockturtle
+{
+
+/*! \brief Batched exhaustive simulation of windows.
+ *
+ * A window is given by a set of leaves (at most 16) and a set of root
+ * signals.  The simulator collects the gates of many windows into one flat
+ * gate list, and the simulation values of all windows into one buffer of
+ * 64-bit words, which is reused when the simulator is cleared.  Calling
+ * `run` computes the complete functions of all collected windows at once,
+ * optionally distributing the windows over several threads.
+ *
+ * Windows with at most 6 leaves use one word per value.  Larger windows use
+ * `2^(k-6)` words per value, which are processed in vectorizable loops.
+ * AND, XOR, MAJ, and XOR3 gates are evaluated directly on the words; other
+ * gates (e.g., in k-LUT networks) fall back to `compute`.
+ *
+ * The network must not be modified between `add_window` and reading the
+ * functions.
+ *
+ * **Required network functions:**
+ * - `size`
+ * - `get_node`
+ * - `node_to_index`
+ * - `is_constant`
+ * - `constant_value`
+ * - `is_ci`
+ * - `is_complemented`
+ * - `foreach_fanin`
+ * - `fanin_size`
+ * - `compute` (for gates that are not AND, XOR, MAJ, or XOR3)
+ *
+   \verbatim embed:rst
+
+   Example
+
+   .. code-block:: c++
+
+      aig_network aig = ...;
+      batched_window_simulator<aig_network> sim( aig );
+
+      std::vector<uint32_t> ids;
+      for ( auto const& [leaves, root] : windows )
+      {
+        ids.emplace_back( sim.add_window( leaves, { root } ) );
+      }
+      sim.run();
+
+      auto const tt = sim.root_function( ids[0], 0 );
+   \endverbatim
+ */
+template<class Ntk>
+class batched_window_simulator
+{
+public:
+  using node = typename Ntk::node;
+  using signal = typename Ntk::signal;
+
+  /*! \brief Maximum number of leaves of a window. */
+  static constexpr uint32_t max_num_leaves{ 16u };
+
+private:
+  enum class gate_kind : uint8_t
+  {
+    and2,
+    xor2,
+    maj3,
+    xor3,
+    generic
+  };
+
+  struct gate_entry
+  {
+    gate_kind kind;
+    uint32_t first_fanin;
+    uint32_t num_fanins;
+    node n;
+  };
+
+  struct window_entry
+  {
+    uint32_t num_leaves;
+    uint32_t num_words;
+    uint32_t first_gate;
+    uint32_t num_gates;
+    uint32_t first_root;
+    uint32_t num_roots;
+    uint64_t first_word;
+  };
+
+public:
+  explicit batched_window_simulator( Ntk const& ntk )
+      : ntk( ntk ),
+        stamps( ntk, 0u ),
+        slots( ntk )
+  {
+    static_assert( is_network_type_v<Ntk>, "Ntk is not a network type" );
+    static_assert( has_get_node_v<Ntk>, "Ntk does not implement the get_node method" );
+    static_assert( has_node_to_index_v<Ntk>, "Ntk does not implement the node_to_index method" );
+    static_assert( has_is_constant_v<Ntk>, "Ntk does not implement the is_constant method" );
+    static_assert( has_constant_value_v<Ntk>, "Ntk does not implement the constant_value method" );
+    static_assert( has_is_ci_v<Ntk>, "Ntk does not implement the is_ci method" );
+    static_assert( has_is_complemented_v<Ntk>, "Ntk does not implement the is_complemented method" );
+    static_assert( has_foreach_fanin_v<Ntk>, "Ntk does not implement the foreach_fanin method" );
+    static_assert( has_fanin_size_v<Ntk>, "Ntk does not implement the fanin_size method" );
+  }
+
+  /*! \brief Removes all windows, but keeps the allocated memory. */
+  void clear()
+  {
+    windows.clear();
+    gates.clear();
+    fanins.clear();
+    roots.clear();
+    num_words_total = 0u;
+  }
+
+  /*! \brief Number of collected windows. */
+  uint32_t num_windows() const
+  {
+    return static_cast<uint32_t>( windows.size() );
+  }
+
+  /*! \brief Adds a window.
+   *
+   * Every path from a primary input to a root must pass through a leaf.
+   *
+   * \param leaves Leaf nodes of the window, its i-th leaf is the i-th variable
+   * \param window_roots Root signals of the window
+   * \return Index of the window
+   */
+  uint32_t add_window( std::vector<node> const& leaves, std::vector<signal> const& window_roots )
+  {
+    return add_window( leaves.begin(), leaves.end(), window_roots.begin(), window_roots.end() );
+  }
+
+  /*! \brief Adds a window given by iterator ranges over leaf nodes and root signals. */
+  template<class LeavesIterator, class RootsIterator>
+  uint32_t add_window( LeavesIterator leaves_begin, LeavesIterator leaves_end, RootsIterator roots_begin, RootsIterator roots_end )
+  {
+    stamps.resize( 0u );
+    slots.resize();
+    ++window_id;
+
+    window_entry w;
+    w.num_leaves = static_cast<uint32_t>( std::distance( leaves_begin, leaves_end ) );
+    assert( w.num_leaves <= max_num_leaves );
+    w.num_words = w.num_leaves <= 6u ? 1u : ( 1u << ( w.num_leaves - 6u ) );
+    w.first_gate = static_cast<uint32_t>( gates.size() );
+    w.first_root = static_cast<uint32_t>( roots.size() );
+
+    /* slots 0 and 1 are the constants, followed by the leaves and the gates */
+    num_slots = 2u;
+    for ( auto it = leaves_begin; it != leaves_end; ++it )
+    {
+      stamps[*it] = window_id;
+      slots[*it] = num_slots++;
+    }
+    for ( auto it = roots_begin; it != roots_end; ++it )
+    {
+      roots.emplace_back( literal( *it ) );
+    }
+
+    w.num_gates = static_cast<uint32_t>( gates.size() ) - w.first_gate;
+    w.num_roots = static_cast<uint32_t>( roots.size() ) - w.first_root;
+    w.first_word = num_words_total;
+    num_words_total += static_cast<uint64_t>( num_slots ) * w.num_words;
+
+    windows.emplace_back( w );
+    return static_cast<uint32_t>( windows.size() - 1u );
+  }
+
+  /*! \brief Simulates all windows.
+   *
+   * \param num_threads Number of threads (0 uses all available cores)
+   */
+  void run( uint32_t num_threads = 1u )
+  {
+    words.resize( num_words_total );
+
+    if ( num_threads == 0u )
+    {
+      num_threads = std::max( 1u, std::thread::hardware_concurrency() );
+    }
+    num_threads = std::min<uint32_t>( num_threads, static_cast<uint32_t>( windows.size() ) );
+
+    if ( num_threads <= 1u )
+    {
+      for ( auto const& w : windows )
+      {
+        simulate_window( w );
+      }
+      return;
+    }
+
+    std::vector<std::thread> threads;
+    threads.reserve( num_threads );
+    for ( auto t = 0u; t < num_threads; ++t )
+    {
+      threads.emplace_back( [&, t]() {
+        for ( auto i = t; i < windows.size(); i += num_threads )
+        {
+          simulate_window( windows[i] );
+        }
+      } );
+    }
+    for ( auto& thread : threads )
+    {
+      thread.join();
+    }
+  }
+
+  /*! \brief Number of leaves of a window. */
+  uint32_t num_leaves( uint32_t window ) const
+  {
+    return windows[window].num_leaves;
+  }
+
+  /*! \brief Number of roots of a window. */
+  uint32_t num_roots( uint32_t window ) const
+  {
+    return windows[window].num_roots;
+  }
+
+  /*! \brief Returns the function of a root in terms of the window leaves.
+   *
+   * `TT` is either `kitty::dynamic_truth_table`, or a static truth table
+   * with as many variables as the window has leaves.
+   *
+   * \param window Index of the window
+   * \param index Index of the root within the window
+   */
+  template<class TT = kitty::dynamic_truth_table>
+  TT root_function( uint32_t window, uint32_t index ) const
+  {
+    auto const& w = windows[window];
+    assert( index < w.num_roots );
+
+    TT tt = make_tt<TT>( w.num_leaves );
+    assert( tt.num_vars() == w.num_leaves );
+    auto const lit = roots[w.first_root + index];
+    auto const* value = words.data() + w.first_word + static_cast<uint64_t>( lit >> 1 ) * w.num_words;
+    auto const mask = ( lit & 1u ) ? ~uint64_t( 0 ) : uint64_t( 0 );
+    std::transform( value, value + w.num_words, tt.begin(), [&]( auto word ) { return word ^ mask; } );
+    if ( w.num_leaves < 6u )
+    {
+      *tt.begin() &= kitty::detail::masks[w.num_leaves];
+    }
+    return tt;
+  }
+
+private:
+  template<class TT>
+  static TT make_tt( uint32_t num_vars )
+  {
+    if constexpr ( std::is_same_v<TT, kitty::dynamic_truth_table> )
+    {
+      return TT( num_vars );
+    }
+    else
+    {
+      (void)num_vars;
+      return TT();
+    }
+  }
+
+  /* slot literal of a signal, collects the gates in its TFI */
+  uint32_t literal( signal const& f )
+  {
+    auto const n = ntk.get_node( f );
+    uint32_t slot;
+    if ( ntk.is_constant( n ) )
+    {
+      slot = ntk.constant_value( n ) ? 1u : 0u;
+    }
+    else
+    {
+      slot = collect_rec( n );
+    }
+    return ( slot << 1 ) | ( ntk.is_complemented( f ) ? 1u : 0u );
+  }
+
+  uint32_t collect_rec( node const& n )
+  {
+    if ( stamps[n] == window_id )
+    {
+      return slots[n];
+    }
+    assert( !ntk.is_ci( n ) && "window leaves must separate the roots from the inputs" );
+
+    /* collect the fanins first, their literals are stored next to each other */
+    ntk.foreach_fanin( n, [&]( auto const& f ) {
+      literal( f );
+    } );
+
+    gate_entry g;
+    g.n = n;
+    g.kind = gate_kind_of( n );
+    g.first_fanin = static_cast<uint32_t>( fanins.size() );
+    g.num_fanins = 0u;
+    ntk.foreach_fanin( n, [&]( auto const& f ) {
+      fanins.emplace_back( literal( f ) );
+      ++g.num_fanins;
+    } );
+
+    stamps[n] = window_id;
+    slots[n] = num_slots++;
+    gates.emplace_back( g );
+    return slots[n];
+  }
+
+  gate_kind gate_kind_of( node const& n ) const
+  {
+    if constexpr ( has_is_and_v<Ntk> )
+    {
+      if ( ntk.is_and( n ) && ntk.fanin_size( n ) == 2u )
+      {
+        return gate_kind::and2;
+      }
+    }
+    if constexpr ( has_is_xor_v<Ntk> )
+    {
+      if ( ntk.is_xor( n ) && ntk.fanin_size( n ) == 2u )
+      {
+        return gate_kind::xor2;
+      }
+    }
+    if constexpr ( has_is_maj_v<Ntk> )
+    {
+      if ( ntk.is_maj( n ) && ntk.fanin_size( n ) == 3u )
+      {
+        return gate_kind::maj3;
+      }
+    }
+    if constexpr ( has_is_xor3_v<Ntk> )
+    {
+      if ( ntk.is_xor3( n ) && ntk.fanin_size( n ) == 3u )
+      {
+        return gate_kind::xor3;
+      }
+    }
+    return gate_kind::generic;
+  }
+
+  void simulate_window( window_entry const& w )
+  {
+    auto const nw = w.num_words;
+    auto* base = words.data() + w.first_word;
+
+    /* constants and projections */
+    std::fill( base, base + nw, uint64_t( 0 ) );
+    std::fill( base + nw, base + 2u * nw, ~uint64_t( 0 ) );
+    for ( auto i = 0u; i < w.num_leaves; ++i )
+    {
+      auto* value = base + static_cast<uint64_t>( 2u + i ) * nw;
+      if ( i < 6u )
+      {
+        std::fill( value, value + nw, kitty::detail::projections[i] );
+      }
+      else
+      {
+        for ( auto k = 0u; k < nw; ++k )
+        {
+          value[k] = ( ( k >> ( i - 6u ) ) & 1u ) ? ~uint64_t( 0 ) : uint64_t( 0 );
+        }
+      }
+    }
+
+    auto slot = 2u + w.num_leaves;
+    for ( auto g = w.first_gate; g < w.first_gate + w.num_gates; ++g )
+    {
+      auto const& gate = gates[g];
+      auto* value = base + static_cast<uint64_t>( slot++ ) * nw;
+      auto const operand = [&]( uint32_t i ) { return base + static_cast<uint64_t>( fanins[gate.first_fanin + i] >> 1 ) * nw; };
+      auto const mask = [&]( uint32_t i ) { return ( fanins[gate.first_fanin + i] & 1u ) ? ~uint64_t( 0 ) : uint64_t( 0 ); };
+
+      switch ( gate.kind )
+      {
+      case gate_kind::and2:
+      {
+        auto const *a = operand( 0 ), *b = operand( 1 );
+        auto const ma = mask( 0 ), mb = mask( 1 );
+        for ( auto k = 0u; k < nw; ++k )
+        {
+          value[k] = ( a[k] ^ ma ) & ( b[k] ^ mb );
+        }
+      }
+      break;
+      case gate_kind::xor2:
+      {
+        auto const *a = operand( 0 ), *b = operand( 1 );
+        auto const m = mask( 0 ) ^ mask( 1 );
+        for ( auto k = 0u; k < nw; ++k )
+        {
+          value[k] = a[k] ^ b[k] ^ m;
+        }
+      }
+      break;
+      case gate_kind::maj3:
+      {
+        auto const *a = operand( 0 ), *b = operand( 1 ), *c = operand( 2 );
+        auto const ma = mask( 0 ), mb = mask( 1 ), mc = mask( 2 );
+        for ( auto k = 0u; k < nw; ++k )
+        {
+          auto const x = a[k] ^ ma, y = b[k] ^ mb, z = c[k] ^ mc;
+          value[k] = ( x & y ) | ( x & z ) | ( y & z );
+        }
+      }
+      break;
+      case gate_kind::xor3:
+      {
+        auto const *a = operand( 0 ), *b = operand( 1 ), *c = operand( 2 );
+        auto const m = mask( 0 ) ^ mask( 1 ) ^ mask( 2 );
+        for ( auto k = 0u; k < nw; ++k )
+        {
+          value[k] = a[k] ^ b[k] ^ c[k] ^ m;
+        }
+      }
+      break;
+      case gate_kind::generic:
+        simulate_generic( w, gate, value );
+        break;
+      }
+    }
+  }
+
+  void simulate_generic( window_entry const& w, gate_entry const& gate, uint64_t* value ) const
+  {
+    if constexpr ( has_compute_v<Ntk, kitty::dynamic_truth_table> )
+    {
+      std::vector<kitty::dynamic_truth_table> fanin_values( gate.num_fanins, kitty::dynamic_truth_table( std::max( w.num_leaves, 6u ) ) );
+      for ( auto i = 0u; i < gate.num_fanins; ++i )
+      {
+        auto const lit = fanins[gate.first_fanin + i];
+        auto const* fv = words.data() + w.first_word + static_cast<uint64_t>( lit >> 1 ) * w.num_words;
+        auto const mask = ( lit & 1u ) ? ~uint64_t( 0 ) : uint64_t( 0 );
+        std::transform( fv, fv + w.num_words, fanin_values[i].begin(), [&]( auto word ) { return word ^ mask; } );
+      }
+      auto const tt = ntk.compute( gate.n, fanin_values.begin(), fanin_values.end() );
+      std::copy( tt.cbegin(), tt.cend(), value );
+    }
+    else
+    {
+      (void)w;
+      (void)gate;
+      (void)value;
+      assert( false && "network does not implement the compute method" );
+    }
+  }
+
+private:
+  Ntk const& ntk;
+
+  node_map<uint32_t, Ntk> stamps;
+  node_map<uint32_t, Ntk> slots;
+  uint32_t window_id{ 0u };
+  uint32_t num_slots{ 0u };
+
+  std::vector<window_entry> windows;
+  std::vector<gate_entry> gates;
+  std::vector<uint32_t> fanins; /* slot << 1 | complement */
+  std::vector<uint32_t> roots; /* slot << 1 | complement */
+  uint64_t num_words_total{ 0u };
+  std::vector<uint64_t> words;
+};
+
+} // namespace mockturtle
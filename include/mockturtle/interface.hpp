@@ -403,6 +403,15 @@ public:
   /*! \brief Returns the number of gates (without dead nodes) */
   uint32_t num_gates() const;
 
+  /*! \brief Returns the memory used by the network in bytes.
+   *
+   * Counts the network object and the storage it refers to (nodes, inputs,
+   * outputs, structural hash table, and additional data such as function
+   * caches).  The figure is computed from the capacities of the containers.
+   * Views add the memory of their own data structures.
+   */
+  uint64_t memory_usage() const;
+
   /*! \brief Returns the fanin size of a node. */
   uint32_t fanin_size( node const& n ) const;
 
@@ -37,6 +37,7 @@
 #include "../networks/aig.hpp"
 #include "../networks/sequential.hpp"
 #include "../traits.hpp"
+#include "../utils/tracing.hpp"
 #include <lorina/aiger.hpp>
 
 namespace mockturtle
@@ -224,6 +225,9 @@ public:
 private:
   Ntk& _ntk;
 
+  /* spans parsing and the creation of outputs in the destructor */
+  trace_span _span{ "read_aiger", "io" };
+
   mutable uint32_t _num_inputs{ 0 };
   mutable std::vector<std::tuple<unsigned, std::string>> outputs;
   mutable std::vector<typename Ntk::signal> signals;
@@ -41,6 +41,7 @@
 #include "../networks/cover.hpp"
 #include "../networks/sequential.hpp"
 #include "../traits.hpp"
+#include "../utils/tracing.hpp"
 
 #include <kitty/kitty.hpp>
 #include <lorina/blif.hpp>
@@ -327,6 +328,8 @@ public:
 private:
   Ntk& ntk_;
 
+  trace_span span_{ "read_blif", "io" };
+
   mutable std::map<std::string, signal<Ntk>> signals;
   mutable std::vector<std::string> outputs;
   mutable std::vector<std::string> latches;
@@ -0,0 +1,132 @@
+/* mockturtle: C++ logic network library
+ * Copyright (C) 2018-2022  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*!
+  \file chunked_output.hpp
+  \brief Chunked and buffered output for the netlist writers
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <fstream>
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace mockturtle::detail
+{
+
+/*! \brief Output file stream with a large stream buffer.
+ *
+ * The buffer is installed before the file is opened, such that the writers
+ * issue few large write calls instead of many small ones.
+ */
+class buffered_ofstream : public std::ofstream
+{
+public:
+  explicit buffered_ofstream( std::string const& filename, std::size_t buffer_size = std::size_t( 1 ) << 20 )
+      : _buffer( buffer_size )
+  {
+    rdbuf()->pubsetbuf( _buffer.data(), static_cast<std::streamsize>( _buffer.size() ) );
+    open( filename.c_str(), std::ofstream::out );
+  }
+
+  ~buffered_ofstream()
+  {
+    /* flush before the buffer is released */
+    close();
+  }
+
+private:
+  std::vector<char> _buffer;
+};
+
+/*! \brief Formats a range of items into an output stream in chunks.
+ *
+ * Calls `fn( out, begin, end )` for consecutive ranges of at most
+ * `chunk_size` items, and writes the formatted ranges to `os` in order.  If
+ * more than one thread is used, the chunks of a round are formatted
+ * concurrently into per-chunk string buffers, which are then copied to `os`.
+ * A `num_threads` of 0 uses all hardware threads.  `fn` must only read shared
+ * data.
+ */
+template<class Fn>
+void format_chunks( std::ostream& os, uint32_t num_items, uint32_t num_threads, Fn&& fn, uint32_t chunk_size = 4096u )
+{
+  if ( num_threads == 0u )
+  {
+    num_threads = std::max( 1u, std::thread::hardware_concurrency() );
+  }
+  uint32_t const num_chunks = ( num_items + chunk_size - 1u ) / chunk_size;
+  num_threads = std::min( num_threads, num_chunks );
+  if ( num_threads <= 1u )
+  {
+    fn( os, 0u, num_items );
+    return;
+  }
+
+  /* bound the amount of buffered output to a few chunks per thread */
+  uint32_t const round_size = 4u * num_threads;
+  std::vector<std::ostringstream> buffers( round_size );
+
+  for ( auto first = 0u; first < num_chunks; first += round_size )
+  {
+    uint32_t const last = std::min( num_chunks, first + round_size );
+    std::atomic<uint32_t> next{ first };
+    auto const worker = [&]() {
+      for ( auto c = next++; c < last; c = next++ )
+      {
+        auto& buffer = buffers[c - first];
+        buffer.str( std::string() );
+        fn( static_cast<std::ostream&>( buffer ), c * chunk_size, std::min( num_items, ( c + 1u ) * chunk_size ) );
+      }
+    };
+
+    std::vector<std::thread> threads;
+    threads.reserve( num_threads - 1u );
+    for ( auto t = 1u; t < num_threads; ++t )
+    {
+      threads.emplace_back( worker );
+    }
+    worker();
+    for ( auto& thread : threads )
+    {
+      thread.join();
+    }
+
+    for ( auto c = first; c < last; ++c )
+    {
+      auto const text = buffers[c - first].str();
+      os.write( text.data(), static_cast<std::streamsize>( text.size() ) );
+    }
+  }
+}
+
+} // namespace mockturtle::detail
@@ -0,0 +1,203 @@
+/* mockturtle: C++ logic network library
+ * Copyright (C) 2018-2022  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*!
+  \file netlist_lexing.hpp
+  \brief Memory-mapped input and name interning for the fast netlist readers
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#if defined( __unix__ ) || defined( __APPLE__ )
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define MOCKTURTLE_HAS_MMAP 1
+#endif
+
+namespace mockturtle::detail
+{
+
+/*! \brief Read-only view of a file.
+ *
+ * The file is memory-mapped on POSIX systems and read into a buffer
+ * otherwise.
+ */
+class mapped_file
+{
+public:
+  explicit mapped_file( std::string const& filename )
+  {
+#if defined( MOCKTURTLE_HAS_MMAP )
+    int const fd = ::open( filename.c_str(), O_RDONLY );
+    if ( fd < 0 )
+    {
+      return;
+    }
+    struct stat sb;
+    if ( ::fstat( fd, &sb ) == 0 )
+    {
+      _size = static_cast<std::size_t>( sb.st_size );
+      if ( _size == 0u )
+      {
+        _open = true;
+      }
+      else
+      {
+        void* data = ::mmap( nullptr, _size, PROT_READ, MAP_PRIVATE, fd, 0 );
+        if ( data != MAP_FAILED )
+        {
+          ::madvise( data, _size, MADV_SEQUENTIAL );
+          _data = static_cast<char const*>( data );
+          _mapped = true;
+          _open = true;
+        }
+      }
+    }
+    ::close( fd );
+#else
+    std::ifstream in( filename, std::ifstream::binary );
+    if ( in.is_open() )
+    {
+      _buffer.assign( std::istreambuf_iterator<char>( in ), std::istreambuf_iterator<char>() );
+      _data = _buffer.data();
+      _size = _buffer.size();
+      _open = true;
+    }
+#endif
+  }
+
+  ~mapped_file()
+  {
+#if defined( MOCKTURTLE_HAS_MMAP )
+    if ( _mapped )
+    {
+      ::munmap( const_cast<char*>( _data ), _size );
+    }
+#endif
+  }
+
+  mapped_file( mapped_file const& ) = delete;
+  mapped_file& operator=( mapped_file const& ) = delete;
+
+  bool is_open() const { return _open; }
+
+  std::string_view view() const { return { _data, _size }; }
+
+private:
+  char const* _data{ nullptr };
+  std::size_t _size{ 0u };
+  bool _open{ false };
+  bool _mapped{ false };
+#if !defined( MOCKTURTLE_HAS_MMAP )
+  std::string _buffer;
+#endif
+};
+
+/*! \brief Maps names to consecutive indexes.
+ *
+ * The characters of all interned names are copied into large chunks, such
+ * that a name costs one hash table entry and no individual allocation.
+ * Views returned by `name` remain valid for the lifetime of the interner.
+ */
+class name_interner
+{
+public:
+  static constexpr uint32_t chunk_size = 1u << 16;
+
+  /*! \brief Returns the index of `name`, adding it if it is new. */
+  uint32_t intern( std::string_view name )
+  {
+    if ( auto const it = _ids.find( name ); it != _ids.end() )
+    {
+      return it->second;
+    }
+
+    auto const stored = store( name );
+    auto const id = static_cast<uint32_t>( _names.size() );
+    _names.emplace_back( stored );
+    _ids.emplace( stored, id );
+    return id;
+  }
+
+  /*! \brief Returns the index of `name`, or `size()` if it does not exist. */
+  uint32_t find( std::string_view name ) const
+  {
+    auto const it = _ids.find( name );
+    return it == _ids.end() ? size() : it->second;
+  }
+
+  std::string_view name( uint32_t id ) const { return _names[id]; }
+
+  uint32_t size() const { return static_cast<uint32_t>( _names.size() ); }
+
+private:
+  std::string_view store( std::string_view name )
+  {
+    if ( name.size() > chunk_size / 4u )
+    {
+      /* long names get a chunk of their own, in front of the chunk being filled */
+      std::unique_ptr<char[]> chunk( new char[name.size()] );
+      std::memcpy( chunk.get(), name.data(), name.size() );
+      std::string_view const stored{ chunk.get(), name.size() };
+      _chunks.insert( _chunks.empty() ? _chunks.end() : std::prev( _chunks.end() ), std::move( chunk ) );
+      if ( _chunks.size() == 1u )
+      {
+        _used = chunk_size;
+      }
+      return stored;
+    }
+
+    if ( _chunks.empty() || _used + name.size() > chunk_size )
+    {
+      _chunks.emplace_back( new char[chunk_size] );
+      _used = 0u;
+    }
+    char* dest = _chunks.back().get() + _used;
+    std::memcpy( dest, name.data(), name.size() );
+    _used += name.size();
+    return { dest, name.size() };
+  }
+
+private:
+  std::vector<std::unique_ptr<char[]>> _chunks;
+  std::size_t _used{ 0u };
+  std::vector<std::string_view> _names;
+  std::unordered_map<std::string_view, uint32_t> _ids;
+};
+
+} // namespace mockturtle::detail
@@ -0,0 +1,610 @@
+/* mockturtle: C++ logic network library
+ * Copyright (C) 2018-2022  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*!
+  \file fast_blif_reader.hpp
+  \brief Fast reader for large BLIF files
+*/
+
+#pragma once
+
+#include "../networks/cover.hpp"
+#include "../networks/sequential.hpp"
+#include "../traits.hpp"
+#include "detail/netlist_lexing.hpp"
+
+#include <kitty/constructors.hpp>
+#include <kitty/cube.hpp>
+#include <kitty/dynamic_truth_table.hpp>
+#include <lorina/common.hpp>
+#include <lorina/diagnostics.hpp>
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace mockturtle
+{
+
+namespace detail
+{
+
+template<class Ntk>
+class fast_blif_parser
+{
+  static constexpr uint32_t no_gate = UINT32_MAX;
+
+  struct cover_row
+  {
+    std::string_view inputs;
+    char output;
+  };
+
+  struct gate
+  {
+    uint32_t output;
+    uint32_t first_fanin;
+    uint32_t num_fanins;
+    uint32_t first_row;
+    uint32_t num_rows;
+  };
+
+  struct latch
+  {
+    uint32_t input;
+    uint32_t output;
+    register_t reg;
+  };
+
+  enum class name_state : uint8_t
+  {
+    unknown,
+    visiting,
+    done
+  };
+
+public:
+  fast_blif_parser( std::string_view buffer, Ntk& ntk, lorina::diagnostic_engine* diag )
+      : buffer( buffer ), ntk( ntk ), diag( diag )
+  {
+  }
+
+  lorina::return_code run()
+  {
+    if ( !parse() || !create_gates() )
+    {
+      return lorina::return_code::parse_error;
+    }
+
+    for ( auto i = 0u; i < outputs.size(); ++i )
+    {
+      ntk.create_po( signals[outputs[i]] );
+      if constexpr ( has_set_output_name_v<Ntk> )
+      {
+        ntk.set_output_name( i, std::string( names.name( outputs[i] ) ) );
+      }
+    }
+
+    if constexpr ( has_create_ri_v<Ntk> )
+    {
+      for ( auto i = 0u; i < latches.size(); ++i )
+      {
+        ntk.create_ri( signals[latches[i].input] );
+        if constexpr ( has_set_output_name_v<Ntk> )
+        {
+          ntk.set_output_name( static_cast<uint32_t>( outputs.size() ) + i, std::string( names.name( latches[i].input ) ) );
+        }
+      }
+    }
+
+    return lorina::return_code::success;
+  }
+
+private:
+  /*! \brief Splits the next logical line into tokens.
+   *
+   * Comments are skipped and a backslash at the end of a line continues the
+   * line on the next one.  Returns false at the end of the buffer.
+   */
+  bool next_line()
+  {
+    tokens.clear();
+    if ( pos >= buffer.size() )
+    {
+      return false;
+    }
+
+    line_begin = pos;
+    while ( pos < buffer.size() )
+    {
+      char const c = buffer[pos];
+      if ( c == '\n' )
+      {
+        ++pos;
+        break;
+      }
+      if ( c == '#' )
+      {
+        while ( pos < buffer.size() && buffer[pos] != '\n' )
+        {
+          ++pos;
+        }
+        continue;
+      }
+      if ( c == '\\' )
+      {
+        auto next = pos + 1u;
+        while ( next < buffer.size() && ( buffer[next] == ' ' || buffer[next] == '\t' || buffer[next] == '\r' ) )
+        {
+          ++next;
+        }
+        if ( next == buffer.size() || buffer[next] == '\n' )
+        {
+          pos = next + 1u;
+          continue;
+        }
+      }
+      if ( c == ' ' || c == '\t' || c == '\r' )
+      {
+        ++pos;
+        continue;
+      }
+
+      auto const begin = pos;
+      while ( pos < buffer.size() && !is_separator( buffer[pos] ) )
+      {
+        ++pos;
+      }
+      tokens.push_back( buffer.substr( begin, pos - begin ) );
+    }
+    return true;
+  }
+
+  static bool is_separator( char c )
+  {
+    return c == ' ' || c == '\t' || c == '\r' || c == '\n' || c == '#';
+  }
+
+  std::string_view current_line() const
+  {
+    auto const end = buffer.find( '\n', line_begin );
+    return buffer.substr( line_begin, ( end == std::string_view::npos ? buffer.size() : end ) - line_begin );
+  }
+
+  uint32_t name_id( std::string_view name )
+  {
+    auto const id = names.intern( name );
+    if ( id == states.size() )
+    {
+      states.emplace_back( name_state::unknown );
+      drivers.emplace_back( no_gate );
+      signals.emplace_back();
+    }
+    return id;
+  }
+
+  bool error( lorina::diag_id id, std::string_view arg )
+  {
+    if ( diag )
+    {
+      diag->report( id ).add_argument( std::string( arg ) );
+    }
+    return false;
+  }
+
+  bool unresolved( std::string_view name, std::string_view dependency )
+  {
+    if ( diag )
+    {
+      diag->report( lorina::diag_id::WRN_UNRESOLVED_DEPENDENCY ).add_argument( std::string( name ) ).add_argument( std::string( dependency ) );
+    }
+    return false;
+  }
+
+  bool redefined( uint32_t id )
+  {
+    if ( states[id] != name_state::unknown || drivers[id] != no_gate )
+    {
+      return error( lorina::diag_id::ERR_PARSE_LINE, current_line() );
+    }
+    return true;
+  }
+
+  bool parse()
+  {
+    bool in_cover = false;
+    while ( next_line() )
+    {
+      if ( tokens.empty() )
+      {
+        continue;
+      }
+
+      auto const& keyword = tokens.front();
+      if ( keyword.front() != '.' )
+      {
+        if ( !in_cover || tokens.size() > 2u || ( tokens.size() == 1u && gates.back().num_fanins != 0u ) )
+        {
+          return error( lorina::diag_id::ERR_PARSE_LINE, current_line() );
+        }
+        auto const& out = tokens.back();
+        if ( out.size() != 1u || ( out.front() != '0' && out.front() != '1' ) ||
+             ( tokens.size() == 2u && tokens.front().size() != gates.back().num_fanins ) )
+        {
+          return error( lorina::diag_id::ERR_PARSE_LINE, current_line() );
+        }
+        rows.push_back( { tokens.size() == 2u ? tokens.front() : std::string_view{}, out.front() } );
+        ++gates.back().num_rows;
+        continue;
+      }
+      in_cover = false;
+
+      if ( keyword == ".names" )
+      {
+        if ( tokens.size() < 2u )
+        {
+          return error( lorina::diag_id::ERR_PARSE_LINE, current_line() );
+        }
+        auto const output = name_id( tokens.back() );
+        if ( !redefined( output ) )
+        {
+          return false;
+        }
+        drivers[output] = static_cast<uint32_t>( gates.size() );
+        gates.push_back( { output, static_cast<uint32_t>( fanins.size() ), static_cast<uint32_t>( tokens.size() - 2u ), static_cast<uint32_t>( rows.size() ), 0u } );
+        for ( auto i = 1u; i + 1u < tokens.size(); ++i )
+        {
+          fanins.push_back( name_id( tokens[i] ) );
+        }
+        in_cover = true;
+      }
+      else if ( keyword == ".inputs" )
+      {
+        for ( auto i = 1u; i < tokens.size(); ++i )
+        {
+          auto const id = name_id( tokens[i] );
+          if ( !redefined( id ) )
+          {
+            return false;
+          }
+          signals[id] = ntk.create_pi();
+          states[id] = name_state::done;
+          if constexpr ( has_set_name_v<Ntk> )
+          {
+            ntk.set_name( signals[id], std::string( tokens[i] ) );
+          }
+        }
+      }
+      else if ( keyword == ".outputs" )
+      {
+        for ( auto i = 1u; i < tokens.size(); ++i )
+        {
+          outputs.push_back( name_id( tokens[i] ) );
+        }
+      }
+      else if ( keyword == ".latch" )
+      {
+        if ( !parse_latch() )
+        {
+          return false;
+        }
+      }
+      else if ( keyword == ".model" )
+      {
+        if constexpr ( has_set_network_name_v<Ntk> )
+        {
+          if ( tokens.size() > 1u )
+          {
+            ntk.set_network_name( std::string( tokens[1] ) );
+          }
+        }
+      }
+      else if ( keyword == ".end" )
+      {
+        break;
+      }
+      else
+      {
+        return error( lorina::diag_id::ERR_UNSUPPORTED_KEYWORD, keyword );
+      }
+    }
+    return true;
+  }
+
+  bool parse_latch()
+  {
+    if constexpr ( has_create_ro_v<Ntk> )
+    {
+      if ( tokens.size() < 3u || tokens.size() > 6u )
+      {
+        return error( lorina::diag_id::ERR_BLIF_LATCH_FORMAT, current_line() );
+      }
+
+      latch l;
+      l.input = name_id( tokens[1] );
+      l.output = name_id( tokens[2] );
+      if ( !redefined( l.output ) )
+      {
+        return false;
+      }
+
+      l.reg.type = "re";
+      l.reg.control = "clock";
+      l.reg.init = 3;
+      std::string_view init;
+      if ( tokens.size() == 4u )
+      {
+        init = tokens[3];
+      }
+      else if ( tokens.size() >= 5u )
+      {
+        auto const& type = tokens[3];
+        l.reg.type = ( type == "fe" || type == "re" || type == "ah" || type == "al" ) ? std::string( type ) : std::string( "as" );
+        l.reg.control = std::string( tokens[4] );
+        if ( tokens.size() == 6u )
+        {
+          init = tokens[5];
+        }
+      }
+      if ( init == "0" || init == "1" || init == "2" )
+      {
+        l.reg.init = init.front() - '0';
+      }
+
+      signals[l.output] = ntk.create_ro();
+      states[l.output] = name_state::done;
+      ntk.set_register( static_cast<uint32_t>( latches.size() ), l.reg );
+      if constexpr ( has_set_name_v<Ntk> )
+      {
+        ntk.set_name( signals[l.output], std::string( tokens[2] ) );
+      }
+      latches.push_back( l );
+      return true;
+    }
+    else
+    {
+      return error( lorina::diag_id::ERR_UNSUPPORTED_KEYWORD, tokens.front() );
+    }
+  }
+
+  /*! \brief Creates all gates, each one after its fanins. */
+  bool create_gates()
+  {
+    std::vector<uint32_t> stack;
+    for ( auto const& g : gates )
+    {
+      if ( states[g.output] == name_state::done )
+      {
+        continue;
+      }
+
+      stack.push_back( g.output );
+      while ( !stack.empty() )
+      {
+        auto const id = stack.back();
+        if ( states[id] == name_state::done )
+        {
+          stack.pop_back();
+          continue;
+        }
+
+        auto const& driver = gates[drivers[id]];
+        if ( states[id] == name_state::unknown )
+        {
+          states[id] = name_state::visiting;
+          for ( auto i = 0u; i < driver.num_fanins; ++i )
+          {
+            auto const fanin = fanins[driver.first_fanin + i];
+            if ( states[fanin] == name_state::done )
+            {
+              continue;
+            }
+            if ( states[fanin] == name_state::visiting || drivers[fanin] == no_gate )
+            {
+              return unresolved( names.name( id ), names.name( fanin ) );
+            }
+            stack.push_back( fanin );
+          }
+          continue;
+        }
+
+        signals[id] = create_gate( driver );
+        states[id] = name_state::done;
+        stack.pop_back();
+      }
+    }
+
+    for ( auto const& o : outputs )
+    {
+      if ( states[o] != name_state::done )
+      {
+        return unresolved( ".outputs", names.name( o ) );
+      }
+    }
+    for ( auto const& l : latches )
+    {
+      if ( states[l.input] != name_state::done )
+      {
+        return unresolved( names.name( l.output ), names.name( l.input ) );
+      }
+    }
+    return true;
+  }
+
+  static kitty::cube make_cube( std::string_view str )
+  {
+    uint32_t bits = 0u, mask = 0u;
+    for ( auto i = 0u; i < str.size() && i < 32u; ++i )
+    {
+      if ( str[i] == '1' )
+      {
+        bits |= 1u << i;
+        mask |= 1u << i;
+      }
+      else if ( str[i] == '0' )
+      {
+        mask |= 1u << i;
+      }
+    }
+    return kitty::cube( bits, mask );
+  }
+
+  signal<Ntk> create_gate( gate const& g )
+  {
+    if ( g.num_rows == 0u )
+    {
+      return ntk.get_constant( false );
+    }
+    if ( g.num_fanins == 0u )
+    {
+      return ntk.get_constant( rows[g.first_row].output == '1' );
+    }
+
+    children.clear();
+    for ( auto i = 0u; i < g.num_fanins; ++i )
+    {
+      children.push_back( signals[fanins[g.first_fanin + i]] );
+    }
+
+    bool const is_sop = rows[g.first_row].output == '1';
+    cubes.clear();
+    for ( auto r = g.first_row; r < g.first_row + g.num_rows; ++r )
+    {
+      cubes.push_back( make_cube( rows[r].inputs ) );
+    }
+
+    if constexpr ( std::is_same_v<typename Ntk::base_type, cover_network> )
+    {
+      return ntk.create_cover_node( children, std::make_pair( cubes, is_sop ) );
+    }
+    else
+    {
+      kitty::dynamic_truth_table tt( g.num_fanins );
+      if ( is_sop )
+      {
+        kitty::create_from_cubes( tt, cubes, false );
+      }
+      else
+      {
+        for ( auto& c : cubes )
+        {
+          c = ~c;
+        }
+        kitty::create_from_clauses( tt, cubes, false );
+      }
+      return ntk.create_node( children, tt );
+    }
+  }
+
+private:
+  std::string_view buffer;
+  Ntk& ntk;
+  lorina::diagnostic_engine* diag;
+
+  std::size_t pos{ 0u };
+  std::size_t line_begin{ 0u };
+  std::vector<std::string_view> tokens;
+
+  name_interner names;
+  std::vector<name_state> states;
+  std::vector<uint32_t> drivers;
+  std::vector<signal<Ntk>> signals;
+
+  std::vector<gate> gates;
+  std::vector<uint32_t> fanins;
+  std::vector<cover_row> rows;
+  std::vector<uint32_t> outputs;
+  std::vector<latch> latches;
+  std::vector<kitty::cube> cubes;
+  std::vector<signal<Ntk>> children;
+};
+
+} // namespace detail
+
+/*! \brief Reads a BLIF netlist from a memory buffer.
+ *
+ * See `read_blif_fast` for the supported subset of BLIF.
+ */
+template<class Ntk>
+[[nodiscard]] lorina::return_code read_blif_fast_from_buffer( std::string_view buffer, Ntk& ntk, lorina::diagnostic_engine* diag = nullptr )
+{
+  static_assert( is_network_type_v<Ntk>, "Ntk is not a network type" );
+  static_assert( has_create_pi_v<Ntk>, "Ntk does not implement the create_pi function" );
+  static_assert( has_create_po_v<Ntk>, "Ntk does not implement the create_po function" );
+  static_assert( has_create_node_v<Ntk> || has_create_cover_node_v<Ntk>, "Ntk does not implement the create_node function or the create_cover_node function" );
+  static_assert( has_get_constant_v<Ntk>, "Ntk does not implement the get_constant function" );
+
+  return detail::fast_blif_parser<Ntk>( buffer, ntk, diag ).run();
+}
+
+/*! \brief Reads a BLIF netlist without going through lorina's callbacks.
+ *
+ * This is a fast path for very large netlists.  The file is memory-mapped and
+ * split into tokens that point into the mapped memory, and each signal name
+ * is stored once in an arena.  Gates are created after the whole file has
+ * been read, such that they may appear in any order.
+ *
+ * The network is built as by `blif_reader`.  Only a single `.model` with
+ * `.inputs`, `.outputs`, `.names`, and (for sequential networks) `.latch`
+ * is supported.
+ *
+ * **Required network functions:**
+ * - `create_pi`
+ * - `create_po`
+ * - `create_node` or `create_cover_node`
+ * - `get_constant`
+ *
+   \verbatim embed:rst
+
+   Example
+
+   .. code-block:: c++
+
+      klut_network klut;
+      if ( read_blif_fast( "file.blif", klut ) != lorina::return_code::success )
+      {
+        std::cout << "read failed\n";
+      }
+   \endverbatim
+ */
+template<class Ntk>
+[[nodiscard]] lorina::return_code read_blif_fast( std::string const& filename, Ntk& ntk, lorina::diagnostic_engine* diag = nullptr )
+{
+  detail::mapped_file file( filename );
+  if ( !file.is_open() )
+  {
+    if ( diag )
+    {
+      diag->report( lorina::diag_id::ERR_FILE_OPEN ).add_argument( filename );
+    }
+    return lorina::return_code::parse_error;
+  }
+  return read_blif_fast_from_buffer( file.view(), ntk, diag );
+}
+
+} // namespace mockturtle
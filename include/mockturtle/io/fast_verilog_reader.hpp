@@ -0,0 +1,1451 @@
+/* mockturtle: C++ logic network library
+ * Copyright (C) 2018-2022  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*!
+  \file fast_verilog_reader.hpp
+  \brief Fast reader for large structural Verilog files
+*/
+
+#pragma once
+
+#include "../traits.hpp"
+#include "detail/netlist_lexing.hpp"
+
+#include <fmt/format.h>
+#include <lorina/common.hpp>
+#include <lorina/diagnostics.hpp>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace mockturtle
+{
+
+/*! \brief Parameters for read_verilog_fast.
+ *
+ * The data structure `fast_verilog_reader_params` holds configurable
+ * parameters with default arguments for `read_verilog_fast`.
+ */
+struct fast_verilog_reader_params
+{
+  /*! \brief Name of the top module.
+   *
+   * If empty, the last module that is not instantiated by any other module
+   * is used.
+   */
+  std::string top_module{};
+
+  /*! \brief Number of threads used to parse modules (0 uses all cores). */
+  uint32_t num_threads{ 0u };
+};
+
+namespace detail
+{
+
+enum class verilog_token_kind : uint8_t
+{
+  identifier,
+  number,
+  symbol,
+  end
+};
+
+struct verilog_token
+{
+  verilog_token_kind kind{ verilog_token_kind::end };
+  std::string_view text;
+  std::size_t pos{ 0u };
+
+  bool is( char c ) const { return kind == verilog_token_kind::symbol && text.front() == c; }
+};
+
+inline bool is_verilog_identifier_char( char c )
+{
+  return ( c >= 'a' && c <= 'z' ) || ( c >= 'A' && c <= 'Z' ) || ( c >= '0' && c <= '9' ) || c == '_' || c == '$';
+}
+
+/*! \brief Tokenizer over a range of a buffer, without copying any text. */
+class verilog_lexer
+{
+public:
+  verilog_lexer( std::string_view buffer, std::size_t begin, std::size_t end )
+      : buffer( buffer.substr( 0u, end ) ), pos( begin )
+  {
+    advance();
+  }
+
+  verilog_token const& peek() const { return lookahead; }
+
+  verilog_token next()
+  {
+    auto const token = lookahead;
+    advance();
+    return token;
+  }
+
+private:
+  void skip_whitespace_and_comments()
+  {
+    while ( pos < buffer.size() )
+    {
+      char const c = buffer[pos];
+      if ( c == ' ' || c == '\t' || c == '\r' || c == '\n' )
+      {
+        ++pos;
+      }
+      else if ( c == '/' && pos + 1u < buffer.size() && buffer[pos + 1u] == '/' )
+      {
+        auto const eol = buffer.find( '\n', pos );
+        pos = eol == std::string_view::npos ? buffer.size() : eol + 1u;
+      }
+      else if ( c == '/' && pos + 1u < buffer.size() && buffer[pos + 1u] == '*' )
+      {
+        auto const eoc = buffer.find( "*/", pos + 2u );
+        pos = eoc == std::string_view::npos ? buffer.size() : eoc + 2u;
+      }
+      else
+      {
+        break;
+      }
+    }
+  }
+
+  void advance()
+  {
+    skip_whitespace_and_comments();
+    lookahead.pos = pos;
+    if ( pos >= buffer.size() )
+    {
+      lookahead.kind = verilog_token_kind::end;
+      lookahead.text = {};
+      return;
+    }
+
+    auto const begin = pos;
+    char const c = buffer[pos];
+    if ( c == '\\' )
+    {
+      /* escaped identifier, terminated by white space */
+      while ( pos < buffer.size() && buffer[pos] != ' ' && buffer[pos] != '\t' && buffer[pos] != '\r' && buffer[pos] != '\n' )
+      {
+        ++pos;
+      }
+      lookahead.kind = verilog_token_kind::identifier;
+    }
+    else if ( c >= '0' && c <= '9' )
+    {
+      while ( pos < buffer.size() && ( is_verilog_identifier_char( buffer[pos] ) || buffer[pos] == '\'' ) )
+      {
+        ++pos;
+      }
+      lookahead.kind = verilog_token_kind::number;
+    }
+    else if ( is_verilog_identifier_char( c ) )
+    {
+      while ( pos < buffer.size() && is_verilog_identifier_char( buffer[pos] ) )
+      {
+        ++pos;
+      }
+      lookahead.kind = verilog_token_kind::identifier;
+    }
+    else
+    {
+      ++pos;
+      lookahead.kind = verilog_token_kind::symbol;
+    }
+    lookahead.text = buffer.substr( begin, pos - begin );
+  }
+
+private:
+  std::string_view buffer;
+  std::size_t pos;
+  verilog_token lookahead;
+};
+
+/*! \brief Splits a buffer into the text ranges of its modules.
+ *
+ * Only comments and the `endmodule` keyword are recognized, which makes the
+ * split much cheaper than tokenizing the buffer.
+ */
+inline std::vector<std::pair<std::size_t, std::size_t>> split_verilog_modules( std::string_view buffer )
+{
+  static constexpr std::string_view keyword = "endmodule";
+
+  std::vector<std::pair<std::size_t, std::size_t>> ranges;
+  std::size_t begin = 0u, pos = 0u;
+  while ( pos < buffer.size() )
+  {
+    char const c = buffer[pos];
+    if ( c == '/' && pos + 1u < buffer.size() && buffer[pos + 1u] == '/' )
+    {
+      auto const eol = buffer.find( '\n', pos );
+      pos = eol == std::string_view::npos ? buffer.size() : eol + 1u;
+    }
+    else if ( c == '/' && pos + 1u < buffer.size() && buffer[pos + 1u] == '*' )
+    {
+      auto const eoc = buffer.find( "*/", pos + 2u );
+      pos = eoc == std::string_view::npos ? buffer.size() : eoc + 2u;
+    }
+    else if ( c == 'e' && ( pos == 0u || !is_verilog_identifier_char( buffer[pos - 1u] ) ) && buffer.compare( pos, keyword.size(), keyword ) == 0 &&
+              ( pos + keyword.size() == buffer.size() || !is_verilog_identifier_char( buffer[pos + keyword.size()] ) ) )
+    {
+      pos += keyword.size();
+      ranges.emplace_back( begin, pos );
+      begin = pos;
+    }
+    else
+    {
+      ++pos;
+    }
+  }
+  return ranges;
+}
+
+enum class verilog_expr_op : uint8_t
+{
+  net,
+  constant,
+  not_,
+  and_,
+  or_,
+  xor_,
+  ite
+};
+
+/*! \brief Node of an expression; `a` is the net or the constant value for leaves. */
+struct verilog_expr
+{
+  verilog_expr_op op;
+  uint32_t a{ 0u };
+  uint32_t b{ 0u };
+  uint32_t c{ 0u };
+};
+
+/*! \brief Module in a flat form that can be instantiated many times. */
+struct verilog_module
+{
+  static constexpr uint32_t none = UINT32_MAX;
+
+  enum class driver_kind : uint8_t
+  {
+    none,
+    assign,
+    instance
+  };
+
+  struct word
+  {
+    uint32_t first_bit;
+    uint32_t width;
+  };
+
+  struct binding
+  {
+    std::string_view formal; /* empty for positional bindings */
+    uint32_t actual;         /* expression */
+  };
+
+  struct instance
+  {
+    std::string_view module_name;
+    uint32_t first_binding;
+    uint32_t num_bindings;
+
+    /* set when linking */
+    uint32_t module{ none };
+    uint32_t first_input{ 0u };
+    uint32_t first_output{ 0u };
+  };
+
+  std::string_view name;
+  name_interner names;
+
+  std::vector<uint32_t> header;  /* port names in the module header */
+  std::vector<uint32_t> inputs;  /* input nets in declaration order */
+  std::vector<uint32_t> outputs; /* output nets in declaration order */
+  std::unordered_map<uint32_t, word> words;
+  std::vector<uint32_t> word_bits;
+
+  std::vector<verilog_expr> exprs;
+  std::vector<std::pair<uint32_t, uint32_t>> assigns; /* (net, expression) */
+  std::vector<instance> instances;
+  std::vector<binding> bindings;
+
+  /* set when linking */
+  std::vector<uint32_t> instance_inputs;  /* expression per input of the instantiated module */
+  std::vector<uint32_t> instance_outputs; /* net per output of the instantiated module, or none */
+  std::vector<std::pair<driver_kind, uint32_t>> drivers;
+  std::unordered_map<uint32_t, uint32_t> port_positions; /* net -> ( position << 1 ) | is_output */
+
+  bool instantiated{ false };
+
+  /* first error, with the argument of its diagnostic */
+  std::optional<std::string> error;
+  lorina::diag_id error_id{ lorina::diag_id::ERR_PARSE_LINE };
+};
+
+/*! \brief Parses the text of one module into a `verilog_module`. */
+class verilog_module_parser
+{
+public:
+  verilog_module_parser( std::string_view buffer, std::pair<std::size_t, std::size_t> const& range, verilog_module& module )
+      : buffer( buffer ), lexer( buffer, range.first, range.second ), m( module )
+  {
+  }
+
+  bool run()
+  {
+    if ( !parse_header() )
+    {
+      return false;
+    }
+
+    while ( true )
+    {
+      auto const token = lexer.next();
+      if ( token.kind != verilog_token_kind::identifier )
+      {
+        return fail( token, lorina::diag_id::ERR_PARSE_LINE );
+      }
+
+      bool ok = true;
+      if ( token.text == "endmodule" )
+      {
+        break;
+      }
+      else if ( token.text == "input" )
+      {
+        ok = parse_declaration( &m.inputs );
+      }
+      else if ( token.text == "output" )
+      {
+        ok = parse_declaration( &m.outputs );
+      }
+      else if ( token.text == "wire" )
+      {
+        ok = parse_declaration( nullptr );
+      }
+      else if ( token.text == "assign" )
+      {
+        ok = parse_assign();
+      }
+      else
+      {
+        ok = parse_instance( token );
+      }
+
+      if ( !ok )
+      {
+        return false;
+      }
+    }
+
+    for ( auto i = 0u; i < m.inputs.size(); ++i )
+    {
+      m.port_positions[m.inputs[i]] = i << 1;
+    }
+    for ( auto i = 0u; i < m.outputs.size(); ++i )
+    {
+      m.port_positions[m.outputs[i]] = ( i << 1 ) | 1u;
+    }
+    return true;
+  }
+
+private:
+  bool fail( verilog_token const& token, lorina::diag_id id )
+  {
+    auto const begin = buffer.rfind( '\n', token.pos == 0u ? 0u : token.pos - 1u );
+    auto const line_begin = ( begin == std::string_view::npos || token.pos == 0u ) ? 0u : begin + 1u;
+    auto const end = buffer.find( '\n', token.pos );
+    m.error = std::string( buffer.substr( line_begin, ( end == std::string_view::npos ? buffer.size() : end ) - line_begin ) );
+    m.error_id = id;
+    return false;
+  }
+
+  bool expect( char c, lorina::diag_id id )
+  {
+    auto const token = lexer.next();
+    return token.is( c ) ? true : fail( token, id );
+  }
+
+  bool parse_header()
+  {
+    auto token = lexer.next();
+    if ( token.text != "module" )
+    {
+      return fail( token, lorina::diag_id::ERR_VERILOG_MODULE_HEADER );
+    }
+    token = lexer.next();
+    if ( token.kind != verilog_token_kind::identifier )
+    {
+      return fail( token, lorina::diag_id::ERR_VERILOG_MODULE_HEADER );
+    }
+    m.name = token.text;
+
+    if ( lexer.peek().is( '(' ) )
+    {
+      lexer.next();
+      while ( !lexer.peek().is( ')' ) )
+      {
+        token = lexer.next();
+        if ( token.kind != verilog_token_kind::identifier )
+        {
+          return fail( token, lorina::diag_id::ERR_VERILOG_MODULE_HEADER );
+        }
+        m.header.push_back( m.names.intern( token.text ) );
+        if ( lexer.peek().is( ',' ) )
+        {
+          lexer.next();
+        }
+      }
+      lexer.next();
+    }
+    return expect( ';', lorina::diag_id::ERR_VERILOG_MODULE_HEADER );
+  }
+
+  std::optional<uint32_t> parse_number()
+  {
+    auto const token = lexer.next();
+    if ( token.kind != verilog_token_kind::number )
+    {
+      fail( token, lorina::diag_id::ERR_PARSE_LINE );
+      return std::nullopt;
+    }
+    uint32_t value = 0u;
+    for ( auto c : token.text )
+    {
+      if ( c < '0' || c > '9' )
+      {
+        fail( token, lorina::diag_id::ERR_PARSE_LINE );
+        return std::nullopt;
+      }
+      value = value * 10u + static_cast<uint32_t>( c - '0' );
+    }
+    return value;
+  }
+
+  bool parse_declaration( std::vector<uint32_t>* ports )
+  {
+    auto const id = ports == &m.inputs ? lorina::diag_id::ERR_VERILOG_INPUT_DECLARATION : ( ports == &m.outputs ? lorina::diag_id::ERR_VERILOG_OUTPUT_DECLARATION : lorina::diag_id::ERR_VERILOG_WIRE_DECLARATION );
+
+    std::optional<std::pair<uint32_t, uint32_t>> range;
+    if ( lexer.peek().is( '[' ) )
+    {
+      lexer.next();
+      auto const msb = parse_number();
+      if ( !msb || !expect( ':', id ) )
+      {
+        return false;
+      }
+      auto const lsb = parse_number();
+      if ( !lsb || !expect( ']', id ) )
+      {
+        return false;
+      }
+      range = std::make_pair( std::min( *msb, *lsb ), std::max( *msb, *lsb ) );
+    }
+
+    while ( true )
+    {
+      auto const token = lexer.next();
+      if ( token.kind != verilog_token_kind::identifier )
+      {
+        return fail( token, id );
+      }
+
+      if ( range )
+      {
+        verilog_module::word w{ static_cast<uint32_t>( m.word_bits.size() ), range->second - range->first + 1u };
+        for ( auto i = range->first; i <= range->second; ++i )
+        {
+          bit_name.assign( token.text );
+          fmt::format_to( std::back_inserter( bit_name ), "[{}]", i );
+          auto const bit = m.names.intern( bit_name );
+          m.word_bits.push_back( bit );
+          if ( ports )
+          {
+            ports->push_back( bit );
+          }
+        }
+        m.words[m.names.intern( token.text )] = w;
+      }
+      else if ( ports )
+      {
+        ports->push_back( m.names.intern( token.text ) );
+      }
+
+      auto const separator = lexer.next();
+      if ( separator.is( ';' ) )
+      {
+        return true;
+      }
+      if ( !separator.is( ',' ) )
+      {
+        return fail( separator, id );
+      }
+    }
+  }
+
+  /*! \brief Parses a name with an optional bit select and returns its net. */
+  std::optional<uint32_t> parse_net( verilog_token const& token )
+  {
+    if ( !lexer.peek().is( '[' ) )
+    {
+      return m.names.intern( token.text );
+    }
+    lexer.next();
+    auto const index = parse_number();
+    if ( !index || !expect( ']', lorina::diag_id::ERR_VERILOG_ASSIGNMENT_RHS ) )
+    {
+      return std::nullopt;
+    }
+    bit_name.assign( token.text );
+    fmt::format_to( std::back_inserter( bit_name ), "[{}]", *index );
+    return m.names.intern( bit_name );
+  }
+
+  uint32_t add_expr( verilog_expr_op op, uint32_t a, uint32_t b = 0u, uint32_t c = 0u )
+  {
+    m.exprs.push_back( { op, a, b, c } );
+    return static_cast<uint32_t>( m.exprs.size() - 1u );
+  }
+
+  /* expression grammar, from the lowest to the highest precedence: ?:, |, ^, &, ~ */
+  std::optional<uint32_t> parse_expr()
+  {
+    auto const cond = parse_binary( 0u );
+    if ( !cond || !lexer.peek().is( '?' ) )
+    {
+      return cond;
+    }
+    lexer.next();
+    auto const then_ = parse_expr();
+    if ( !then_ || !expect( ':', lorina::diag_id::ERR_VERILOG_ASSIGNMENT_RHS ) )
+    {
+      return std::nullopt;
+    }
+    auto const else_ = parse_expr();
+    if ( !else_ )
+    {
+      return std::nullopt;
+    }
+    return add_expr( verilog_expr_op::ite, *cond, *then_, *else_ );
+  }
+
+  std::optional<uint32_t> parse_binary( uint32_t level )
+  {
+    static constexpr char operators[] = { '|', '^', '&' };
+    static constexpr verilog_expr_op ops[] = { verilog_expr_op::or_, verilog_expr_op::xor_, verilog_expr_op::and_ };
+
+    auto lhs = level == 3u ? parse_unary() : parse_binary( level + 1u );
+    while ( lhs && level < 3u && lexer.peek().is( operators[level] ) )
+    {
+      lexer.next();
+      auto const rhs = parse_binary( level + 1u );
+      if ( !rhs )
+      {
+        return std::nullopt;
+      }
+      lhs = add_expr( ops[level], *lhs, *rhs );
+    }
+    return lhs;
+  }
+
+  std::optional<uint32_t> parse_unary()
+  {
+    auto const token = lexer.next();
+    if ( token.is( '~' ) || token.is( '!' ) )
+    {
+      auto const child = parse_unary();
+      return child ? std::optional<uint32_t>( add_expr( verilog_expr_op::not_, *child ) ) : std::nullopt;
+    }
+    if ( token.is( '(' ) )
+    {
+      auto const inner = parse_expr();
+      if ( !inner || !expect( ')', lorina::diag_id::ERR_VERILOG_ASSIGNMENT_RHS ) )
+      {
+        return std::nullopt;
+      }
+      return inner;
+    }
+    if ( token.kind == verilog_token_kind::identifier )
+    {
+      auto const net = parse_net( token );
+      return net ? std::optional<uint32_t>( add_expr( verilog_expr_op::net, *net ) ) : std::nullopt;
+    }
+    if ( token.kind == verilog_token_kind::number )
+    {
+      /* 0, 1, 1'b0, 1'b1, 1'h0, 1'h1 */
+      auto const quote = token.text.find( '\'' );
+      auto const digits = quote == std::string_view::npos ? token.text : token.text.substr( std::min( token.text.size(), quote + 2u ) );
+      if ( digits.size() == 1u && ( digits.front() == '0' || digits.front() == '1' ) &&
+           ( quote == std::string_view::npos || token.text.substr( 0u, quote ) == "1" ) )
+      {
+        return add_expr( verilog_expr_op::constant, digits.front() == '1' ? 1u : 0u );
+      }
+    }
+    fail( token, lorina::diag_id::ERR_VERILOG_ASSIGNMENT_RHS );
+    return std::nullopt;
+  }
+
+  bool parse_assign()
+  {
+    auto const token = lexer.next();
+    if ( token.kind != verilog_token_kind::identifier )
+    {
+      return fail( token, lorina::diag_id::ERR_VERILOG_ASSIGNMENT );
+    }
+    auto const lhs = parse_net( token );
+    if ( !lhs || !expect( '=', lorina::diag_id::ERR_VERILOG_ASSIGNMENT ) )
+    {
+      return false;
+    }
+    auto const rhs = parse_expr();
+    if ( !rhs || !expect( ';', lorina::diag_id::ERR_VERILOG_ASSIGNMENT ) )
+    {
+      return false;
+    }
+    m.assigns.emplace_back( *lhs, *rhs );
+    return true;
+  }
+
+  bool parse_instance( verilog_token const& module_name )
+  {
+    auto const id = lorina::diag_id::ERR_VERILOG_MODULE_INSTANTIATION_STATEMENT;
+
+    auto const inst_name = lexer.next();
+    if ( inst_name.kind != verilog_token_kind::identifier )
+    {
+      return fail( inst_name.is( '#' ) ? module_name : inst_name, id );
+    }
+
+    verilog_module::instance inst{ module_name.text, static_cast<uint32_t>( m.bindings.size() ), 0u };
+    if ( !expect( '(', id ) )
+    {
+      return false;
+    }
+    while ( !lexer.peek().is( ')' ) )
+    {
+      verilog_module::binding b{};
+      if ( lexer.peek().is( '.' ) )
+      {
+        lexer.next();
+        auto const formal = lexer.next();
+        if ( formal.kind != verilog_token_kind::identifier || !expect( '(', id ) )
+        {
+          return fail( formal, id );
+        }
+        b.formal = formal.text;
+        auto const actual = parse_expr();
+        if ( !actual || !expect( ')', id ) )
+        {
+          return false;
+        }
+        b.actual = *actual;
+      }
+      else
+      {
+        auto const actual = parse_expr();
+        if ( !actual )
+        {
+          return false;
+        }
+        b.actual = *actual;
+      }
+      m.bindings.push_back( b );
+      ++inst.num_bindings;
+
+      if ( lexer.peek().is( ',' ) )
+      {
+        lexer.next();
+      }
+      else if ( !lexer.peek().is( ')' ) )
+      {
+        return fail( lexer.peek(), id );
+      }
+    }
+    lexer.next();
+    if ( !expect( ';', id ) )
+    {
+      return false;
+    }
+    m.instances.push_back( inst );
+    return true;
+  }
+
+private:
+  std::string_view buffer;
+  verilog_lexer lexer;
+  verilog_module& m;
+  std::string bit_name;
+};
+
+/*! \brief Resolves the instances of a module and computes the driver of each net. */
+inline bool link_verilog_module( verilog_module& m, std::vector<verilog_module> const& modules, std::unordered_map<std::string_view, uint32_t> const& module_index )
+{
+  auto const fail = [&]( lorina::diag_id id, std::string_view arg ) {
+    m.error = std::string( arg );
+    m.error_id = id;
+    return false;
+  };
+
+  /* bits of a port or of a word, by name */
+  std::vector<uint32_t> bits;
+  auto const port_bits = [&]( verilog_module const& owner, uint32_t name ) {
+    bits.clear();
+    if ( auto const it = owner.words.find( name ); it != owner.words.end() )
+    {
+      bits.insert( bits.end(), owner.word_bits.begin() + it->second.first_bit, owner.word_bits.begin() + it->second.first_bit + it->second.width );
+    }
+    else
+    {
+      bits.push_back( name );
+    }
+  };
+
+  std::vector<uint32_t> actuals;
+  for ( auto& inst : m.instances )
+  {
+    auto const it = module_index.find( inst.module_name );
+    if ( it == module_index.end() )
+    {
+      return fail( lorina::diag_id::ERR_VERILOG_MODULE_INSTANTIATION_UNDECLARED_MODULE, inst.module_name );
+    }
+    inst.module = it->second;
+    auto const& callee = modules[inst.module];
+
+    inst.first_input = static_cast<uint32_t>( m.instance_inputs.size() );
+    inst.first_output = static_cast<uint32_t>( m.instance_outputs.size() );
+    m.instance_inputs.resize( m.instance_inputs.size() + callee.inputs.size(), verilog_module::none );
+    m.instance_outputs.resize( m.instance_outputs.size() + callee.outputs.size(), verilog_module::none );
+
+    for ( auto i = 0u; i < inst.num_bindings; ++i )
+    {
+      auto const& b = m.bindings[inst.first_binding + i];
+      uint32_t formal;
+      if ( b.formal.empty() )
+      {
+        if ( i >= callee.header.size() )
+        {
+          return fail( lorina::diag_id::ERR_VERILOG_MODULE_INSTANTIATION_STATEMENT, inst.module_name );
+        }
+        formal = callee.header[i];
+      }
+      else
+      {
+        formal = callee.names.find( b.formal );
+        if ( formal == callee.names.size() )
+        {
+          return fail( lorina::diag_id::ERR_VERILOG_MODULE_INSTANTIATION_UNDECLARED_PIN, b.formal );
+        }
+      }
+      port_bits( callee, formal );
+
+      /* actual expression per bit; words are connected bit by bit */
+      actuals.clear();
+      if ( bits.size() == 1u )
+      {
+        actuals.push_back( b.actual );
+      }
+      else
+      {
+        auto const& actual = m.exprs[b.actual];
+        auto const word = actual.op == verilog_expr_op::net ? m.words.find( actual.a ) : m.words.end();
+        if ( word == m.words.end() || word->second.width != bits.size() )
+        {
+          return fail( lorina::diag_id::ERR_VERILOG_MODULE_INSTANTIATION_STATEMENT, inst.module_name );
+        }
+        for ( auto j = 0u; j < word->second.width; ++j )
+        {
+          m.exprs.push_back( { verilog_expr_op::net, m.word_bits[word->second.first_bit + j] } );
+          actuals.push_back( static_cast<uint32_t>( m.exprs.size() - 1u ) );
+        }
+      }
+
+      for ( auto j = 0u; j < bits.size(); ++j )
+      {
+        auto const port = callee.port_positions.find( bits[j] );
+        if ( port == callee.port_positions.end() )
+        {
+          return fail( lorina::diag_id::ERR_VERILOG_MODULE_INSTANTIATION_UNDECLARED_PIN, callee.names.name( bits[j] ) );
+        }
+        if ( port->second & 1u )
+        {
+          auto const& actual = m.exprs[actuals[j]];
+          if ( actual.op != verilog_expr_op::net )
+          {
+            return fail( lorina::diag_id::ERR_VERILOG_MODULE_INSTANTIATION_STATEMENT, inst.module_name );
+          }
+          m.instance_outputs[inst.first_output + ( port->second >> 1 )] = actual.a;
+        }
+        else
+        {
+          m.instance_inputs[inst.first_input + ( port->second >> 1 )] = actuals[j];
+        }
+      }
+    }
+
+    for ( auto i = 0u; i < callee.inputs.size(); ++i )
+    {
+      if ( m.instance_inputs[inst.first_input + i] == verilog_module::none )
+      {
+        return fail( lorina::diag_id::ERR_VERILOG_MODULE_INSTANTIATION_UNDECLARED_PIN, callee.names.name( callee.inputs[i] ) );
+      }
+    }
+  }
+
+  /* drivers */
+  m.drivers.assign( m.names.size(), { verilog_module::driver_kind::none, 0u } );
+  auto const drive = [&]( uint32_t net, verilog_module::driver_kind kind, uint32_t index ) {
+    if ( m.drivers[net].first != verilog_module::driver_kind::none )
+    {
+      return false;
+    }
+    m.drivers[net] = { kind, index };
+    return true;
+  };
+  for ( auto i = 0u; i < m.assigns.size(); ++i )
+  {
+    if ( !drive( m.assigns[i].first, verilog_module::driver_kind::assign, i ) )
+    {
+      return fail( lorina::diag_id::ERR_VERILOG_ASSIGNMENT, m.names.name( m.assigns[i].first ) );
+    }
+  }
+  for ( auto i = 0u; i < m.instances.size(); ++i )
+  {
+    auto const& inst = m.instances[i];
+    for ( auto j = 0u; j < modules[inst.module].outputs.size(); ++j )
+    {
+      if ( auto const net = m.instance_outputs[inst.first_output + j]; net != verilog_module::none && !drive( net, verilog_module::driver_kind::instance, i ) )
+      {
+        return fail( lorina::diag_id::ERR_VERILOG_MODULE_INSTANTIATION_STATEMENT, inst.module_name );
+      }
+    }
+  }
+  for ( auto const& input : m.inputs )
+  {
+    if ( m.drivers[input].first != verilog_module::driver_kind::none )
+    {
+      return fail( lorina::diag_id::ERR_VERILOG_INPUT_DECLARATION, m.names.name( input ) );
+    }
+  }
+  return true;
+}
+
+/*! \brief Instantiates linked modules into a network. */
+template<class Ntk>
+class verilog_elaborator
+{
+  enum class net_state : uint8_t
+  {
+    unknown,
+    visiting,
+    done
+  };
+
+public:
+  verilog_elaborator( Ntk& ntk, std::vector<verilog_module> const& modules, lorina::diagnostic_engine* diag )
+      : ntk( ntk ), modules( modules ), diag( diag ), active( modules.size(), false )
+  {
+  }
+
+  /*! \brief Instantiates module `index` and returns the signals of its outputs. */
+  std::optional<std::vector<signal<Ntk>>> instantiate( uint32_t index, std::vector<signal<Ntk>> const& inputs )
+  {
+    auto const& m = modules[index];
+    if ( active[index] )
+    {
+      return unresolved( m, m.name, m.name );
+    }
+    active[index] = true;
+    if ( stacks.size() <= depth )
+    {
+      stacks.emplace_back();
+    }
+    ++depth;
+
+    std::vector<signal<Ntk>> values( m.names.size() );
+    std::vector<net_state> states( m.names.size(), net_state::unknown );
+    for ( auto i = 0u; i < m.inputs.size(); ++i )
+    {
+      values[m.inputs[i]] = inputs[i];
+      states[m.inputs[i]] = net_state::done;
+    }
+
+    for ( auto const& a : m.assigns )
+    {
+      if ( !evaluate( m, a.first, values, states ) )
+      {
+        return std::nullopt;
+      }
+    }
+    for ( auto i = 0u; i < m.instances.size(); ++i )
+    {
+      if ( !evaluate_instance( m, i, values, states ) )
+      {
+        return std::nullopt;
+      }
+    }
+
+    std::vector<signal<Ntk>> outputs;
+    outputs.reserve( m.outputs.size() );
+    for ( auto const& o : m.outputs )
+    {
+      if ( !evaluate( m, o, values, states ) )
+      {
+        return std::nullopt;
+      }
+      outputs.push_back( values[o] );
+    }
+
+    active[index] = false;
+    --depth;
+    return outputs;
+  }
+
+private:
+  std::nullopt_t unresolved( verilog_module const& m, std::string_view name, std::string_view dependency ) const
+  {
+    if ( diag )
+    {
+      diag->report( lorina::diag_id::WRN_UNRESOLVED_DEPENDENCY ).add_argument( fmt::format( "{}.{}", m.name, name ) ).add_argument( fmt::format( "{}.{}", m.name, dependency ) );
+    }
+    return std::nullopt;
+  }
+
+  template<class Fn>
+  void foreach_leaf( verilog_module const& m, uint32_t expr, Fn&& fn )
+  {
+    leaves_stack.clear();
+    leaves_stack.push_back( expr );
+    while ( !leaves_stack.empty() )
+    {
+      auto const& e = m.exprs[leaves_stack.back()];
+      leaves_stack.pop_back();
+      switch ( e.op )
+      {
+      case verilog_expr_op::net:
+        fn( e.a );
+        break;
+      case verilog_expr_op::constant:
+        break;
+      case verilog_expr_op::ite:
+        leaves_stack.push_back( e.c );
+        [[fallthrough]];
+      case verilog_expr_op::and_:
+      case verilog_expr_op::or_:
+      case verilog_expr_op::xor_:
+        leaves_stack.push_back( e.b );
+        [[fallthrough]];
+      case verilog_expr_op::not_:
+        leaves_stack.push_back( e.a );
+        break;
+      }
+    }
+  }
+
+  /*! \brief Computes the signal of a net after the signals of all nets it depends on. */
+  bool evaluate( verilog_module const& m, uint32_t net, std::vector<signal<Ntk>>& values, std::vector<net_state>& states )
+  {
+    /* one stack per level of the module hierarchy, since instances are evaluated recursively */
+    auto& stack = stacks[depth - 1u];
+    stack.clear();
+    stack.push_back( net );
+    while ( !stack.empty() )
+    {
+      auto const n = stack.back();
+      if ( states[n] == net_state::done )
+      {
+        stack.pop_back();
+        continue;
+      }
+
+      auto const [kind, index] = m.drivers[n];
+      if ( kind == verilog_module::driver_kind::none )
+      {
+        unresolved( m, stack.size() > 1u ? m.names.name( stack[stack.size() - 2u] ) : m.names.name( n ), m.names.name( n ) );
+        return false;
+      }
+
+      if ( states[n] == net_state::unknown )
+      {
+        states[n] = net_state::visiting;
+        bool cycle = false;
+        auto const push = [&]( uint32_t leaf ) {
+          if ( states[leaf] == net_state::visiting )
+          {
+            cycle = true;
+          }
+          else if ( states[leaf] == net_state::unknown )
+          {
+            stack.push_back( leaf );
+          }
+        };
+        if ( kind == verilog_module::driver_kind::assign )
+        {
+          foreach_leaf( m, m.assigns[index].second, push );
+        }
+        else
+        {
+          auto const& inst = m.instances[index];
+          for ( auto i = 0u; i < modules[inst.module].inputs.size(); ++i )
+          {
+            foreach_leaf( m, m.instance_inputs[inst.first_input + i], push );
+          }
+        }
+        if ( cycle )
+        {
+          unresolved( m, m.names.name( n ), m.names.name( n ) );
+          return false;
+        }
+        continue;
+      }
+
+      stack.pop_back();
+      if ( kind == verilog_module::driver_kind::assign )
+      {
+        values[n] = build( m, m.assigns[index].second, values );
+        states[n] = net_state::done;
+      }
+      else if ( !instantiate_instance( m, index, values, states ) )
+      {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  bool evaluate_instance( verilog_module const& m, uint32_t index, std::vector<signal<Ntk>>& values, std::vector<net_state>& states )
+  {
+    auto const& inst = m.instances[index];
+    for ( auto i = 0u; i < modules[inst.module].outputs.size(); ++i )
+    {
+      if ( auto const net = m.instance_outputs[inst.first_output + i]; net != verilog_module::none )
+      {
+        return evaluate( m, net, values, states );
+      }
+    }
+
+    /* instance without connected outputs */
+    std::vector<uint32_t> leaves;
+    for ( auto i = 0u; i < modules[inst.module].inputs.size(); ++i )
+    {
+      foreach_leaf( m, m.instance_inputs[inst.first_input + i], [&]( uint32_t leaf ) { leaves.push_back( leaf ); } );
+    }
+    for ( auto const& leaf : leaves )
+    {
+      if ( !evaluate( m, leaf, values, states ) )
+      {
+        return false;
+      }
+    }
+    return instantiate_instance( m, index, values, states );
+  }
+
+  bool instantiate_instance( verilog_module const& m, uint32_t index, std::vector<signal<Ntk>>& values, std::vector<net_state>& states )
+  {
+    auto const& inst = m.instances[index];
+    auto const& callee = modules[inst.module];
+
+    std::vector<signal<Ntk>> inputs;
+    inputs.reserve( callee.inputs.size() );
+    for ( auto i = 0u; i < callee.inputs.size(); ++i )
+    {
+      inputs.push_back( build( m, m.instance_inputs[inst.first_input + i], values ) );
+    }
+
+    auto const outputs = instantiate( inst.module, inputs );
+    if ( !outputs )
+    {
+      return false;
+    }
+    for ( auto i = 0u; i < callee.outputs.size(); ++i )
+    {
+      if ( auto const net = m.instance_outputs[inst.first_output + i]; net != verilog_module::none )
+      {
+        values[net] = ( *outputs )[i];
+        states[net] = net_state::done;
+      }
+    }
+    return true;
+  }
+
+  /*! \brief Returns the literal of a leaf or a complemented leaf as ( net << 1 ) | complemented. */
+  static std::optional<uint32_t> literal( verilog_module const& m, uint32_t expr )
+  {
+    auto const& e = m.exprs[expr];
+    if ( e.op == verilog_expr_op::net )
+    {
+      return e.a << 1;
+    }
+    if ( e.op == verilog_expr_op::not_ && m.exprs[e.a].op == verilog_expr_op::net )
+    {
+      return ( m.exprs[e.a].a << 1 ) | 1u;
+    }
+    return std::nullopt;
+  }
+
+  /*! \brief Recognizes `( a & b ) | ( a & c ) | ( b & c )` and returns the expressions of a, b, and c. */
+  static std::optional<std::array<uint32_t, 3>> match_maj( verilog_module const& m, verilog_expr const& e )
+  {
+    std::array<uint32_t, 3> terms;
+    if ( m.exprs[e.a].op == verilog_expr_op::or_ )
+    {
+      terms = { m.exprs[e.a].a, m.exprs[e.a].b, e.b };
+    }
+    else if ( m.exprs[e.b].op == verilog_expr_op::or_ )
+    {
+      terms = { e.a, m.exprs[e.b].a, m.exprs[e.b].b };
+    }
+    else
+    {
+      return std::nullopt;
+    }
+
+    std::array<uint32_t, 6> operands;
+    std::array<uint32_t, 6> lits;
+    for ( auto i = 0u; i < 3u; ++i )
+    {
+      auto const& t = m.exprs[terms[i]];
+      if ( t.op != verilog_expr_op::and_ )
+      {
+        return std::nullopt;
+      }
+      auto const l0 = literal( m, t.a );
+      auto const l1 = literal( m, t.b );
+      if ( !l0 || !l1 || *l0 == *l1 )
+      {
+        return std::nullopt;
+      }
+      operands[2 * i] = t.a;
+      operands[2 * i + 1] = t.b;
+      lits[2 * i] = *l0;
+      lits[2 * i + 1] = *l1;
+    }
+
+    /* the three terms must be the three pairs of three distinct literals */
+    std::array<uint32_t, 3> result;
+    std::array<uint32_t, 3> distinct;
+    auto num_distinct = 0u;
+    for ( auto i = 0u; i < 6u; ++i )
+    {
+      auto const it = std::find( distinct.begin(), distinct.begin() + num_distinct, lits[i] );
+      if ( it == distinct.begin() + num_distinct )
+      {
+        if ( num_distinct == 3u )
+        {
+          return std::nullopt;
+        }
+        result[num_distinct] = operands[i];
+        distinct[num_distinct++] = lits[i];
+      }
+    }
+    auto const pair_key = [&]( uint32_t a, uint32_t b ) { return std::make_pair( std::min( a, b ), std::max( a, b ) ); };
+    if ( num_distinct != 3u ||
+         pair_key( lits[0], lits[1] ) == pair_key( lits[2], lits[3] ) ||
+         pair_key( lits[0], lits[1] ) == pair_key( lits[4], lits[5] ) ||
+         pair_key( lits[2], lits[3] ) == pair_key( lits[4], lits[5] ) )
+    {
+      return std::nullopt;
+    }
+    return result;
+  }
+
+  signal<Ntk> build( verilog_module const& m, uint32_t expr, std::vector<signal<Ntk>> const& values )
+  {
+    auto const& e = m.exprs[expr];
+    switch ( e.op )
+    {
+    case verilog_expr_op::net:
+      return values[e.a];
+    case verilog_expr_op::constant:
+      return ntk.get_constant( e.a != 0u );
+    case verilog_expr_op::not_:
+      return ntk.create_not( build( m, e.a, values ) );
+    case verilog_expr_op::and_:
+      return ntk.create_and( build( m, e.a, values ), build( m, e.b, values ) );
+    case verilog_expr_op::or_:
+      if ( auto const maj = match_maj( m, e ) )
+      {
+        return ntk.create_maj( build( m, ( *maj )[0], values ), build( m, ( *maj )[1], values ), build( m, ( *maj )[2], values ) );
+      }
+      return ntk.create_or( build( m, e.a, values ), build( m, e.b, values ) );
+    case verilog_expr_op::xor_:
+      if constexpr ( has_create_xor3_v<Ntk> )
+      {
+        if ( m.exprs[e.a].op == verilog_expr_op::xor_ )
+        {
+          auto const& inner = m.exprs[e.a];
+          return ntk.create_xor3( build( m, inner.a, values ), build( m, inner.b, values ), build( m, e.b, values ) );
+        }
+      }
+      return ntk.create_xor( build( m, e.a, values ), build( m, e.b, values ) );
+    case verilog_expr_op::ite:
+      return ntk.create_ite( build( m, e.a, values ), build( m, e.b, values ), build( m, e.c, values ) );
+    }
+    return ntk.get_constant( false );
+  }
+
+private:
+  Ntk& ntk;
+  std::vector<verilog_module> const& modules;
+  lorina::diagnostic_engine* diag;
+  std::vector<bool> active;
+  std::deque<std::vector<uint32_t>> stacks; /* references stay valid when growing */
+  uint32_t depth{ 0u };
+  std::vector<uint32_t> leaves_stack;
+};
+
+/*! \brief Runs `fn( i )` for all `i < size`, distributed over threads. */
+template<class Fn>
+void parallel_for_each_index( uint32_t size, uint32_t num_threads, Fn&& fn )
+{
+  if ( num_threads == 0u )
+  {
+    num_threads = std::max( 1u, std::thread::hardware_concurrency() );
+  }
+  num_threads = std::min( num_threads, size );
+  if ( num_threads <= 1u )
+  {
+    for ( auto i = 0u; i < size; ++i )
+    {
+      fn( i );
+    }
+    return;
+  }
+
+  std::atomic<uint32_t> next{ 0u };
+  std::vector<std::thread> threads;
+  threads.reserve( num_threads );
+  for ( auto t = 0u; t < num_threads; ++t )
+  {
+    threads.emplace_back( [&]() {
+      for ( auto i = next++; i < size; i = next++ )
+      {
+        fn( i );
+      }
+    } );
+  }
+  for ( auto& thread : threads )
+  {
+    thread.join();
+  }
+}
+
+} // namespace detail
+
+/*! \brief Reads a structural Verilog netlist from a memory buffer.
+ *
+ * See `read_verilog_fast` for the supported subset of Verilog.
+ */
+template<class Ntk>
+[[nodiscard]] lorina::return_code read_verilog_fast_from_buffer( std::string_view buffer, Ntk& ntk, fast_verilog_reader_params const& ps = {}, lorina::diagnostic_engine* diag = nullptr )
+{
+  static_assert( is_network_type_v<Ntk>, "Ntk is not a network type" );
+  static_assert( has_create_pi_v<Ntk>, "Ntk does not implement the create_pi function" );
+  static_assert( has_create_po_v<Ntk>, "Ntk does not implement the create_po function" );
+  static_assert( has_get_constant_v<Ntk>, "Ntk does not implement the get_constant function" );
+  static_assert( has_create_not_v<Ntk>, "Ntk does not implement the create_not function" );
+  static_assert( has_create_and_v<Ntk>, "Ntk does not implement the create_and function" );
+  static_assert( has_create_or_v<Ntk>, "Ntk does not implement the create_or function" );
+  static_assert( has_create_xor_v<Ntk>, "Ntk does not implement the create_xor function" );
+  static_assert( has_create_ite_v<Ntk>, "Ntk does not implement the create_ite function" );
+  static_assert( has_create_maj_v<Ntk>, "Ntk does not implement the create_maj function" );
+
+  auto const ranges = detail::split_verilog_modules( buffer );
+  std::vector<detail::verilog_module> modules( ranges.size() );
+
+  auto const report = [&]( detail::verilog_module const& m ) {
+    if ( diag )
+    {
+      diag->report( m.error_id ).add_argument( *m.error );
+    }
+    return lorina::return_code::parse_error;
+  };
+
+  /* parse modules in parallel */
+  detail::parallel_for_each_index( static_cast<uint32_t>( modules.size() ), ps.num_threads, [&]( uint32_t i ) {
+    detail::verilog_module_parser( buffer, ranges[i], modules[i] ).run();
+  } );
+
+  std::unordered_map<std::string_view, uint32_t> module_index;
+  for ( auto i = 0u; i < modules.size(); ++i )
+  {
+    if ( modules[i].error )
+    {
+      return report( modules[i] );
+    }
+    module_index[modules[i].name] = i;
+  }
+
+  /* resolve instances in parallel */
+  detail::parallel_for_each_index( static_cast<uint32_t>( modules.size() ), ps.num_threads, [&]( uint32_t i ) {
+    detail::link_verilog_module( modules[i], modules, module_index );
+  } );
+
+  for ( auto& m : modules )
+  {
+    if ( m.error )
+    {
+      return report( m );
+    }
+    for ( auto const& inst : m.instances )
+    {
+      modules[inst.module].instantiated = true;
+    }
+  }
+
+  /* top module */
+  std::optional<uint32_t> top;
+  if ( !ps.top_module.empty() )
+  {
+    if ( auto const it = module_index.find( ps.top_module ); it != module_index.end() )
+    {
+      top = it->second;
+    }
+  }
+  else
+  {
+    for ( auto i = 0u; i < modules.size(); ++i )
+    {
+      if ( !modules[i].instantiated )
+      {
+        top = i;
+      }
+    }
+  }
+  if ( !top )
+  {
+    if ( diag )
+    {
+      diag->report( lorina::diag_id::ERR_VERILOG_MODULE_INSTANTIATION_UNDECLARED_MODULE ).add_argument( ps.top_module );
+    }
+    return lorina::return_code::parse_error;
+  }
+
+  auto const& m = modules[*top];
+  if constexpr ( has_set_network_name_v<Ntk> )
+  {
+    ntk.set_network_name( std::string( m.name ) );
+  }
+
+  std::vector<signal<Ntk>> inputs;
+  inputs.reserve( m.inputs.size() );
+  for ( auto const& input : m.inputs )
+  {
+    inputs.push_back( ntk.create_pi() );
+    if constexpr ( has_set_name_v<Ntk> )
+    {
+      ntk.set_name( inputs.back(), std::string( m.names.name( input ) ) );
+    }
+  }
+
+  auto const outputs = detail::verilog_elaborator<Ntk>( ntk, modules, diag ).instantiate( *top, inputs );
+  if ( !outputs )
+  {
+    return lorina::return_code::parse_error;
+  }
+
+  for ( auto i = 0u; i < outputs->size(); ++i )
+  {
+    ntk.create_po( ( *outputs )[i] );
+    if constexpr ( has_set_output_name_v<Ntk> )
+    {
+      ntk.set_output_name( i, std::string( m.names.name( m.outputs[i] ) ) );
+    }
+  }
+
+  return lorina::return_code::success;
+}
+
+/*! \brief Reads a structural Verilog netlist without going through lorina's callbacks.
+ *
+ * This is a fast path for very large netlists.  The file is memory-mapped and
+ * first split into modules.  The modules are then tokenized without copying
+ * the text, with signal names stored once per module in an arena, and
+ * translated into flat netlists in parallel.  Finally, the top module is
+ * instantiated into the network, inlining the netlists of the modules it
+ * instantiates.
+ *
+ * Modules may contain `input`, `output`, and `wire` declarations (also with
+ * bit ranges), `assign` statements with expressions over `~`, `&`, `|`, `^`,
+ * and `? :`, and instances of other modules in the file, with named or
+ * positional port connections.  Statements may appear in any order.  The
+ * predefined modules of `verilog_reader` (e.g., `ripple_carry_adder`) and
+ * module parameters are not supported.  Majority expressions written as
+ * `( a & b ) | ( a & c ) | ( b & c )` are created with `create_maj`.
+ *
+ * **Required network functions:**
+ * - `create_pi`
+ * - `create_po`
+ * - `get_constant`
+ * - `create_not`
+ * - `create_and`
+ * - `create_or`
+ * - `create_xor`
+ * - `create_ite`
+ * - `create_maj`
+ *
+   \verbatim embed:rst
+
+   Example
+
+   .. code-block:: c++
+
+      aig_network aig;
+      fast_verilog_reader_params ps;
+      ps.num_threads = 4u;
+      if ( read_verilog_fast( "file.v", aig, ps ) != lorina::return_code::success )
+      {
+        std::cout << "read failed\n";
+      }
+   \endverbatim
+ */
+template<class Ntk>
+[[nodiscard]] lorina::return_code read_verilog_fast( std::string const& filename, Ntk& ntk, fast_verilog_reader_params const& ps = {}, lorina::diagnostic_engine* diag = nullptr )
+{
+  detail::mapped_file file( filename );
+  if ( !file.is_open() )
+  {
+    if ( diag )
+    {
+      diag->report( lorina::diag_id::ERR_FILE_OPEN ).add_argument( filename );
+    }
+    return lorina::return_code::parse_error;
+  }
+  return read_verilog_fast_from_buffer( file.view(), ntk, ps, diag );
+}
+
+} // namespace mockturtle
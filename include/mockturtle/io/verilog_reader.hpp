@@ -49,6 +49,7 @@
 #include "../generators/arithmetic.hpp"
 #include "../generators/modular_arithmetic.hpp"
 #include "../traits.hpp"
+#include "../utils/tracing.hpp"
 
 namespace mockturtle
 {
@@ -621,6 +622,8 @@ private:
 private:
   Ntk& ntk_;
 
+  trace_span span_{ "read_verilog", "io" };
+
   std::string const top_module_name_;
 
   mutable std::map<std::string, signal<Ntk>> signals_;
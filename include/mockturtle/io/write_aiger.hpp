@@ -38,6 +38,7 @@
 #pragma once
 
 #include "../traits.hpp"
+#include "../utils/tracing.hpp"
 
 #include <cstdio>
 #include <fstream>
@@ -97,6 +98,8 @@ inline void write_aiger( Ntk const& aig, std::ostream& os )
 
   assert( aig.is_combinational() && "Network has to be combinational" );
 
+  trace_span span( "write_aiger", "io" );
+
   using node = typename Ntk::node;
   using signal = typename Ntk::signal;
 
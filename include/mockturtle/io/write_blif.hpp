@@ -37,7 +37,9 @@
 
 #include "../networks/sequential.hpp"
 #include "../traits.hpp"
+#include "../utils/tracing.hpp"
 #include "../views/topo_view.hpp"
+#include "detail/chunked_output.hpp"
 
 #include <kitty/constructors.hpp>
 #include <kitty/isop.hpp>
@@ -49,6 +51,7 @@
 #include <fstream>
 #include <iostream>
 #include <string>
+#include <vector>
 
 namespace mockturtle
 {
@@ -86,6 +89,9 @@ struct write_blif_params
     * ```
    */
   uint32_t rename_ri_using_node = 0u;
+
+  /*! \brief Number of threads formatting nodes (0: all hardware threads). */
+  uint32_t num_threads = 1u;
 };
 
 /*! \brief Writes network in BLIF format into output stream
@@ -124,6 +130,8 @@ void write_blif( Ntk const& ntk, std::ostream& os, write_blif_params const& ps =
   static_assert( has_node_to_index_v<Ntk>, "Ntk does not implement the node_to_index method" );
   static_assert( has_node_function_v<Ntk>, "Ntk does not implement the node_function method" );
 
+  trace_span span( "write_blif", "io" );
+
   uint32_t num_latches{ 0 };
   if constexpr ( has_num_registers_v<Ntk> )
   {
@@ -238,69 +246,52 @@ void write_blif( Ntk const& ntk, std::ostream& os, write_blif_params const& ps =
     defined_names.insert( "new_n1" ); /* we should not have collision here */
   }
 
-  /* write nodes */
+  /* resolve names in topological order */
+  std::vector<std::string> node_names( topo_ntk.size() );
+  std::vector<node<Ntk>> order;
   topo_ntk.foreach_node( [&]( auto const& n ) {
-    if ( topo_ntk.is_constant( n ) || topo_ntk.is_ci( n ) )
-      return; /* continue */
+    auto& name = node_names[topo_ntk.node_to_index( n )];
+    if constexpr ( has_has_name_v<Ntk> && has_get_name_v<Ntk> )
+    {
+      signal<Ntk> const s = topo_ntk.make_signal( n );
+      name = topo_ntk.has_name( s ) ? topo_ntk.get_name( s ) : topo_ntk.is_pi( n ) ? fmt::format( "pi{}", n ) : fmt::format( "new_n{}", n );
+    }
+    else
+    {
+      name = topo_ntk.is_pi( n ) ? fmt::format( "pi{}", n ) : fmt::format( "new_n{}", n );
+    }
+
+    if ( !topo_ntk.is_constant( n ) && !topo_ntk.is_ci( n ) )
+    {
+      defined_names.insert( name ); /* we should not have collision here */
+      order.push_back( n );
+    }
+  } );
+
+  auto const write_node = [&]( std::ostream& os, node<Ntk> const& n ) {
+    std::string const& fanout_name = node_names[topo_ntk.node_to_index( n )];
 
     /* write truth table of node */
-    auto func = topo_ntk.node_function( n );
+    auto const cubes = isop( topo_ntk.node_function( n ) );
 
-    if ( isop( func ).size() == 0 ) /* constants */
+    if ( cubes.size() == 0 ) /* constants */
     {
-      if constexpr ( has_has_name_v<Ntk> && has_get_name_v<Ntk> )
-      {
-        auto const s = topo_ntk.make_signal( n );
-        std::string const constant_name = topo_ntk.has_name( s ) ? topo_ntk.get_name( s ) : fmt::format( "new_n{}", topo_ntk.get_node( s ) );
-        os << fmt::format( ".names {}\n", constant_name );
-        os << "0" << '\n';
-        defined_names.insert( constant_name ); /* we should not have collision here */
-      }
-      else
-      {
-        std::string const constant_name = fmt::format( "new_n{}", n );
-        os << fmt::format( ".names {}\n", constant_name );
-        os << "0" << '\n';
-        defined_names.insert( constant_name ); /* we should not have collision here */
-      }
+      os << fmt::format( ".names {}\n", fanout_name );
+      os << "0" << '\n';
       return;
     }
 
-    os << fmt::format( ".names " );
+    os << ".names ";
 
     /* write fanins of node */
     topo_ntk.foreach_fanin( n, [&]( auto const& f ) {
-      auto f_node = topo_ntk.get_node( f );
-      if constexpr ( has_has_name_v<Ntk> && has_get_name_v<Ntk> )
-      {
-        signal<Ntk> const s = topo_ntk.make_signal( f_node );
-        std::string const fanin_name = topo_ntk.has_name( s ) ? topo_ntk.get_name( s ) : topo_ntk.is_pi( f_node ) ? fmt::format( "pi{}", f_node ) : fmt::format( "new_n{}", f_node );
-        os << fanin_name << ' ';
-      }
-      else
-      {
-        std::string const fanin_name = topo_ntk.is_pi( f_node ) ? fmt::format( "pi{} ", f_node ) : fmt::format( "new_n{} ", f_node );
-        os << fanin_name;
-      }
+      os << node_names[topo_ntk.node_to_index( topo_ntk.get_node( f ) )] << ' ';
     } );
 
     /* write fanout of node */
-    if constexpr ( has_has_name_v<Ntk> && has_get_name_v<Ntk> )
-    {
-      auto const s = topo_ntk.make_signal( n );
-      std::string const fanout_name = topo_ntk.has_name( s ) ? topo_ntk.get_name( s ) : fmt::format( "new_n{}", topo_ntk.get_node( s ) );
-      os << fanout_name << '\n';
-      defined_names.insert( fanout_name ); /* we should not have collision here */
-    }
-    else
-    {
-      std::string const fanout_name = fmt::format( "new_n{}", n );
-      os << fanout_name << '\n';
-      defined_names.insert( fanout_name ); /* we should not have collision here */
-    }
+    os << fanout_name << '\n';
 
-    int count = 0;
-    for ( auto cube : isop( func ) )
+    for ( auto cube : cubes )
     {
       topo_ntk.foreach_fanin( n, [&]( auto const& f, auto index ) {
         if ( cube.get_mask( index ) && topo_ntk.is_complemented( f ) )
@@ -309,7 +300,14 @@ void write_blif( Ntk const& ntk, std::ostream& os, write_blif_params const& ps =
 
       cube.print( topo_ntk.fanin_size( n ), os );
       os << " 1\n";
-      count++;
+    }
+  };
+
+  /* write nodes, possibly formatting chunks of them in parallel */
+  detail::format_chunks( os, static_cast<uint32_t>( order.size() ), ps.num_threads, [&]( std::ostream& out, uint32_t begin, uint32_t end ) {
+    for ( auto i = begin; i < end; ++i )
+    {
+      write_node( out, order[i] );
     }
   } );
 
@@ -422,7 +420,7 @@ void write_blif( Ntk const& ntk, std::ostream& os, write_blif_params const& ps =
 template<class Ntk>
 void write_blif( Ntk const& ntk, std::string const& filename, write_blif_params const& ps = {} )
 {
-  std::ofstream os( filename.c_str(), std::ofstream::out );
+  detail::buffered_ofstream os( filename );
   write_blif( ntk, os, ps );
   os.close();
 }
@@ -38,8 +38,10 @@
 #include "../traits.hpp"
 #include "../utils/node_map.hpp"
 #include "../utils/string_utils.hpp"
+#include "../utils/tracing.hpp"
 #include "../views/binding_view.hpp"
 #include "../views/topo_view.hpp"
+#include "detail/chunked_output.hpp"
 
 #include <fmt/format.h>
 #include <kitty/print.hpp>
@@ -50,6 +52,8 @@
 #include <iostream>
 #include <optional>
 #include <string>
+#include <utility>
+#include <vector>
 
 namespace mockturtle
 {
@@ -61,7 +65,7 @@ namespace detail
 
 template<class Ntk>
 std::vector<std::pair<bool, std::string>>
-format_fanin( Ntk const& ntk, node<Ntk> const& n, node_map<std::string, Ntk>& node_names )
+format_fanin( Ntk const& ntk, node<Ntk> const& n, node_map<std::string, Ntk> const& node_names )
 {
   std::vector<std::pair<bool, std::string>> children;
   ntk.foreach_fanin( n, [&]( auto const& f, auto i ) {
@@ -80,7 +84,7 @@ format_fanin( Ntk const& ntk, node<Ntk> const& n, node_map<std::string, Ntk>& no
 
 template<class Ntk>
 std::vector<std::pair<bool, std::string>>
-format_fanin( Ntk const& ntk, node<Ntk> const& n, node_map<std::vector<std::string>, Ntk>& node_names )
+format_fanin( Ntk const& ntk, node<Ntk> const& n, node_map<std::vector<std::string>, Ntk> const& node_names )
 {
   std::vector<std::pair<bool, std::string>> children;
   ntk.foreach_fanin( n, [&]( auto const& f, auto i ) {
@@ -118,6 +122,9 @@ struct write_verilog_params
   std::vector<std::pair<std::string, uint32_t>> input_names;
   std::vector<std::pair<std::string, uint32_t>> output_names;
   bool verbose{ false };
+
+  /*! \brief Number of threads formatting gates (0: all hardware threads). */
+  uint32_t num_threads{ 1u };
 };
 
 /*! \brief Writes network in structural Verilog format into output stream
@@ -166,6 +173,8 @@ void write_verilog( Ntk const& ntk, std::ostream& os, write_verilog_params const
   static_assert( has_is_ite_v<Ntk>, "Ntk does not implement the is_ite method" );
   static_assert( has_node_to_index_v<Ntk>, "Ntk does not implement the node_to_index method" );
 
+  trace_span span( "write_verilog", "io" );
+
   assert( ntk.is_combinational() && "Network has to be combinational" );
 
   lorina::verilog_writer writer( os );
@@ -346,15 +355,20 @@ void write_verilog( Ntk const& ntk, std::ostream& os, write_verilog_params const
     node_names[n] = xs[i];
   } );
 
+  /* assign names in topological order */
+  std::vector<node<Ntk>> order;
+  order.reserve( ntk.size() );
   topo_view ntk_topo{ ntk };
-
   ntk_topo.foreach_node( [&]( auto const& n ) {
-    if ( ntk.is_constant( n ) || ntk.is_pi( n ) )
-      return true;
-
-    /* assign a name */
-    node_names[n] = fmt::format( "n{}", ntk.node_to_index( n ) );
+    if ( !ntk.is_constant( n ) && !ntk.is_pi( n ) )
+    {
+      node_names[n] = fmt::format( "n{}", ntk.node_to_index( n ) );
+      order.push_back( n );
+    }
+  } );
 
+  /* names are only read from here on, such that gates can be formatted concurrently */
+  auto const write_gate = [&, &node_names = std::as_const( node_names )]( lorina::verilog_writer const& writer, node<Ntk> const& n ) {
     if constexpr ( has_is_buf_v<Ntk> )
     {
       if ( ntk.is_buf( n ) )
@@ -374,7 +388,7 @@ void write_verilog( Ntk const& ntk, std::ostream& os, write_verilog_params const
           args.emplace_back( std::make_pair( "o", node_names[n] ) );
           writer.on_module_instantiation( "buffer", {}, "buf_" + node_names[n], args );
         }
-        return true;
+        return;
       }
     }
 
@@ -390,7 +404,7 @@ void write_verilog( Ntk const& ntk, std::ostream& os, write_verilog_params const
         args.emplace_back( std::make_pair( "o1", node_names[n] + "_1" ) );
         args.emplace_back( std::make_pair( "o2", node_names[n] + "_2" ) );
         writer.on_module_instantiation( "crossing", {}, "cross_" + node_names[n], args );
-        return true;
+        return;
       }
     }
 
@@ -468,7 +482,7 @@ void write_verilog( Ntk const& ntk, std::ostream& os, write_verilog_params const
         if ( ntk.is_nary_and( n ) )
         {
           writer.on_assign( node_names[n], detail::format_fanin<Ntk>( ntk, n, node_names ), "&" );
-          return true;
+          return;
         }
       }
       if constexpr ( has_is_nary_or_v<Ntk> )
@@ -476,7 +490,7 @@ void write_verilog( Ntk const& ntk, std::ostream& os, write_verilog_params const
         if ( ntk.is_nary_or( n ) )
         {
           writer.on_assign( node_names[n], detail::format_fanin<Ntk>( ntk, n, node_names ), "|" );
-          return true;
+          return;
         }
       }
       if constexpr ( has_is_nary_xor_v<Ntk> )
@@ -484,7 +498,7 @@ void write_verilog( Ntk const& ntk, std::ostream& os, write_verilog_params const
         if ( ntk.is_nary_xor( n ) )
         {
           writer.on_assign( node_names[n], detail::format_fanin<Ntk>( ntk, n, node_names ), "^" );
-          return true;
+          return;
         }
       }
       if constexpr ( has_is_function_v<Ntk> )
@@ -493,8 +507,14 @@ void write_verilog( Ntk const& ntk, std::ostream& os, write_verilog_params const
       }
       writer.on_assign_unknown_gate( node_names[n] );
     }
+  };
 
-    return true;
+  detail::format_chunks( os, static_cast<uint32_t>( order.size() ), ps.num_threads, [&]( std::ostream& out, uint32_t begin, uint32_t end ) {
+    lorina::verilog_writer const chunk_writer( out );
+    for ( auto i = begin; i < end; ++i )
+    {
+      write_gate( chunk_writer, order[i] );
+    }
   } );
 
   ntk.foreach_po( [&]( auto const& f, auto i ) {
@@ -735,8 +755,12 @@ void write_verilog_with_binding( Ntk const& ntk, std::ostream& os, write_verilog
     length = std::max( length, static_cast<unsigned int>( gate.name.length() ) );
   }
 
+  /* assign names and instance numbers in topological order */
+  std::vector<node<Ntk>> order;
+  std::vector<unsigned> first_instance;
+  order.reserve( ntk.size() );
+  first_instance.reserve( ntk.size() );
   topo_view ntk_topo{ ntk };
-
   ntk_topo.foreach_node( [&]( auto const& n ) {
     if ( po_nodes.has( n ) )
     {
@@ -747,6 +771,17 @@ void write_verilog_with_binding( Ntk const& ntk, std::ostream& os, write_verilog
       node_names[n] = fmt::format( "n{}", ntk.node_to_index( n ) );
     }
 
+    order.push_back( n );
+    first_instance.push_back( counter );
+    if ( ntk.has_binding( n ) )
+    {
+      /* nodes driving multiple POs are duplicated */
+      counter += po_nodes.has( n ) ? static_cast<unsigned>( po_nodes[n].size() ) : 1u;
+    }
+  } );
+
+  /* names are only read from here on, such that gates can be formatted concurrently */
+  auto const write_gate = [&, &node_names = std::as_const( node_names ), &po_nodes = std::as_const( po_nodes )]( lorina::verilog_writer const& writer, node<Ntk> const& n, unsigned counter ) {
     if ( ntk.has_binding( n ) )
     {
       auto const& gate = gates[ntk.get_binding_index( n )];
@@ -794,8 +829,14 @@ void write_verilog_with_binding( Ntk const& ntk, std::ostream& os, write_verilog
     {
       std::cerr << "[e] internal node " << n << " is not mapped.\n";
     }
+  };
 
-    return true;
+  detail::format_chunks( os, static_cast<uint32_t>( order.size() ), ps.num_threads, [&]( std::ostream& out, uint32_t begin, uint32_t end ) {
+    lorina::verilog_writer const chunk_writer( out );
+    for ( auto i = begin; i < end; ++i )
+    {
+      write_gate( chunk_writer, order[i], first_instance[i] );
+    }
   } );
 
   writer.on_module_end();
@@ -1072,8 +1113,12 @@ void write_verilog_with_cell( Ntk const& ntk, std::ostream& os, write_verilog_pa
     length = std::max( length, static_cast<unsigned int>( cell.name.length() ) );
   }
 
+  /* assign names and instance numbers in topological order */
+  std::vector<node<Ntk>> order;
+  std::vector<unsigned> first_instance;
+  order.reserve( ntk.size() );
+  first_instance.reserve( ntk.size() );
   topo_view ntk_topo{ ntk };
-
   ntk_topo.foreach_node( [&]( auto const& n ) {
     /* load names of n */
     if constexpr ( has_is_multioutput_v<Ntk> )
@@ -1117,6 +1162,42 @@ void write_verilog_with_cell( Ntk const& ntk, std::ostream& os, write_verilog_pa
       }
     }
 
+    order.push_back( n );
+    first_instance.push_back( counter );
+    if ( ntk.has_cell( n ) )
+    {
+      /* outputs driving multiple POs are buffered */
+      unsigned num_buffers = 0;
+      auto const count_buffers = [&]( auto const& f ) {
+        if ( auto el = po_nodes.find( f ); el != po_nodes.end() && el->second.size() > 1 )
+        {
+          num_buffers += static_cast<unsigned>( el->second.size() ) - 1u;
+        }
+      };
+      if constexpr ( has_is_multioutput_v<Ntk> )
+      {
+        for ( uint32_t i = 0; i < ntk.num_outputs( n ); ++i )
+        {
+          count_buffers( ntk.make_signal( n, i ) );
+        }
+      }
+      else
+      {
+        count_buffers( ntk.make_signal( n ) );
+      }
+      counter += 1u + num_buffers;
+
+      /* writing stops at this node if buffers are missing */
+      if ( num_buffers > 0 && buf_id == UINT32_MAX )
+      {
+        return false;
+      }
+    }
+    return true;
+  } );
+
+  /* names are only read from here on, such that gates can be formatted concurrently */
+  auto const write_gate = [&, &node_names = std::as_const( node_names )]( lorina::verilog_writer const& writer, node<Ntk> const& n, unsigned counter ) {
     if ( ntk.has_cell( n ) )
     {
       auto const& cell = cells[ntk.get_cell_index( n )];
@@ -1157,7 +1238,7 @@ void write_verilog_with_cell( Ntk const& ntk, std::ostream& os, write_verilog_pa
             if ( buf_id == UINT32_MAX )
             {
               std::cerr << "[e] Error: cell library does not contain a buffer cell\n";
-              return false;
+              return;
             }
 
             if ( ps.verbose )
@@ -1192,7 +1273,7 @@ void write_verilog_with_cell( Ntk const& ntk, std::ostream& os, write_verilog_pa
           if ( buf_id == UINT32_MAX )
           {
             std::cerr << "[e] Error: cell library does not contain a buffer cell\n";
-            return false;
+            return;
           }
 
           std::cerr << "[i] Buffering node " << n << " driving multiple POs.\n";
@@ -1221,8 +1302,14 @@ void write_verilog_with_cell( Ntk const& ntk, std::ostream& os, write_verilog_pa
     {
       std::cerr << "[e] internal node " << n << " is not mapped.\n";
     }
+  };
 
-    return true;
+  detail::format_chunks( os, static_cast<uint32_t>( order.size() ), ps.num_threads, [&]( std::ostream& out, uint32_t begin, uint32_t end ) {
+    lorina::verilog_writer const chunk_writer( out );
+    for ( auto i = begin; i < end; ++i )
+    {
+      write_gate( chunk_writer, order[i], first_instance[i] );
+    }
   } );
 
   writer.on_module_end();
@@ -1253,7 +1340,7 @@ void write_verilog_with_cell( Ntk const& ntk, std::ostream& os, write_verilog_pa
 template<class Ntk>
 void write_verilog( Ntk const& ntk, std::string const& filename, write_verilog_params const& ps = {} )
 {
-  std::ofstream os( filename.c_str(), std::ofstream::out );
+  detail::buffered_ofstream os( filename );
   write_verilog( ntk, os, ps );
   os.close();
 }
@@ -1280,7 +1367,7 @@ void write_verilog( Ntk const& ntk, std::string const& filename, write_verilog_p
 template<class Ntk>
 void write_verilog_with_binding( Ntk const& ntk, std::string const& filename, write_verilog_params const& ps = {} )
 {
-  std::ofstream os( filename.c_str(), std::ofstream::out );
+  detail::buffered_ofstream os( filename );
   write_verilog_with_binding( ntk, os, ps );
   os.close();
 }
@@ -1307,7 +1394,7 @@ void write_verilog_with_binding( Ntk const& ntk, std::string const& filename, wr
 template<class Ntk>
 void write_verilog_with_cell( Ntk const& ntk, std::string const& filename, write_verilog_params const& ps = {} )
 {
-  std::ofstream os( filename.c_str(), std::ofstream::out );
+  detail::buffered_ofstream os( filename );
   write_verilog_with_cell( ntk, os, ps );
   os.close();
 }
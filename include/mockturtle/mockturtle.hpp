@@ -96,6 +96,7 @@
 #include "mockturtle/algorithms/mig_resub.hpp"
 #include "mockturtle/algorithms/miter.hpp"
 #include "mockturtle/algorithms/network_fuzz_tester.hpp"
+#include "mockturtle/algorithms/node_reordering.hpp"
 #include "mockturtle/algorithms/node_resynthesis.hpp"
 #include "mockturtle/algorithms/node_resynthesis/akers.hpp"
 #include "mockturtle/algorithms/node_resynthesis/bidecomposition.hpp"
@@ -123,10 +124,13 @@
 #include "mockturtle/algorithms/resyn_engines/mig_resyn.hpp"
 #include "mockturtle/algorithms/resyn_engines/xag_resyn.hpp"
 #include "mockturtle/algorithms/satlut_mapping.hpp"
+#include "mockturtle/algorithms/sequential_simulation.hpp"
 #include "mockturtle/algorithms/sim_resub.hpp"
 #include "mockturtle/algorithms/simulation.hpp"
+#include "mockturtle/algorithms/switching_activity.hpp"
 #include "mockturtle/algorithms/testcase_minimizer.hpp"
 #include "mockturtle/algorithms/window_rewriting.hpp"
+#include "mockturtle/algorithms/window_simulation.hpp"
 #include "mockturtle/algorithms/xag_optimization.hpp"
 #include "mockturtle/algorithms/xag_resub_withDC.hpp"
 #include "mockturtle/algorithms/xmg_algebraic_rewriting.hpp"
@@ -146,6 +150,8 @@
 #include "mockturtle/io/blif_reader.hpp"
 #include "mockturtle/io/bristol_reader.hpp"
 #include "mockturtle/io/dimacs_reader.hpp"
+#include "mockturtle/io/fast_blif_reader.hpp"
+#include "mockturtle/io/fast_verilog_reader.hpp"
 #include "mockturtle/io/genlib_reader.hpp"
 #include "mockturtle/io/pla_reader.hpp"
 #include "mockturtle/io/serialize.hpp"
@@ -180,13 +186,17 @@
 #include "mockturtle/properties/xmgcost.hpp"
 #include "mockturtle/traits.hpp"
 #include "mockturtle/utils/algorithm.hpp"
+#include "mockturtle/utils/concurrent_truth_table_cache.hpp"
 #include "mockturtle/utils/cost_functions.hpp"
+#include "mockturtle/utils/cut_store.hpp"
 #include "mockturtle/utils/cuts.hpp"
 #include "mockturtle/utils/debugging_utils.hpp"
 #include "mockturtle/utils/hash_functions.hpp"
 #include "mockturtle/utils/include/percy.hpp"
 #include "mockturtle/utils/index_list/index_list.hpp"
 #include "mockturtle/utils/json_utils.hpp"
+#include "mockturtle/utils/level_parallel.hpp"
+#include "mockturtle/utils/memory_usage.hpp"
 #include "mockturtle/utils/mixed_radix.hpp"
 #include "mockturtle/utils/name_utils.hpp"
 #include "mockturtle/utils/network_cache.hpp"
@@ -194,10 +204,12 @@
 #include "mockturtle/utils/node_map.hpp"
 #include "mockturtle/utils/progress_bar.hpp"
 #include "mockturtle/utils/recursive_cost_functions.hpp"
+#include "mockturtle/utils/signature_matrix.hpp"
 #include "mockturtle/utils/stopwatch.hpp"
 #include "mockturtle/utils/string_utils.hpp"
 #include "mockturtle/utils/super_utils.hpp"
 #include "mockturtle/utils/tech_library.hpp"
+#include "mockturtle/utils/tracing.hpp"
 #include "mockturtle/utils/truth_table_cache.hpp"
 #include "mockturtle/utils/truth_table_utils.hpp"
 #include "mockturtle/utils/window_utils.hpp"
@@ -213,6 +225,7 @@
 #include "mockturtle/views/mapping_view.hpp"
 #include "mockturtle/views/mffc_view.hpp"
 #include "mockturtle/views/names_view.hpp"
+#include "mockturtle/views/snapshot_view.hpp"
 #include "mockturtle/views/topo_view.hpp"
 #include "mockturtle/views/window_view.hpp"
 #include "mockturtle/views/rank_view.hpp"
@@ -66,8 +66,8 @@ struct aig_hash
   uint64_t operator()( Node const& n ) const
   {
     uint64_t seed = -2011;
-    seed += n.children[0].index * 7937;
-    seed += n.children[1].index * 2971;
+    seed += static_cast<uint64_t>( n.children[0].index ) * 7937;
+    seed += static_cast<uint64_t>( n.children[1].index ) * 2971;
     seed += n.children[0].weight * 911;
     seed += n.children[1].weight * 353;
     return seed;
@@ -77,122 +77,139 @@ struct aig_hash
 /*! \brief AIG storage container
 
   AIGs have nodes with fan-in 2.  We split of one bit of the index pointer to
-  store a complemented attribute.  Every node has 64-bit of additional data
-  used for the following purposes:
-
-  `data[0].h1`: Fan-out size (we use MSB to indicate whether a node is dead)
-  `data[0].h2`: Application-specific value
-  `data[1].h1`: Visited flag
-  `data[1].h2`: Is terminal node (PI or CI)
+  store a complemented attribute.  The `Layout` parameter selects 64-bit or
+  32-bit node pointers and data words (see `storage_layout`).  The additional
+  data of every node is described in `regular_node_data`.
 */
-using aig_storage = storage<regular_node<2, 2, 1>,
-                            empty_storage_data,
-                            aig_hash<regular_node<2, 2, 1>>>;
+template<storage_layout Layout = storage_layout::wide>
+using basic_aig_storage = storage<typename regular_storage_types<2, Layout>::node_type,
+                                  typename regular_storage_types<2, Layout>::data_type,
+                                  aig_hash<typename regular_storage_types<2, Layout>::node_type>>;
 
-class aig_network
-{
-public:
-#pragma region Types and constructors
-  static constexpr bool is_aig_network_type = true;
-  static constexpr auto min_fanin_size = 2u;
-  static constexpr auto max_fanin_size = 2u;
+using aig_storage = basic_aig_storage<>;
 
-  using base_type = aig_network;
-  using storage = std::shared_ptr<aig_storage>;
-  using node = uint64_t;
+struct aig_signal
+{
+  aig_signal() = default;
 
-  struct signal
+  aig_signal( uint64_t index, uint64_t complement )
+      : complement( complement ), index( index )
   {
-    signal() = default;
+  }
 
-    signal( uint64_t index, uint64_t complement )
-        : complement( complement ), index( index )
-    {
-    }
+  explicit aig_signal( uint64_t data )
+      : data( data )
+  {
+  }
 
-    explicit signal( uint64_t data )
-        : data( data )
-    {
-    }
+  aig_signal( node_pointer<1> const& p )
+      : complement( p.weight ), index( p.index )
+  {
+  }
 
-    signal( aig_storage::node_type::pointer_type const& p )
-        : complement( p.weight ), index( p.index )
-    {
-    }
+  aig_signal( compact_node_pointer<1> const& p )
+      : complement( p.weight ), index( p.index )
+  {
+  }
 
-    union
+  union
+  {
+    struct
     {
-      struct
-      {
-        uint64_t complement : 1;
-        uint64_t index : 63;
-      };
-      uint64_t data;
+      uint64_t complement : 1;
+      uint64_t index : 63;
     };
+    uint64_t data;
+  };
 
-    signal operator!() const
-    {
-      return signal( data ^ 1 );
-    }
+  aig_signal operator!() const
+  {
+    return aig_signal( data ^ 1 );
+  }
 
-    signal operator+() const
-    {
-      return { index, 0 };
-    }
+  aig_signal operator+() const
+  {
+    return { index, 0 };
+  }
 
-    signal operator-() const
-    {
-      return { index, 1 };
-    }
+  aig_signal operator-() const
+  {
+    return { index, 1 };
+  }
 
-    signal operator^( bool complement ) const
-    {
-      return signal( data ^ ( complement ? 1 : 0 ) );
-    }
+  aig_signal operator^( bool complement ) const
+  {
+    return aig_signal( data ^ ( complement ? 1 : 0 ) );
+  }
 
-    bool operator==( signal const& other ) const
-    {
-      return data == other.data;
-    }
+  bool operator==( aig_signal const& other ) const
+  {
+    return data == other.data;
+  }
 
-    bool operator!=( signal const& other ) const
-    {
-      return data != other.data;
-    }
+  bool operator!=( aig_signal const& other ) const
+  {
+    return data != other.data;
+  }
 
-    bool operator<( signal const& other ) const
-    {
-      return data < other.data;
-    }
+  bool operator<( aig_signal const& other ) const
+  {
+    return data < other.data;
+  }
 
-    operator aig_storage::node_type::pointer_type() const
-    {
-      return { index, complement };
-    }
+  operator node_pointer<1>() const
+  {
+    return { index, complement };
+  }
+
+  operator compact_node_pointer<1>() const
+  {
+    return { index, complement };
+  }
 
 #if __cplusplus > 201703L
-    bool operator==( aig_storage::node_type::pointer_type const& other ) const
-    {
-      return data == other.data;
-    }
+  bool operator==( node_pointer<1> const& other ) const
+  {
+    return data == other.data;
+  }
+
+  bool operator==( compact_node_pointer<1> const& other ) const
+  {
+    return data == other.data;
+  }
 #endif
-  };
+};
+
+template<storage_layout Layout = storage_layout::wide>
+class basic_aig_network
+{
+public:
+#pragma region Types and constructors
+  static constexpr bool is_aig_network_type = true;
+  static constexpr auto min_fanin_size = 2u;
+  static constexpr auto max_fanin_size = 2u;
+
+  using base_type = basic_aig_network;
+  using storage = std::shared_ptr<basic_aig_storage<Layout>>;
+  using node = uint64_t;
+  using signal = aig_signal;
+  using node_data = regular_node_data<Layout>;
 
-  aig_network()
-      : _storage( std::make_shared<aig_storage>() ),
-        _events( std::make_shared<decltype( _events )::element_type>() )
+  basic_aig_network()
+      : _storage( std::make_shared<basic_aig_storage<Layout>>() ),
+        _events( std::make_shared<typename decltype( _events )::element_type>() )
   {
   }
 
-  aig_network( std::shared_ptr<aig_storage> storage )
+  basic_aig_network( std::shared_ptr<basic_aig_storage<Layout>> storage )
       : _storage( storage ),
-        _events( std::make_shared<decltype( _events )::element_type>() )
+        _events( std::make_shared<typename decltype( _events )::element_type>() )
   {
   }
 
-  aig_network clone() const
+  basic_aig_network clone() const
   {
-    return { std::make_shared<aig_storage>( *_storage ) };
+    return { std::make_shared<basic_aig_storage<Layout>>( *_storage ) };
   }
 #pragma endregion
 
@@ -207,7 +224,7 @@ public:
     const auto index = _storage->nodes.size();
     auto& node = _storage->nodes.emplace_back();
     node.children[0].data = node.children[1].data = _storage->inputs.size();
-    node.data[1].h2 = 1; // mark as PI
+    node_data::set_ci( node ); // mark as PI
     _storage->inputs.emplace_back( index );
     return { index, 0 };
   }
@@ -215,7 +232,7 @@ public:
   uint32_t create_po( signal const& f )
   {
     /* increase ref-count to children */
-    _storage->nodes[f.index].data[0].h1++;
+    node_data::incr_fanout_size( *_storage, f.index );
     auto const po_index = _storage->outputs.size();
     _storage->outputs.emplace_back( f.index, f.complement );
     return static_cast<uint32_t>( po_index );
@@ -233,12 +250,12 @@ public:
 
   bool is_ci( node const& n ) const
   {
-    return _storage->nodes[n].data[1].h2 == 1;
+    return node_data::is_ci( *_storage, n );
   }
 
   bool is_pi( node const& n ) const
   {
-    return _storage->nodes[n].data[1].h2 == 1 && !is_constant( n );
+    return node_data::is_ci( *_storage, n ) && !is_constant( n );
   }
 
   bool constant_value( node const& n ) const
@@ -279,7 +296,7 @@ public:
       return a.complement ? b : get_constant( false );
     }
 
-    storage::element_type::node_type node;
+    typename storage::element_type::node_type node;
     node.children[0] = a;
     node.children[1] = b;
 
@@ -304,8 +321,8 @@ public:
     _storage->hash[node] = index;
 
     /* increase ref-count to children */
-    _storage->nodes[a.index].data[0].h1++;
-    _storage->nodes[b.index].data[0].h1++;
+    node_data::incr_fanout_size( *_storage, a.index );
+    node_data::incr_fanout_size( *_storage, b.index );
 
     for ( auto const& fn : _events->on_add )
     {
@@ -402,7 +419,7 @@ public:
 #pragma endregion
 
 #pragma region Create arbitrary functions
-  signal clone_node( aig_network const& other, node const& source, std::vector<signal> const& children )
+  signal clone_node( basic_aig_network const& other, node const& source, std::vector<signal> const& children )
   {
     (void)other;
     (void)source;
@@ -430,7 +447,7 @@ public:
       return a.complement == false ? get_constant( false ) : b;
     }
 
-    storage::element_type::node_type node;
+    typename storage::element_type::node_type node;
     node.children[0] = a;
     node.children[1] = b;
 
@@ -488,7 +505,7 @@ public:
     }
 
     // node already in hash table
-    storage::element_type::node_type _hash_obj;
+    typename storage::element_type::node_type _hash_obj;
     _hash_obj.children[0] = child0;
     _hash_obj.children[1] = child1;
     if ( const auto it = _storage->hash.find( _hash_obj ); it != _storage->hash.end() && it->second != old_node )
@@ -509,7 +526,7 @@ public:
     _storage->hash[node] = n;
 
     // update the reference counter of the new signal
-    _storage->nodes[new_signal.index].data[0].h1++;
+    node_data::incr_fanout_size( *_storage, new_signal.index );
 
     for ( auto const& fn : _events->on_modified )
     {
@@ -566,7 +583,7 @@ public:
     }
 
     // update the reference counter of the new signal
-    _storage->nodes[new_signal.index].data[0].h1++;
+    node_data::incr_fanout_size( *_storage, new_signal.index );
 
     for ( auto const& fn : _events->on_modified )
     {
@@ -589,7 +606,7 @@ public:
         if ( old_node != new_signal.index )
         {
           /* increment fan-in of new node */
-          _storage->nodes[new_signal.index].data[0].h1++;
+          node_data::incr_fanout_size( *_storage, new_signal.index );
         }
       }
     }
@@ -603,7 +620,7 @@ public:
 
     /* delete the node (ignoring its current fanout_size) */
     auto& nobj = _storage->nodes[n];
-    nobj.data[0].h1 = UINT32_C( 0x80000000 ); /* fanout size 0, but dead */
+    node_data::kill( nobj ); /* fanout size 0, but dead */
     _storage->hash.erase( nobj );
 
     for ( auto const& fn : _events->on_delete )
@@ -633,7 +650,7 @@ public:
     
     assert( n < _storage->nodes.size() );
     auto& nobj = _storage->nodes[n];
-    nobj.data[0].h1 = UINT32_C( 0 ); /* fanout size 0, but not dead (like just created) */
+    node_data::revive( nobj ); /* fanout size 0, but not dead (like just created) */
     _storage->hash[nobj] = n;
 
     for ( auto const& fn : _events->on_add )
@@ -654,7 +671,7 @@ public:
 
   inline bool is_dead( node const& n ) const
   {
-    return ( _storage->nodes[n].data[0].h1 >> 31 ) & 1;
+    return node_data::is_dead( *_storage, n );
   }
 
   void substitute_node( node const& old_node, signal const& new_signal )
@@ -856,6 +873,11 @@ public:
     return static_cast<uint32_t>( _storage->hash.size() );
   }
 
+  uint64_t memory_usage() const
+  {
+    return sizeof( *this ) + _storage->memory_usage();
+  }
+
   uint32_t fanin_size( node const& n ) const
   {
     if ( is_constant( n ) || is_ci( n ) )
@@ -865,17 +887,17 @@ public:
 
   uint32_t fanout_size( node const& n ) const
   {
-    return _storage->nodes[n].data[0].h1 & UINT32_C( 0x7FFFFFFF );
+    return node_data::fanout_size( *_storage, n );
   }
 
   uint32_t incr_fanout_size( node const& n ) const
   {
-    return _storage->nodes[n].data[0].h1++ & UINT32_C( 0x7FFFFFFF );
+    return node_data::incr_fanout_size( *_storage, n );
   }
 
   uint32_t decr_fanout_size( node const& n ) const
   {
-    return --_storage->nodes[n].data[0].h1 & UINT32_C( 0x7FFFFFFF );
+    return node_data::decr_fanout_size( *_storage, n );
   }
 
   bool is_and( node const& n ) const
@@ -1179,44 +1201,44 @@ public:
 #pragma region Custom node values
   void clear_values() const
   {
-    std::for_each( _storage->nodes.begin(), _storage->nodes.end(), []( auto& n ) { n.data[0].h2 = 0; } );
+    node_data::clear_values( *_storage );
   }
 
   auto value( node const& n ) const
   {
-    return _storage->nodes[n].data[0].h2;
+    return node_data::value( *_storage, n );
   }
 
   void set_value( node const& n, uint32_t v ) const
   {
-    _storage->nodes[n].data[0].h2 = v;
+    node_data::set_value( *_storage, n, v );
   }
 
   auto incr_value( node const& n ) const
   {
-    return _storage->nodes[n].data[0].h2++;
+    return node_data::incr_value( *_storage, n );
   }
 
   auto decr_value( node const& n ) const
   {
-    return --_storage->nodes[n].data[0].h2;
+    return node_data::decr_value( *_storage, n );
   }
 #pragma endregion
 
 #pragma region Visited flags
   void clear_visited() const
   {
-    std::for_each( _storage->nodes.begin(), _storage->nodes.end(), []( auto& n ) { n.data[1].h1 = 0; } );
+    node_data::clear_visited( *_storage );
   }
 
   auto visited( node const& n ) const
   {
-    return _storage->nodes[n].data[1].h1;
+    return node_data::visited( *_storage, n );
   }
 
   void set_visited( node const& n, uint32_t v ) const
   {
-    _storage->nodes[n].data[1].h1 = v;
+    node_data::set_visited( *_storage, n, v );
   }
 
   uint32_t trav_id() const
@@ -1238,19 +1260,23 @@ public:
 #pragma endregion
 
 public:
-  std::shared_ptr<aig_storage> _storage;
+  std::shared_ptr<basic_aig_storage<Layout>> _storage;
   std::shared_ptr<network_events<base_type>> _events;
 };
 
+using aig_network = basic_aig_network<>;
+using compact_aig_network = basic_aig_network<storage_layout::compact>;
+using compact_cold_aig_network = basic_aig_network<storage_layout::compact_cold>;
+
 } // namespace mockturtle
 
 namespace std
 {
 
 template<>
-struct hash<mockturtle::aig_network::signal>
+struct hash<mockturtle::aig_signal>
 {
-  uint64_t operator()( mockturtle::aig_network::signal const& s ) const noexcept
+  uint64_t operator()( mockturtle::aig_signal const& s ) const noexcept
   {
     uint64_t k = s.data;
     k ^= k >> 33;
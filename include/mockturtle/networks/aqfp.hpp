@@ -56,6 +56,11 @@ namespace mockturtle
 struct aqfp_storage_data
 {
   std::unordered_map<uint32_t, kitty::dynamic_truth_table> node_fn_cache;
+
+  uint64_t memory_usage() const
+  {
+    return sizeof( *this ) + dynamic_memory_usage( node_fn_cache );
+  }
 };
 
 /*! \brief AQFP storage container
@@ -615,6 +620,11 @@ public:
     return static_cast<uint32_t>( _storage->nodes.size() - 1u - _storage->inputs.size() );
   }
 
+  uint64_t memory_usage() const
+  {
+    return sizeof( *this ) + _storage->memory_usage();
+  }
+
   uint32_t fanin_size( node const& n ) const
   {
     if ( is_constant( n ) || is_ci( n ) )
@@ -51,6 +51,11 @@ namespace mockturtle
 struct block_storage_data
 {
   truth_table_cache<kitty::dynamic_truth_table> cache;
+
+  uint64_t memory_usage() const
+  {
+    return sizeof( *this ) + dynamic_memory_usage( cache );
+  }
 };
 
 /*! \brief Block node
@@ -709,6 +714,11 @@ public:
     return static_cast<uint32_t>( _storage->nodes.size() - _storage->inputs.size() - 2 );
   }
 
+  uint64_t memory_usage() const
+  {
+    return sizeof( *this ) + _storage->memory_usage();
+  }
+
   uint32_t num_outputs( node const& n ) const
   {
     return static_cast<uint32_t>( _storage->nodes[n].data.size() - 2 );
@@ -72,6 +72,11 @@ struct cover_storage_data
   }
 
   std::vector<std::pair<std::vector<kitty::cube>, bool>> covers;
+
+  uint64_t memory_usage() const
+  {
+    return sizeof( *this ) + dynamic_memory_usage( covers );
+  }
 };
 
 /*! \brief cover node
@@ -531,6 +536,11 @@ public:
     return static_cast<uint32_t>( _storage->nodes.size() - _storage->inputs.size() - 2 );
   }
 
+  uint64_t memory_usage() const
+  {
+    return sizeof( *this ) + _storage->memory_usage();
+  }
+
   uint32_t fanin_size( node const& n ) const
   {
     return static_cast<uint32_t>( _storage->nodes[n].children.size() );
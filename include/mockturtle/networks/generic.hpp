@@ -56,6 +56,11 @@ struct generic_storage_data
   uint32_t num_pos = 0u;
   std::vector<int8_t> registers;
   uint32_t trav_id = 0u;
+
+  uint64_t memory_usage() const
+  {
+    return sizeof( *this ) + dynamic_memory_usage( cache ) + dynamic_memory_usage( registers );
+  }
 };
 
 /*! \brief Generic node
@@ -629,6 +634,11 @@ public:
     return static_cast<uint32_t>( _storage->nodes.size() - _storage->inputs.size() - _storage->outputs.size() - 2 );
   }
 
+  uint64_t memory_usage() const
+  {
+    return sizeof( *this ) + _storage->memory_usage();
+  }
+
   uint32_t fanin_size( node const& n ) const
   {
     return static_cast<uint32_t>( _storage->nodes[n].children.size() );
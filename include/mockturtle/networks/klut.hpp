@@ -57,6 +57,11 @@ namespace mockturtle
 struct klut_storage_data
 {
   truth_table_cache<kitty::dynamic_truth_table> cache;
+
+  uint64_t memory_usage() const
+  {
+    return sizeof( *this ) + dynamic_memory_usage( cache );
+  }
 };
 
 /*! \brief k-LUT node
@@ -449,6 +454,11 @@ public:
     return static_cast<uint32_t>( _storage->nodes.size() - _storage->inputs.size() - 2 );
   }
 
+  uint64_t memory_usage() const
+  {
+    return sizeof( *this ) + _storage->memory_usage();
+  }
+
   uint32_t fanin_size( node const& n ) const
   {
     return static_cast<uint32_t>( _storage->nodes[n].children.size() );
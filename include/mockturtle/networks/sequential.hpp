@@ -53,16 +53,16 @@ struct is_aig_like : std::false_type
 {
 };
 
-template<>
-struct is_aig_like<aig_network> : std::true_type
+template<storage_layout Layout>
+struct is_aig_like<basic_aig_network<Layout>> : std::true_type
 {
 };
-template<>
-struct is_aig_like<xag_network> : std::true_type
+template<storage_layout Layout>
+struct is_aig_like<basic_xag_network<Layout>> : std::true_type
 {
 };
-template<>
-struct is_aig_like<mig_network> : std::true_type
+template<storage_layout Layout>
+struct is_aig_like<basic_mig_network<Layout>> : std::true_type
 {
 };
 template<>
@@ -358,18 +358,14 @@ public:
   sequential()
       : _sequential_storage( std::make_shared<sequential_information>() )
   {
-    static_assert( std::is_same_v<base_type, aig_network> || std::is_same_v<base_type, xag_network> ||
-                       std::is_same_v<base_type, mig_network> || std::is_same_v<base_type, xmg_network> ||
-                       std::is_same_v<base_type, aqfp_network>,
+    static_assert( detail::is_aig_like_v<base_type>,
                    "Sequential interfaces extended for unknown network type. Please check the compatibility of implementations." );
   }
 
   sequential( storage base_storage )
       : Ntk( base_storage ), _sequential_storage( std::make_shared<sequential_information>() )
   {
-    static_assert( std::is_same_v<base_type, aig_network> || std::is_same_v<base_type, xag_network> ||
-                       std::is_same_v<base_type, mig_network> || std::is_same_v<base_type, xmg_network> ||
-                       std::is_same_v<base_type, aqfp_network>,
+    static_assert( detail::is_aig_like_v<base_type>,
                    "Sequential interfaces extended for unknown network type. Please check the compatibility of implementations." );
   }
 
@@ -443,6 +439,11 @@ public:
     return static_cast<uint32_t>( this->_storage->inputs.size() - _sequential_storage->num_pis );
   }
 
+  uint64_t memory_usage() const
+  {
+    return Ntk::memory_usage() + sizeof( sequential_information ) + dynamic_memory_usage( _sequential_storage->registers );
+  }
+
   node pi_at( uint32_t index ) const
   {
     assert( index < _sequential_storage->num_pis );
@@ -730,6 +731,11 @@ public:
     return static_cast<uint32_t>( this->_storage->inputs.size() - _sequential_storage->num_pis );
   }
 
+  uint64_t memory_usage() const
+  {
+    return Ntk::memory_usage() + sizeof( sequential_information ) + dynamic_memory_usage( _sequential_storage->registers );
+  }
+
   node pi_at( uint32_t index ) const
   {
     assert( index < _sequential_storage->num_pis );
@@ -39,13 +39,18 @@
 
 #pragma once
 
+#include <algorithm>
 #include <array>
+#include <cassert>
+#include <cstdint>
 #include <iostream>
 #include <unordered_map>
 #include <vector>
 
 #include <parallel_hashmap/phmap.h>
 
+#include "../utils/memory_usage.hpp"
+
 namespace mockturtle
 {
 
@@ -100,6 +105,46 @@ public:
   }
 };
 
+/*! \brief 32-bit node pointer
+
+  Has the same fields as `node_pointer`, but can only address 2^(32 -
+  PointerFieldSize) nodes.
+*/
+template<int PointerFieldSize = 0>
+struct compact_node_pointer
+{
+private:
+  static constexpr auto _len = sizeof( uint32_t ) * 8;
+
+public:
+  compact_node_pointer() = default;
+  compact_node_pointer( uint64_t index, uint64_t weight ) : weight( static_cast<uint32_t>( weight ) ), index( static_cast<uint32_t>( index ) )
+  {
+    assert( index < ( UINT64_C( 1 ) << ( _len - PointerFieldSize ) ) );
+  }
+  compact_node_pointer( uint32_t data ) : data( data ) {}
+
+  union
+  {
+    struct
+    {
+      uint32_t weight : PointerFieldSize;
+      uint32_t index : _len - PointerFieldSize;
+    };
+    uint32_t data;
+  };
+
+  bool operator==( compact_node_pointer<PointerFieldSize> const& other ) const
+  {
+    return data == other.data;
+  }
+
+  bool operator!=( compact_node_pointer<PointerFieldSize> const& other ) const
+  {
+    return data != other.data;
+  }
+};
+
 union cauint64_t
 {
   uint64_t n{ 0 };
@@ -131,6 +176,20 @@ struct regular_node
   }
 };
 
+template<int Fanin, int Size = 0, int PointerFieldSize = 0>
+struct compact_regular_node
+{
+  using pointer_type = compact_node_pointer<PointerFieldSize>;
+
+  std::array<pointer_type, Fanin> children;
+  std::array<uint32_t, Size> data{};
+
+  bool operator==( compact_regular_node<Fanin, Size, PointerFieldSize> const& other ) const
+  {
+    return children == other.children;
+  }
+};
+
 template<int Size = 0, int PointerFieldSize = 0>
 struct mixed_fanin_node
 {
@@ -143,6 +202,11 @@ struct mixed_fanin_node
   {
     return children == other.children;
   }
+
+  uint64_t memory_usage() const
+  {
+    return sizeof( *this ) + dynamic_memory_usage( children );
+  }
 };
 
 template<int PointerFieldSize = 0>
@@ -157,6 +221,11 @@ struct block_fanin_node
   {
     return children == other.children;
   }
+
+  uint64_t memory_usage() const
+  {
+    return sizeof( *this ) + dynamic_memory_usage( children ) + dynamic_memory_usage( data );
+  }
 };
 
 /*! \brief Hash function for 64-bit word */
@@ -232,6 +301,12 @@ struct storage
   phmap::flat_hash_map<node_type, uint64_t, NodeHasher> hash;
 
   T data;
+
+  /*! \brief Returns the memory used by the storage in bytes. */
+  uint64_t memory_usage() const
+  {
+    return sizeof( *this ) + dynamic_memory_usage( nodes ) + dynamic_memory_usage( inputs ) + dynamic_memory_usage( outputs ) + dynamic_memory_usage( hash ) + dynamic_memory_usage( data );
+  }
 };
 
 template<typename Node, typename T = empty_storage_data>
@@ -254,6 +329,347 @@ struct storage_no_hash
   std::vector<typename node_type::pointer_type> outputs;
 
   T data;
+
+  /*! \brief Returns the memory used by the storage in bytes. */
+  uint64_t memory_usage() const
+  {
+    return sizeof( *this ) + dynamic_memory_usage( nodes ) + dynamic_memory_usage( inputs ) + dynamic_memory_usage( outputs ) + dynamic_memory_usage( data );
+  }
+};
+
+/*! \brief Memory layouts of the storage of AIGs, XAGs, and MIGs
+
+  - `wide`: 64-bit node pointers and two 64-bit data words per node
+  - `compact`: 32-bit node pointers and three 32-bit data words per node
+  - `compact_cold`: 32-bit node pointers and one 32-bit data word per node,
+    application-specific values and visited flags are stored in separate
+    arrays, which are allocated when they are first used
+
+  The compact layouts can store networks with less than 2^31 nodes.
+*/
+enum class storage_layout
+{
+  wide,
+  compact,
+  compact_cold
+};
+
+/*! \brief Separate arrays for values and visited flags */
+struct cold_storage_data
+{
+  std::vector<uint32_t> values;
+  std::vector<uint32_t> visited;
+
+  uint64_t memory_usage() const
+  {
+    return sizeof( *this ) + dynamic_memory_usage( values ) + dynamic_memory_usage( visited );
+  }
+};
+
+/*! \brief Node and storage data types of a network with fan-in `Fanin` */
+template<int Fanin, storage_layout Layout>
+struct regular_storage_types;
+
+template<int Fanin>
+struct regular_storage_types<Fanin, storage_layout::wide>
+{
+  using node_type = regular_node<Fanin, 2, 1>;
+  using data_type = empty_storage_data;
+};
+
+template<int Fanin>
+struct regular_storage_types<Fanin, storage_layout::compact>
+{
+  using node_type = compact_regular_node<Fanin, 3, 1>;
+  using data_type = empty_storage_data;
+};
+
+template<int Fanin>
+struct regular_storage_types<Fanin, storage_layout::compact_cold>
+{
+  using node_type = compact_regular_node<Fanin, 1, 1>;
+  using data_type = cold_storage_data;
+};
+
+/*! \brief Accesses the node data of AIGs, XAGs, and MIGs
+
+  Every node stores its fan-out size, whether it is dead, whether it is a
+  combinational input, an application-specific value, and a visited flag.
+  This class implements the access to these fields for each storage layout.
+
+  The `wide` layout uses the data words as follows:
+
+  `data[0].h1`: Fan-out size (we use MSB to indicate whether a node is dead)
+  `data[0].h2`: Application-specific value
+  `data[1].h1`: Visited flag
+  `data[1].h2`: Is terminal node (PI or CI)
+
+  The compact layouts store the fan-out size in bits 0-29 of `data[0]`, bit
+  30 is set for terminal nodes and bit 31 for dead nodes.  In the `compact`
+  layout, `data[1]` and `data[2]` are the application-specific value and the
+  visited flag.  In the `compact_cold` layout, they are stored in the arrays
+  of `cold_storage_data`.
+*/
+template<storage_layout Layout>
+struct regular_node_data
+{
+  static constexpr uint32_t fanout_mask = UINT32_C( 0x3FFFFFFF );
+  static constexpr uint32_t ci_bit = UINT32_C( 0x40000000 );
+  static constexpr uint32_t dead_bit = UINT32_C( 0x80000000 );
+
+  template<class Storage>
+  static uint32_t fanout_size( Storage const& s, uint64_t n )
+  {
+    return s.nodes[n].data[0] & fanout_mask;
+  }
+
+  template<class Storage>
+  static uint32_t incr_fanout_size( Storage& s, uint64_t n )
+  {
+    return s.nodes[n].data[0]++ & fanout_mask;
+  }
+
+  template<class Storage>
+  static uint32_t decr_fanout_size( Storage& s, uint64_t n )
+  {
+    return --s.nodes[n].data[0] & fanout_mask;
+  }
+
+  template<class Storage>
+  static bool is_dead( Storage const& s, uint64_t n )
+  {
+    return ( s.nodes[n].data[0] & dead_bit ) != 0;
+  }
+
+  /* fan-out size 0, but dead */
+  template<class Node>
+  static void kill( Node& node )
+  {
+    node.data[0] = dead_bit | ( node.data[0] & ci_bit );
+  }
+
+  /* fan-out size 0, but not dead (like just created) */
+  template<class Node>
+  static void revive( Node& node )
+  {
+    node.data[0] &= ci_bit;
+  }
+
+  template<class Storage>
+  static bool is_ci( Storage const& s, uint64_t n )
+  {
+    return ( s.nodes[n].data[0] & ci_bit ) != 0;
+  }
+
+  template<class Node>
+  static void set_ci( Node& node )
+  {
+    node.data[0] |= ci_bit;
+  }
+
+  template<class Storage>
+  static void clear_values( Storage& s )
+  {
+    if constexpr ( Layout == storage_layout::compact_cold )
+    {
+      s.data.values.assign( s.nodes.size(), 0u );
+    }
+    else
+    {
+      std::for_each( s.nodes.begin(), s.nodes.end(), []( auto& n ) { n.data[1] = 0; } );
+    }
+  }
+
+  template<class Storage>
+  static uint32_t value( Storage const& s, uint64_t n )
+  {
+    if constexpr ( Layout == storage_layout::compact_cold )
+    {
+      return n < s.data.values.size() ? s.data.values[n] : 0u;
+    }
+    else
+    {
+      return s.nodes[n].data[1];
+    }
+  }
+
+  template<class Storage>
+  static void set_value( Storage& s, uint64_t n, uint32_t v )
+  {
+    value_ref( s, n ) = v;
+  }
+
+  template<class Storage>
+  static uint32_t incr_value( Storage& s, uint64_t n )
+  {
+    return value_ref( s, n )++;
+  }
+
+  template<class Storage>
+  static uint32_t decr_value( Storage& s, uint64_t n )
+  {
+    return --value_ref( s, n );
+  }
+
+  template<class Storage>
+  static uint32_t& value_ref( Storage& s, uint64_t n )
+  {
+    if constexpr ( Layout == storage_layout::compact_cold )
+    {
+      if ( n >= s.data.values.size() )
+      {
+        s.data.values.resize( std::max<uint64_t>( n + 1, s.nodes.size() ), 0u );
+      }
+      return s.data.values[n];
+    }
+    else
+    {
+      return s.nodes[n].data[1];
+    }
+  }
+
+  template<class Storage>
+  static void clear_visited( Storage& s )
+  {
+    if constexpr ( Layout == storage_layout::compact_cold )
+    {
+      s.data.visited.assign( s.nodes.size(), 0u );
+    }
+    else
+    {
+      std::for_each( s.nodes.begin(), s.nodes.end(), []( auto& n ) { n.data[2] = 0; } );
+    }
+  }
+
+  template<class Storage>
+  static uint32_t visited( Storage const& s, uint64_t n )
+  {
+    if constexpr ( Layout == storage_layout::compact_cold )
+    {
+      return n < s.data.visited.size() ? s.data.visited[n] : 0u;
+    }
+    else
+    {
+      return s.nodes[n].data[2];
+    }
+  }
+
+  template<class Storage>
+  static void set_visited( Storage& s, uint64_t n, uint32_t v )
+  {
+    if constexpr ( Layout == storage_layout::compact_cold )
+    {
+      if ( n >= s.data.visited.size() )
+      {
+        s.data.visited.resize( std::max<uint64_t>( n + 1, s.nodes.size() ), 0u );
+      }
+      s.data.visited[n] = v;
+    }
+    else
+    {
+      s.nodes[n].data[2] = v;
+    }
+  }
+};
+
+template<>
+struct regular_node_data<storage_layout::wide>
+{
+  template<class Storage>
+  static uint32_t fanout_size( Storage const& s, uint64_t n )
+  {
+    return s.nodes[n].data[0].h1 & UINT32_C( 0x7FFFFFFF );
+  }
+
+  template<class Storage>
+  static uint32_t incr_fanout_size( Storage& s, uint64_t n )
+  {
+    return s.nodes[n].data[0].h1++ & UINT32_C( 0x7FFFFFFF );
+  }
+
+  template<class Storage>
+  static uint32_t decr_fanout_size( Storage& s, uint64_t n )
+  {
+    return --s.nodes[n].data[0].h1 & UINT32_C( 0x7FFFFFFF );
+  }
+
+  template<class Storage>
+  static bool is_dead( Storage const& s, uint64_t n )
+  {
+    return ( s.nodes[n].data[0].h1 >> 31 ) & 1;
+  }
+
+  template<class Node>
+  static void kill( Node& node )
+  {
+    node.data[0].h1 = UINT32_C( 0x80000000 );
+  }
+
+  template<class Node>
+  static void revive( Node& node )
+  {
+    node.data[0].h1 = UINT32_C( 0 );
+  }
+
+  template<class Storage>
+  static bool is_ci( Storage const& s, uint64_t n )
+  {
+    return s.nodes[n].data[1].h2 == 1;
+  }
+
+  template<class Node>
+  static void set_ci( Node& node )
+  {
+    node.data[1].h2 = 1;
+  }
+
+  template<class Storage>
+  static void clear_values( Storage& s )
+  {
+    std::for_each( s.nodes.begin(), s.nodes.end(), []( auto& n ) { n.data[0].h2 = 0; } );
+  }
+
+  template<class Storage>
+  static uint64_t value( Storage const& s, uint64_t n )
+  {
+    return s.nodes[n].data[0].h2;
+  }
+
+  template<class Storage>
+  static void set_value( Storage& s, uint64_t n, uint32_t v )
+  {
+    s.nodes[n].data[0].h2 = v;
+  }
+
+  template<class Storage>
+  static uint64_t incr_value( Storage& s, uint64_t n )
+  {
+    return s.nodes[n].data[0].h2++;
+  }
+
+  template<class Storage>
+  static uint64_t decr_value( Storage& s, uint64_t n )
+  {
+    return --s.nodes[n].data[0].h2;
+  }
+
+  template<class Storage>
+  static void clear_visited( Storage& s )
+  {
+    std::for_each( s.nodes.begin(), s.nodes.end(), []( auto& n ) { n.data[1].h1 = 0; } );
+  }
+
+  template<class Storage>
+  static uint64_t visited( Storage const& s, uint64_t n )
+  {
+    return s.nodes[n].data[1].h1;
+  }
+
+  template<class Storage>
+  static void set_visited( Storage& s, uint64_t n, uint32_t v )
+  {
+    s.nodes[n].data[1].h1 = v;
+  }
 };
 
 } /* namespace mockturtle */
\ No newline at end of file
@@ -649,6 +649,11 @@ public:
     return static_cast<uint32_t>( _storage->hash.size() );
   }
 
+  uint64_t memory_usage() const
+  {
+    return sizeof( *this ) + _storage->memory_usage();
+  }
+
   uint32_t fanin_size( node const& n ) const
   {
     if ( is_constant( n ) || is_ci( n ) )
@@ -65,8 +65,8 @@ struct xag_hash
   uint64_t operator()( Node const& n ) const
   {
     uint64_t seed = -2011;
-    seed += n.children[0].index * 7937;
-    seed += n.children[1].index * 2971;
+    seed += static_cast<uint64_t>( n.children[0].index ) * 7937;
+    seed += static_cast<uint64_t>( n.children[1].index ) * 2971;
     seed += n.children[0].weight * 911;
     seed += n.children[1].weight * 353;
     return seed;
@@ -76,121 +76,139 @@ struct xag_hash
 /*! \brief XAG storage container
 
   XAGs have nodes with fan-in 2.  We split of one bit of the index pointer to
-  store a complemented attribute.  Every node has 64-bit of additional data
-  used for the following purposes:
-
-  `data[0].h1`: Fan-out size (we use MSB to indicate whether a node is dead)
-  `data[0].h2`: Application-specific value
-  `data[1].h1`: Visited flag
-  `data[1].h2`: Is terminal node (PI or CI)
+  store a complemented attribute.  The `Layout` parameter selects 64-bit or
+  32-bit node pointers and data words (see `storage_layout`).  The additional
+  data of every node is described in `regular_node_data`.
 */
-using xag_storage = storage<regular_node<2, 2, 1>,
-                            empty_storage_data,
-                            xag_hash<regular_node<2, 2, 1>>>;
+template<storage_layout Layout = storage_layout::wide>
+using basic_xag_storage = storage<typename regular_storage_types<2, Layout>::node_type,
+                                  typename regular_storage_types<2, Layout>::data_type,
+                                  xag_hash<typename regular_storage_types<2, Layout>::node_type>>;
 
-class xag_network
-{
-public:
-#pragma region Types and constructors
-  static constexpr auto min_fanin_size = 2u;
-  static constexpr auto max_fanin_size = 2u;
+using xag_storage = basic_xag_storage<>;
 
-  using base_type = xag_network;
-  using storage = std::shared_ptr<xag_storage>;
-  using node = uint64_t;
+struct xag_signal
+{
+  xag_signal() = default;
 
-  struct signal
+  xag_signal( uint64_t index, uint64_t complement )
+      : complement( complement ), index( index )
   {
-    signal() = default;
+  }
 
-    signal( uint64_t index, uint64_t complement )
-        : complement( complement ), index( index )
-    {
-    }
+  explicit xag_signal( uint64_t data )
+      : data( data )
+  {
+  }
 
-    explicit signal( uint64_t data )
-        : data( data )
-    {
-    }
+  xag_signal( node_pointer<1> const& p )
+      : complement( p.weight ), index( p.index )
+  {
+  }
 
-    signal( xag_storage::node_type::pointer_type const& p )
-        : complement( p.weight ), index( p.index )
-    {
-    }
+  xag_signal( compact_node_pointer<1> const& p )
+      : complement( p.weight ), index( p.index )
+  {
+  }
 
-    union
+  union
+  {
+    struct
     {
-      struct
-      {
-        uint64_t complement : 1;
-        uint64_t index : 63;
-      };
-      uint64_t data;
+      uint64_t complement : 1;
+      uint64_t index : 63;
     };
+    uint64_t data;
+  };
 
-    signal operator!() const
-    {
-      return signal( data ^ 1 );
-    }
+  xag_signal operator!() const
+  {
+    return xag_signal( data ^ 1 );
+  }
 
-    signal operator+() const
-    {
-      return { index, 0 };
-    }
+  xag_signal operator+() const
+  {
+    return { index, 0 };
+  }
 
-    signal operator-() const
-    {
-      return { index, 1 };
-    }
+  xag_signal operator-() const
+  {
+    return { index, 1 };
+  }
 
-    signal operator^( bool complement ) const
-    {
-      return signal( data ^ ( complement ? 1 : 0 ) );
-    }
+  xag_signal operator^( bool complement ) const
+  {
+    return xag_signal( data ^ ( complement ? 1 : 0 ) );
+  }
 
-    bool operator==( signal const& other ) const
-    {
-      return data == other.data;
-    }
+  bool operator==( xag_signal const& other ) const
+  {
+    return data == other.data;
+  }
 
-    bool operator!=( signal const& other ) const
-    {
-      return data != other.data;
-    }
+  bool operator!=( xag_signal const& other ) const
+  {
+    return data != other.data;
+  }
 
-    bool operator<( signal const& other ) const
-    {
-      return data < other.data;
-    }
+  bool operator<( xag_signal const& other ) const
+  {
+    return data < other.data;
+  }
 
-    operator xag_storage::node_type::pointer_type() const
-    {
-      return { index, complement };
-    }
+  operator node_pointer<1>() const
+  {
+    return { index, complement };
+  }
+
+  operator compact_node_pointer<1>() const
+  {
+    return { index, complement };
+  }
 
 #if __cplusplus > 201703L
-    bool operator==( xag_storage::node_type::pointer_type const& other ) const
-    {
-      return data == other.data;
-    }
+  bool operator==( node_pointer<1> const& other ) const
+  {
+    return data == other.data;
+  }
+
+  bool operator==( compact_node_pointer<1> const& other ) const
+  {
+    return data == other.data;
+  }
 #endif
-  };
+};
+
+template<storage_layout Layout = storage_layout::wide>
+class basic_xag_network
+{
+public:
+#pragma region Types and constructors
+  static constexpr bool is_xag_network_type = true;
+  static constexpr auto min_fanin_size = 2u;
+  static constexpr auto max_fanin_size = 2u;
+
+  using base_type = basic_xag_network;
+  using storage = std::shared_ptr<basic_xag_storage<Layout>>;
+  using node = uint64_t;
+  using signal = xag_signal;
+  using node_data = regular_node_data<Layout>;
 
-  xag_network()
-      : _storage( std::make_shared<xag_storage>() ),
-        _events( std::make_shared<decltype( _events )::element_type>() )
+  basic_xag_network()
+      : _storage( std::make_shared<basic_xag_storage<Layout>>() ),
+        _events( std::make_shared<typename decltype( _events )::element_type>() )
   {
   }
 
-  xag_network( std::shared_ptr<xag_storage> storage )
+  basic_xag_network( std::shared_ptr<basic_xag_storage<Layout>> storage )
       : _storage( storage ),
-        _events( std::make_shared<decltype( _events )::element_type>() )
+        _events( std::make_shared<typename decltype( _events )::element_type>() )
   {
   }
 
-  xag_network clone() const
+  basic_xag_network clone() const
   {
-    return { std::make_shared<xag_storage>( *_storage ) };
+    return { std::make_shared<basic_xag_storage<Layout>>( *_storage ) };
   }
 #pragma endregion
 
@@ -205,7 +223,7 @@ public:
     const auto index = _storage->nodes.size();
     auto& node = _storage->nodes.emplace_back();
     node.children[0].data = node.children[1].data = _storage->inputs.size();
-    node.data[1].h2 = 1; // mark as PI
+    node_data::set_ci( node ); // mark as PI
     _storage->inputs.emplace_back( index );
     return { index, 0 };
   }
@@ -213,7 +231,7 @@ public:
   uint32_t create_po( signal const& f )
   {
     /* increase ref-count to children */
-    _storage->nodes[f.index].data[0].h1++;
+    node_data::incr_fanout_size( *_storage, f.index );
     auto const po_index = static_cast<uint32_t>( _storage->outputs.size() );
     _storage->outputs.emplace_back( f.index, f.complement );
     return po_index;
@@ -231,12 +249,12 @@ public:
 
   bool is_ci( node const& n ) const
   {
-    return _storage->nodes[n].data[1].h2 == 1;
+    return node_data::is_ci( *_storage, n );
   }
 
   bool is_pi( node const& n ) const
   {
-    return _storage->nodes[n].data[1].h2 == 1 && !is_constant( n );
+    return node_data::is_ci( *_storage, n ) && !is_constant( n );
   }
 
   bool constant_value( node const& n ) const
@@ -261,7 +279,7 @@ public:
 #pragma region Create binary functions
   signal _create_node( signal a, signal b )
   {
-    storage::element_type::node_type node;
+    typename storage::element_type::node_type node;
     node.children[0] = a;
     node.children[1] = b;
 
@@ -285,8 +303,8 @@ public:
     _storage->hash[node] = index;
 
     /* increase ref-count to children */
-    _storage->nodes[a.index].data[0].h1++;
-    _storage->nodes[b.index].data[0].h1++;
+    node_data::incr_fanout_size( *_storage, a.index );
+    node_data::incr_fanout_size( *_storage, b.index );
 
     for ( auto const& fn : _events->on_add )
     {
@@ -419,7 +437,7 @@ public:
 #pragma endregion
 
 #pragma region Create arbitrary functions
-  signal clone_node( xag_network const& other, node const& source, std::vector<signal> const& children )
+  signal clone_node( basic_xag_network const& other, node const& source, std::vector<signal> const& children )
   {
     assert( children.size() == 2u );
     if ( other.is_and( source ) )
@@ -452,7 +470,7 @@ public:
       return a.complement == false ? get_constant( false ) : b;
     }
 
-    storage::element_type::node_type node;
+    typename storage::element_type::node_type node;
     node.children[0] = a;
     node.children[1] = b;
 
@@ -488,7 +506,7 @@ public:
       return a ^ f_compl;
     }
 
-    storage::element_type::node_type node;
+    typename storage::element_type::node_type node;
     node.children[0] = a;
     node.children[1] = b;
 
@@ -560,7 +578,7 @@ public:
     }
 
     // node already in hash table
-    storage::element_type::node_type _hash_obj;
+    typename storage::element_type::node_type _hash_obj;
     _hash_obj.children[0] = child0;
     _hash_obj.children[1] = child1;
     if ( const auto it = _storage->hash.find( _hash_obj ); it != _storage->hash.end() && it->second != old_node )
@@ -581,7 +599,7 @@ public:
     _storage->hash[node] = n;
 
     // update the reference counter of the new signal
-    _storage->nodes[new_signal.index].data[0].h1++;
+    node_data::incr_fanout_size( *_storage, new_signal.index );
 
     for ( auto const& fn : _events->on_modified )
     {
@@ -656,7 +674,7 @@ public:
     }
 
     // update the reference counter of the new signal
-    _storage->nodes[new_signal.index].data[0].h1++;
+    node_data::incr_fanout_size( *_storage, new_signal.index );
 
     for ( auto const& fn : _events->on_modified )
     {
@@ -679,7 +697,7 @@ public:
         if ( old_node != new_signal.index )
         {
           /* increment fan-in of new node */
-          _storage->nodes[new_signal.index].data[0].h1++;
+          node_data::incr_fanout_size( *_storage, new_signal.index );
         }
       }
     }
@@ -692,7 +710,7 @@ public:
       return;
 
     auto& nobj = _storage->nodes[n];
-    nobj.data[0].h1 = UINT32_C( 0x80000000 ); /* fanout size 0, but dead */
+    node_data::kill( nobj ); /* fanout size 0, but dead */
     _storage->hash.erase( nobj );
 
     for ( auto const& fn : _events->on_delete )
@@ -720,7 +738,7 @@ public:
 
     assert( n < _storage->nodes.size() );
     auto& nobj = _storage->nodes[n];
-    nobj.data[0].h1 = UINT32_C( 0 ); /* fanout size 0, but not dead (like just created) */
+    node_data::revive( nobj ); /* fanout size 0, but not dead (like just created) */
     _storage->hash[nobj] = n;
 
     for ( auto const& fn : _events->on_add )
@@ -741,7 +759,7 @@ public:
 
   inline bool is_dead( node const& n ) const
   {
-    return ( _storage->nodes[n].data[0].h1 >> 31 ) & 1;
+    return node_data::is_dead( *_storage, n );
   }
 
   void substitute_node( node const& old_node, signal const& new_signal )
@@ -852,6 +870,11 @@ public:
     return static_cast<uint32_t>( _storage->hash.size() );
   }
 
+  uint64_t memory_usage() const
+  {
+    return sizeof( *this ) + _storage->memory_usage();
+  }
+
   uint32_t fanin_size( node const& n ) const
   {
     if ( is_constant( n ) || is_ci( n ) )
@@ -861,17 +884,17 @@ public:
 
   uint32_t fanout_size( node const& n ) const
   {
-    return _storage->nodes[n].data[0].h1 & UINT32_C( 0x7FFFFFFF );
+    return node_data::fanout_size( *_storage, n );
   }
 
   uint32_t incr_fanout_size( node const& n ) const
   {
-    return _storage->nodes[n].data[0].h1++ & UINT32_C( 0x7FFFFFFF );
+    return node_data::incr_fanout_size( *_storage, n );
   }
 
   uint32_t decr_fanout_size( node const& n ) const
   {
-    return --_storage->nodes[n].data[0].h1 & UINT32_C( 0x7FFFFFFF );
+    return node_data::decr_fanout_size( *_storage, n );
   }
 
   bool is_and( node const& n ) const
@@ -1202,44 +1225,44 @@ public:
 #pragma region Custom node values
   void clear_values() const
   {
-    std::for_each( _storage->nodes.begin(), _storage->nodes.end(), []( auto& n ) { n.data[0].h2 = 0; } );
+    node_data::clear_values( *_storage );
   }
 
   auto value( node const& n ) const
   {
-    return _storage->nodes[n].data[0].h2;
+    return node_data::value( *_storage, n );
   }
 
   void set_value( node const& n, uint32_t v ) const
   {
-    _storage->nodes[n].data[0].h2 = v;
+    node_data::set_value( *_storage, n, v );
   }
 
   auto incr_value( node const& n ) const
   {
-    return _storage->nodes[n].data[0].h2++;
+    return node_data::incr_value( *_storage, n );
   }
 
   auto decr_value( node const& n ) const
   {
-    return --_storage->nodes[n].data[0].h2;
+    return node_data::decr_value( *_storage, n );
   }
 #pragma endregion
 
 #pragma region Visited flags
   void clear_visited() const
   {
-    std::for_each( _storage->nodes.begin(), _storage->nodes.end(), []( auto& n ) { n.data[1].h1 = 0; } );
+    node_data::clear_visited( *_storage );
   }
 
   auto visited( node const& n ) const
   {
-    return _storage->nodes[n].data[1].h1;
+    return node_data::visited( *_storage, n );
   }
 
   void set_visited( node const& n, uint32_t v ) const
   {
-    _storage->nodes[n].data[1].h1 = v;
+    node_data::set_visited( *_storage, n, v );
   }
 
   uint32_t trav_id() const
@@ -1261,19 +1284,23 @@ public:
 #pragma endregion
 
 public:
-  std::shared_ptr<xag_storage> _storage;
+  std::shared_ptr<basic_xag_storage<Layout>> _storage;
   std::shared_ptr<network_events<base_type>> _events;
 };
 
+using xag_network = basic_xag_network<>;
+using compact_xag_network = basic_xag_network<storage_layout::compact>;
+using compact_cold_xag_network = basic_xag_network<storage_layout::compact_cold>;
+
 } // namespace mockturtle
 
 namespace std
 {
 
 template<>
-struct hash<mockturtle::xag_network::signal>
+struct hash<mockturtle::xag_signal>
 {
-  uint64_t operator()( mockturtle::xag_network::signal const& s ) const noexcept
+  uint64_t operator()( mockturtle::xag_signal const& s ) const noexcept
   {
     uint64_t k = s.data;
     k ^= k >> 33;
@@ -93,6 +93,36 @@ template<class Ntk>
 inline constexpr bool is_aig_network_type_v = is_aig_network_type<Ntk>::value;
 #pragma endregion
 
+#pragma region is_xag_network_type
+template<class Ntk, class = void>
+struct is_xag_network_type : std::false_type
+{
+};
+
+template<class Ntk>
+struct is_xag_network_type<Ntk, std::enable_if_t<Ntk::is_xag_network_type, std::void_t<decltype( Ntk::is_xag_network_type )>>> : std::true_type
+{
+};
+
+template<class Ntk>
+inline constexpr bool is_xag_network_type_v = is_xag_network_type<Ntk>::value;
+#pragma endregion
+
+#pragma region is_mig_network_type
+template<class Ntk, class = void>
+struct is_mig_network_type : std::false_type
+{
+};
+
+template<class Ntk>
+struct is_mig_network_type<Ntk, std::enable_if_t<Ntk::is_mig_network_type, std::void_t<decltype( Ntk::is_mig_network_type )>>> : std::true_type
+{
+};
+
+template<class Ntk>
+inline constexpr bool is_mig_network_type_v = is_mig_network_type<Ntk>::value;
+#pragma endregion
+
 #pragma region is_buffered_network_type
 template<class Ntk, class = void>
 struct is_buffered_network_type : std::false_type
@@ -963,6 +993,21 @@ template<class Ntk>
 inline constexpr bool has_num_registers_v = has_num_registers<Ntk>::value;
 #pragma endregion
 
+#pragma region has_memory_usage
+template<class Ntk, class = void>
+struct has_memory_usage : std::false_type
+{
+};
+
+template<class Ntk>
+struct has_memory_usage<Ntk, std::void_t<decltype( std::declval<Ntk>().memory_usage() )>> : std::true_type
+{
+};
+
+template<class Ntk>
+inline constexpr bool has_memory_usage_v = has_memory_usage<Ntk>::value;
+#pragma endregion
+
 #pragma region has_fanin_size
 template<class Ntk, class = void>
 struct has_fanin_size : std::false_type
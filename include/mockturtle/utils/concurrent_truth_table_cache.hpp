@@ -0,0 +1,411 @@
+/* mockturtle: C++ logic network library
+ * Copyright (C) 2018-2022  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*!
+  \file concurrent_truth_table_cache.hpp
+  \brief Sharded truth table cache for concurrent use
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cassert>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <type_traits>
+#include <vector>
+
+#include <kitty/dynamic_truth_table.hpp>
+#include <kitty/operations.hpp>
+#include <kitty/operators.hpp>
+#include <kitty/static_truth_table.hpp>
+
+namespace mockturtle
+{
+
+/*! \cond PRIVATE */
+namespace detail
+{
+
+template<typename TT>
+struct concurrent_tt_traits;
+
+template<>
+struct concurrent_tt_traits<kitty::dynamic_truth_table>
+{
+  static constexpr uint32_t default_num_vars = 6u;
+  static constexpr bool fixed_num_vars = false;
+};
+
+template<uint32_t NumVars, bool S>
+struct concurrent_tt_traits<kitty::static_truth_table<NumVars, S>>
+{
+  static constexpr uint32_t default_num_vars = NumVars;
+  static constexpr bool fixed_num_vars = true;
+};
+
+} // namespace detail
+/*! \endcond */
+
+/*! \brief Sharded truth table cache for concurrent use.
+ *
+ * This cache follows the conventions of `truth_table_cache`: only normal
+ * truth tables are stored and an entry is referred to by a literal, whose
+ * least significant bit is the complement.  In contrast to
+ * `truth_table_cache`, several threads can insert truth tables and read
+ * truth tables at the same time.
+ *
+ * The cache is split into shards, selected by the hash value of a truth
+ * table.  Each shard stores its truth tables inline as fixed-width entries
+ * in blocks of growing size, which are never moved once allocated.  Up to 6
+ * variables, an entry is a single `uint64_t`.  Insertions lock only the
+ * shard of the truth table, while reading a truth table from its literal
+ * (`operator[]`) does not lock.
+ *
+ * Truth tables of type `kitty::dynamic_truth_table` may have any number of
+ * variables up to the number given in the constructor.  Literals are not
+ * assigned consecutively and should only be obtained from `insert`.
+ *
+   \verbatim embed:rst
+
+   Example
+
+   .. code-block:: c++
+
+      concurrent_truth_table_cache<kitty::dynamic_truth_table> cache( 6u );
+
+      std::vector<std::thread> threads;
+      for ( auto i = 0u; i < 4u; ++i )
+      {
+        threads.emplace_back( [&]() {
+          kitty::dynamic_truth_table maj( 3 );
+          kitty::create_majority( maj );
+          auto lit = cache.insert( maj ); // same literal in all threads
+          auto tt = cache[lit ^ 1];       // tt is ~maj
+        } );
+      }
+      for ( auto& t : threads )
+      {
+        t.join();
+      }
+   \endverbatim
+ */
+template<typename TT>
+class concurrent_truth_table_cache
+{
+private:
+  struct block
+  {
+    block( uint32_t num_entries, uint32_t width )
+        : words( new uint64_t[static_cast<std::size_t>( num_entries ) * width] ),
+          num_vars( new uint8_t[num_entries] )
+    {
+    }
+
+    std::unique_ptr<uint64_t[]> words;
+    std::unique_ptr<uint8_t[]> num_vars;
+  };
+
+  struct shard
+  {
+    std::mutex mutex;
+
+    /* number of entries, published after an entry is written */
+    std::atomic<uint32_t> size{ 0u };
+
+    /* block `i` holds `2^i` times as many entries as block 0 */
+    std::array<std::atomic<block*>, 32u> blocks;
+
+    /* open addressing table of entry index + 1 (0 is empty) */
+    std::vector<uint32_t> slots;
+    std::vector<uint64_t> hashes;
+  };
+
+public:
+  /*! \brief Creates a concurrent truth table cache.
+   *
+   * \param num_vars Maximum number of variables of the truth tables
+   * \param log_num_shards Logarithm of the number of shards
+   * \param log_block_size Logarithm of the number of entries in the first block
+   */
+  explicit concurrent_truth_table_cache( uint32_t num_vars = detail::concurrent_tt_traits<TT>::default_num_vars, uint32_t log_num_shards = 4u, uint32_t log_block_size = 12u );
+
+  ~concurrent_truth_table_cache();
+
+  concurrent_truth_table_cache( concurrent_truth_table_cache const& ) = delete;
+  concurrent_truth_table_cache& operator=( concurrent_truth_table_cache const& ) = delete;
+
+  /*! \brief Inserts a truth table and returns a literal.
+   *
+   * As in `truth_table_cache`, the complement of a truth table that is not
+   * normal is inserted and a negative literal is returned.  This method can
+   * be called concurrently.
+   *
+   * \param tt Truth table to insert
+   * \return Literal of position in cache
+   */
+  uint32_t insert( TT tt );
+
+  /*! \brief Returns truth table for a given literal.
+   *
+   * The literal must have been returned by `insert`.  This method does not
+   * lock and can be called concurrently to `insert`.
+   */
+  TT operator[]( uint32_t lit ) const;
+
+  /*! \brief Returns number of normalized truth tables in the cache. */
+  std::size_t size() const;
+
+  /*! \brief Returns the number of shards. */
+  uint32_t num_shards() const { return 1u << _log_num_shards; }
+
+private:
+  uint64_t hash( TT const& tt ) const;
+  uint32_t locate( uint32_t local, uint32_t& offset ) const;
+  bool equal( block const& blk, uint32_t offset, TT const& tt ) const;
+  void store( shard& sh, uint32_t local, TT const& tt );
+  void grow( shard& sh );
+
+private:
+  uint32_t _num_vars;
+  uint32_t _width;
+  uint32_t _log_num_shards;
+  uint32_t _log_block_size;
+  std::unique_ptr<shard[]> _shards;
+};
+
+template<typename TT>
+concurrent_truth_table_cache<TT>::concurrent_truth_table_cache( uint32_t num_vars, uint32_t log_num_shards, uint32_t log_block_size )
+    : _num_vars( num_vars ),
+      _width( num_vars <= 6u ? 1u : ( 1u << ( num_vars - 6u ) ) ),
+      _log_num_shards( log_num_shards ),
+      _log_block_size( log_block_size ),
+      _shards( new shard[1u << log_num_shards] )
+{
+  assert( !detail::concurrent_tt_traits<TT>::fixed_num_vars || num_vars == detail::concurrent_tt_traits<TT>::default_num_vars );
+  assert( log_num_shards + log_block_size < 31u );
+
+  for ( auto i = 0u; i < num_shards(); ++i )
+  {
+    auto& sh = _shards[i];
+    for ( auto& blk : sh.blocks )
+    {
+      blk.store( nullptr, std::memory_order_relaxed );
+    }
+    sh.slots.resize( 64u, 0u );
+    sh.hashes.resize( 64u, 0u );
+  }
+}
+
+template<typename TT>
+concurrent_truth_table_cache<TT>::~concurrent_truth_table_cache()
+{
+  for ( auto i = 0u; i < num_shards(); ++i )
+  {
+    for ( auto& blk : _shards[i].blocks )
+    {
+      delete blk.load( std::memory_order_relaxed );
+    }
+  }
+}
+
+template<typename TT>
+uint32_t concurrent_truth_table_cache<TT>::insert( TT tt )
+{
+  assert( tt.num_vars() <= _num_vars );
+
+  uint32_t is_compl{ 0 };
+  if ( kitty::get_bit( tt, 0 ) )
+  {
+    is_compl = 1;
+    tt = ~tt;
+  }
+
+  auto const h = hash( tt );
+  auto const shard_index = static_cast<uint32_t>( h >> 32 ) & ( num_shards() - 1u );
+  auto& sh = _shards[shard_index];
+
+  std::lock_guard<std::mutex> lock( sh.mutex );
+
+  /* is truth table already in cache? */
+  auto const mask = static_cast<uint32_t>( sh.slots.size() - 1u );
+  auto pos = static_cast<uint32_t>( h ) & mask;
+  while ( sh.slots[pos] != 0u )
+  {
+    if ( sh.hashes[pos] == h )
+    {
+      auto const local = sh.slots[pos] - 1u;
+      uint32_t offset;
+      auto const block_index = locate( local, offset );
+      if ( equal( *sh.blocks[block_index].load( std::memory_order_relaxed ), offset, tt ) )
+      {
+        return ( ( ( local << _log_num_shards ) | shard_index ) << 1u ) | is_compl;
+      }
+    }
+    pos = ( pos + 1u ) & mask;
+  }
+
+  /* add truth table to end of shard */
+  auto const local = sh.size.load( std::memory_order_relaxed );
+  store( sh, local, tt );
+  sh.slots[pos] = local + 1u;
+  sh.hashes[pos] = h;
+  sh.size.store( local + 1u, std::memory_order_release );
+
+  if ( 2u * ( local + 1u ) > sh.slots.size() )
+  {
+    grow( sh );
+  }
+
+  return ( ( ( local << _log_num_shards ) | shard_index ) << 1u ) | is_compl;
+}
+
+template<typename TT>
+TT concurrent_truth_table_cache<TT>::operator[]( uint32_t lit ) const
+{
+  auto const index = lit >> 1u;
+  auto const& sh = _shards[index & ( num_shards() - 1u )];
+  auto const local = index >> _log_num_shards;
+
+  /* synchronizes with the insertion of the entry */
+  [[maybe_unused]] auto const size = sh.size.load( std::memory_order_acquire );
+  assert( local < size );
+
+  uint32_t offset;
+  auto const& blk = *sh.blocks[locate( local, offset )].load( std::memory_order_acquire );
+
+  TT tt = [&]() {
+    if constexpr ( detail::concurrent_tt_traits<TT>::fixed_num_vars )
+    {
+      return TT{};
+    }
+    else
+    {
+      return TT( blk.num_vars[offset] );
+    }
+  }();
+  std::copy( &blk.words[offset * _width], &blk.words[offset * _width] + tt.num_blocks(), tt.begin() );
+
+  return ( lit & 1u ) ? ~tt : tt;
+}
+
+template<typename TT>
+std::size_t concurrent_truth_table_cache<TT>::size() const
+{
+  std::size_t total{ 0 };
+  for ( auto i = 0u; i < num_shards(); ++i )
+  {
+    total += _shards[i].size.load( std::memory_order_acquire );
+  }
+  return total;
+}
+
+template<typename TT>
+uint64_t concurrent_truth_table_cache<TT>::hash( TT const& tt ) const
+{
+  /* splitmix64 finalizer over the words and the number of variables */
+  uint64_t h = 0x9e3779b97f4a7c15ull * ( tt.num_vars() + 1u );
+  std::for_each( tt.cbegin(), tt.cend(), [&]( auto word ) {
+    h ^= word + 0x9e3779b97f4a7c15ull + ( h << 6u ) + ( h >> 2u );
+    h = ( h ^ ( h >> 30u ) ) * 0xbf58476d1ce4e5b9ull;
+    h = ( h ^ ( h >> 27u ) ) * 0x94d049bb133111ebull;
+    h ^= h >> 31u;
+  } );
+  return h;
+}
+
+template<typename TT>
+uint32_t concurrent_truth_table_cache<TT>::locate( uint32_t local, uint32_t& offset ) const
+{
+  /* blocks before block `b` hold `(2^b - 1) * 2^log_block_size` entries */
+  auto const q = ( local >> _log_block_size ) + 1u;
+  uint32_t b{ 0 };
+  while ( ( q >> ( b + 1u ) ) != 0u )
+  {
+    ++b;
+  }
+  offset = local - ( ( ( 1u << b ) - 1u ) << _log_block_size );
+  return b;
+}
+
+template<typename TT>
+bool concurrent_truth_table_cache<TT>::equal( block const& blk, uint32_t offset, TT const& tt ) const
+{
+  if ( blk.num_vars[offset] != tt.num_vars() )
+  {
+    return false;
+  }
+  return std::equal( tt.cbegin(), tt.cend(), &blk.words[offset * _width] );
+}
+
+template<typename TT>
+void concurrent_truth_table_cache<TT>::store( shard& sh, uint32_t local, TT const& tt )
+{
+  /* a literal has 31 bits for the local index and the shard */
+  assert( local < ( 1u << ( 31u - _log_num_shards ) ) && "concurrent truth table cache is full" );
+
+  uint32_t offset;
+  auto const block_index = locate( local, offset );
+  block* blk = sh.blocks[block_index].load( std::memory_order_relaxed );
+  if ( blk == nullptr )
+  {
+    blk = new block( 1u << ( _log_block_size + block_index ), _width );
+    sh.blocks[block_index].store( blk, std::memory_order_release );
+  }
+
+  std::copy( tt.cbegin(), tt.cend(), &blk->words[offset * _width] );
+  blk->num_vars[offset] = static_cast<uint8_t>( tt.num_vars() );
+}
+
+template<typename TT>
+void concurrent_truth_table_cache<TT>::grow( shard& sh )
+{
+  std::vector<uint32_t> slots( 2u * sh.slots.size(), 0u );
+  std::vector<uint64_t> hashes( 2u * sh.hashes.size(), 0u );
+  auto const mask = static_cast<uint32_t>( slots.size() - 1u );
+
+  for ( auto i = 0u; i < sh.slots.size(); ++i )
+  {
+    if ( sh.slots[i] == 0u )
+    {
+      continue;
+    }
+    auto pos = static_cast<uint32_t>( sh.hashes[i] ) & mask;
+    while ( slots[pos] != 0u )
+    {
+      pos = ( pos + 1u ) & mask;
+    }
+    slots[pos] = sh.slots[i];
+    hashes[pos] = sh.hashes[i];
+  }
+
+  sh.slots.swap( slots );
+  sh.hashes.swap( hashes );
+}
+
+} /* namespace mockturtle */
@@ -0,0 +1,320 @@
+/* mockturtle: C++ logic network library
+ * Copyright (C) 2018-2022  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*!
+  \file cut_store.hpp
+  \brief Cut database attached to a network and kept up to date with its events
+*/
+
+#pragma once
+
+#include <cassert>
+#include <cstdint>
+#include <memory>
+#include <tuple>
+#include <vector>
+
+#include <kitty/npn.hpp>
+#include <kitty/static_truth_table.hpp>
+
+#include "../algorithms/cut_enumeration.hpp"
+#include "../networks/events.hpp"
+#include "../traits.hpp"
+
+namespace mockturtle
+{
+
+/*! \brief Statistics for the cut store.
+ *
+ * The data structure `cut_store_stats` provides data collected by a
+ * `cut_store` since its construction.
+ */
+struct cut_store_stats
+{
+  /*! \brief Number of cuts that were enumerated. */
+  uint64_t enumerated_cuts{ 0 };
+
+  /*! \brief Number of cut set queries answered from the store. */
+  uint64_t reused{ 0 };
+
+  /*! \brief Number of cut sets invalidated by changes in the network. */
+  uint64_t invalidated{ 0 };
+
+  /*! \brief Number of NPN classes computed. */
+  uint64_t npn_computed{ 0 };
+};
+
+/*! \brief Cut database attached to a network.
+ *
+ * The store enumerates the cuts of a node on demand, together with the cuts
+ * of its transitive fanin, and keeps them until the node is affected by a
+ * change of the network.  To this end, it registers to the network events:
+ * when a node is modified or deleted, the cuts of the node and of its
+ * transitive fanout are invalidated, while all other cuts are kept.
+ * Several optimization steps on the same network can thus share the
+ * enumeration effort, as long as they use compatible cut parameters (see
+ * `is_compatible`).
+ *
+ * Cut functions are stored as `kitty::static_truth_table<NumVars>` in a
+ * truth table cache.  Their exact NPN classes are computed on first request
+ * and cached by function, such that each distinct function is canonized
+ * only once.
+ *
+ * The cut data `CutData` is computed when a cut set is enumerated, hence it
+ * may be outdated if it depends on information outside of the transitive
+ * fanin (e.g., fanout sizes).  Method `recompute` enumerates again the cuts
+ * of a single node.
+ *
+ * The network must provide `foreach_fanout` (e.g., by wrapping it into a
+ * `fanout_view`), and all combinational inputs must exist when the store is
+ * constructed.  The cut limit must be smaller than 16.
+ *
+   \verbatim embed:rst
+
+   Example
+
+   .. code-block:: c++
+
+      fanout_view<aig_network> ntk{ aig };
+      cut_enumeration_params ps;
+      ps.cut_limit = 8u;
+      cut_store<fanout_view<aig_network>, 4u> store( ntk, ps );
+
+      ntk.foreach_gate( [&]( auto const& n ) {
+        for ( auto const& cut : store.cuts( n ) )
+        {
+          auto const& [tt_npn, neg, perm] = store.npn_class( *cut );
+          ...
+        }
+      } );
+   \endverbatim
+ */
+template<class Ntk, uint32_t NumVars, typename CutData = empty_cut_data>
+class cut_store
+{
+public:
+  using network_cuts_t = dynamic_network_cuts<Ntk, NumVars, true, CutData>;
+  using cut_t = typename network_cuts_t::cut_t;
+  using cut_set_t = typename network_cuts_t::cut_set_t;
+  using truth_table_t = kitty::static_truth_table<NumVars>;
+  using npn_class_t = std::tuple<truth_table_t, uint32_t, std::vector<uint8_t>>;
+
+public:
+  cut_store( Ntk& ntk, cut_enumeration_params const& ps )
+      : _ntk( ntk ),
+        _ps( ps ),
+        _cuts( ntk.size() + ( ntk.size() >> 1 ) ),
+        _cut_manager( ntk, _ps, _cst, _cuts )
+  {
+    static_assert( is_network_type_v<Ntk>, "Ntk is not a network type" );
+    static_assert( has_foreach_fanout_v<Ntk>, "Ntk does not implement the foreach_fanout method" );
+    static_assert( has_foreach_fanin_v<Ntk>, "Ntk does not implement the foreach_fanin method" );
+    static_assert( has_compute_v<Ntk, truth_table_t>, "Ntk does not implement the compute method for static truth tables" );
+    assert( ps.cut_size <= NumVars && "cut_size exceeds the number of variables of the stored truth tables" );
+
+    _cut_manager.init_cuts();
+
+    _add_event = _ntk.events().register_add_event( [this]( auto const& n ) {
+      invalidate( n );
+    } );
+    _modified_event = _ntk.events().register_modified_event( [this]( auto const& n, auto const& previous_children ) {
+      (void)previous_children;
+      invalidate( n );
+    } );
+    _delete_event = _ntk.events().register_delete_event( [this]( auto const& n ) {
+      invalidate( n );
+    } );
+  }
+
+  ~cut_store()
+  {
+    _ntk.events().release_add_event( _add_event );
+    _ntk.events().release_modified_event( _modified_event );
+    _ntk.events().release_delete_event( _delete_event );
+  }
+
+  cut_store( cut_store const& ) = delete;
+  cut_store& operator=( cut_store const& ) = delete;
+
+public:
+  /*! \brief Checks whether the store can serve a consumer using `ps`.
+   *
+   * Cuts are shared only with consumers that would enumerate exactly the
+   * same cuts, i.e., with the same cut size, cut limit, and truth table
+   * minimization.
+   */
+  bool is_compatible( cut_enumeration_params const& ps ) const
+  {
+    return ps.cut_size == _ps.cut_size && ps.cut_limit == _ps.cut_limit && ps.minimize_truth_table == _ps.minimize_truth_table;
+  }
+
+  /*! \brief Returns the cuts of a node, enumerating them if needed. */
+  cut_set_t const& cuts( node<Ntk> const& n )
+  {
+    auto const index = _ntk.node_to_index( n );
+    if ( index < _cuts.nodes_size() && _cuts.cuts( index ).size() > 0 )
+    {
+      ++_st.reused;
+    }
+    else
+    {
+      compute( n );
+    }
+    return _cuts.cuts( index );
+  }
+
+  /*! \brief Enumerates again the cuts of a node.
+   *
+   * The cuts of the transitive fanin are kept, while the cuts of the
+   * transitive fanout are invalidated.
+   */
+  cut_set_t const& recompute( node<Ntk> const& n )
+  {
+    assert( !_ntk.is_constant( n ) && !_ntk.is_ci( n ) );
+    invalidate( n );
+    compute( n );
+    return _cuts.cuts( _ntk.node_to_index( n ) );
+  }
+
+  /*! \brief Returns the function of a cut. */
+  truth_table_t truth_table( cut_t const& cut ) const
+  {
+    return _cuts.truth_table( cut );
+  }
+
+  /*! \brief Returns the exact NPN class of the function of a cut.
+   *
+   * The result is the tuple returned by `kitty::exact_npn_canonization`.
+   */
+  npn_class_t const& npn_class( cut_t const& cut )
+  {
+    auto const func_id = cut->func_id;
+    if ( func_id >= _npn_classes.size() )
+    {
+      _npn_classes.resize( func_id + 1u );
+    }
+
+    auto& entry = _npn_classes[func_id];
+    if ( !entry )
+    {
+      entry = std::make_unique<npn_class_t>( kitty::exact_npn_canonization( _cuts.truth_table( cut ) ) );
+      ++_st.npn_computed;
+    }
+    return *entry;
+  }
+
+  /*! \brief Removes all cuts except for the ones of constants and inputs. */
+  void clear()
+  {
+    _ntk.foreach_gate( [&]( auto const& n ) {
+      auto const index = _ntk.node_to_index( n );
+      if ( index < _cuts.nodes_size() && _cuts.cuts( index ).size() > 0 )
+      {
+        _cut_manager.clear_cuts( n );
+        ++_st.invalidated;
+      }
+    } );
+  }
+
+  cut_enumeration_params const& params() const
+  {
+    return _ps;
+  }
+
+  cut_store_stats const& stats() const
+  {
+    return _st;
+  }
+
+  /*! \brief Returns the memory used by the cuts, their functions, and NPN classes in bytes. */
+  uint64_t memory_usage() const
+  {
+    uint64_t bytes = sizeof( *this ) + dynamic_memory_usage( _cuts ) + dynamic_memory_usage( _npn_classes ) + dynamic_memory_usage( _stack );
+    for ( auto const& entry : _npn_classes )
+    {
+      if ( entry )
+      {
+        bytes += sizeof( npn_class_t ) + dynamic_memory_usage( std::get<2>( *entry ) );
+      }
+    }
+    return bytes;
+  }
+
+private:
+  void compute( node<Ntk> const& n )
+  {
+    auto const before = _cuts.total_cuts();
+    _cut_manager.compute_cuts( n );
+    _st.enumerated_cuts += _cuts.total_cuts() - before;
+  }
+
+  /* clears the cuts of `n` and of its transitive fanout; a node has cuts
+   * only if all nodes in its transitive fanin have cuts, hence the
+   * traversal stops at nodes without cuts */
+  void invalidate( node<Ntk> const& n )
+  {
+    if ( _ntk.is_constant( n ) || _ntk.is_ci( n ) )
+    {
+      return;
+    }
+
+    _stack.clear();
+    _stack.push_back( n );
+    while ( !_stack.empty() )
+    {
+      auto const g = _stack.back();
+      _stack.pop_back();
+
+      auto const index = _ntk.node_to_index( g );
+      if ( index >= _cuts.nodes_size() || _cuts.cuts( index ).size() == 0 )
+      {
+        continue;
+      }
+
+      _cut_manager.clear_cuts( g );
+      ++_st.invalidated;
+
+      _ntk.foreach_fanout( g, [&]( auto const& f ) {
+        _stack.push_back( f );
+      } );
+    }
+  }
+
+private:
+  Ntk& _ntk;
+  cut_enumeration_params const _ps;
+  cut_enumeration_stats _cst;
+  network_cuts_t _cuts;
+  detail::dynamic_cut_enumeration_impl<Ntk, NumVars, true, CutData> _cut_manager;
+  std::vector<std::unique_ptr<npn_class_t>> _npn_classes;
+  std::vector<node<Ntk>> _stack;
+  cut_store_stats _st;
+
+  std::shared_ptr<typename network_events<Ntk>::add_event_type> _add_event;
+  std::shared_ptr<typename network_events<Ntk>::modified_event_type> _modified_event;
+  std::shared_ptr<typename network_events<Ntk>::delete_event_type> _delete_event;
+};
+
+} /* namespace mockturtle */
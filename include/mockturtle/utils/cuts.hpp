@@ -34,6 +34,7 @@
 
 #pragma once
 
+#include <algorithm>
 #include <array>
 #include <cassert>
 #include <iostream>
@@ -43,9 +44,163 @@
 
 #include "algorithm.hpp"
 
+#if defined( __AVX2__ )
+#include <immintrin.h>
+#endif
+
 namespace mockturtle
 {
 
+namespace detail
+{
+
+#if defined( __AVX2__ )
+/* loads up to 8 leaves, lanes beyond `n` are zero and never read from memory */
+inline __m256i load_leaves( uint32_t const* p, uint32_t n, __m256i& valid )
+{
+  valid = _mm256_cmpgt_epi32( _mm256_set1_epi32( static_cast<int>( n ) ), _mm256_setr_epi32( 0, 1, 2, 3, 4, 5, 6, 7 ) );
+  return _mm256_maskload_epi32( reinterpret_cast<int const*>( p ), valid );
+}
+
+inline uint32_t lane_count( __m256i mask )
+{
+  return static_cast<uint32_t>( __builtin_popcount( static_cast<uint32_t>( _mm256_movemask_ps( _mm256_castsi256_ps( mask ) ) ) ) );
+}
+#endif
+
+/*! \brief Locates a leaf in a sorted leaf array.
+ *
+ * Returns the number of leaves in `leaves` that are smaller than `leaf` and
+ * sets `found` if `leaf` is contained.  With AVX2, the leaf is compared
+ * against 8 leaves at once.
+ */
+inline uint32_t leaf_rank( uint32_t const* leaves, uint32_t length, uint32_t leaf, bool& found )
+{
+#if defined( __AVX2__ )
+  /* leaf indices are node indices and fit into signed 32-bit lanes */
+  __m256i const pivot = _mm256_set1_epi32( static_cast<int>( leaf ) );
+  uint32_t smaller{ 0 }, equal{ 0 };
+  for ( uint32_t i = 0; i < length; i += 8 )
+  {
+    __m256i valid;
+    __m256i const chunk = load_leaves( leaves + i, std::min( length - i, 8u ), valid );
+    smaller += lane_count( _mm256_and_si256( valid, _mm256_cmpgt_epi32( pivot, chunk ) ) );
+    equal += lane_count( _mm256_and_si256( valid, _mm256_cmpeq_epi32( pivot, chunk ) ) );
+  }
+  found = equal != 0;
+  return smaller;
+#else
+  uint32_t smaller{ 0 }, equal{ 0 };
+  for ( uint32_t i = 0; i < length; ++i )
+  {
+    smaller += leaves[i] < leaf ? 1u : 0u;
+    equal += leaves[i] == leaf ? 1u : 0u;
+  }
+  found = equal != 0;
+  return smaller;
+#endif
+}
+
+/*! \brief Checks whether a sorted leaf array is a subset of another one. */
+inline bool leaves_included( uint32_t const* sub, uint32_t sub_length, uint32_t const* super, uint32_t super_length )
+{
+#if defined( __AVX2__ )
+  for ( uint32_t j = 0; j < sub_length; ++j )
+  {
+    bool found;
+    leaf_rank( super, super_length, sub[j], found );
+    if ( !found )
+    {
+      return false;
+    }
+  }
+  return true;
+#else
+  // this is basically
+  //     return std::includes( super, super + super_length, sub, sub + sub_length )
+  // but it turns out that this code is faster compared to the standard
+  // implementation.
+  if ( sub_length == 0 )
+  {
+    return true;
+  }
+  for ( auto it2 = super, it1 = sub; it2 != super + super_length; ++it2 )
+  {
+    if ( *it2 > *it1 )
+    {
+      return false;
+    }
+    if ( ( *it2 == *it1 ) && ( ++it1 == sub + sub_length ) )
+    {
+      return true;
+    }
+  }
+  return false;
+#endif
+}
+
+/*! \brief Merges two sorted leaf arrays.
+ *
+ * Computes the union of the two sorted arrays into `result`, if the union has
+ * at most `limit` elements, and returns its size.  Otherwise, returns -1.
+ *
+ * With AVX2, the merge is computed without data-dependent branches: the
+ * output position of every leaf is its rank in the own array plus its rank
+ * in the other array, where ranks are computed with vector comparisons.
+ * Without AVX2, the scalar `set_union_safe` is used.
+ */
+template<int MaxLeaves>
+inline int32_t merge_leaves( uint32_t const* a, uint32_t na, uint32_t const* b, uint32_t nb, uint32_t* result, uint32_t limit )
+{
+#if defined( __AVX2__ )
+  std::array<uint32_t, MaxLeaves> b_new;
+  std::array<uint32_t, MaxLeaves> b_pos;
+  uint32_t num_new{ 0 };
+
+  /* leaves of `b` that are not in `a`, and their rank in `a` */
+  for ( uint32_t j = 0; j < nb; ++j )
+  {
+    bool found;
+    auto const rank = leaf_rank( a, na, b[j], found );
+    b_new[num_new] = b[j];
+    b_pos[num_new] = rank + num_new;
+    num_new += found ? 0u : 1u;
+  }
+
+  if ( na + num_new > limit )
+  {
+    return -1;
+  }
+
+  for ( uint32_t j = 0; j < num_new; ++j )
+  {
+    result[b_pos[j]] = b_new[j];
+  }
+  for ( uint32_t i = 0; i < na; ++i )
+  {
+    bool found;
+    result[i + leaf_rank( b_new.data(), num_new, a[i], found )] = a[i];
+  }
+  return static_cast<int32_t>( na + num_new );
+#else
+  return set_union_safe( a, a + na, b, b + nb, result, limit );
+#endif
+}
+
+/*! \brief Signature-based filter for cut merging.
+ *
+ * Each leaf sets one bit (its index modulo 64) of the signature, hence the
+ * number of bits in the union of two signatures is a lower bound on the size
+ * of the merged cut.
+ */
+inline bool signatures_fit( uint64_t sign1, uint64_t sign2, uint32_t cut_size )
+{
+  auto const sign = sign1 | sign2;
+  return uint32_t( __builtin_popcount( static_cast<uint32_t>( sign & 0xffffffff ) ) ) + uint32_t( __builtin_popcount( static_cast<uint32_t>( sign >> 32 ) ) ) <= cut_size;
+}
+
+} // namespace detail
+
 struct empty_cut_data
 {
 };
@@ -287,43 +442,18 @@ bool cut<MaxLeaves, T>::dominates( cut const& that ) const
     return std::equal( begin(), end(), that.begin() );
   }
 
-  if ( _length == 0 )
-  {
-    return true;
-  }
-
-  // this is basically
-  //     return std::includes( that.begin(), that.end(), begin(), end() )
-  // but it turns out that this code is faster compared to the standard
-  // implementation.
-  for ( auto it2 = that.begin(), it1 = begin(); it2 != that.end(); ++it2 )
-  {
-    if ( *it2 > *it1 )
-    {
-      return false;
-    }
-    if ( ( *it2 == *it1 ) && ( ++it1 == end() ) )
-    {
-      return true;
-    }
-  }
-
-  return false;
+  return detail::leaves_included( _leaves.data(), _length, that._leaves.data(), that._length );
 }
 
 template<int MaxLeaves, typename T>
 bool cut<MaxLeaves, T>::merge( cut const& that, cut& res, uint32_t cut_size ) const
 {
-  if ( _length + that._length > cut_size )
+  if ( _length + that._length > cut_size && !detail::signatures_fit( _signature, that._signature, cut_size ) )
   {
-    const auto sign = _signature + that._signature;
-    if ( uint32_t( __builtin_popcount( static_cast<uint32_t>( sign & 0xffffffff ) ) ) + uint32_t( __builtin_popcount( static_cast<uint32_t>( sign >> 32 ) ) ) > cut_size )
-    {
-      return false;
-    }
+    return false;
   }
 
-  int32_t length = set_union_safe( begin(), end(), that.begin(), that.end(), res.begin(), cut_size );
+  int32_t length = detail::merge_leaves<MaxLeaves>( _leaves.data(), _length, that._leaves.data(), that._length, res._leaves.data(), cut_size );
   if ( length >= 0 )
   {
     res._cend = res._end = res.begin() + length;
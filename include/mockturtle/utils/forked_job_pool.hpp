@@ -0,0 +1,312 @@
+/* mockturtle: C++ logic network library
+ * Copyright (C) 2018-2022  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*!
+  \file forked_job_pool.hpp
+  \brief Runs jobs in forked child processes
+*/
+
+#pragma once
+
+#ifndef _MSC_VER
+
+#include <algorithm>
+#include <cassert>
+#include <cerrno>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+#include <iostream>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <signal.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace mockturtle
+{
+
+/*! \brief Outcome of a job run by `forked_job_pool`. */
+enum class forked_job_outcome
+{
+  passed,    /* the job returned true */
+  failed,    /* the job returned false */
+  crashed,   /* the child terminated abnormally (signal, exception, or another exit code) */
+  timed_out, /* the child was killed after the timeout */
+  error      /* the child could not be forked or its status could not be retrieved */
+};
+
+/*! \brief Runs jobs in forked child processes.
+ *
+ * Runs up to `num_workers` jobs at a time, each in its own child process,
+ * such that a crash or a hang of a job does not affect the caller.  The
+ * child inherits a copy of the memory of the caller, so a job may read any
+ * data of the caller, but its side effects are lost.
+ *
+ * While waiting, all child processes of the caller are assumed to be jobs
+ * of the pool; other terminated children are reaped and ignored.
+ */
+class forked_job_pool
+{
+public:
+  using clock = std::chrono::steady_clock;
+
+  explicit forked_job_pool( uint32_t num_workers, std::optional<uint64_t> timeout_seconds = std::nullopt )
+      : slots( std::max( 1u, num_workers ) ), timeout( timeout_seconds )
+  {
+  }
+
+  ~forked_job_pool()
+  {
+    kill_all();
+  }
+
+  forked_job_pool( forked_job_pool const& ) = delete;
+  forked_job_pool& operator=( forked_job_pool const& ) = delete;
+
+  std::optional<uint32_t> free_slot() const
+  {
+    for ( auto i = 0u; i < slots.size(); ++i )
+    {
+      if ( !slots[i] )
+      {
+        return i;
+      }
+    }
+    return std::nullopt;
+  }
+
+  uint32_t num_running() const
+  {
+    return static_cast<uint32_t>( std::count_if( slots.begin(), slots.end(), []( auto const& s ) { return s.has_value(); } ) );
+  }
+
+  /*! \brief Starts `job` in a child process occupying the free slot `slot`.
+   *
+   * Returns false if the process cannot be forked, in which case the slot
+   * stays free and the job has the outcome `forked_job_outcome::error`.
+   */
+  bool start( uint32_t slot, uint64_t id, std::function<bool()> const& job )
+  {
+    assert( !slots[slot] );
+
+    /* buffered output would otherwise be written by both processes */
+    std::fflush( nullptr );
+    std::cout.flush();
+
+    pid_t const pid = fork();
+    if ( pid < 0 )
+    {
+      return false;
+    }
+    if ( pid == 0 )
+    {
+      int code = 2;
+      try
+      {
+        code = job() ? 0 : 1;
+      }
+      catch ( ... )
+      {
+      }
+      std::fflush( nullptr );
+      std::cout.flush();
+      _exit( code );
+    }
+
+    slots[slot] = running_job{ pid, id, clock::now() };
+    return true;
+  }
+
+  /*! \brief Waits until one of the running jobs terminates, returns its id and outcome.
+   *
+   * The caller blocks in `waitid`.  If a timeout is set, a watchdog thread
+   * kills the jobs that exceed it.
+   */
+  std::pair<uint64_t, forked_job_outcome> wait_any()
+  {
+    assert( num_running() > 0u );
+
+    std::mutex mutex;
+    std::condition_variable cv;
+    bool stop{ false };
+    std::thread watchdog;
+    if ( timeout )
+    {
+      watchdog = std::thread( [&]() {
+        std::unique_lock<std::mutex> lock( mutex );
+        while ( !stop )
+        {
+          std::optional<clock::time_point> next;
+          auto const now = clock::now();
+          for ( auto& s : slots )
+          {
+            if ( !s || s->killed )
+            {
+              continue;
+            }
+            auto const deadline = s->start + std::chrono::seconds( *timeout );
+            if ( deadline <= now )
+            {
+              kill( s->pid, SIGKILL );
+              s->killed = true;
+            }
+            else if ( !next || deadline < *next )
+            {
+              next = deadline;
+            }
+          }
+
+          if ( next )
+          {
+            cv.wait_until( lock, *next );
+          }
+          else
+          {
+            cv.wait( lock, [&]() { return stop; } );
+          }
+        }
+      } );
+    }
+
+    /* terminated children are not reaped yet (WNOWAIT), such that the watchdog never signals a reused pid */
+    std::optional<running_job>* slot{ nullptr };
+    while ( slot == nullptr )
+    {
+      siginfo_t info{};
+      if ( waitid( P_ALL, 0, &info, WEXITED | WNOWAIT ) < 0 )
+      {
+        if ( errno == EINTR )
+        {
+          continue;
+        }
+        break;
+      }
+
+      auto const it = std::find_if( slots.begin(), slots.end(), [&]( auto const& s ) { return s && s->pid == info.si_pid; } );
+      if ( it == slots.end() )
+      {
+        waitpid( info.si_pid, nullptr, 0 );
+        continue;
+      }
+      slot = &*it;
+    }
+
+    if ( watchdog.joinable() )
+    {
+      {
+        std::lock_guard<std::mutex> lock( mutex );
+        stop = true;
+      }
+      cv.notify_all();
+      watchdog.join();
+    }
+
+    if ( slot == nullptr )
+    {
+      /* the children cannot be waited for, give up on the first running job */
+      slot = &*std::find_if( slots.begin(), slots.end(), []( auto const& s ) { return s.has_value(); } );
+      auto const id = ( *slot )->id;
+      kill( ( *slot )->pid, SIGKILL );
+      slot->reset();
+      return { id, forked_job_outcome::error };
+    }
+
+    int status{ 0 };
+    waitpid( ( *slot )->pid, &status, 0 );
+    auto const id = ( *slot )->id;
+    auto const killed = ( *slot )->killed;
+    slot->reset();
+
+    if ( WIFEXITED( status ) && WEXITSTATUS( status ) == 0 )
+    {
+      return { id, forked_job_outcome::passed };
+    }
+    else if ( WIFEXITED( status ) && WEXITSTATUS( status ) == 1 )
+    {
+      return { id, forked_job_outcome::failed };
+    }
+    else if ( killed && WIFSIGNALED( status ) && WTERMSIG( status ) == SIGKILL )
+    {
+      return { id, forked_job_outcome::timed_out };
+    }
+    return { id, forked_job_outcome::crashed };
+  }
+
+  void kill_all()
+  {
+    for ( auto& s : slots )
+    {
+      if ( s )
+      {
+        int status{ 0 };
+        kill( s->pid, SIGKILL );
+        waitpid( s->pid, &status, 0 );
+        s.reset();
+      }
+    }
+  }
+
+private:
+  struct running_job
+  {
+    pid_t pid;
+    uint64_t id;
+    clock::time_point start;
+    bool killed{ false };
+  };
+
+  std::vector<std::optional<running_job>> slots;
+  std::optional<uint64_t> timeout;
+};
+
+namespace detail
+{
+
+/* inserts `suffix` in front of the extension of `filename` */
+inline std::string filename_with_suffix( std::string const& filename, std::string const& suffix )
+{
+  auto const dot = filename.find_last_of( '.' );
+  auto const slash = filename.find_last_of( '/' );
+  if ( dot == std::string::npos || ( slash != std::string::npos && dot < slash ) )
+  {
+    return filename + suffix;
+  }
+  return filename.substr( 0u, dot ) + suffix + filename.substr( dot );
+}
+
+} /* namespace detail */
+
+} /* namespace mockturtle */
+
+#endif
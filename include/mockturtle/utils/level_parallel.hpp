@@ -0,0 +1,206 @@
+/* mockturtle: C++ logic network library
+ * Copyright (C) 2018-2022  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*!
+  \file level_parallel.hpp
+  \brief Level-synchronous parallel traversal of networks
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include "../traits.hpp"
+
+namespace mockturtle
+{
+
+/*! \brief Nodes grouped by level.
+ *
+ * The nodes of level `l` are stored in `nodes` between positions
+ * `offsets[l]` and `offsets[l + 1]`.  Within a level, the nodes keep
+ * the order in which they were given.  Since all fanins of a node are on
+ * lower levels, the nodes of a level can be processed independently once
+ * all lower levels are done.
+ */
+template<class Ntk>
+struct level_order
+{
+  std::vector<node<Ntk>> nodes;
+  std::vector<uint32_t> offsets;
+
+  uint32_t num_levels() const
+  {
+    return offsets.empty() ? 0u : static_cast<uint32_t>( offsets.size() - 1u );
+  }
+};
+
+/*! \brief Groups nodes by level.
+ *
+ * `order` must be a topological order.  The level of a node is one more
+ * than the largest level among its fanins in `order`; nodes without such
+ * fanins are on level 0.
+ */
+template<class Ntk>
+level_order<Ntk> compute_level_order( Ntk const& ntk, std::vector<node<Ntk>> const& order )
+{
+  std::vector<uint32_t> levels( ntk.size(), 0u );
+  std::vector<uint32_t> counts;
+  for ( auto const& n : order )
+  {
+    uint32_t level = 0u;
+    ntk.foreach_fanin( n, [&]( auto const& f ) {
+      level = std::max( level, levels[ntk.node_to_index( ntk.get_node( f ) )] + 1u );
+    } );
+    levels[ntk.node_to_index( n )] = level;
+    if ( level >= counts.size() )
+    {
+      counts.resize( level + 1u, 0u );
+    }
+    ++counts[level];
+  }
+
+  level_order<Ntk> res;
+  res.offsets.resize( counts.size() + 1u, 0u );
+  for ( auto l = 0u; l < counts.size(); ++l )
+  {
+    res.offsets[l + 1u] = res.offsets[l] + counts[l];
+  }
+
+  res.nodes.resize( order.size() );
+  std::vector<uint32_t> pos( res.offsets.begin(), res.offsets.end() - 1 );
+  for ( auto const& n : order )
+  {
+    res.nodes[pos[levels[ntk.node_to_index( n )]]++] = n;
+  }
+  return res;
+}
+
+/*! \cond PRIVATE */
+namespace detail
+{
+
+/*! \brief Reusable barrier for a fixed number of threads. */
+class spin_barrier
+{
+public:
+  explicit spin_barrier( uint32_t num_threads )
+      : _num_threads( num_threads )
+  {
+  }
+
+  void arrive_and_wait()
+  {
+    auto const generation = _generation.load( std::memory_order_acquire );
+    if ( _arrived.fetch_add( 1u, std::memory_order_acq_rel ) + 1u == _num_threads )
+    {
+      _arrived.store( 0u, std::memory_order_relaxed );
+      _generation.fetch_add( 1u, std::memory_order_release );
+      return;
+    }
+    while ( _generation.load( std::memory_order_acquire ) == generation )
+    {
+      std::this_thread::yield();
+    }
+  }
+
+private:
+  uint32_t const _num_threads;
+  std::atomic<uint32_t> _arrived{ 0u };
+  std::atomic<uint32_t> _generation{ 0u };
+};
+
+} // namespace detail
+/*! \endcond */
+
+/*! \brief Calls `fn( n, thread_id )` for all nodes, level by level.
+ *
+ * The nodes of a level are distributed over `num_threads` threads
+ * (0 uses all hardware threads), and a level is started only after all
+ * nodes of the previous levels have been processed.  `fn` may thus read
+ * data of nodes on lower levels and write data of the node it is called
+ * with.  Data local to a thread should be indexed by `thread_id`, which is
+ * smaller than the value returned by `level_parallel_threads`.
+ */
+template<class Ntk, class Fn>
+void foreach_node_level_parallel( level_order<Ntk> const& levels, uint32_t num_threads, Fn&& fn )
+{
+  if ( num_threads == 0u )
+  {
+    num_threads = std::max( 1u, std::thread::hardware_concurrency() );
+  }
+
+  if ( num_threads == 1u )
+  {
+    for ( auto const& n : levels.nodes )
+    {
+      fn( n, 0u );
+    }
+    return;
+  }
+
+  std::vector<std::atomic<uint32_t>> next( levels.num_levels() );
+  for ( auto l = 0u; l < levels.num_levels(); ++l )
+  {
+    next[l].store( levels.offsets[l], std::memory_order_relaxed );
+  }
+
+  detail::spin_barrier barrier( num_threads );
+  auto const worker = [&]( uint32_t thread_id ) {
+    for ( auto l = 0u; l < levels.num_levels(); ++l )
+    {
+      auto const end = levels.offsets[l + 1u];
+      for ( auto i = next[l]++; i < end; i = next[l]++ )
+      {
+        fn( levels.nodes[i], thread_id );
+      }
+      barrier.arrive_and_wait();
+    }
+  };
+
+  std::vector<std::thread> threads;
+  threads.reserve( num_threads - 1u );
+  for ( auto t = 1u; t < num_threads; ++t )
+  {
+    threads.emplace_back( worker, t );
+  }
+  worker( 0u );
+  for ( auto& thread : threads )
+  {
+    thread.join();
+  }
+}
+
+/*! \brief Number of thread-local slots needed by `foreach_node_level_parallel`. */
+inline uint32_t level_parallel_threads( uint32_t num_threads )
+{
+  return num_threads == 0u ? std::max( 1u, std::thread::hardware_concurrency() ) : num_threads;
+}
+
+} // namespace mockturtle
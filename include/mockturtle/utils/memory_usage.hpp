@@ -0,0 +1,265 @@
+/* mockturtle: C++ logic network library
+ * Copyright (C) 2018-2022  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*!
+  \file memory_usage.hpp
+  \brief Memory accounting for containers and process peak memory
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <kitty/dynamic_truth_table.hpp>
+#include <kitty/partial_truth_table.hpp>
+#include <parallel_hashmap/phmap.h>
+
+#if defined( __unix__ ) || defined( __APPLE__ )
+#include <sys/resource.h>
+#endif
+
+namespace mockturtle
+{
+
+/*! \brief Returns the number of bytes that an object allocates dynamically.
+ *
+ * The size of the object itself (`sizeof`) is not included.  Types that
+ * own dynamic memory implement a member function `memory_usage()` that
+ * returns their total size in bytes (including `sizeof`), or are handled
+ * by one of the overloads for standard containers.  All other types are
+ * assumed to not allocate.
+ *
+ * The figures are computed from the capacities of the containers and do
+ * not include the bookkeeping of the memory allocator.
+ */
+template<typename T>
+uint64_t dynamic_memory_usage( T const& value );
+
+template<typename T, typename Alloc>
+uint64_t dynamic_memory_usage( std::vector<T, Alloc> const& vec );
+
+template<typename T, typename Alloc>
+uint64_t dynamic_memory_usage( std::deque<T, Alloc> const& deq );
+
+template<typename T1, typename T2>
+uint64_t dynamic_memory_usage( std::pair<T1, T2> const& pair );
+
+template<typename K, typename V, typename H, typename E, typename Alloc>
+uint64_t dynamic_memory_usage( std::unordered_map<K, V, H, E, Alloc> const& map );
+
+template<typename K, typename V, typename H, typename E, typename Alloc>
+uint64_t dynamic_memory_usage( phmap::flat_hash_map<K, V, H, E, Alloc> const& map );
+
+template<typename K, typename H, typename E, typename Alloc>
+uint64_t dynamic_memory_usage( phmap::flat_hash_set<K, H, E, Alloc> const& set );
+
+inline uint64_t dynamic_memory_usage( std::string const& str );
+inline uint64_t dynamic_memory_usage( kitty::dynamic_truth_table const& tt );
+inline uint64_t dynamic_memory_usage( kitty::partial_truth_table const& tt );
+
+/*! \cond PRIVATE */
+namespace detail
+{
+
+template<typename T, typename = void>
+struct has_memory_usage_member : std::false_type
+{
+};
+
+template<typename T>
+struct has_memory_usage_member<T, std::void_t<decltype( std::declval<T const&>().memory_usage() )>> : std::true_type
+{
+};
+
+/* elements of trivially copyable types cannot own memory, no need to visit them */
+template<typename T, typename Container>
+uint64_t elements_memory_usage( Container const& container )
+{
+  uint64_t bytes{ 0 };
+  if constexpr ( !std::is_trivially_copyable_v<T> )
+  {
+    for ( auto const& element : container )
+    {
+      bytes += dynamic_memory_usage( element );
+    }
+  }
+  return bytes;
+}
+
+} /* namespace detail */
+/*! \endcond */
+
+template<typename T>
+uint64_t dynamic_memory_usage( T const& value )
+{
+  if constexpr ( detail::has_memory_usage_member<T>::value )
+  {
+    return value.memory_usage() - sizeof( T );
+  }
+  else
+  {
+    (void)value;
+    return 0u;
+  }
+}
+
+template<typename T, typename Alloc>
+uint64_t dynamic_memory_usage( std::vector<T, Alloc> const& vec )
+{
+  return vec.capacity() * sizeof( T ) + detail::elements_memory_usage<T>( vec );
+}
+
+template<typename T, typename Alloc>
+uint64_t dynamic_memory_usage( std::deque<T, Alloc> const& deq )
+{
+  /* the capacity of a deque is not exposed, only its elements are counted */
+  return deq.size() * sizeof( T ) + detail::elements_memory_usage<T>( deq );
+}
+
+template<typename T1, typename T2>
+uint64_t dynamic_memory_usage( std::pair<T1, T2> const& pair )
+{
+  return dynamic_memory_usage( pair.first ) + dynamic_memory_usage( pair.second );
+}
+
+template<typename K, typename V, typename H, typename E, typename Alloc>
+uint64_t dynamic_memory_usage( std::unordered_map<K, V, H, E, Alloc> const& map )
+{
+  /* one pointer per bucket, one list node (next pointer, hash, value) per entry */
+  using value_type = typename std::unordered_map<K, V, H, E, Alloc>::value_type;
+  return map.bucket_count() * sizeof( void* ) + map.size() * ( sizeof( value_type ) + 2u * sizeof( void* ) ) + detail::elements_memory_usage<value_type>( map );
+}
+
+template<typename K, typename V, typename H, typename E, typename Alloc>
+uint64_t dynamic_memory_usage( phmap::flat_hash_map<K, V, H, E, Alloc> const& map )
+{
+  /* one slot and one control byte per entry of the capacity */
+  using value_type = typename phmap::flat_hash_map<K, V, H, E, Alloc>::value_type;
+  return map.capacity() * ( sizeof( value_type ) + 1u ) + detail::elements_memory_usage<value_type>( map );
+}
+
+template<typename K, typename H, typename E, typename Alloc>
+uint64_t dynamic_memory_usage( phmap::flat_hash_set<K, H, E, Alloc> const& set )
+{
+  return set.capacity() * ( sizeof( K ) + 1u ) + detail::elements_memory_usage<K>( set );
+}
+
+inline uint64_t dynamic_memory_usage( std::string const& str )
+{
+  /* short strings are stored inside the object */
+  return str.capacity() + 1u > sizeof( std::string ) ? str.capacity() + 1u : 0u;
+}
+
+inline uint64_t dynamic_memory_usage( kitty::dynamic_truth_table const& tt )
+{
+  return dynamic_memory_usage( tt._bits );
+}
+
+inline uint64_t dynamic_memory_usage( kitty::partial_truth_table const& tt )
+{
+  return dynamic_memory_usage( tt._bits );
+}
+
+/*! \brief Returns the total memory of an object in bytes.
+ *
+ * Returns `sizeof( value )` plus the memory that the object allocates
+ * dynamically (see `dynamic_memory_usage`).
+ */
+template<typename T>
+uint64_t memory_usage( T const& value )
+{
+  return sizeof( T ) + dynamic_memory_usage( value );
+}
+
+/*! \cond PRIVATE */
+namespace detail
+{
+
+/* memory of the network that a view wraps, used by views that add data */
+template<typename Ntk>
+uint64_t base_memory_usage( Ntk const& ntk )
+{
+  if constexpr ( has_memory_usage_member<Ntk>::value )
+  {
+    return ntk.memory_usage();
+  }
+  else
+  {
+    (void)ntk;
+    return sizeof( Ntk );
+  }
+}
+
+} /* namespace detail */
+/*! \endcond */
+
+/*! \brief Returns the memory of a network and of data structures in bytes.
+ *
+ * The network is counted with its member function `memory_usage()`, if it
+ * has one, and each data structure with `dynamic_memory_usage`.  Algorithms
+ * use it to report their memory footprint at the end of a run.
+ */
+template<typename Ntk, typename... Ts>
+uint64_t memory_footprint( Ntk const& ntk, Ts const&... data )
+{
+  uint64_t bytes = ( uint64_t{ 0 } + ... + dynamic_memory_usage( data ) );
+  if constexpr ( detail::has_memory_usage_member<Ntk>::value )
+  {
+    bytes += ntk.memory_usage();
+  }
+  return bytes;
+}
+
+/*! \brief Returns the peak resident memory of the process in bytes.
+ *
+ * This is the high-water mark reported by the operating system, which
+ * includes all allocations of the process.  Returns 0 on platforms on
+ * which it is not available.
+ */
+inline uint64_t peak_process_memory()
+{
+#if defined( __unix__ ) || defined( __APPLE__ )
+  struct rusage usage;
+  if ( getrusage( RUSAGE_SELF, &usage ) != 0 )
+  {
+    return 0u;
+  }
+#if defined( __APPLE__ )
+  return static_cast<uint64_t>( usage.ru_maxrss );
+#else
+  return static_cast<uint64_t>( usage.ru_maxrss ) * 1024u;
+#endif
+#else
+  return 0u;
+#endif
+}
+
+} /* namespace mockturtle */
@@ -41,6 +41,7 @@
 #include <vector>
 
 #include "../traits.hpp"
+#include "memory_usage.hpp"
 
 namespace mockturtle
 {
@@ -194,6 +195,16 @@ public:
     }
   }
 
+  /*! \brief Returns the memory used by the map in bytes.
+   *
+   * The container is shared between copies of the map and is counted by
+   * each of them.
+   */
+  uint64_t memory_usage() const
+  {
+    return sizeof( *this ) + sizeof( container_type ) + dynamic_memory_usage( *data );
+  }
+
 private:
   Ntk const* ntk;
   std::shared_ptr<container_type> data;
@@ -330,6 +341,12 @@ public:
   {
   }
 
+  /*! \brief Returns the memory used by the map in bytes. */
+  uint64_t memory_usage() const
+  {
+    return sizeof( *this ) + sizeof( container_type ) + dynamic_memory_usage( *data );
+  }
+
 protected:
   Ntk const* ntk;
   std::shared_ptr<container_type> data;
@@ -0,0 +1,253 @@
+/* mockturtle: C++ logic network library
+ * Copyright (C) 2018-2022  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*!
+  \file signature_matrix.hpp
+  \brief Flat storage of simulation signatures with word-parallel kernels
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <iterator>
+#include <type_traits>
+#include <vector>
+
+#include <kitty/detail/mscfix.hpp>
+#include <kitty/static_truth_table.hpp>
+
+#if defined( __AVX2__ )
+#include <immintrin.h>
+#endif
+
+namespace mockturtle
+{
+
+/*! \brief Number of 64-bit words of a truth table type, if known at compile time.
+ *
+ * The value is 0 for truth tables whose size is only known at runtime
+ * (e.g., `kitty::dynamic_truth_table` and `kitty::partial_truth_table`).
+ */
+template<class TT>
+struct signature_width : std::integral_constant<uint32_t, 0u>
+{
+};
+
+template<uint32_t NumVars>
+struct signature_width<kitty::static_truth_table<NumVars, true>> : std::integral_constant<uint32_t, 1u>
+{
+};
+
+template<uint32_t NumVars>
+struct signature_width<kitty::static_truth_table<NumVars, false>> : std::integral_constant<uint32_t, ( 1u << ( NumVars - 6u ) )>
+{
+};
+
+template<class TT>
+constexpr uint32_t signature_width_v = signature_width<TT>::value;
+
+/*! \brief Row-major matrix of simulation signatures.
+ *
+ * Each row stores the bits of one function in consecutive 64-bit words, and
+ * all rows are kept in a single buffer.  Resetting the matrix keeps its
+ * capacity, so that a matrix owned by a long-living engine does not allocate
+ * memory once it has grown to the largest window.
+ *
+ * If `NumWords` is non-zero, the number of words per row is fixed at compile
+ * time and the kernels are fully unrolled.  Unused bits in the last word of
+ * each row are kept at 0; the kernels mask them out of their results, such
+ * that word functions may complement rows freely.
+ *
+ * Pointers returned by `row` are invalidated when rows are added.
+ */
+template<uint32_t NumWords = 0u>
+class signature_matrix
+{
+public:
+  signature_matrix() = default;
+
+  /*! \brief Removes all rows and sets the number of bits per row. */
+  void reset( uint32_t num_bits )
+  {
+    if constexpr ( NumWords == 0u )
+    {
+      _num_words = ( num_bits + 63u ) >> 6;
+    }
+    else
+    {
+      assert( ( ( num_bits + 63u ) >> 6 ) == NumWords );
+    }
+    _last_mask = ( num_bits & 63u ) == 0u ? ~uint64_t( 0 ) : ( uint64_t( 1 ) << ( num_bits & 63u ) ) - 1u;
+    _num_rows = 0u;
+    _words.clear();
+  }
+
+  /*! \brief Reserves memory for `num_rows` rows. */
+  void reserve( uint32_t num_rows )
+  {
+    _words.reserve( static_cast<std::size_t>( num_rows ) * num_words() );
+  }
+
+  uint32_t num_rows() const { return _num_rows; }
+
+  uint32_t num_words() const
+  {
+    if constexpr ( NumWords == 0u )
+    {
+      return _num_words;
+    }
+    else
+    {
+      return NumWords;
+    }
+  }
+
+  uint64_t* row( uint32_t r ) { return _words.data() + static_cast<std::size_t>( r ) * num_words(); }
+  uint64_t const* row( uint32_t r ) const { return _words.data() + static_cast<std::size_t>( r ) * num_words(); }
+
+  /*! \brief Appends a row with all bits set to 0 and returns its index. */
+  uint32_t add_row()
+  {
+    _words.resize( _words.size() + num_words(), 0u );
+    return _num_rows++;
+  }
+
+  /*! \brief Appends a row with the words of a truth table and returns its index. */
+  template<class TT>
+  uint32_t add_row( TT const& tt )
+  {
+    assert( static_cast<uint32_t>( std::distance( tt.cbegin(), tt.cend() ) ) == num_words() );
+    _words.insert( _words.end(), tt.cbegin(), tt.cend() );
+    _words.back() &= _last_mask;
+    return _num_rows++;
+  }
+
+  /*! \brief Sets word `w` of row `r` to `fn( w )` for all words. */
+  template<class Fn>
+  void assign( uint32_t r, Fn&& fn )
+  {
+    auto* words = row( r );
+    auto const n = num_words();
+    for ( auto w = 0u; w < n; ++w )
+    {
+      words[w] = fn( w );
+    }
+    words[n - 1u] &= _last_mask;
+  }
+
+  /*! \brief Checks whether `fn( w )` is 0 for all words. */
+  template<class Fn>
+  bool is_const0( Fn&& fn ) const
+  {
+    auto const n = num_words();
+    if ( ( fn( n - 1u ) & _last_mask ) != 0u )
+    {
+      return false;
+    }
+    auto w = 0u;
+    for ( ; w + 4u < n; w += 4u )
+    {
+      if ( ( fn( w ) | fn( w + 1u ) | fn( w + 2u ) | fn( w + 3u ) ) != 0u )
+      {
+        return false;
+      }
+    }
+    for ( ; w + 1u < n; ++w )
+    {
+      if ( fn( w ) != 0u )
+      {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  /*! \brief Counts the ones in `fn( w )` over all words. */
+  template<class Fn>
+  uint32_t count_ones( Fn&& fn ) const
+  {
+    auto const n = num_words();
+    uint32_t count = __builtin_popcountll( fn( n - 1u ) & _last_mask );
+    for ( auto w = 0u; w + 1u < n; ++w )
+    {
+      count += __builtin_popcountll( fn( w ) );
+    }
+    return count;
+  }
+
+  /*! \brief Intersections of a function and its complement with two sets.
+   *
+   * Computes in a single pass whether `f & s0`, `~f & s0`, `f & s1`, and
+   * `~f & s1` are empty, which is returned in bits 0 to 3, respectively.
+   * The sets `s0` and `s1` must have their unused bits at 0.
+   */
+  uint32_t empty_intersections( uint64_t const* f, uint64_t const* s0, uint64_t const* s1 ) const
+  {
+    auto const n = num_words();
+    uint64_t acc[4] = { 0u, 0u, 0u, 0u };
+    auto w = 0u;
+#if defined( __AVX2__ )
+    if ( n >= 4u )
+    {
+      auto acc0 = _mm256_setzero_si256();
+      auto acc1 = _mm256_setzero_si256();
+      auto acc2 = _mm256_setzero_si256();
+      auto acc3 = _mm256_setzero_si256();
+      for ( ; w + 4u <= n; w += 4u )
+      {
+        auto const vf = _mm256_loadu_si256( reinterpret_cast<__m256i const*>( f + w ) );
+        auto const v0 = _mm256_loadu_si256( reinterpret_cast<__m256i const*>( s0 + w ) );
+        auto const v1 = _mm256_loadu_si256( reinterpret_cast<__m256i const*>( s1 + w ) );
+        acc0 = _mm256_or_si256( acc0, _mm256_and_si256( vf, v0 ) );
+        acc1 = _mm256_or_si256( acc1, _mm256_andnot_si256( vf, v0 ) );
+        acc2 = _mm256_or_si256( acc2, _mm256_and_si256( vf, v1 ) );
+        acc3 = _mm256_or_si256( acc3, _mm256_andnot_si256( vf, v1 ) );
+      }
+      acc[0] = _mm256_testz_si256( acc0, acc0 ) ? 0u : 1u;
+      acc[1] = _mm256_testz_si256( acc1, acc1 ) ? 0u : 1u;
+      acc[2] = _mm256_testz_si256( acc2, acc2 ) ? 0u : 1u;
+      acc[3] = _mm256_testz_si256( acc3, acc3 ) ? 0u : 1u;
+    }
+#endif
+    for ( ; w < n; ++w )
+    {
+      acc[0] |= f[w] & s0[w];
+      acc[1] |= ~f[w] & s0[w];
+      acc[2] |= f[w] & s1[w];
+      acc[3] |= ~f[w] & s1[w];
+    }
+    return ( acc[0] == 0u ? 1u : 0u ) | ( acc[1] == 0u ? 2u : 0u ) | ( acc[2] == 0u ? 4u : 0u ) | ( acc[3] == 0u ? 8u : 0u );
+  }
+
+private:
+  uint32_t _num_words{ NumWords };
+  uint32_t _num_rows{ 0u };
+  uint64_t _last_mask{ ~uint64_t( 0 ) };
+  std::vector<uint64_t> _words;
+};
+
+} // namespace mockturtle
@@ -39,6 +39,8 @@
 
 #include <fmt/format.h>
 
+#include "tracing.hpp"
+
 namespace mockturtle
 {
 
@@ -49,6 +51,9 @@ namespace mockturtle
  * automatically.  A reference to a duration object is passed to the
  * constructor.  After stopping the time the measured time interval is added
  * to the durationr reference.
+ *
+ * If a name is passed to the constructor, the measured interval is also
+ * recorded as a trace span (see `trace_span`) when tracing is enabled.
  *
    \verbatim embed:rst
 
@@ -85,6 +90,17 @@ public:
   {
   }
 
+  /*! \brief Constructor with trace span.
+   *
+   * Starts tracking time and a trace span called `name`.
+   */
+  stopwatch( duration& dur, char const* name )
+      : dur( dur ),
+        beg( clock::now() ),
+        span( name )
+  {
+  }
+
   /*! \brief Default deconstructor.
    *
    * Stops tracking time and updates duration.
@@ -97,6 +113,7 @@ public:
 private:
   duration& dur;
   time_point beg;
+  trace_span span;
 };
 
 /*! \brief Calls a function and tracks time.
@@ -126,6 +143,22 @@ std::invoke_result_t<Fn> call_with_stopwatch( typename Clock::duration& dur, Fn&
   return fn();
 }
 
+/*! \brief Calls a function and tracks time in a named trace span.
+ *
+ * Same as `call_with_stopwatch` above, and records the call as a trace span
+ * called `name` when tracing is enabled.
+ *
+ * \param dur Duration reference (time will be added to it)
+ * \param name Name of the trace span (string literal)
+ * \param fn Callable object with no arguments
+ */
+template<class Fn, class Clock = std::chrono::steady_clock>
+std::invoke_result_t<Fn> call_with_stopwatch( typename Clock::duration& dur, char const* name, Fn&& fn )
+{
+  stopwatch<Clock> t( dur, name );
+  return fn();
+}
+
 /*! \brief Constructs an object and calls time.
  *
  * This function can track the time for the construction of an object and
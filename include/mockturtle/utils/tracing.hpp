@@ -0,0 +1,308 @@
+/* mockturtle: C++ logic network library
+ * Copyright (C) 2018-2022  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*!
+  \file tracing.hpp
+  \brief Scoped spans and counters exported as Chrome trace events
+*/
+
+#pragma once
+
+#include <fstream>
+#include <ostream>
+#include <string>
+
+#ifdef MOCKTURTLE_ENABLE_TRACING
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <fmt/format.h>
+#endif
+
+namespace mockturtle
+{
+
+/*! \brief Whether tracing is compiled in (macro `MOCKTURTLE_ENABLE_TRACING`). */
+#ifdef MOCKTURTLE_ENABLE_TRACING
+inline constexpr bool tracing_enabled = true;
+#else
+inline constexpr bool tracing_enabled = false;
+#endif
+
+#ifdef MOCKTURTLE_ENABLE_TRACING
+namespace detail
+{
+
+struct trace_event
+{
+  char const* name;
+  char const* category;
+  char phase;
+  int64_t begin;
+  int64_t duration;
+  double value;
+};
+
+/* events of one thread; the lock is only contended while exporting */
+struct trace_buffer
+{
+  uint32_t thread_id;
+  std::mutex mutex;
+  std::vector<trace_event> events;
+};
+
+class tracer
+{
+public:
+  using clock = std::chrono::steady_clock;
+
+  static tracer& instance()
+  {
+    static tracer t;
+    return t;
+  }
+
+  bool active() const
+  {
+    return _active.load( std::memory_order_relaxed );
+  }
+
+  void set_active( bool value )
+  {
+    _active.store( value, std::memory_order_relaxed );
+  }
+
+  int64_t now() const
+  {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>( clock::now() - _origin ).count();
+  }
+
+  void record( trace_event const& event )
+  {
+    thread_local std::shared_ptr<trace_buffer> buffer = register_thread();
+    std::lock_guard<std::mutex> lock( buffer->mutex );
+    buffer->events.push_back( event );
+  }
+
+  void clear()
+  {
+    std::lock_guard<std::mutex> lock( _mutex );
+    for ( auto& buffer : _buffers )
+    {
+      std::lock_guard<std::mutex> buffer_lock( buffer->mutex );
+      buffer->events.clear();
+    }
+  }
+
+  void write( std::ostream& os )
+  {
+    std::lock_guard<std::mutex> lock( _mutex );
+    os << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    bool first = true;
+    for ( auto& buffer : _buffers )
+    {
+      std::lock_guard<std::mutex> buffer_lock( buffer->mutex );
+      for ( auto const& e : buffer->events )
+      {
+        os << ( first ? "\n" : ",\n" );
+        first = false;
+        if ( e.phase == 'X' )
+        {
+          os << fmt::format( "{{\"name\":\"{}\",\"cat\":\"{}\",\"ph\":\"X\",\"pid\":0,\"tid\":{},\"ts\":{:.3f},\"dur\":{:.3f}}}",
+                             e.name, e.category, buffer->thread_id, e.begin / 1000.0, e.duration / 1000.0 );
+        }
+        else
+        {
+          os << fmt::format( "{{\"name\":\"{}\",\"cat\":\"{}\",\"ph\":\"C\",\"pid\":0,\"tid\":{},\"ts\":{:.3f},\"args\":{{\"{}\":{:.17g}}}}}",
+                             e.name, e.category, buffer->thread_id, e.begin / 1000.0, e.name, e.value );
+        }
+      }
+    }
+    os << "\n]}\n";
+  }
+
+private:
+  tracer()
+      : _origin( clock::now() )
+  {}
+
+  std::shared_ptr<trace_buffer> register_thread()
+  {
+    auto buffer = std::make_shared<trace_buffer>();
+    std::lock_guard<std::mutex> lock( _mutex );
+    buffer->thread_id = static_cast<uint32_t>( _buffers.size() );
+    _buffers.push_back( buffer );
+    return buffer;
+  }
+
+private:
+  clock::time_point _origin;
+  std::atomic<bool> _active{ true };
+  std::mutex _mutex;
+  std::vector<std::shared_ptr<trace_buffer>> _buffers;
+};
+
+} // namespace detail
+#endif
+
+/*! \brief Scoped trace span.
+ *
+ * Records the time between construction and destruction as a complete
+ * event of the calling thread.  Spans of the same thread nest by
+ * containment.  Name and category must be string literals (or outlive
+ * the export of the trace).  If tracing is not compiled in, the span is
+ * an empty object and does nothing.
+ *
+   \verbatim embed:rst
+
+   Example
+
+   .. code-block:: c++
+
+      {
+        trace_span span( "collapse" );
+        // do some work
+      } // span ends here
+
+      write_chrome_trace( "trace.json" );
+   \endverbatim
+ */
+class trace_span
+{
+public:
+  /*! \brief Creates an inactive span. */
+  trace_span() = default;
+
+  explicit trace_span( char const* name, char const* category = "mockturtle" )
+  {
+#ifdef MOCKTURTLE_ENABLE_TRACING
+    auto& t = detail::tracer::instance();
+    if ( name != nullptr && t.active() )
+    {
+      _name = name;
+      _category = category;
+      _begin = t.now();
+    }
+#else
+    (void)name;
+    (void)category;
+#endif
+  }
+
+  ~trace_span()
+  {
+#ifdef MOCKTURTLE_ENABLE_TRACING
+    if ( _name != nullptr )
+    {
+      auto& t = detail::tracer::instance();
+      t.record( { _name, _category, 'X', _begin, t.now() - _begin, 0.0 } );
+    }
+#endif
+  }
+
+  trace_span( trace_span const& ) = delete;
+  trace_span& operator=( trace_span const& ) = delete;
+
+#ifdef MOCKTURTLE_ENABLE_TRACING
+private:
+  char const* _name{ nullptr };
+  char const* _category{ nullptr };
+  int64_t _begin{ 0 };
+#endif
+};
+
+/*! \brief Records the value of a counter at the current time. */
+inline void trace_counter( char const* name, double value, char const* category = "mockturtle" )
+{
+#ifdef MOCKTURTLE_ENABLE_TRACING
+  auto& t = detail::tracer::instance();
+  if ( t.active() )
+  {
+    t.record( { name, category, 'C', t.now(), 0, value } );
+  }
+#else
+  (void)name;
+  (void)value;
+  (void)category;
+#endif
+}
+
+/*! \brief Resumes recording (recording is on from program start). */
+inline void start_tracing()
+{
+#ifdef MOCKTURTLE_ENABLE_TRACING
+  detail::tracer::instance().set_active( true );
+#endif
+}
+
+/*! \brief Pauses recording; spans started before still end. */
+inline void stop_tracing()
+{
+#ifdef MOCKTURTLE_ENABLE_TRACING
+  detail::tracer::instance().set_active( false );
+#endif
+}
+
+/*! \brief Removes all recorded events. */
+inline void clear_trace()
+{
+#ifdef MOCKTURTLE_ENABLE_TRACING
+  detail::tracer::instance().clear();
+#endif
+}
+
+/*! \brief Writes the recorded events in Chrome trace event format.
+ *
+ * The output can be opened in `chrome://tracing` or Perfetto.  Each
+ * thread that recorded events appears with its own id, in the order in
+ * which the threads recorded their first event.  If tracing is not
+ * compiled in, the trace is empty.
+ */
+inline void write_chrome_trace( std::ostream& os )
+{
+#ifdef MOCKTURTLE_ENABLE_TRACING
+  detail::tracer::instance().write( os );
+#else
+  os << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n]}\n";
+#endif
+}
+
+/*! \brief Writes the recorded events in Chrome trace event format into a file. */
+inline bool write_chrome_trace( std::string const& filename )
+{
+  std::ofstream os( filename.c_str(), std::ofstream::out );
+  if ( !os.is_open() )
+  {
+    return false;
+  }
+  write_chrome_trace( os );
+  return true;
+}
+
+} // namespace mockturtle
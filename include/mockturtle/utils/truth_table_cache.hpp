@@ -42,6 +42,8 @@
 
 #include <parallel_hashmap/phmap.h>
 
+#include "memory_usage.hpp"
+
 namespace mockturtle
 {
 
@@ -117,6 +119,12 @@ public:
    */
   void resize( uint32_t capacity );
 
+  /*! \brief Returns the memory used by the cache in bytes. */
+  uint64_t memory_usage() const
+  {
+    return sizeof( *this ) + dynamic_memory_usage( _indexes ) + dynamic_memory_usage( _data );
+  }
+
 private:
   phmap::flat_hash_map<TT, uint32_t, kitty::hash<TT>> _indexes;
   std::vector<TT> _data;
@@ -231,6 +231,12 @@ public:
     _depth = std::max( _depth, _levels[f] );
   }
 
+  /*! \brief Returns the memory used by the network, the levels, and the critical path in bytes. */
+  uint64_t memory_usage() const
+  {
+    return detail::base_memory_usage<Ntk>( *this ) + sizeof( *this ) - sizeof( Ntk ) + dynamic_memory_usage( _levels ) + dynamic_memory_usage( _crit_path );
+  }
+
 private:
   uint32_t compute_levels( node const& n )
   {
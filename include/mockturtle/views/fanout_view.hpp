@@ -246,6 +246,12 @@ public:
     }
   }
 
+  /*! \brief Returns the memory used by the network and the fanout lists in bytes. */
+  uint64_t memory_usage() const
+  {
+    return detail::base_memory_usage<Ntk>( *this ) + sizeof( *this ) - sizeof( Ntk ) + dynamic_memory_usage( _fanout );
+  }
+
 private:
   void register_events()
   {
@@ -266,6 +266,18 @@ public:
         [&]( auto i ) { return this->index_to_node( i ); }, fn );
   }
 
+  /*! \brief Returns the memory used by the network and the mapping in bytes. */
+  uint64_t memory_usage() const
+  {
+    uint64_t bytes = detail::base_memory_usage<Ntk>( *this ) + sizeof( *this ) - sizeof( Ntk );
+    bytes += sizeof( detail::mapping_view_storage<StoreFunction> ) + dynamic_memory_usage( _mapping_storage->mappings );
+    if constexpr ( StoreFunction )
+    {
+      bytes += dynamic_memory_usage( _mapping_storage->functions ) + dynamic_memory_usage( _mapping_storage->cache );
+    }
+    return bytes;
+  }
+
 private:
   std::shared_ptr<detail::mapping_view_storage<StoreFunction>> _mapping_storage;
 };
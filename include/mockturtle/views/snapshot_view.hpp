@@ -0,0 +1,422 @@
+/* mockturtle: C++ logic network library
+ * Copyright (C) 2018-2022  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*!
+  \file snapshot_view.hpp
+  \brief Frozen, thread-shareable snapshot of a network
+*/
+
+#pragma once
+
+#include "../networks/detail/foreach.hpp"
+#include "../networks/events.hpp"
+#include "../traits.hpp"
+#include "immutable_view.hpp"
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace mockturtle
+{
+
+namespace detail
+{
+
+/*! \brief Read-only side tables of a network snapshot.
+ *
+ * All arrays are indexed by `node_to_index`.  Fanins and fanouts are stored
+ * in compressed form (one offset array and one flat element array) to avoid
+ * per-node allocations.
+ */
+template<typename Ntk>
+struct snapshot_storage
+{
+  using node = typename Ntk::node;
+  using signal = typename Ntk::signal;
+
+  std::vector<uint32_t> fanin_offsets;
+  std::vector<signal> fanins;
+  std::vector<uint32_t> fanout_offsets;
+  std::vector<node> fanouts;
+  std::vector<uint32_t> fanout_sizes;
+  std::vector<uint32_t> levels;
+
+  /*! \brief Live gates in topological order. */
+  std::vector<node> gates;
+
+  uint32_t depth{ 0 };
+};
+
+} // namespace detail
+
+/*! \brief Frozen snapshot of a network that can be shared across threads.
+ *
+ * This view copies the storage of a storage-based network once and computes,
+ * in a single topological pass, compact read-only side tables: flat fanin and
+ * fanout arrays, fanout sizes, levels, depth, and a topological order of the
+ * gates.  As an `immutable_view`, all methods that change the structure are
+ * deleted, so the copied storage is never written after construction.
+ *
+ * Methods that are conceptually read-only but write scratch data into the
+ * node storage of regular networks (`visited`, `value`, `trav_id`, and their
+ * setters) are redirected to per-object scratch arrays.  Copies of a
+ * snapshot share the frozen data, but each copy owns its scratch arrays and
+ * its own event list.  To run algorithms concurrently, give each thread its
+ * own copy of the snapshot, e.g., by passing it by value or by wrapping it in
+ * another view such as `depth_view` or `topo_view`.
+ *
+ * The snapshot implements `foreach_fanout`, `level`, and `depth`, such that
+ * `fanout_view` does not need to recompute fanouts.  Since `update_levels` is
+ * not provided, `depth_view` still computes its own levels, which allows the
+ * use of custom cost functions.  `foreach_gate` visits gates in topological
+ * order.
+ *
+ * **Required network functions:**
+ * - `size`
+ * - `node_to_index`
+ * - `index_to_node`
+ * - `get_node`
+ * - `foreach_node`
+ * - `foreach_po`
+ * - `foreach_fanin`
+ * - `fanout_size`
+ * - `is_constant`
+ * - `is_ci`
+ *
+ * Example
+ *
+   \verbatim embed:rst
+
+   .. code-block:: c++
+
+      aig_network aig = ...;
+      snapshot_view snapshot{ aig };
+
+      std::thread t1( [snapshot]() { depth_view d{ snapshot }; ... } );
+      std::thread t2( [snapshot]() { simulate<kitty::static_truth_table<8>>( snapshot ); } );
+   \endverbatim
+ */
+template<typename Ntk>
+class snapshot_view : public immutable_view<Ntk>
+{
+public:
+  using storage = typename Ntk::storage;
+  using node = typename Ntk::node;
+  using signal = typename Ntk::signal;
+
+  explicit snapshot_view( Ntk const& ntk )
+      : immutable_view<Ntk>( ntk ), _frozen( std::make_shared<detail::snapshot_storage<Ntk>>() )
+  {
+    static_assert( is_network_type_v<Ntk>, "Ntk is not a network type" );
+    static_assert( has_size_v<Ntk>, "Ntk does not implement the size method" );
+    static_assert( has_node_to_index_v<Ntk>, "Ntk does not implement the node_to_index method" );
+    static_assert( has_index_to_node_v<Ntk>, "Ntk does not implement the index_to_node method" );
+    static_assert( has_get_node_v<Ntk>, "Ntk does not implement the get_node method" );
+    static_assert( has_foreach_node_v<Ntk>, "Ntk does not implement the foreach_node method" );
+    static_assert( has_foreach_po_v<Ntk>, "Ntk does not implement the foreach_po method" );
+    static_assert( has_foreach_fanin_v<Ntk>, "Ntk does not implement the foreach_fanin method" );
+    static_assert( has_fanout_size_v<Ntk>, "Ntk does not implement the fanout_size method" );
+    static_assert( has_is_constant_v<Ntk>, "Ntk does not implement the is_constant method" );
+    static_assert( has_is_ci_v<Ntk>, "Ntk does not implement the is_ci method" );
+
+    /* detach from the original network */
+    this->_storage = std::make_shared<typename storage::element_type>( *ntk._storage );
+    this->_events = std::make_shared<typename decltype( this->_events )::element_type>();
+
+    freeze();
+
+    _visited.resize( Ntk::size(), 0u );
+    _values.resize( Ntk::size(), 0u );
+  }
+
+  /*! \brief Copy constructor.
+   *
+   * Shares the frozen data, copies the scratch arrays, and creates a fresh
+   * event list, such that copies can be used independently by different
+   * threads.
+   */
+  snapshot_view( snapshot_view<Ntk> const& other )
+      : immutable_view<Ntk>( other ), _frozen( other._frozen ), _visited( other._visited ), _values( other._values ), _trav_id( other._trav_id )
+  {
+    this->_events = std::make_shared<typename decltype( this->_events )::element_type>();
+  }
+
+  snapshot_view<Ntk>& operator=( snapshot_view<Ntk> const& other )
+  {
+    this->_storage = other._storage;
+    this->_events = std::make_shared<typename decltype( this->_events )::element_type>();
+    _frozen = other._frozen;
+    _visited = other._visited;
+    _values = other._values;
+    _trav_id = other._trav_id;
+    return *this;
+  }
+
+#pragma region Structural properties
+  uint32_t num_gates() const
+  {
+    return static_cast<uint32_t>( _frozen->gates.size() );
+  }
+
+  uint32_t fanin_size( node const& n ) const
+  {
+    auto const i = this->node_to_index( n );
+    return _frozen->fanin_offsets[i + 1] - _frozen->fanin_offsets[i];
+  }
+
+  uint32_t fanout_size( node const& n ) const
+  {
+    return _frozen->fanout_sizes[this->node_to_index( n )];
+  }
+
+  uint32_t incr_fanout_size( node const& n ) const = delete;
+  uint32_t decr_fanout_size( node const& n ) const = delete;
+
+  uint32_t level( node const& n ) const
+  {
+    return _frozen->levels[this->node_to_index( n )];
+  }
+
+  uint32_t depth() const
+  {
+    return _frozen->depth;
+  }
+#pragma endregion
+
+#pragma region Node and signal iterators
+  template<typename Fn>
+  void foreach_gate( Fn&& fn ) const
+  {
+    detail::foreach_element( _frozen->gates.begin(), _frozen->gates.end(), fn );
+  }
+
+  template<typename Fn>
+  void foreach_fanin( node const& n, Fn&& fn ) const
+  {
+    auto const i = this->node_to_index( n );
+    auto const begin = _frozen->fanins.begin() + _frozen->fanin_offsets[i];
+    auto const end = _frozen->fanins.begin() + _frozen->fanin_offsets[i + 1];
+    detail::foreach_element( begin, end, fn );
+  }
+
+  template<typename Fn>
+  void foreach_fanout( node const& n, Fn&& fn ) const
+  {
+    auto const i = this->node_to_index( n );
+    auto const begin = _frozen->fanouts.begin() + _frozen->fanout_offsets[i];
+    auto const end = _frozen->fanouts.begin() + _frozen->fanout_offsets[i + 1];
+    detail::foreach_element( begin, end, fn );
+  }
+#pragma endregion
+
+#pragma region Custom node values
+  void clear_values() const
+  {
+    std::fill( _values.begin(), _values.end(), 0u );
+  }
+
+  uint32_t value( node const& n ) const
+  {
+    return _values[this->node_to_index( n )];
+  }
+
+  void set_value( node const& n, uint32_t v ) const
+  {
+    _values[this->node_to_index( n )] = v;
+  }
+
+  uint32_t incr_value( node const& n ) const
+  {
+    return _values[this->node_to_index( n )]++;
+  }
+
+  uint32_t decr_value( node const& n ) const
+  {
+    return --_values[this->node_to_index( n )];
+  }
+#pragma endregion
+
+#pragma region Visited flags
+  void clear_visited() const
+  {
+    std::fill( _visited.begin(), _visited.end(), 0u );
+  }
+
+  uint32_t visited( node const& n ) const
+  {
+    return _visited[this->node_to_index( n )];
+  }
+
+  void set_visited( node const& n, uint32_t v ) const
+  {
+    _visited[this->node_to_index( n )] = v;
+  }
+
+  uint32_t trav_id() const
+  {
+    return _trav_id;
+  }
+
+  void incr_trav_id() const
+  {
+    ++_trav_id;
+  }
+#pragma endregion
+
+private:
+  void freeze()
+  {
+    Ntk const& ntk = *this;
+    auto& fr = *_frozen;
+    auto const size = ntk.size();
+
+    /* fanins and fanout sizes */
+    fr.fanin_offsets.assign( size + 1, 0u );
+    fr.fanout_sizes.assign( size, 0u );
+    ntk.foreach_node( [&]( auto const& n ) {
+      auto const i = ntk.node_to_index( n );
+      fr.fanout_sizes[i] = ntk.fanout_size( n );
+      if ( ntk.is_constant( n ) || ntk.is_ci( n ) )
+        return;
+      ntk.foreach_fanin( n, [&]( auto const& f ) {
+        fr.fanins.emplace_back( f );
+        ++fr.fanin_offsets[i + 1];
+      } );
+    } );
+    /* `foreach_node` visits nodes in index order, hence prefix sums give the offsets */
+    for ( auto i = 0u; i < size; ++i )
+    {
+      fr.fanin_offsets[i + 1] += fr.fanin_offsets[i];
+    }
+
+    /* topological order of gates and levels */
+    fr.levels.assign( size, 0u );
+    std::vector<uint8_t> state( size, 0u ); /* 0: new, 1: on stack, 2: done */
+    std::vector<std::pair<uint32_t, uint32_t>> stack;
+    ntk.foreach_node( [&]( auto const& n ) {
+      auto const root = ntk.node_to_index( n );
+      if ( state[root] == 2u )
+        return;
+      if ( ntk.is_constant( n ) || ntk.is_ci( n ) )
+      {
+        state[root] = 2u;
+        return;
+      }
+
+      stack.emplace_back( root, fr.fanin_offsets[root] );
+      state[root] = 1u;
+      while ( !stack.empty() )
+      {
+        auto& [i, pos] = stack.back();
+        if ( pos < fr.fanin_offsets[i + 1] )
+        {
+          auto const c = ntk.node_to_index( ntk.get_node( fr.fanins[pos++] ) );
+          if ( state[c] == 0u )
+          {
+            if ( ntk.is_constant( ntk.index_to_node( c ) ) || ntk.is_ci( ntk.index_to_node( c ) ) )
+            {
+              state[c] = 2u;
+            }
+            else
+            {
+              state[c] = 1u;
+              stack.emplace_back( c, fr.fanin_offsets[c] );
+            }
+          }
+          continue;
+        }
+
+        uint32_t level{ 0 };
+        for ( auto j = fr.fanin_offsets[i]; j < fr.fanin_offsets[i + 1]; ++j )
+        {
+          level = std::max( level, fr.levels[ntk.node_to_index( ntk.get_node( fr.fanins[j] ) )] );
+        }
+        fr.levels[i] = level + 1;
+        fr.gates.emplace_back( ntk.index_to_node( i ) );
+        state[i] = 2u;
+        stack.pop_back();
+      }
+    } );
+
+    ntk.foreach_po( [&]( auto const& f ) {
+      fr.depth = std::max( fr.depth, fr.levels[ntk.node_to_index( ntk.get_node( f ) )] );
+    } );
+
+    /* fanouts (gates only) */
+    fr.fanout_offsets.assign( size + 1, 0u );
+    for ( auto const& g : fr.gates )
+    {
+      auto const i = ntk.node_to_index( g );
+      for ( auto j = fr.fanin_offsets[i]; j < fr.fanin_offsets[i + 1]; ++j )
+      {
+        ++fr.fanout_offsets[ntk.node_to_index( ntk.get_node( fr.fanins[j] ) ) + 1];
+      }
+    }
+    for ( auto i = 0u; i < size; ++i )
+    {
+      fr.fanout_offsets[i + 1] += fr.fanout_offsets[i];
+    }
+    fr.fanouts.resize( fr.fanout_offsets[size] );
+    std::vector<uint32_t> fill( fr.fanout_offsets.begin(), fr.fanout_offsets.end() - 1 );
+    for ( auto const& g : fr.gates )
+    {
+      auto const i = ntk.node_to_index( g );
+      for ( auto j = fr.fanin_offsets[i]; j < fr.fanin_offsets[i + 1]; ++j )
+      {
+        auto const c = ntk.node_to_index( ntk.get_node( fr.fanins[j] ) );
+        /* a node appears once per fanout even if it is used several times as a fanin */
+        if ( fill[c] > fr.fanout_offsets[c] && fr.fanouts[fill[c] - 1] == g )
+          continue;
+        fr.fanouts[fill[c]++] = g;
+      }
+    }
+    /* compact duplicate-free fanout lists */
+    {
+      std::vector<node> fanouts;
+      fanouts.reserve( fr.fanouts.size() );
+      std::vector<uint32_t> offsets( size + 1, 0u );
+      for ( auto i = 0u; i < size; ++i )
+      {
+        fanouts.insert( fanouts.end(), fr.fanouts.begin() + fr.fanout_offsets[i], fr.fanouts.begin() + fill[i] );
+        offsets[i + 1] = static_cast<uint32_t>( fanouts.size() );
+      }
+      fr.fanouts = std::move( fanouts );
+      fr.fanout_offsets = std::move( offsets );
+    }
+  }
+
+private:
+  std::shared_ptr<detail::snapshot_storage<Ntk>> _frozen;
+
+  mutable std::vector<uint32_t> _visited;
+  mutable std::vector<uint32_t> _values;
+  mutable uint32_t _trav_id{ 0 };
+};
+
+template<class T>
+snapshot_view( T const& ) -> snapshot_view<T>;
+
+} // namespace mockturtle
@@ -41,6 +41,7 @@
 
 #include "../networks/detail/foreach.hpp"
 #include "../traits.hpp"
+#include "../utils/memory_usage.hpp"
 #include "immutable_view.hpp"
 
 namespace mockturtle
@@ -276,6 +277,12 @@ public:
     }
   }
 
+  /*! \brief Returns the memory used by the network and the topological order in bytes. */
+  uint64_t memory_usage() const
+  {
+    return detail::base_memory_usage<Ntk>( *this ) + sizeof( *this ) - sizeof( Ntk ) + dynamic_memory_usage( topo_order );
+  }
+
 private:
   void create_topo_rec( node const& n )
   {
@@ -1593,8 +1593,6 @@ int sat_solver_simplify(sat_solver* s)
 
 void sat_solver_reducedb(sat_solver* s)
 {
-    static abctime TimeTotal = 0;
-    abctime clk = Abc_Clock();
     Sat_Mem_t * pMem = &s->Mem;
     int nLearnedOld = veci_size(&s->act_clas);
     int * act_clas = veci_begin(&s->act_clas);
@@ -1699,8 +1697,6 @@ void sat_solver_reducedb(sat_solver* s)
     Counter = Sat_MemCompactLearned( pMem, 1 );
     assert( Counter == (int)s->stats.learnts );
 
-    // report the results
-    TimeTotal += Abc_Clock() - clk;
 }
 
 
@@ -1709,8 +1705,6 @@ void sat_solver_rollback( sat_solver* s )
 {
     Sat_Mem_t * pMem = &s->Mem;
     int i, k, j;
-    static int Count = 0;
-    Count++;
     assert( s->iVarPivot >= 0 && s->iVarPivot <= s->size );
     assert( s->iTrailPivot >= 0 && s->iTrailPivot <= s->qtail );
     // reset implication queue
@@ -2068,8 +2068,6 @@ inline int sat_solver_simplify(sat_solver* s)
 
 inline void sat_solver_reducedb(sat_solver* s)
 {
-	static abctime TimeTotal = 0;
-	abctime clk = Abc_Clock();
 	Sat_Mem_t* pMem = &s->Mem;
 	int nLearnedOld = veci_size(&s->act_clas);
 	int* act_clas = veci_begin(&s->act_clas);
@@ -2173,8 +2171,6 @@ inline void sat_solver_reducedb(sat_solver* s)
 	Counter = Sat_MemCompactLearned(pMem, 1);
 	assert(Counter == (int) s->stats.learnts);
 
-	// report the results
-	TimeTotal += Abc_Clock() - clk;
 }
 
 // reverses to the previously bookmarked point
@@ -2182,8 +2178,6 @@ inline void sat_solver_rollback(sat_solver* s)
 {
 	Sat_Mem_t* pMem = &s->Mem;
 	int i, k, j;
-	static int Count = 0;
-	Count++;
 	assert(s->iVarPivot >= 0 && s->iVarPivot <= s->size);
 	assert(s->iTrailPivot >= 0 && s->iTrailPivot <= s->qtail);
 	// reset implication queue
@@ -11,7 +11,9 @@
 #include <mockturtle/generators/arithmetic.hpp>
 #include <mockturtle/networks/aig.hpp>
 #include <mockturtle/networks/xag.hpp>
+#include <mockturtle/utils/cut_store.hpp>
 #include <mockturtle/views/depth_view.hpp>
+#include <mockturtle/views/fanout_view.hpp>
 
 using namespace mockturtle;
 
@@ -159,3 +161,30 @@ TEST_CASE( "SOP balance XAG adder", "[balancing]" )
   auto const miter_ntk = *miter<xag_network>( xag, res );
   CHECK( *equivalence_checking( miter_ntk ) == true );
 }
+
+TEST_CASE( "Rebalance XAG adder with a shared cut store", "[balancing]" )
+{
+  xag_network xag;
+  std::vector<xag_network::signal> as( 8u ), bs( 8u );
+  std::generate( as.begin(), as.end(), [&]() { return xag.create_pi(); } );
+  std::generate( bs.begin(), bs.end(), [&]() { return xag.create_pi(); } );
+  auto carry = xag.get_constant( false );
+  carry_ripple_adder_inplace( xag, as, bs, carry );
+  std::for_each( as.begin(), as.end(), [&]( auto const& f ) { xag.create_po( f ); } );
+
+  balancing_params ps;
+  ps.cut_enumeration_ps.cut_limit = 8u;
+  fanout_view<xag_network> fanout_xag{ xag };
+  cut_store<fanout_view<xag_network>, 4u> cuts( fanout_xag, ps.cut_enumeration_ps );
+
+  const auto esop_xag = balancing( xag, { esop_rebalancing<xag_network>{} }, cuts, ps );
+  CHECK( depth_view{ esop_xag }.depth() == 12u );
+  CHECK( *equivalence_checking( *miter<xag_network>( xag, esop_xag ) ) );
+
+  /* the second pass finds all cuts in the store */
+  const auto enumerated_cuts = cuts.stats().enumerated_cuts;
+  const auto sop_xag = balancing( xag, { sop_rebalancing<xag_network>{} }, cuts, ps );
+  CHECK( cuts.stats().reused > 0u );
+  CHECK( cuts.stats().enumerated_cuts == enumerated_cuts );
+  CHECK( *equivalence_checking( *miter<xag_network>( xag, sop_xag ) ) );
+}
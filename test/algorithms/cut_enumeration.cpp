@@ -139,6 +139,56 @@ TEST_CASE( "compute truth tables of AIG cuts", "[cut_enumeration]" )
   CHECK( cuts.truth_table( cuts.cuts( i4 )[3] )._bits[0] == 0x0d );
 }
 
+TEST_CASE( "compute truth tables of AIG cuts on demand", "[cut_enumeration]" )
+{
+  aig_network aig;
+
+  const auto a = aig.create_pi();
+  const auto b = aig.create_pi();
+  const auto c = aig.create_pi();
+  const auto f1 = aig.create_nand( a, b );
+  const auto f2 = aig.create_xor( f1, c );
+  const auto f3 = aig.create_maj( a, f2, !c );
+  const auto f4 = aig.create_and( aig.get_constant( true ), f3 );
+  aig.create_po( f4 );
+  aig.create_po( aig.create_or( f2, f3 ) );
+
+  cut_enumeration_params ps;
+  cut_enumeration_stats st_eager, st_lazy;
+  const auto eager = cut_enumeration<aig_network, true>( aig, ps, &st_eager );
+  ps.lazy_truth_tables = true;
+  const auto lazy = cut_enumeration<aig_network, true>( aig, ps, &st_lazy );
+
+  CHECK( st_eager.num_deferred_truth_tables == 0u );
+  CHECK( st_lazy.num_truth_tables == 0u );
+  CHECK( st_lazy.num_deferred_truth_tables == st_eager.num_truth_tables );
+  CHECK( lazy.num_deferred_truth_tables() == 0u );
+
+  uint64_t num_cuts{ 0 };
+  aig.foreach_node( [&]( auto const& n ) {
+    const auto index = aig.node_to_index( n );
+    REQUIRE( eager.cuts( index ).size() == lazy.cuts( index ).size() );
+    for ( auto i = 0u; i < eager.cuts( index ).size(); ++i )
+    {
+      CHECK( lazy.truth_table( lazy.cuts( index )[i] ) == eager.truth_table( eager.cuts( index )[i] ) );
+      num_cuts += lazy.cuts( index )[i].size() > 1u ? 1u : 0u;
+    }
+  } );
+
+  /* truth tables are memoized in the cuts */
+  const auto num_computed = lazy.num_deferred_truth_tables();
+  CHECK( num_computed > 0u );
+  CHECK( num_computed <= st_lazy.num_deferred_truth_tables );
+  aig.foreach_node( [&]( auto const& n ) {
+    for ( auto const& cut : lazy.cuts( aig.node_to_index( n ) ) )
+    {
+      lazy.truth_table( *cut );
+    }
+  } );
+  CHECK( lazy.num_deferred_truth_tables() == num_computed );
+  CHECK( num_computed <= num_cuts );
+}
+
 TEST_CASE( "compute XOR network cuts in 2-LUT network", "[cut_enumeration]" )
 {
   klut_network klut;
@@ -2,9 +2,16 @@
 
 #include <vector>
 
+#include <kitty/static_truth_table.hpp>
 #include <mockturtle/algorithms/dont_cares.hpp>
+#include <mockturtle/algorithms/reconv_cut.hpp>
 #include <mockturtle/algorithms/simulation.hpp>
 #include <mockturtle/networks/aig.hpp>
+#include <mockturtle/utils/window_utils.hpp>
+#include <mockturtle/views/color_view.hpp>
+#include <mockturtle/views/depth_view.hpp>
+#include <mockturtle/views/fanout_view.hpp>
+#include <mockturtle/views/window_view.hpp>
 
 using namespace mockturtle;
 
@@ -42,6 +49,159 @@ TEST_CASE( "ODCs in simple AIG", "[dont_cares]" )
   CHECK( f2_odc._bits[0] == 0x7 );
 }
 
+TEST_CASE( "don't cares with a don't care manager", "[dont_cares]" )
+{
+  aig_network aig;
+  auto a = aig.create_pi();
+  auto b = aig.create_pi();
+  auto f1 = aig.create_and( a, b );
+  auto f2 = aig.create_and( a, !b );
+  auto f3 = aig.create_and( f1, f2 );
+  aig.create_po( f3 );
+
+  dont_care_manager<aig_network> dcs( aig );
+  const auto sdc = dcs.satisfiability_dont_cares( { aig.get_node( f1 ), aig.get_node( f2 ) } );
+  CHECK( sdc._bits[0] == 0x8u );
+
+  std::vector<node<aig_network>> leaves{ { aig.get_node( a ), aig.get_node( b ) } };
+  CHECK( dcs.observability_dont_cares( aig.get_node( f1 ), leaves, { aig.get_node( f3 ) } )._bits[0] == 0xd );
+  CHECK( dcs.observability_dont_cares( aig.get_node( f2 ), leaves, { aig.get_node( f3 ) } )._bits[0] == 0x7 );
+
+  /* the network may grow between two windows */
+  auto f4 = aig.create_or( f1, f2 );
+  auto f5 = aig.create_and( f4, !f1 );
+  aig.create_po( f5 );
+  CHECK( dcs.satisfiability_dont_cares( { aig.get_node( f4 ), aig.get_node( f1 ) } )._bits[0] == 0x8u );
+
+  /* care sets of cuts inside a window */
+  dcs.set_window( { aig.get_node( f5 ) } );
+  CHECK( dcs.in_window( aig.get_node( f1 ) ) );
+  CHECK( !dcs.in_window( aig.get_node( f3 ) ) );
+
+  std::vector<node<aig_network>> cut{ { aig.get_node( f4 ), aig.get_node( f1 ) } };
+  kitty::static_truth_table<2> care;
+  CHECK( dcs.compute_care( cut.begin(), cut.end(), care ) );
+  CHECK( care._bits == 0x7u );
+
+  cut[1] = aig.get_node( f3 );
+  CHECK( !dcs.compute_care( cut.begin(), cut.end(), care ) );
+}
+
+namespace
+{
+
+template<bool SortByLevel, class Ntk>
+std::vector<node<Ntk>> reference_leaves( Ntk const& ntk, std::vector<node<Ntk>> const& pivots, uint32_t max_tfi_inputs )
+{
+  reconvergence_driven_cut_parameters ps;
+  ps.max_leaves = max_tfi_inputs;
+  reconvergence_driven_cut_statistics st;
+  detail::reconvergence_driven_cut_impl<Ntk, false, SortByLevel> cuts( ntk, ps, st );
+  return cuts.run( pivots ).first;
+}
+
+/* SDCs from a reconvergence-driven window that is simulated from scratch */
+template<bool SortByLevel, class Ntk>
+kitty::dynamic_truth_table reference_sdc( Ntk const& ntk, std::vector<node<Ntk>> const& pivots, uint32_t max_tfi_inputs )
+{
+  auto const leaves = reference_leaves<SortByLevel>( ntk, pivots, max_tfi_inputs );
+
+  fanout_view<Ntk> fanout_ntk{ ntk };
+  fanout_ntk.clear_visited();
+  color_view<fanout_view<Ntk>> color_ntk{ fanout_ntk };
+  std::vector<node<Ntk>> gates{ collect_nodes( color_ntk, leaves, pivots ) };
+  window_view window_ntk{ color_ntk, leaves, pivots, gates };
+
+  default_simulator<kitty::dynamic_truth_table> sim( window_ntk.num_pis() );
+  auto const tts = simulate_nodes<kitty::dynamic_truth_table>( window_ntk, sim );
+
+  kitty::dynamic_truth_table care( static_cast<uint32_t>( pivots.size() ) );
+  for ( auto i = 0u; i < ( 1u << window_ntk.num_pis() ); ++i )
+  {
+    uint32_t entry{ 0u };
+    for ( auto j = 0u; j < pivots.size(); ++j )
+    {
+      entry |= kitty::get_bit( tts[pivots[j]], i ) << j;
+    }
+    kitty::set_bit( care, entry );
+  }
+  return ~care;
+}
+
+aig_network reconvergent_network()
+{
+  aig_network aig;
+  std::vector<aig_network::signal> fs;
+  for ( auto i = 0u; i < 6u; ++i )
+  {
+    fs.emplace_back( aig.create_pi() );
+  }
+  for ( auto i = 0u; i < 60u; ++i )
+  {
+    auto const x = fs[( 7u * i + 3u ) % fs.size()];
+    auto const y = fs[( 5u * i + 1u ) % fs.size()];
+    fs.emplace_back( i % 3u == 0u ? aig.create_xor( x, y ) : aig.create_and( x ^ ( i % 2u == 0u ), y ) );
+  }
+  aig.create_po( fs.back() );
+  return aig;
+}
+
+template<class Ntk>
+std::vector<node<Ntk>> fanin_nodes( Ntk const& ntk, node<Ntk> const& n )
+{
+  std::vector<node<Ntk>> fanins;
+  ntk.foreach_fanin( n, [&]( auto const& f ) {
+    fanins.emplace_back( ntk.get_node( f ) );
+  } );
+  return fanins;
+}
+
+} // namespace
+
+TEST_CASE( "don't care manager matches windows simulated from scratch", "[dont_cares]" )
+{
+  auto const aig = reconvergent_network();
+
+  dont_care_manager<aig_network> dcs( aig, 6u );
+  dont_care_manager<aig_network, kitty::static_truth_table<6>> static_dcs( aig, 6u );
+  aig.foreach_gate( [&]( auto const& n ) {
+    auto const pivots = fanin_nodes( aig, n );
+    auto const expected = reference_sdc<false>( aig, pivots, 6u );
+    CHECK( satisfiability_dont_cares( aig, pivots, 6u ) == expected );
+    CHECK( dcs.satisfiability_dont_cares( pivots ) == expected );
+
+    static_dcs.set_window( pivots );
+    kitty::dynamic_truth_table care( static_cast<uint32_t>( pivots.size() ) );
+    CHECK( static_dcs.compute_care( pivots.begin(), pivots.end(), care ) );
+    CHECK( ~care == expected );
+  } );
+}
+
+TEST_CASE( "don't care manager with level-sorted windows", "[dont_cares]" )
+{
+  depth_view aig{ reconvergent_network() };
+
+  dont_care_manager<depth_view<aig_network>, kitty::dynamic_truth_table, true> dcs( aig, 4u );
+  uint32_t num_level_sorted{ 0u };
+  aig.foreach_gate( [&]( auto const& n ) {
+    auto const pivots = fanin_nodes( aig, n );
+    auto const leaves = reference_leaves<true>( aig, pivots, 4u );
+    CHECK( dcs.satisfiability_dont_cares( pivots ) == reference_sdc<true>( aig, pivots, 4u ) );
+    for ( auto const& l : leaves )
+    {
+      CHECK( dcs.in_window( l ) );
+    }
+
+    if ( leaves != reference_leaves<false>( aig, pivots, 4u ) )
+    {
+      ++num_level_sorted;
+    }
+  } );
+
+  /* sorting by level must make a difference for the test to be meaningful */
+  CHECK( num_level_sorted > 0u );
+}
+
 TEST_CASE( "SDCs in simple AIG using satisfiability checker", "[dont_cares]" )
 {
   aig_network aig;
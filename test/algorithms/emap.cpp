@@ -1011,4 +1011,48 @@ TEST_CASE( "Emap on circuit with don't touch cells", "[emap]" )
   CHECK( st.area < 11.0f + eps );
   CHECK( st.delay > 5.8f - eps );
   CHECK( st.delay < 5.8f + eps );
-}
\ No newline at end of file
+}
+
+TEST_CASE( "Emap with multiple threads", "[emap]" )
+{
+  std::vector<gate> gates;
+
+  std::istringstream in( test_library );
+  auto result = lorina::read_genlib( in, genlib_reader( gates ) );
+  CHECK( result == lorina::return_code::success );
+
+  tech_library<3> lib( gates );
+
+  aig_network aig;
+
+  std::vector<typename aig_network::signal> a( 12 ), b( 12 );
+  std::generate( a.begin(), a.end(), [&aig]() { return aig.create_pi(); } );
+  std::generate( b.begin(), b.end(), [&aig]() { return aig.create_pi(); } );
+
+  for ( auto const& o : carry_ripple_multiplier( aig, a, b ) )
+  {
+    aig.create_po( o );
+  }
+
+  for ( auto area_oriented : { false, true } )
+  {
+    emap_params ps;
+    ps.area_oriented_mapping = area_oriented;
+    emap_stats st1, st4;
+    binding_view<klut_network> luts1 = emap_klut( aig, lib, ps, &st1 );
+    ps.num_threads = 4u;
+    binding_view<klut_network> luts4 = emap_klut( aig, lib, ps, &st4 );
+
+    CHECK( luts1.size() == luts4.size() );
+    CHECK( luts1.num_gates() == luts4.num_gates() );
+    CHECK( st1.area == st4.area );
+    CHECK( st1.delay == st4.delay );
+
+    bool same_bindings = true;
+    luts1.foreach_gate( [&]( auto const& n ) {
+      if ( !luts4.has_binding( n ) || luts1.get_binding_index( n ) != luts4.get_binding_index( n ) )
+        same_bindings = false;
+    } );
+    CHECK( same_bindings );
+  }
+}
@@ -72,3 +72,84 @@ TEST_CASE( "Equivalence check on two non-equivalent AIGs", "[equivalence_checkin
   CHECK( !*result );
   CHECK( st.counter_example == std::vector<bool>( { true, true } ) );
 }
+
+TEST_CASE( "Equivalence check per output on two adders", "[equivalence_checking]" )
+{
+  aig_network aig1, aig2;
+
+  std::vector<aig_network::signal> a1, b1, a2, b2;
+  for ( auto i = 0u; i < 8u; ++i )
+  {
+    a1.push_back( aig1.create_pi() );
+    a2.push_back( aig2.create_pi() );
+  }
+  for ( auto i = 0u; i < 8u; ++i )
+  {
+    b1.push_back( aig1.create_pi() );
+    b2.push_back( aig2.create_pi() );
+  }
+
+  /* ripple carry adders, the second one with majority carries */
+  auto c1 = aig1.get_constant( false );
+  auto c2 = aig2.get_constant( false );
+  for ( auto i = 0u; i < 8u; ++i )
+  {
+    aig1.create_po( aig1.create_xor( aig1.create_xor( a1[i], b1[i] ), c1 ) );
+    c1 = aig1.create_or( aig1.create_and( a1[i], b1[i] ), aig1.create_and( c1, aig1.create_xor( a1[i], b1[i] ) ) );
+    aig2.create_po( aig2.create_xor( a2[i], aig2.create_xor( b2[i], c2 ) ) );
+    c2 = aig2.create_maj( a2[i], b2[i], c2 );
+  }
+
+  const auto miter_ntk = *miter_per_output<aig_network>( aig1, aig2 );
+  CHECK( miter_ntk.num_pos() == 8u );
+
+  equivalence_checking_params ps;
+  ps.num_threads = 3u;
+  equivalence_checking_stats st;
+  auto result = equivalence_checking( miter_ntk, ps, &st );
+  CHECK( result );
+  CHECK( *result );
+  CHECK( st.num_sat_calls == 8u );
+  CHECK( st.output_times.size() == 8u );
+  CHECK( !st.failing_output );
+
+  ps.output_group_size = 3u;
+  result = equivalence_checking( miter_ntk, ps, &st );
+  CHECK( result );
+  CHECK( *result );
+  CHECK( st.num_sat_calls == 3u );
+}
+
+TEST_CASE( "Equivalence check per output finds a counter-example", "[equivalence_checking]" )
+{
+  aig_network aig1, aig2;
+
+  std::vector<aig_network::signal> pis1, pis2;
+  for ( auto i = 0u; i < 12u; ++i )
+  {
+    pis1.push_back( aig1.create_pi() );
+    pis2.push_back( aig2.create_pi() );
+  }
+
+  /* the last output differs only if all inputs are 1 */
+  aig1.create_po( aig1.create_xor( pis1[0], pis1[1] ) );
+  aig2.create_po( aig2.create_xor( pis2[1], pis2[0] ) );
+  aig1.create_po( aig1.create_nary_and( pis1 ) );
+  aig2.create_po( aig2.get_constant( false ) );
+
+  const auto miter_ntk = *miter_per_output<aig_network>( aig1, aig2 );
+
+  for ( auto num_patterns : { 0u, 256u } )
+  {
+    equivalence_checking_params ps;
+    ps.num_threads = 2u;
+    ps.num_patterns = num_patterns;
+    equivalence_checking_stats st;
+    const auto result = equivalence_checking( miter_ntk, ps, &st );
+    CHECK( result );
+    CHECK( !*result );
+    CHECK( st.counter_example == std::vector<bool>( 12u, true ) );
+    CHECK( st.failing_output );
+    CHECK( *st.failing_output == 1u );
+  }
+}
@@ -0,0 +1,113 @@
+#include <catch.hpp>
+
+#include <mockturtle/algorithms/aig_balancing.hpp>
+#include <mockturtle/algorithms/aig_resub.hpp>
+#include <mockturtle/algorithms/cleanup.hpp>
+#include <mockturtle/algorithms/explorer.hpp>
+#include <mockturtle/algorithms/simulation.hpp>
+#include <mockturtle/networks/aig.hpp>
+
+#include <kitty/static_truth_table.hpp>
+
+using namespace mockturtle;
+
+namespace
+{
+
+aig_network redundant_network()
+{
+  aig_network aig;
+  auto const a = aig.create_pi();
+  auto const b = aig.create_pi();
+  auto const c = aig.create_pi();
+  auto const d = aig.create_pi();
+
+  /* a dangling gate and a redundant cover of (a & b) | (a & c) */
+  aig.create_and( c, d );
+  auto const f = aig.create_or( aig.create_and( a, b ), aig.create_and( a, c ) );
+  aig.create_po( aig.create_or( f, aig.create_and( aig.create_and( a, b ), d ) ) );
+  aig.create_po( aig.create_xor( f, d ) );
+  return aig;
+}
+
+bool equivalent( aig_network const& aig1, aig_network const& aig2 )
+{
+  default_simulator<kitty::static_truth_table<4u>> sim;
+  return simulate<kitty::static_truth_table<4u>>( aig1, sim ) == simulate<kitty::static_truth_table<4u>>( aig2, sim );
+}
+
+} // namespace
+
+TEST_CASE( "Parallel restarts of explorer", "[explorer]" )
+{
+  auto const aig = redundant_network();
+
+  auto const explore = [&]( uint32_t num_threads ) {
+    explorer_params ps;
+    ps.num_restarts = 4u;
+    ps.random_seed = 42u;
+    ps.max_steps = 3u;
+    ps.num_threads = num_threads;
+
+    explorer_stats st;
+    explorer<aig_network> expl( ps, st );
+    expl.add_decompressing_script( []( aig_network& ntk, uint32_t, uint32_t ) {
+      aig_balance( ntk );
+    } );
+    expl.add_compressing_script( []( aig_network& ntk, uint32_t, uint32_t ) {
+      aig_resubstitution( ntk );
+      ntk = cleanup_dangling( ntk );
+    } );
+    return expl.run( aig );
+  };
+
+  auto const res1 = explore( 1u );
+  auto const res3 = explore( 3u );
+
+  CHECK( res1.num_gates() < aig.num_gates() );
+  CHECK( res3.num_gates() == res1.num_gates() );
+  CHECK( equivalent( res1, aig ) );
+  CHECK( equivalent( res3, aig ) );
+}
+
+TEST_CASE( "Continue from the best network of previous restarts", "[explorer]" )
+{
+  auto const aig = redundant_network();
+
+  /* only the first restart removes the dangling gate; the sizes seen by the
+   * decompressing script show whether the second restart continues from it */
+  auto const explore = [&]( uint32_t reseed_after ) {
+    explorer_params ps;
+    ps.num_restarts = 2u;
+    ps.max_steps = 4u;
+    ps.compressing_scripts_per_step = 1u;
+    ps.reseed_after = reseed_after;
+
+    std::vector<uint32_t> sizes;
+    explorer_stats st;
+    explorer<aig_network> expl( ps, st );
+    expl.add_decompressing_script( [&]( aig_network& ntk, uint32_t, uint32_t ) {
+      sizes.emplace_back( ntk.num_gates() );
+    } );
+    expl.add_compressing_script( [&]( aig_network& ntk, uint32_t, uint32_t ) {
+      if ( sizes.size() <= ps.max_steps )
+      {
+        ntk = cleanup_dangling( ntk );
+      }
+    } );
+    auto const res = expl.run( aig );
+
+    CHECK( res.num_gates() == aig.num_gates() - 1u );
+    CHECK( equivalent( res, aig ) );
+    return sizes;
+  };
+
+  auto const sizes = explore( 0u );
+  CHECK( sizes.size() == 8u );
+  CHECK( sizes.back() == aig.num_gates() );
+
+  auto const sizes_reseeded = explore( 2u );
+  CHECK( sizes_reseeded.size() == 8u );
+  CHECK( sizes_reseeded[5] == aig.num_gates() );
+  CHECK( sizes_reseeded.back() == aig.num_gates() - 1u );
+}
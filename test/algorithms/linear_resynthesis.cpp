@@ -1,5 +1,7 @@
 #include <catch.hpp>
 
+#include <random>
+
 #include <kitty/dynamic_truth_table.hpp>
 #include <mockturtle/algorithms/linear_resynthesis.hpp>
 #include <mockturtle/algorithms/simulation.hpp>
@@ -53,6 +55,49 @@ TEST_CASE( "Linear resynthesis with Paar algorithm 2", "[linear_resynthesis]" )
   }
 }
 
+TEST_CASE( "Linear resynthesis with Paar algorithm on wide matrices", "[linear_resynthesis]" )
+{
+  std::mt19937 rng( 42u );
+  std::bernoulli_distribution bit( 0.3 );
+
+  xag_network xag;
+  std::vector<xag_network::signal> xs( 150u );
+  std::generate( xs.begin(), xs.end(), [&]() { return xag.create_pi(); } );
+
+  std::vector<std::vector<bool>> matrix;
+  for ( auto o = 0u; o < 100u; ++o )
+  {
+    std::vector<bool> row( xs.size() );
+    std::vector<xag_network::signal> fanins;
+    for ( auto i = 0u; i < xs.size(); ++i )
+    {
+      row[i] = bit( rng );
+      if ( row[i] )
+      {
+        fanins.push_back( xs[i] );
+      }
+    }
+    matrix.push_back( row );
+    xag.create_po( xag.create_nary_xor( fanins ) ^ ( o % 7u == 0u ) );
+  }
+  xag.create_po( xag.get_constant( true ) );
+  matrix.emplace_back( xs.size(), false );
+
+  CHECK( get_linear_matrix( xag ) == matrix );
+
+  const auto xag2 = linear_resynthesis_paar( xag );
+  CHECK( xag2.num_pos() == xag.num_pos() );
+  CHECK( xag2.num_gates() < xag.num_gates() );
+
+  for ( auto k = 0u; k < 20u; ++k )
+  {
+    std::vector<bool> assignment( xs.size() );
+    std::generate( assignment.begin(), assignment.end(), [&]() { return bit( rng ); } );
+    default_simulator<bool> sim( assignment );
+    CHECK( simulate<bool>( xag, sim ) == simulate<bool>( xag2, sim ) );
+  }
+}
+
 TEST_CASE( "Extract linear matrix from linear network", "[linear_resynthesis]" )
 {
   xag_network xag;
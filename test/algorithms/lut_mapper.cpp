@@ -334,3 +334,36 @@ TEST_CASE( "LUT map remapping LUT network", "[lut_mapper]" )
   CHECK( mapped_ntk.num_cells() == 1 );
   CHECK( *equivalence_checking( miter_ntk ) == true );
 }
+
+TEST_CASE( "LUT map with multiple threads", "[lut_mapper]" )
+{
+  aig_network aig;
+
+  std::vector<aig_network::signal> a( 12 ), b( 12 );
+  std::generate( a.begin(), a.end(), [&aig]() { return aig.create_pi(); } );
+  std::generate( b.begin(), b.end(), [&aig]() { return aig.create_pi(); } );
+
+  for ( auto const& o : carry_ripple_multiplier( aig, a, b ) )
+  {
+    aig.create_po( o );
+  }
+
+  for ( auto area_oriented : { false, true } )
+  {
+    lut_map_params ps;
+    ps.area_oriented_mapping = area_oriented;
+    lut_map_stats st1, st4;
+    klut_network const klut1 = lut_map( aig, ps, &st1 );
+    ps.num_threads = 4u;
+    klut_network const klut4 = lut_map( aig, ps, &st4 );
+
+    CHECK( klut1.num_gates() == klut4.num_gates() );
+    CHECK( st1.area == st4.area );
+    CHECK( st1.delay == st4.delay );
+    CHECK( st1.edges == st4.edges );
+    CHECK( st1.round_stats == st4.round_stats );
+
+    auto const miter_ntk = *miter<klut_network>( klut1, klut4 );
+    CHECK( *equivalence_checking( miter_ntk ) == true );
+  }
+}
@@ -0,0 +1,84 @@
+#ifndef _MSC_VER
+
+#include <catch.hpp>
+
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <string>
+
+#include <lorina/verilog.hpp>
+#include <mockturtle/algorithms/network_fuzz_tester.hpp>
+#include <mockturtle/generators/random_network.hpp>
+#include <mockturtle/io/verilog_reader.hpp>
+#include <mockturtle/networks/aig.hpp>
+
+using namespace mockturtle;
+
+namespace
+{
+
+/* the buggy behavior to be found: two gates with two complemented primary inputs each */
+bool has_nors_of_pis( aig_network const& aig )
+{
+  uint32_t num_found{ 0u };
+  aig.foreach_gate( [&]( auto const& n ) {
+    uint32_t num_complemented_pis{ 0u };
+    aig.foreach_fanin( n, [&]( auto const& f ) {
+      if ( aig.is_complemented( f ) && aig.is_pi( aig.get_node( f ) ) )
+      {
+        ++num_complemented_pis;
+      }
+    } );
+    num_found += num_complemented_pis == 2u ? 1u : 0u;
+  } );
+  return num_found >= 2u;
+}
+
+uint64_t fuzz( uint32_t num_workers, std::function<bool( aig_network )>&& fn )
+{
+  fuzz_tester_params ps;
+  ps.num_iterations = 100u;
+  ps.num_workers = num_workers;
+  ps.filename = "fuzz_tester_test.v";
+
+  random_network_generator_params_size ps_gen;
+  ps_gen.num_gates = 10u;
+  auto gen = random_aig_generator( ps_gen );
+  network_fuzz_tester<aig_network, decltype( gen )> fuzzer( gen, ps );
+  return fuzzer.run( std::move( fn ) );
+}
+
+} // namespace
+
+TEST_CASE( "Fuzz tester reports the first failing network", "[network_fuzz_tester]" )
+{
+  auto const expected = fuzz( 1u, []( aig_network ntk ) { return !has_nors_of_pis( ntk ); } );
+  REQUIRE( expected > 1u );
+
+  /* all networks before the failing one are generated and pass */
+  CHECK( fuzz( 2u, []( aig_network ntk ) { return !has_nors_of_pis( ntk ); } ) == expected );
+
+  aig_network aig;
+  REQUIRE( lorina::read_verilog( "fuzz_tester_test.v", verilog_reader( aig ) ) == lorina::return_code::success );
+  CHECK( has_nors_of_pis( aig ) );
+
+  /* crashes in the workers are reported as failures */
+  CHECK( fuzz( 2u, []( aig_network ntk ) {
+           if ( has_nors_of_pis( ntk ) )
+           {
+             std::signal( SIGABRT, SIG_DFL );
+             std::abort();
+           }
+           return true;
+         } ) == expected );
+
+  CHECK( fuzz( 2u, []( aig_network ) { return true; } ) == 0u );
+
+  std::remove( "fuzz_tester_test.v" );
+  std::remove( "fuzz_tester_test_0.v" );
+  std::remove( "fuzz_tester_test_1.v" );
+}
+
+#endif
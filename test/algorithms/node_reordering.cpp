@@ -0,0 +1,143 @@
+#include <catch.hpp>
+
+#include <kitty/static_truth_table.hpp>
+#include <mockturtle/algorithms/node_reordering.hpp>
+#include <mockturtle/algorithms/simulation.hpp>
+#include <mockturtle/networks/aig.hpp>
+#include <mockturtle/networks/mig.hpp>
+#include <mockturtle/networks/sequential.hpp>
+#include <mockturtle/networks/xag.hpp>
+#include <mockturtle/views/names_view.hpp>
+#include <mockturtle/views/topo_view.hpp>
+
+using namespace mockturtle;
+
+template<class Ntk>
+Ntk scrambled_network()
+{
+  Ntk ntk;
+  auto const a = ntk.create_pi();
+  auto const b = ntk.create_pi();
+  auto const c = ntk.create_pi();
+  auto const d = ntk.create_pi();
+
+  /* dangling and scattered gates */
+  ntk.create_and( a, d );
+  auto const g1 = ntk.create_and( a, b );
+  ntk.create_and( !b, d );
+  auto const g2 = ntk.create_and( c, d );
+  auto const g3 = ntk.create_xor( g1, g2 );
+  auto const g4 = ntk.create_and( g3, !a );
+  ntk.create_po( g4 );
+  ntk.create_po( ntk.create_or( g1, c ) );
+
+  /* the new node is created after its fanout */
+  auto const g5 = ntk.create_and( !b, !c );
+  ntk.substitute_node( ntk.get_node( g2 ), g5 );
+  return ntk;
+}
+
+template<class Ntk>
+void check_topological( Ntk const& ntk )
+{
+  ntk.foreach_gate( [&]( auto const& n ) {
+    ntk.foreach_fanin( n, [&]( auto const& f ) {
+      CHECK( ntk.node_to_index( ntk.get_node( f ) ) < ntk.node_to_index( n ) );
+    } );
+  } );
+}
+
+template<class Ntk>
+void test_node_reordering()
+{
+  auto const ntk = scrambled_network<Ntk>();
+  /* the index order of `ntk` is not topological */
+  auto const expected = simulate<kitty::static_truth_table<4>>( topo_view{ ntk } );
+
+  for ( auto strategy : { node_reordering_strategy::dfs, node_reordering_strategy::level, node_reordering_strategy::locality } )
+  {
+    node_reordering_params ps;
+    ps.strategy = strategy;
+    node_reordering_stats st;
+    auto const res = node_reordering( ntk, ps, &st );
+
+    CHECK( res.num_pis() == ntk.num_pis() );
+    CHECK( res.num_pos() == ntk.num_pos() );
+    CHECK( res.num_gates() < ntk.num_gates() );
+    CHECK( simulate<kitty::static_truth_table<4>>( res ) == expected );
+    check_topological( res );
+  }
+}
+
+TEST_CASE( "reorder nodes of different networks", "[node_reordering]" )
+{
+  test_node_reordering<aig_network>();
+  test_node_reordering<xag_network>();
+  test_node_reordering<mig_network>();
+}
+
+TEST_CASE( "DFS and level orders of node_reordering", "[node_reordering]" )
+{
+  aig_network aig;
+  auto const a = aig.create_pi();
+  auto const b = aig.create_pi();
+  auto const c = aig.create_pi();
+  auto const d = aig.create_pi();
+  auto const g1 = aig.create_and( a, b );
+  auto const g2 = aig.create_and( c, d );
+  auto const g3 = aig.create_and( g1, c );
+  auto const g4 = aig.create_and( g2, g3 );
+  aig.create_po( g4 );
+
+  node_reordering_params ps;
+  auto const dfs = node_reordering( aig, ps );
+  std::vector<uint32_t> num_gate_fanins;
+  dfs.foreach_gate( [&]( auto const& n ) {
+    uint32_t fanin_gates{ 0 };
+    dfs.foreach_fanin( n, [&]( auto const& f ) {
+      fanin_gates += dfs.is_ci( dfs.get_node( f ) ) ? 0u : 1u;
+    } );
+    num_gate_fanins.emplace_back( fanin_gates );
+  } );
+  /* DFS from the output visits g2 first: g2, g1, g3, g4 */
+  CHECK( num_gate_fanins == std::vector<uint32_t>{ 0u, 0u, 1u, 2u } );
+
+  ps.strategy = node_reordering_strategy::level;
+  auto const lvl = node_reordering( aig, ps );
+  depth_view d_lvl{ lvl };
+  uint32_t last_level{ 0 };
+  lvl.foreach_gate( [&]( auto const& n ) {
+    CHECK( d_lvl.level( n ) >= last_level );
+    last_level = d_lvl.level( n );
+  } );
+}
+
+TEST_CASE( "node_reordering keeps names and registers", "[node_reordering]" )
+{
+  names_view<sequential<aig_network>> ntk;
+  auto const a = ntk.create_pi();
+  auto const b = ntk.create_pi();
+  auto const r = ntk.create_ro();
+  ntk.set_name( a, "a" );
+  ntk.set_name( b, "b" );
+  ntk.set_name( r, "r" );
+
+  auto const g1 = ntk.create_and( a, r );
+  auto const g2 = ntk.create_and( b, !g1 );
+  ntk.set_name( g1, "g1" );
+  ntk.create_po( g2 );
+  ntk.create_ri( g1 );
+  ntk.set_output_name( 0, "y" );
+  ntk.set_output_name( 1, "r_in" );
+
+  auto const res = node_reordering( ntk );
+  CHECK( res.num_pis() == 2u );
+  CHECK( res.num_registers() == 1u );
+  CHECK( res.num_gates() == 2u );
+  CHECK( res.get_name( res.make_signal( res.pi_at( 0 ) ) ) == "a" );
+  CHECK( res.get_name( res.make_signal( res.pi_at( 1 ) ) ) == "b" );
+  CHECK( res.get_name( res.make_signal( res.ro_at( 0 ) ) ) == "r" );
+  CHECK( res.get_name( res.ri_at( 0 ) ) == "g1" );
+  CHECK( res.get_output_name( 0 ) == "y" );
+  CHECK( res.get_output_name( 1 ) == "r_in" );
+}
@@ -3,11 +3,15 @@
 #include <mockturtle/algorithms/cleanup.hpp>
 #include <mockturtle/algorithms/pattern_generation.hpp>
 #include <mockturtle/algorithms/simulation.hpp>
+#include <mockturtle/generators/arithmetic.hpp>
 #include <mockturtle/networks/aig.hpp>
 #include <mockturtle/networks/xag.hpp>
 
 #include <kitty/bit_operations.hpp>
 
+#include <algorithm>
+#include <vector>
+
 using namespace mockturtle;
 
 TEST_CASE( "Stuck-at pattern generation", "[pattern_generation]" )
@@ -117,3 +121,56 @@ TEST_CASE( "With observability awareness", "[pattern_generation]" )
   /* the generated pattern should be either 000, 010, or 101 */
   CHECK( ( ( !kitty::get_bit( sim.compute_pi( 0 ), 3 ) && !kitty::get_bit( sim.compute_pi( 2 ), 3 ) ) || ( kitty::get_bit( sim.compute_pi( 0 ), 3 ) && !kitty::get_bit( sim.compute_pi( 1 ), 3 ) && kitty::get_bit( sim.compute_pi( 2 ), 3 ) ) ) == true );
 }
+
+TEST_CASE( "Multi-threaded stuck-at pattern generation", "[pattern_generation]" )
+{
+  aig_network aig;
+  std::vector<aig_network::signal> a( 6u ), b( 6u );
+  std::generate( a.begin(), a.end(), [&]() { return aig.create_pi(); } );
+  std::generate( b.begin(), b.end(), [&]() { return aig.create_pi(); } );
+  auto const product = carry_ripple_multiplier( aig, a, b );
+  std::for_each( product.begin(), product.end(), [&]( auto const& f ) { aig.create_po( f ); } );
+
+  pattern_generation_params ps;
+  ps.num_stuck_at = 2;
+  ps.num_threads = 4;
+
+  partial_simulator sim( aig.num_pis(), 0 );
+  pattern_generation_stats st;
+  pattern_generation( aig, sim, ps, &st );
+  CHECK( sim.num_bits() == st.num_generated_patterns );
+  CHECK( st.num_generated_patterns > 0u );
+
+  /* every non-constant gate has at least two patterns for both values */
+  auto const tts = simulate_nodes<kitty::partial_truth_table>( aig, sim );
+  uint32_t num_constant{ 0u };
+  aig.foreach_gate( [&]( auto const& n ) {
+    auto const ones = kitty::count_ones( tts[n] );
+    if ( ones == 0u || ones == sim.num_bits() )
+    {
+      ++num_constant;
+    }
+    else
+    {
+      CHECK( ones >= 2u );
+      CHECK( sim.num_bits() - ones >= 2u );
+    }
+  } );
+  CHECK( num_constant == st.num_constant );
+
+  /* the result only depends on the number of threads */
+  partial_simulator sim2( aig.num_pis(), 0 );
+  pattern_generation( aig, sim2, ps );
+  CHECK( sim2.get_patterns() == sim.get_patterns() );
+
+  /* patterns with care bits are merged and packed */
+  bit_packed_simulator bsim( aig.num_pis(), 0 );
+  pattern_generation_stats bst;
+  pattern_generation( aig, bsim, ps, &bst );
+  CHECK( bst.num_generated_patterns == st.num_generated_patterns );
+  CHECK( bsim.num_bits() < bst.num_generated_patterns );
+
+  bit_packed_simulator bsim2( aig.num_pis(), 0 );
+  pattern_generation( aig, bsim2, ps );
+  CHECK( bsim2.get_patterns() == bsim.get_patterns() );
+}
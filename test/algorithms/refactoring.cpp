@@ -185,3 +185,29 @@ TEST_CASE( "Refactoring from inverted projection", "[refactoring]" )
     CHECK( mig.is_complemented( f ) );
   } );
 }
+
+TEST_CASE( "Refactoring of windows with more than 16 leaves", "[refactoring]" )
+{
+  xag_network xag;
+  std::vector<xag_network::signal> pis( 18u );
+  std::generate( pis.begin(), pis.end(), [&]() { return xag.create_pi(); } );
+  xag.create_po( xag.create_nary_and( pis ) );
+
+  refactoring_params ps;
+  ps.max_pis = 18u;
+
+  uint32_t max_vars{ 0u };
+  bool is_and{ false };
+  auto resyn = [&]( auto&, kitty::dynamic_truth_table const& tt, auto, auto, auto&& ) {
+    if ( tt.num_vars() > max_vars )
+    {
+      max_vars = tt.num_vars();
+      is_and = kitty::count_ones( tt ) == 1u && kitty::get_bit( tt, tt.num_bits() - 1u );
+    }
+  };
+  refactoring( xag, resyn, ps );
+
+  CHECK( max_vars == 18u );
+  CHECK( is_and );
+  CHECK( xag.num_gates() == 17u );
+}
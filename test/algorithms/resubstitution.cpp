@@ -6,6 +6,7 @@
 #include <mockturtle/io/write_verilog.hpp>
 #include <mockturtle/networks/aig.hpp>
 #include <mockturtle/networks/mig.hpp>
+#include <mockturtle/networks/xag.hpp>
 #include <mockturtle/networks/xmg.hpp>
 #include <mockturtle/traits.hpp>
 #include <mockturtle/views/depth_view.hpp>
@@ -548,3 +549,117 @@ TEST_CASE( "Simulation-guided resubstitution", "[resubstitution]" )
   CHECK( aig.num_pos() == 1 );
   CHECK( aig.num_gates() == 1 );
 }
+
+TEMPLATE_TEST_CASE( "Resubstitution of AIGs in all storage layouts", "[resubstitution]", aig_network, compact_aig_network, compact_cold_aig_network )
+{
+  TestType aig;
+  auto x0 = aig.create_pi();
+  auto x1 = aig.create_pi();
+  auto x2 = aig.create_pi();
+  auto x3 = aig.create_pi();
+  auto n0 = aig.create_and( !x2, x3 );
+  auto n1 = aig.create_and( !x2, n0 );
+  auto n2 = aig.create_and( x3, !n1 );
+  auto n3 = aig.create_and( x0, !x1 );
+  auto n4 = aig.create_and( !n2, n3 );
+  auto n5 = aig.create_and( x1, !n2 );
+  auto n6 = aig.create_and( !n4, !n5 );
+  auto n7 = aig.create_and( n1, n3 );
+  aig.create_po( n6 );
+  aig.create_po( n7 );
+
+  const auto tt = simulate<kitty::static_truth_table<4u>>( aig );
+  CHECK( aig.num_gates() == 8u );
+
+  using view_t = depth_view<fanout_view<TestType>>;
+  fanout_view<TestType> fanout_view{ aig };
+  view_t resub_view{ fanout_view };
+
+  resubstitution_params ps;
+  ps.max_inserts = 3;
+  aig_resubstitution2( resub_view, ps );
+  aig = cleanup_dangling( aig );
+
+  CHECK( simulate<kitty::static_truth_table<4u>>( aig ) == tt );
+  CHECK( aig.num_gates() == 6u );
+
+  sim_resubstitution( aig );
+  aig = cleanup_dangling( aig );
+
+  CHECK( simulate<kitty::static_truth_table<4u>>( aig ) == tt );
+  CHECK( aig.num_gates() <= 6u );
+}
+
+TEMPLATE_TEST_CASE( "Resubstitution of XAGs in all storage layouts", "[resubstitution]", xag_network, compact_xag_network, compact_cold_xag_network )
+{
+  TestType xag;
+
+  const auto a = xag.create_pi();
+  const auto b = xag.create_pi();
+  const auto c = xag.create_pi();
+
+  const auto f = xag.create_and( xag.create_or( xag.create_and( b, xag.create_not( a ) ), xag.create_and( xag.create_not( b ), a ) ), c );
+  xag.create_po( f );
+
+  const auto tt = simulate<kitty::static_truth_table<3u>>( xag );
+  CHECK( xag.num_gates() == 4u );
+
+  using view_t = depth_view<fanout_view<TestType>>;
+  fanout_view<TestType> fanout_view{ xag };
+  view_t resub_view{ fanout_view };
+
+  xag_resubstitution( resub_view );
+  xag = cleanup_dangling( xag );
+
+  CHECK( simulate<kitty::static_truth_table<3u>>( xag ) == tt );
+  CHECK( xag.num_gates() == 2u );
+
+  sim_resubstitution( xag );
+  xag = cleanup_dangling( xag );
+
+  CHECK( simulate<kitty::static_truth_table<3u>>( xag ) == tt );
+  CHECK( xag.num_gates() == 2u );
+}
+
+TEMPLATE_TEST_CASE( "Resubstitution of MIGs in all storage layouts", "[resubstitution]", mig_network, compact_mig_network, compact_cold_mig_network )
+{
+  const auto make_mig = []() {
+    TestType mig;
+    const auto a = mig.create_pi();
+    const auto b = mig.create_pi();
+    const auto c = mig.create_pi();
+    mig.create_po( mig.create_maj( a, mig.create_maj( a, b, c ), c ) );
+    return mig;
+  };
+
+  auto mig = make_mig();
+  const auto tt = simulate<kitty::static_truth_table<3u>>( mig );
+  CHECK( mig.num_gates() == 2u );
+
+  using view_t = depth_view<fanout_view<TestType>>;
+  fanout_view<TestType> fanout_mig{ mig };
+  view_t resub_view{ fanout_mig };
+
+  mig_resubstitution( resub_view );
+  mig = cleanup_dangling( mig );
+
+  CHECK( simulate<kitty::static_truth_table<3u>>( mig ) == tt );
+  CHECK( mig.num_gates() == 1u );
+
+  auto mig2 = make_mig();
+  fanout_view<TestType> fanout_mig2{ mig2 };
+  view_t resub_view2{ fanout_mig2 };
+
+  mig_resubstitution2( resub_view2 );
+  mig2 = cleanup_dangling( mig2 );
+
+  CHECK( simulate<kitty::static_truth_table<3u>>( mig2 ) == tt );
+  CHECK( mig2.num_gates() == 1u );
+
+  auto mig3 = make_mig();
+  sim_resubstitution( mig3 );
+  mig3 = cleanup_dangling( mig3 );
+
+  CHECK( simulate<kitty::static_truth_table<3u>>( mig3 ) == tt );
+  CHECK( mig3.num_gates() == 1u );
+}
@@ -1,5 +1,7 @@
 #include <catch.hpp>
 
+#include <numeric>
+
 #include <kitty/kitty.hpp>
 
 #include <mockturtle/algorithms/resyn_engines/xag_resyn.hpp>
@@ -14,14 +16,12 @@ template<class TT>
 struct aig_resyn_sparams_copy : public xag_resyn_static_params_default<TT>
 {
   static constexpr bool use_xor = false;
-  static constexpr bool copy_tts = true;
 };
 
 template<class TT>
 struct aig_resyn_sparams_no_copy : public xag_resyn_static_params_default<TT>
 {
   static constexpr bool use_xor = false;
-  static constexpr bool copy_tts = false;
 };
 
 template<class TT = kitty::partial_truth_table>
@@ -234,3 +234,58 @@ TEST_CASE( "Synthesize XAGs for all 4-input functions", "[xag_resyn]" )
   CHECK( success_counter == 54622 );
   CHECK( failed_counter == 10914 );
 }
+
+template<uint32_t NumVars>
+void test_fixed_width_xag_resyn()
+{
+  using static_tt = kitty::static_truth_table<NumVars>;
+  std::vector<static_tt> tts( 150u );
+  std::vector<kitty::partial_truth_table> ptts( 150u, kitty::partial_truth_table( 1u << NumVars ) );
+  for ( auto i = 0u; i < tts.size(); ++i )
+  {
+    kitty::create_random( tts[i], i );
+    std::copy( tts[i].cbegin(), tts[i].cend(), ptts[i].begin() );
+  }
+  std::vector<uint32_t> divs( tts.size() );
+  std::iota( divs.begin(), divs.end(), 0u );
+
+  xag_resyn_stats st;
+  xag_resyn_decompose<static_tt> engine( st );
+  xag_resyn_decompose<kitty::partial_truth_table> engine_partial( st );
+
+  uint32_t num_found{ 0u };
+  for ( auto k = 0u; k < 20u; ++k )
+  {
+    static_tt care;
+    kitty::create_random( care, 1000u + k );
+    static_tt const target = ( tts[k] & ~tts[k + 20u] ) | ( k % 2u ? tts[k + 40u] : ~tts[k + 40u] );
+    kitty::partial_truth_table ptarget( 1u << NumVars ), pcare( 1u << NumVars );
+    std::copy( target.cbegin(), target.cend(), ptarget.begin() );
+    std::copy( care.cbegin(), care.cend(), pcare.begin() );
+
+    auto const res = engine( target, care, divs.begin(), divs.end(), tts, 3u );
+    auto const res_partial = engine_partial( ptarget, pcare, divs.begin(), divs.end(), ptts, 3u );
+    REQUIRE( res.has_value() == res_partial.has_value() );
+    if ( !res )
+    {
+      continue;
+    }
+    ++num_found;
+    CHECK( res->raw() == res_partial->raw() );
+
+    xag_network xag;
+    decode( xag, *res );
+    partial_simulator sim( ptts );
+    auto const ans = simulate<kitty::partial_truth_table, xag_network, partial_simulator>( xag, sim )[0];
+    CHECK( kitty::implies( ptarget & pcare, ans ) );
+    CHECK( kitty::implies( ~ptarget & pcare, ~ans ) );
+  }
+  CHECK( num_found > 0u );
+}
+
+TEST_CASE( "XAG resynthesis with fixed-width truth tables", "[xag_resyn]" )
+{
+  test_fixed_width_xag_resyn<6u>();
+  test_fixed_width_xag_resyn<8u>();
+  test_fixed_width_xag_resyn<10u>();
+}
@@ -1,5 +1,6 @@
 #include <catch.hpp>
 
+#include <algorithm>
 #include <cstdint>
 #include <vector>
 
@@ -159,4 +160,105 @@ TEST_CASE( "Retime backward 3", "[retime]" )
 
   retime( ntk );
   CHECK( ntk.num_registers() == 3u );
-}
\ No newline at end of file
+}
+
+/* longest combinational path ending in a CO, computed with an explicit stack */
+static uint32_t clock_period( generic_network const& ntk )
+{
+  std::vector<uint32_t> levels( ntk.size(), UINT32_MAX );
+  std::vector<generic_network::node> stack;
+  uint32_t period = 0u;
+
+  ntk.foreach_node( [&]( auto const& root ) {
+    if ( !ntk.is_co( root ) )
+      return;
+
+    stack.push_back( root );
+    while ( !stack.empty() )
+    {
+      auto const n = stack.back();
+      if ( ntk.is_constant( n ) || ntk.is_ci( n ) )
+      {
+        levels[n] = 0u;
+        stack.pop_back();
+        continue;
+      }
+
+      uint32_t max_level = 0u;
+      bool ready = true;
+      ntk.foreach_fanin( n, [&]( auto const& f ) {
+        auto const m = ntk.get_node( f );
+        if ( levels[m] == UINT32_MAX )
+        {
+          ready = false;
+          stack.push_back( m );
+        }
+        else
+        {
+          max_level = std::max( max_level, levels[m] );
+        }
+      } );
+      if ( ready )
+      {
+        levels[n] = max_level + ( ntk.is_node( n ) ? 1u : 0u );
+        stack.pop_back();
+      }
+    }
+    period = std::max( period, levels[root] );
+  } );
+  return period;
+}
+
+TEST_CASE( "Retime forward with clock period constraint", "[retime]" )
+{
+  generic_network ntk;
+  const auto a = ntk.create_pi();
+  const auto b = ntk.create_pi();
+  const auto x1 = ntk.create_not( a );
+  const auto x2 = ntk.create_not( b );
+  const auto b1 = create_register_box( ntk, x1 );
+  const auto b2 = create_register_box( ntk, x2 );
+  const auto f = ntk.create_and( b1, b2 );
+
+  ntk.create_po( f );
+
+  CHECK( clock_period( ntk ) == 1u );
+
+  retime_params ps;
+  ps.max_period = 1u;
+  retime( ntk, ps );
+  CHECK( ntk.num_registers() == 2u );
+  CHECK( clock_period( ntk ) == 1u );
+
+  ps.max_period = 2u;
+  retime( ntk, ps );
+  CHECK( ntk.num_registers() == 1u );
+  CHECK( clock_period( ntk ) == 2u );
+}
+
+TEST_CASE( "Retime backward with clock period constraint", "[retime]" )
+{
+  generic_network ntk;
+  const auto a = ntk.create_pi();
+  const auto x1 = ntk.create_not( a );
+  const auto x2 = ntk.create_buf( a );
+
+  const auto b1 = create_register_box( ntk, x1 );
+  const auto b2 = create_register_box( ntk, x2 );
+
+  ntk.create_po( ntk.create_not( b1 ) );
+  ntk.create_po( ntk.create_not( b2 ) );
+
+  CHECK( clock_period( ntk ) == 1u );
+
+  retime_params ps;
+  ps.max_period = 1u;
+  retime( ntk, ps );
+  CHECK( ntk.num_registers() == 2u );
+  CHECK( clock_period( ntk ) == 1u );
+
+  ps.max_period = 2u;
+  retime( ntk, ps );
+  CHECK( ntk.num_registers() == 1u );
+  CHECK( clock_period( ntk ) == 2u );
+}
@@ -1,5 +1,12 @@
 #include <catch.hpp>
 
+#include <fmt/format.h>
+#include <lorina/aiger.hpp>
+#include <mockturtle/algorithms/balancing.hpp>
+#include <mockturtle/algorithms/balancing/sop_balancing.hpp>
+#include <mockturtle/algorithms/cleanup.hpp>
+#include <mockturtle/algorithms/equivalence_checking.hpp>
+#include <mockturtle/algorithms/miter.hpp>
 #include <mockturtle/algorithms/rewrite.hpp>
 #include <mockturtle/algorithms/node_resynthesis/mig_npn.hpp>
 #include <mockturtle/algorithms/node_resynthesis/xag_npn.hpp>
@@ -8,8 +15,10 @@
 #include <mockturtle/networks/xag.hpp>
 #include <mockturtle/networks/mig.hpp>
 #include <mockturtle/networks/xmg.hpp>
+#include <mockturtle/io/aiger_reader.hpp>
 #include <mockturtle/traits.hpp>
 #include <mockturtle/utils/cost_functions.hpp>
+#include <mockturtle/utils/cut_store.hpp>
 #include <mockturtle/utils/tech_library.hpp>
 #include <mockturtle/views/fanout_view.hpp>
 
@@ -216,3 +225,65 @@ TEST_CASE( "Rewrite depth-preserving", "[rewrite]" )
   CHECK( aig.num_pos() == 2 );
   CHECK( aig.num_gates() == 8 );
 }
+
+TEST_CASE( "Rewrite with don't cares on benchmarks", "[rewrite]" )
+{
+  xag_npn_resynthesis<aig_network, aig_network, xag_npn_db_kind::aig_complete> resyn;
+  exact_library_params eps;
+  eps.np_classification = false;
+  exact_library<aig_network> exact_lib( resyn, eps );
+
+  /* the windows are expanded in the order of their level, as before the
+   * don't care manager was introduced, and lead to the same results */
+  auto const check = [&]( std::string const& benchmark, uint32_t num_gates ) {
+    aig_network aig;
+    REQUIRE( lorina::read_aiger( fmt::format( "{}/{}.aig", BENCHMARKS_PATH, benchmark ), aiger_reader( aig ) ) == lorina::return_code::success );
+
+    rewrite_params ps;
+    ps.use_dont_cares = true;
+    rewrite( aig, exact_lib, ps );
+    aig = cleanup_dangling( aig );
+
+    CHECK( aig.num_gates() == num_gates );
+  };
+
+  check( "c432", 178u );
+  check( "c880", 312u );
+  check( "c1908", 318u );
+}
+
+TEST_CASE( "Rewrite and balancing with a shared cut store", "[rewrite]" )
+{
+  xag_npn_resynthesis<aig_network, aig_network, xag_npn_db_kind::aig_complete> resyn;
+  exact_library_params eps;
+  eps.np_classification = false;
+  exact_library<aig_network> exact_lib( resyn, eps );
+
+  aig_network original, reference, aig;
+  for ( auto* ntk : { &original, &reference, &aig } )
+  {
+    REQUIRE( lorina::read_aiger( fmt::format( "{}/c432.aig", BENCHMARKS_PATH ), aiger_reader( *ntk ) ) == lorina::return_code::success );
+  }
+
+  rewrite_params ps;
+  rewrite( reference, exact_lib, ps );
+
+  fanout_view<aig_network> fanout_aig{ aig };
+  cut_store<fanout_view<aig_network>, 4u, cut_enumeration_rewrite_cut> cuts( fanout_aig, ps.cut_enumeration_ps );
+  rewrite( aig, exact_lib, cuts, ps );
+  CHECK( aig.num_gates() == reference.num_gates() );
+
+  /* the second pass finds the cuts left by rewrite in the store */
+  auto const enumerated_cuts = cuts.stats().enumerated_cuts;
+  balancing_params bps;
+  auto const balanced = balancing( aig, { sop_rebalancing<aig_network>{} }, cuts, bps );
+  CHECK( cuts.stats().reused > 0u );
+  CHECK( cuts.stats().enumerated_cuts == enumerated_cuts );
+  CHECK( *equivalence_checking( *miter<aig_network>( original, balanced ) ) );
+
+  /* a second rewrite finds the NPN classes of all cut functions in the store */
+  auto const npn_computed = cuts.stats().npn_computed;
+  rewrite( aig, exact_lib, cuts, ps );
+  CHECK( cuts.stats().npn_computed == npn_computed );
+  CHECK( *equivalence_checking( *miter<aig_network>( original, aig ) ) );
+}
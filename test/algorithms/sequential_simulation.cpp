@@ -0,0 +1,165 @@
+#include <catch.hpp>
+
+#include <mockturtle/algorithms/sequential_simulation.hpp>
+#include <mockturtle/networks/aig.hpp>
+#include <mockturtle/networks/mig.hpp>
+#include <mockturtle/networks/sequential.hpp>
+#include <mockturtle/networks/xag.hpp>
+
+using namespace mockturtle;
+
+TEST_CASE( "simulate a shift register with initial values", "[sequential_simulation]" )
+{
+  sequential<aig_network> aig;
+  auto const a = aig.create_pi();
+  auto const x0 = aig.create_ro();
+  auto const x1 = aig.create_ro();
+  auto const x2 = aig.create_ro();
+  aig.create_po( x2 );
+  aig.create_po( aig.create_and( a, x2 ) );
+  aig.create_ri( !x2 );
+  aig.create_ri( x0 );
+  aig.create_ri( x1 );
+
+  mockturtle::register_t reg;
+  reg.init = 1;
+  aig.set_register( 2, reg );
+  reg.init = 0;
+  aig.set_register( 0, reg );
+  aig.set_register( 1, reg );
+
+  sequential_simulation_params ps;
+  ps.num_words = 2u;
+  sequential_simulator sim( aig, ps );
+
+  /* x2 -> ~x0 -> x1 -> x2 is a ring of three registers with one inversion */
+  std::vector<uint64_t> const expected = { 1u, 0u, 0u, 0u, 1u, 1u, 1u, 0u, 0u };
+  for ( auto c = 0u; c < expected.size(); ++c )
+  {
+    sim.step( []( uint64_t, uint32_t, uint32_t ) { return ~uint64_t( 0 ); } );
+    for ( auto w = 0u; w < 2u; ++w )
+    {
+      CHECK( sim.po_value( 0, w ) == ( expected[c] ? ~uint64_t( 0 ) : 0u ) );
+      CHECK( sim.po_value( 1, w ) == ( expected[c] ? ~uint64_t( 0 ) : 0u ) );
+    }
+  }
+  CHECK( sim.stats().num_cycles == expected.size() );
+
+  sim.reset();
+  sim.step( []( uint64_t, uint32_t, uint32_t ) { return uint64_t( 0 ); } );
+  CHECK( sim.po_value( 0, 0 ) == ~uint64_t( 0 ) );
+  CHECK( sim.po_value( 1, 0 ) == 0u );
+  CHECK( sim.ri_value( 2, 0 ) == 0u );
+}
+
+TEST_CASE( "simulate independent traces of an accumulator", "[sequential_simulation]" )
+{
+  sequential<xag_network> xag;
+  auto const a = xag.create_pi();
+  auto const s = xag.create_ro();
+  auto const next = xag.create_xor( a, s );
+  xag.create_po( next );
+  xag.create_ri( next );
+
+  mockturtle::register_t reg;
+  reg.init = 0;
+  xag.set_register( 0, reg );
+
+  auto const input = []( uint64_t cycle, uint32_t, uint32_t word ) {
+    return detail::trace_random_word( 42u, cycle, 0u, word );
+  };
+
+  sequential_simulation_params ps;
+  ps.num_words = 3u;
+  ps.count_toggles = true;
+  sequential_simulator sim( xag, ps );
+
+  std::vector<uint64_t> state( 3u, 0u );
+  uint64_t expected_toggles{ 0u };
+  for ( auto c = 0u; c < 20u; ++c )
+  {
+    sim.step( input );
+    for ( auto w = 0u; w < 3u; ++w )
+    {
+      if ( c > 0u )
+      {
+        expected_toggles += __builtin_popcountll( input( c, 0u, w ) );
+      }
+      state[w] ^= input( c, 0u, w );
+      CHECK( sim.po_value( 0, w ) == state[w] );
+    }
+  }
+
+  /* the output toggles whenever the input is 1 */
+  auto const toggles = sim.toggles();
+  CHECK( toggles[xag.node_to_index( xag.get_node( next ) )] == expected_toggles );
+  CHECK( sim.signature( next )._bits == state );
+}
+
+TEST_CASE( "sequential simulation does not depend on the number of threads", "[sequential_simulation]" )
+{
+  sequential<mig_network> mig;
+  auto const a = mig.create_pi();
+  auto const b = mig.create_pi();
+  auto const r0 = mig.create_ro();
+  auto const r1 = mig.create_ro();
+  auto const r2 = mig.create_ro();
+  auto const m = mig.create_maj( a, r0, !r1 );
+  auto const n = mig.create_maj( b, m, r2 );
+  mig.create_po( n );
+  mig.create_po( !m );
+  mig.create_ri( n );
+  mig.create_ri( m );
+  mig.create_ri( !r0 );
+
+  mockturtle::register_t reg;
+  reg.init = 1;
+  mig.set_register( 1, reg );
+
+  sequential_simulation_params ps;
+  ps.num_words = 7u;
+  ps.count_toggles = true;
+
+  sequential_simulator sim1( mig, ps );
+  std::vector<uint64_t> outputs1;
+  sim1.run( 50u, [&]( uint32_t, auto const& block ) {
+    for ( auto w = 0u; w < block.num_words(); ++w )
+    {
+      outputs1.emplace_back( block.po_value( 0, w ) ^ block.previous_value( mig.make_signal( mig.get_node( m ) ), w ) );
+    }
+  } );
+
+  ps.num_threads = 3u;
+  sequential_simulator sim3( mig, ps );
+  CHECK( sim3.stats().num_blocks == 3u );
+
+  std::vector<std::vector<uint64_t>> outputs3( 3u );
+  sim3.run( 20u, [&]( uint32_t, auto const& block ) {
+    auto& out = outputs3[block.first_word() == 0u ? 0u : ( block.first_word() < 4u ? 1u : 2u )];
+    for ( auto w = 0u; w < block.num_words(); ++w )
+    {
+      out.emplace_back( block.po_value( 0, w ) ^ block.previous_value( mig.make_signal( mig.get_node( m ) ), w ) );
+    }
+  } );
+  for ( auto c = 0u; c < 30u; ++c )
+  {
+    sim3.step();
+  }
+
+  CHECK( sim1.toggles() == sim3.toggles() );
+  CHECK( sim1.switching_activities() == sim3.switching_activities() );
+  CHECK( sim1.signature( n ) == sim3.signature( n ) );
+  CHECK( sim1.signature( m ) == sim3.signature( m ) );
+
+  /* the first 20 cycles, reordered by block */
+  std::vector<uint64_t> reordered;
+  for ( auto c = 0u; c < 20u; ++c )
+  {
+    for ( auto const& out : outputs3 )
+    {
+      auto const words = out.size() / 20u;
+      reordered.insert( reordered.end(), out.begin() + c * words, out.begin() + ( c + 1u ) * words );
+    }
+  }
+  CHECK( std::equal( reordered.begin(), reordered.end(), outputs1.begin() ) );
+}
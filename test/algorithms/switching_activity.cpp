@@ -0,0 +1,113 @@
+#include <catch.hpp>
+
+#include <cmath>
+#include <vector>
+
+#include <kitty/constructors.hpp>
+#include <kitty/partial_truth_table.hpp>
+#include <mockturtle/algorithms/switching_activity.hpp>
+#include <mockturtle/networks/aig.hpp>
+#include <mockturtle/networks/klut.hpp>
+
+using namespace mockturtle;
+
+TEST_CASE( "switching activity from an input trace", "[switching_activity]" )
+{
+  aig_network aig;
+  auto const a = aig.create_pi();
+  auto const b = aig.create_pi();
+  auto const f1 = aig.create_and( a, b );
+  auto const f2 = aig.create_and( !a, !b );
+  aig.create_po( f1 );
+  aig.create_po( f2 );
+
+  /* cycle:  0 1 2 3 4 5 6 7
+   * a:      0 1 1 0 0 1 1 0
+   * b:      0 0 1 1 0 0 1 1
+   * a & b:  0 0 1 0 0 0 1 0
+   * !a & !b 1 0 0 0 1 0 0 0 */
+  std::vector<kitty::partial_truth_table> trace( 2u, kitty::partial_truth_table( 8u ) );
+  kitty::create_from_binary_string( trace[0], "01100110" );
+  kitty::create_from_binary_string( trace[1], "11001100" );
+
+  switching_activity_engine engine( aig );
+  engine.set_input_trace( trace );
+
+  CHECK( engine.activity( aig.get_node( a ) ) == Approx( 4.0 / 7.0 ) );
+  CHECK( engine.activity( aig.get_node( b ) ) == Approx( 3.0 / 7.0 ) );
+  CHECK( engine.activity( aig.get_node( f1 ) ) == Approx( 4.0 / 7.0 ) );
+  CHECK( engine.activity( aig.get_node( f2 ) ) == Approx( 3.0 / 7.0 ) );
+  CHECK( engine.activity( aig.get_node( aig.get_constant( false ) ) ) == 0.0f );
+  CHECK( engine.stats().num_updates == 1u );
+
+  /* the activities are cached until the network changes */
+  engine.activities();
+  CHECK( engine.stats().num_updates == 1u );
+  auto const f3 = aig.create_and( f1, !f2 );
+  aig.create_po( f3 );
+  CHECK( engine.activity( aig.get_node( f3 ) ) == Approx( 4.0 / 7.0 ) );
+  CHECK( engine.stats().num_updates == 2u );
+
+  CHECK( !engine.read_input_trace( "missing_trace_file.pat" ) );
+}
+
+TEST_CASE( "switching activity in parallel blocks", "[switching_activity]" )
+{
+  klut_network klut;
+  std::vector<klut_network::signal> fs;
+  for ( auto i = 0u; i < 8u; ++i )
+  {
+    fs.emplace_back( klut.create_pi() );
+  }
+  for ( auto i = 0u; i < 40u; ++i )
+  {
+    auto const x = fs[( 7u * i + 3u ) % fs.size()];
+    auto const y = fs[( 5u * i + 1u ) % fs.size()];
+    auto const z = fs[( 3u * i + 2u ) % fs.size()];
+    fs.emplace_back( i % 2u == 0u ? klut.create_maj( x, y, z ) : klut.create_xor( x, y ) );
+  }
+  klut.create_po( fs.back() );
+
+  switching_activity_params ps;
+  ps.num_cycles = 1000u;
+  auto const expected = compute_switching_activity( klut, ps );
+
+  for ( auto num_threads : { 2u, 3u, 8u } )
+  {
+    ps.num_threads = num_threads;
+    switching_activity_stats st;
+    auto const activities = compute_switching_activity( klut, ps, &st );
+    CHECK( st.num_blocks > 1u );
+    CHECK( activities == expected );
+  }
+}
+
+TEST_CASE( "switching activity with input statistics", "[switching_activity]" )
+{
+  aig_network aig;
+  auto const a = aig.create_pi();
+  auto const b = aig.create_pi();
+  auto const f = aig.create_and( a, b );
+  aig.create_po( f );
+
+  switching_activity_params ps;
+  ps.num_cycles = 1u << 16;
+
+  /* uncorrelated uniform inputs */
+  auto activities = compute_switching_activity( aig, ps );
+  CHECK( std::abs( activities[aig.node_to_index( aig.get_node( a ) )] - 0.5 ) < 0.02 );
+  CHECK( std::abs( activities[aig.node_to_index( aig.get_node( f ) )] - 0.375 ) < 0.02 );
+
+  /* slowly changing inputs with the same signal probability */
+  ps.input_toggle_rates = { 0.1, 0.1 };
+  activities = compute_switching_activity( aig, ps );
+  CHECK( std::abs( activities[aig.node_to_index( aig.get_node( a ) )] - 0.1 ) < 0.01 );
+  CHECK( std::abs( activities[aig.node_to_index( aig.get_node( b ) )] - 0.1 ) < 0.01 );
+  CHECK( activities[aig.node_to_index( aig.get_node( f ) )] < 0.15 );
+
+  /* biased inputs */
+  ps.input_probabilities = { 0.9, 0.9 };
+  ps.input_toggle_rates = {};
+  activities = compute_switching_activity( aig, ps );
+  CHECK( std::abs( activities[aig.node_to_index( aig.get_node( a ) )] - 0.18 ) < 0.02 );
+}
@@ -0,0 +1,106 @@
+#ifndef _MSC_VER
+
+#include <catch.hpp>
+
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include <lorina/verilog.hpp>
+#include <mockturtle/algorithms/testcase_minimizer.hpp>
+#include <mockturtle/io/verilog_reader.hpp>
+#include <mockturtle/io/write_verilog.hpp>
+#include <mockturtle/networks/aig.hpp>
+
+using namespace mockturtle;
+
+namespace
+{
+
+/* the buggy behavior to be found: two gates with two complemented primary inputs each */
+bool has_nors_of_pis( aig_network const& aig )
+{
+  uint32_t num_found{ 0u };
+  aig.foreach_gate( [&]( auto const& n ) {
+    uint32_t num_complemented_pis{ 0u };
+    aig.foreach_fanin( n, [&]( auto const& f ) {
+      if ( aig.is_complemented( f ) && aig.is_pi( aig.get_node( f ) ) )
+      {
+        ++num_complemented_pis;
+      }
+    } );
+    num_found += num_complemented_pis == 2u ? 1u : 0u;
+  } );
+  return num_found >= 2u;
+}
+
+/* XOR logic around the two NOR gates triggering the buggy behavior */
+void write_initial_testcase()
+{
+  aig_network aig;
+  std::vector<aig_network::signal> pis;
+  for ( auto i = 0u; i < 6u; ++i )
+  {
+    pis.emplace_back( aig.create_pi() );
+  }
+
+  auto const x1 = aig.create_xor( pis[0], pis[1] );
+  auto const x2 = aig.create_xor( pis[2], pis[3] );
+  auto const x3 = aig.create_xor( x1, pis[4] );
+  aig.create_po( aig.create_and( x3, aig.create_nor( pis[0], pis[5] ) ) );
+  aig.create_po( aig.create_or( x2, aig.create_nor( pis[2], pis[4] ) ) );
+  aig.create_po( aig.create_xor( x2, x3 ) );
+  REQUIRE( aig.num_gates() == 16u );
+  REQUIRE( has_nors_of_pis( aig ) );
+
+  write_verilog( aig, "./minimizer_test.v" );
+}
+
+aig_network minimize( std::function<bool( aig_network )> const& fn )
+{
+  write_initial_testcase();
+
+  testcase_minimizer_params ps;
+  ps.path = ".";
+  ps.init_case = "minimizer_test";
+  ps.minimized_case = "minimizer_test_min";
+  ps.num_iterations_stage = 20u;
+  ps.num_workers = 2u;
+  testcase_minimizer<aig_network> minimizer( ps );
+  minimizer.run( fn );
+
+  aig_network aig;
+  REQUIRE( lorina::read_verilog( "./minimizer_test_min.v", verilog_reader( aig ) ) == lorina::return_code::success );
+
+  std::remove( "./minimizer_test.v" );
+  std::remove( "./minimizer_test_min.v" );
+  return aig;
+}
+
+} // namespace
+
+TEST_CASE( "Minimize a failing testcase with parallel workers", "[testcase_minimizer]" )
+{
+  auto const aig = minimize( []( aig_network ntk ) { return !has_nors_of_pis( ntk ); } );
+  CHECK( has_nors_of_pis( aig ) );
+  CHECK( aig.num_gates() == 2u );
+}
+
+TEST_CASE( "Minimize a crashing testcase with parallel workers", "[testcase_minimizer]" )
+{
+  auto const aig = minimize( []( aig_network ntk ) {
+    if ( has_nors_of_pis( ntk ) )
+    {
+      std::signal( SIGABRT, SIG_DFL );
+      std::abort();
+    }
+    return true;
+  } );
+  CHECK( has_nors_of_pis( aig ) );
+  CHECK( aig.num_gates() == 2u );
+}
+
+#endif
@@ -0,0 +1,152 @@
+#include <catch.hpp>
+
+#include <random>
+
+#include <kitty/dynamic_truth_table.hpp>
+#include <kitty/static_truth_table.hpp>
+#include <mockturtle/algorithms/collapse_mapped.hpp>
+#include <mockturtle/algorithms/lut_mapping.hpp>
+#include <mockturtle/algorithms/reconv_cut.hpp>
+#include <mockturtle/algorithms/simulation.hpp>
+#include <mockturtle/algorithms/window_simulation.hpp>
+#include <mockturtle/networks/aig.hpp>
+#include <mockturtle/networks/klut.hpp>
+#include <mockturtle/networks/mig.hpp>
+#include <mockturtle/networks/xag.hpp>
+#include <mockturtle/networks/xmg.hpp>
+#include <mockturtle/views/cut_view.hpp>
+#include <mockturtle/views/mapping_view.hpp>
+
+using namespace mockturtle;
+
+template<class Ntk>
+Ntk random_network( uint32_t num_pis, uint32_t num_gates, uint32_t seed )
+{
+  std::mt19937 rng( seed );
+  Ntk ntk;
+  std::vector<typename Ntk::signal> fs;
+  for ( auto i = 0u; i < num_pis; ++i )
+  {
+    fs.emplace_back( ntk.create_pi() );
+  }
+  auto const pick = [&]() {
+    auto const f = fs[std::uniform_int_distribution<std::size_t>( 0u, fs.size() - 1u )( rng )];
+    return ( rng() & 1u ) ? !f : f;
+  };
+  while ( ntk.num_gates() < num_gates )
+  {
+    auto const a = pick(), b = pick(), c = pick();
+    switch ( rng() % 4u )
+    {
+    case 0u:
+      fs.emplace_back( ntk.create_and( a, b ) );
+      break;
+    case 1u:
+      fs.emplace_back( ntk.create_xor( a, b ) );
+      break;
+    case 2u:
+      fs.emplace_back( ntk.create_maj( a, b, c ) );
+      break;
+    default:
+      fs.emplace_back( ntk.create_or( a, ntk.get_constant( ( rng() & 1u ) != 0u ) ) );
+      break;
+    }
+  }
+  for ( auto i = fs.size() - 10u; i < fs.size(); ++i )
+  {
+    ntk.create_po( fs[i] );
+  }
+  return ntk;
+}
+
+template<class Ntk>
+void test_window_simulation( Ntk const& ntk )
+{
+  batched_window_simulator<Ntk> sim( ntk );
+  std::vector<std::vector<kitty::dynamic_truth_table>> expected;
+
+  for ( auto round = 0u; round < 2u; ++round )
+  {
+    sim.clear();
+    expected.clear();
+
+    ntk.foreach_gate( [&]( auto const& n, auto i ) {
+      if ( i % 3u != round )
+      {
+        return;
+      }
+      reconvergence_driven_cut_parameters ps;
+      ps.max_leaves = 4u + i % 13u;
+      auto const leaves = reconvergence_driven_cut<Ntk, false, false>( ntk, std::vector<typename Ntk::node>{ n }, ps ).first;
+
+      std::vector<typename Ntk::signal> roots{ ntk.make_signal( n ) };
+      ntk.foreach_fanin( n, [&]( auto const& f ) {
+        roots.emplace_back( !f );
+      } );
+
+      auto const window = sim.add_window( leaves, roots );
+      CHECK( window == expected.size() );
+
+      expected.emplace_back();
+      for ( auto const& r : roots )
+      {
+        cut_view<Ntk> cut( ntk, leaves, r );
+        default_simulator<kitty::dynamic_truth_table> cut_sim( static_cast<uint32_t>( leaves.size() ) );
+        expected.back().emplace_back( simulate<kitty::dynamic_truth_table>( cut, cut_sim )[0] );
+      }
+    } );
+
+    sim.run( round + 1u );
+
+    CHECK( sim.num_windows() == expected.size() );
+    for ( auto w = 0u; w < sim.num_windows(); ++w )
+    {
+      CHECK( sim.num_roots( w ) == expected[w].size() );
+      for ( auto r = 0u; r < sim.num_roots( w ); ++r )
+      {
+        CHECK( sim.root_function( w, r ) == expected[w][r] );
+      }
+    }
+  }
+}
+
+TEST_CASE( "Batched window simulation of different networks", "[window_simulation]" )
+{
+  test_window_simulation( random_network<aig_network>( 20u, 300u, 1u ) );
+  test_window_simulation( random_network<xag_network>( 20u, 300u, 2u ) );
+  test_window_simulation( random_network<mig_network>( 20u, 300u, 3u ) );
+  test_window_simulation( random_network<xmg_network>( 20u, 300u, 4u ) );
+
+  mapping_view<aig_network, true> mapped{ random_network<aig_network>( 20u, 300u, 5u ) };
+  lut_mapping<mapping_view<aig_network, true>, true>( mapped );
+  test_window_simulation( *collapse_mapped_network<klut_network>( mapped ) );
+}
+
+TEST_CASE( "Window functions as static truth tables", "[window_simulation]" )
+{
+  xag_network xag;
+  auto const a = xag.create_pi();
+  auto const b = xag.create_pi();
+  auto const c = xag.create_pi();
+  auto const f1 = xag.create_and( a, !b );
+  auto const f2 = xag.create_xor( f1, c );
+  xag.create_po( f2 );
+
+  batched_window_simulator<xag_network> sim( xag );
+  auto const w1 = sim.add_window( { xag.get_node( a ), xag.get_node( b ), xag.get_node( c ) }, { f2, !f1 } );
+  auto const w2 = sim.add_window( { xag.get_node( f1 ), xag.get_node( c ) }, { f2 } );
+  sim.run();
+
+  kitty::static_truth_table<3> x, y, z;
+  kitty::create_nth_var( x, 0 );
+  kitty::create_nth_var( y, 1 );
+  kitty::create_nth_var( z, 2 );
+  CHECK( sim.root_function<kitty::static_truth_table<3>>( w1, 0 ) == ( ( x & ~y ) ^ z ) );
+  CHECK( sim.root_function<kitty::static_truth_table<3>>( w1, 1 ) == ~( x & ~y ) );
+
+  kitty::static_truth_table<2> u, v;
+  kitty::create_nth_var( u, 0 );
+  kitty::create_nth_var( v, 1 );
+  CHECK( sim.num_leaves( w2 ) == 2u );
+  CHECK( sim.root_function<kitty::static_truth_table<2>>( w2, 0 ) == ( u ^ v ) );
+}
@@ -0,0 +1,165 @@
+#include <catch.hpp>
+
+#include <sstream>
+#include <string>
+
+#include <mockturtle/algorithms/simulation.hpp>
+#include <mockturtle/io/blif_reader.hpp>
+#include <mockturtle/io/fast_blif_reader.hpp>
+#include <mockturtle/io/write_blif.hpp>
+#include <mockturtle/networks/cover.hpp>
+#include <mockturtle/networks/klut.hpp>
+#include <mockturtle/networks/sequential.hpp>
+#include <mockturtle/views/names_view.hpp>
+
+#include <kitty/kitty.hpp>
+#include <lorina/blif.hpp>
+
+using namespace mockturtle;
+
+TEST_CASE( "read a combinational BLIF file with the fast reader", "[fast_blif_reader]" )
+{
+  names_view<klut_network> klut;
+
+  std::string file{
+      "# comment\n"
+      ".model top\n"
+      ".inputs a b \\\n"
+      "  c\n"
+      ".outputs y1 y2\n"
+      ".names c n1 n2 # gates are not in topological order\n"
+      "1- 1\n"
+      "-1 1\n"
+      ".names a b n1\n"
+      "11 1\n"
+      ".names n2 y1\n"
+      "0 1\n"
+      ".names n2 y2\n"
+      "1 1\n"
+      ".names one\n"
+      "1\n"
+      ".end\n" };
+
+  auto const result = read_blif_fast_from_buffer( file, klut );
+
+  CHECK( result == lorina::return_code::success );
+  CHECK( klut.num_pis() == 3 );
+  CHECK( klut.num_pos() == 2 );
+  CHECK( klut.num_gates() == 4 );
+  CHECK( klut.get_network_name() == "top" );
+  CHECK( klut.get_name( klut.make_signal( klut.pi_at( 2 ) ) ) == "c" );
+  CHECK( klut.get_output_name( 1 ) == "y2" );
+
+  default_simulator<kitty::dynamic_truth_table> sim( klut.num_pis() );
+  auto const tts = simulate<kitty::dynamic_truth_table>( klut, sim );
+  CHECK( kitty::to_hex( tts[0] ) == "07" );
+  CHECK( kitty::to_hex( tts[1] ) == "f8" );
+}
+
+TEST_CASE( "read BLIF files with max terms and constants with the fast reader", "[fast_blif_reader]" )
+{
+  std::string file{
+      ".model top\n"
+      ".inputs a b c\n"
+      ".outputs y1 y2 y3\n"
+      ".names a b c y1\n"
+      "00- 0\n"
+      "1-1 0\n"
+      ".names y2\n"
+      ".names y3\n"
+      "1\n"
+      ".end\n" };
+
+  klut_network klut;
+  cover_network cover;
+  CHECK( read_blif_fast_from_buffer( file, klut ) == lorina::return_code::success );
+  CHECK( read_blif_fast_from_buffer( file, cover ) == lorina::return_code::success );
+
+  for ( auto const& tts : { simulate<kitty::dynamic_truth_table>( klut, default_simulator<kitty::dynamic_truth_table>( 3u ) ),
+                            simulate<kitty::dynamic_truth_table>( cover, default_simulator<kitty::dynamic_truth_table>( 3u ) ) } )
+  {
+    CHECK( kitty::to_hex( tts[0] ) == "4e" );
+    CHECK( kitty::to_hex( tts[1] ) == "00" );
+    CHECK( kitty::to_hex( tts[2] ) == "ff" );
+  }
+}
+
+TEST_CASE( "read a sequential BLIF file with the fast reader", "[fast_blif_reader]" )
+{
+  sequential<klut_network> klut, klut_lorina;
+
+  std::string file{
+      ".model top\n"
+      ".inputs a b\n"
+      ".outputs y\n"
+      ".latch n1 s1 re clk 0\n"
+      ".latch n2 s2 1\n"
+      ".names a s1 n1\n"
+      "11 1\n"
+      ".names b s2 n2\n"
+      "1- 1\n"
+      "-1 1\n"
+      ".names n1 n2 y\n"
+      "10 1\n"
+      ".end\n" };
+
+  CHECK( read_blif_fast_from_buffer( file, klut ) == lorina::return_code::success );
+  std::istringstream in( file );
+  CHECK( lorina::read_blif( in, blif_reader( klut_lorina ) ) == lorina::return_code::success );
+
+  CHECK( klut.num_pis() == 2 );
+  CHECK( klut.num_pos() == 1 );
+  CHECK( klut.num_registers() == 2 );
+  CHECK( klut.num_gates() == klut_lorina.num_gates() );
+  CHECK( klut.register_at( 0 ).control == "clk" );
+  CHECK( klut.register_at( 0 ).init == 0 );
+  CHECK( klut.register_at( 1 ).type == "re" );
+  CHECK( klut.register_at( 1 ).init == 1 );
+
+  klut.foreach_gate( [&]( auto const& n ) {
+    CHECK( klut.node_function( n ) == klut_lorina.node_function( n ) );
+  } );
+}
+
+TEST_CASE( "fast BLIF reader reports errors", "[fast_blif_reader]" )
+{
+  klut_network klut1, klut2, klut3;
+
+  /* undefined signal */
+  CHECK( read_blif_fast_from_buffer( ".model top\n.inputs a\n.outputs y\n.names a b y\n11 1\n.end\n", klut1 ) == lorina::return_code::parse_error );
+
+  /* combinational cycle */
+  CHECK( read_blif_fast_from_buffer( ".model top\n.inputs a\n.outputs y\n.names a z y\n11 1\n.names y z\n1 1\n.end\n", klut2 ) == lorina::return_code::parse_error );
+
+  /* malformed cover */
+  CHECK( read_blif_fast_from_buffer( ".model top\n.inputs a b\n.outputs y\n.names a b y\n111 1\n.end\n", klut3 ) == lorina::return_code::parse_error );
+}
+
+TEST_CASE( "fast BLIF reader reads files written by write_blif", "[fast_blif_reader]" )
+{
+  klut_network klut;
+  std::vector<klut_network::signal> pis;
+  for ( auto i = 0u; i < 8u; ++i )
+  {
+    pis.push_back( klut.create_pi() );
+  }
+  auto f = klut.get_constant( false );
+  for ( auto i = 0u; i + 2u < pis.size(); ++i )
+  {
+    f = klut.create_maj( f, klut.create_xor( pis[i], pis[i + 1] ), klut.create_and( pis[i + 2], pis[i] ) );
+    klut.create_po( f );
+  }
+
+  std::ostringstream out;
+  write_blif( klut, out );
+  auto const text = out.str();
+
+  klut_network fast, lorina_klut;
+  CHECK( read_blif_fast_from_buffer( text, fast ) == lorina::return_code::success );
+  std::istringstream in( text );
+  CHECK( lorina::read_blif( in, blif_reader( lorina_klut ) ) == lorina::return_code::success );
+
+  CHECK( fast.num_gates() == lorina_klut.num_gates() );
+  default_simulator<kitty::dynamic_truth_table> sim( klut.num_pis() );
+  CHECK( simulate<kitty::dynamic_truth_table>( fast, sim ) == simulate<kitty::dynamic_truth_table>( klut, sim ) );
+}
@@ -0,0 +1,226 @@
+#include <catch.hpp>
+
+#include <sstream>
+#include <string>
+
+#include <mockturtle/algorithms/simulation.hpp>
+#include <mockturtle/io/fast_verilog_reader.hpp>
+#include <mockturtle/io/verilog_reader.hpp>
+#include <mockturtle/io/write_verilog.hpp>
+#include <mockturtle/networks/aig.hpp>
+#include <mockturtle/networks/mig.hpp>
+#include <mockturtle/networks/xag.hpp>
+#include <mockturtle/networks/xmg.hpp>
+#include <mockturtle/views/names_view.hpp>
+
+#include <fmt/format.h>
+#include <kitty/kitty.hpp>
+#include <lorina/verilog.hpp>
+
+using namespace mockturtle;
+
+namespace
+{
+
+std::string const flat_file{
+    "// comment\n"
+    "module top( y1, y2, y3, a, b, c ) ;\n"
+    "  input a , b , c ;\n"
+    "  output y1 , y2 , y3 ;\n"
+    "  wire g0, g1 , g2 , g3 , g4 , g5 , g6 ;\n"
+    "  assign y1 = g3 ;\n" /* statements in any order */
+    "  assign g0 = a ;\n"
+    "  assign g1 = ~c ;\n"
+    "  assign g2 = g0 & g1 ;\n"
+    "  assign g3 = a | g2 ;\n"
+    "  assign g4 = ( ~a & b ) | ( ~a & c ) | ( b & c ) ;\n"
+    "  assign g5 = g2 ^ g3 ^ g4 ;\n"
+    "  /* block\n"
+    "     comment */\n"
+    "  assign g6 = ~( g4 & g5 ) ;\n"
+    "  assign y2 = g4 ;\n"
+    "  assign y3 = a ? g6 : 1'b1 ;\n"
+    "endmodule\n" };
+
+} // namespace
+
+TEST_CASE( "read a VERILOG file with the fast reader", "[fast_verilog_reader]" )
+{
+  names_view<mig_network> mig;
+  CHECK( read_verilog_fast_from_buffer( flat_file, mig ) == lorina::return_code::success );
+
+  CHECK( mig.num_pis() == 3 );
+  CHECK( mig.num_pos() == 3 );
+  CHECK( mig.get_network_name() == "top" );
+  CHECK( mig.get_name( mig.make_signal( mig.pi_at( 1 ) ) ) == "b" );
+  CHECK( mig.get_output_name( 2 ) == "y3" );
+
+  /* the majority expression is a single gate */
+  CHECK( mig.is_maj( mig.get_node( mig.po_at( 1 ) ) ) );
+
+  auto const tts = simulate<kitty::dynamic_truth_table>( mig, default_simulator<kitty::dynamic_truth_table>( 3u ) );
+  CHECK( kitty::to_hex( tts[0] ) == "aa" );
+  CHECK( kitty::to_hex( tts[1] ) == "d4" );
+
+  auto const& a = kitty::nth_var<kitty::dynamic_truth_table>( 3, 0 );
+  auto const& g2 = a & ~kitty::nth_var<kitty::dynamic_truth_table>( 3, 2 );
+  auto const& g5 = g2 ^ tts[0] ^ tts[1];
+  CHECK( tts[2] == kitty::ternary_ite( a, ~( tts[1] & g5 ), ~a | a ) );
+}
+
+TEST_CASE( "read a VERILOG file with the fast reader into different networks", "[fast_verilog_reader]" )
+{
+  aig_network aig;
+  xag_network xag;
+  xmg_network xmg;
+  CHECK( read_verilog_fast_from_buffer( flat_file, aig ) == lorina::return_code::success );
+  CHECK( read_verilog_fast_from_buffer( flat_file, xag ) == lorina::return_code::success );
+  CHECK( read_verilog_fast_from_buffer( flat_file, xmg ) == lorina::return_code::success );
+
+  default_simulator<kitty::dynamic_truth_table> sim( 3u );
+  auto const tts = simulate<kitty::dynamic_truth_table>( aig, sim );
+  CHECK( simulate<kitty::dynamic_truth_table>( xag, sim ) == tts );
+  CHECK( simulate<kitty::dynamic_truth_table>( xmg, sim ) == tts );
+}
+
+TEST_CASE( "read a hierarchical VERILOG file with the fast reader", "[fast_verilog_reader]" )
+{
+  std::string const file{
+      "module top( a, b, s );\n"
+      "  input [1:0] a, b;\n"
+      "  output [2:0] s;\n"
+      "  wire c;\n"
+      "  full_adder fa1( .x( a[1] ), .y( b[1] ), .cin( c ), .s( s[1] ), .cout( s[2] ) );\n"
+      "  half_adder ha0( a[0], b[0], s[0], c );\n"
+      "endmodule\n"
+      "module full_adder( x, y, cin, s, cout );\n"
+      "  input x, y, cin;\n"
+      "  output s, cout;\n"
+      "  wire p, c1, c2;\n"
+      "  half_adder h1( .a( x ), .b( y ), .s( p ), .c( c1 ) );\n"
+      "  half_adder h2( .a( p ), .b( cin ), .s( s ), .c( c2 ) );\n"
+      "  assign cout = c1 | c2;\n"
+      "endmodule\n"
+      "module half_adder( a, b, s, c );\n"
+      "  input a, b;\n"
+      "  output s, c;\n"
+      "  assign s = a ^ b;\n"
+      "  assign c = a & b;\n"
+      "endmodule\n" };
+
+  for ( auto num_threads : { 1u, 3u } )
+  {
+    names_view<xag_network> xag;
+    fast_verilog_reader_params ps;
+    ps.num_threads = num_threads;
+    CHECK( read_verilog_fast_from_buffer( file, xag, ps ) == lorina::return_code::success );
+
+    CHECK( xag.get_network_name() == "top" );
+    CHECK( xag.num_pis() == 4 );
+    CHECK( xag.num_pos() == 3 );
+    CHECK( xag.get_name( xag.make_signal( xag.pi_at( 2 ) ) ) == "b[0]" );
+    CHECK( xag.get_output_name( 2 ) == "s[2]" );
+
+    /* s = a + b */
+    auto const tts = simulate<kitty::dynamic_truth_table>( xag, default_simulator<kitty::dynamic_truth_table>( 4u ) );
+    for ( auto m = 0u; m < 16u; ++m )
+    {
+      auto const sum = ( m & 3u ) + ( m >> 2 );
+      for ( auto i = 0u; i < 3u; ++i )
+      {
+        CHECK( kitty::get_bit( tts[i], m ) == ( ( sum >> i ) & 1u ) );
+      }
+    }
+  }
+
+  /* a lower module as top module */
+  xag_network xag;
+  fast_verilog_reader_params ps;
+  ps.top_module = "full_adder";
+  CHECK( read_verilog_fast_from_buffer( file, xag, ps ) == lorina::return_code::success );
+  CHECK( xag.num_pis() == 3 );
+  CHECK( xag.num_pos() == 2 );
+}
+
+TEST_CASE( "fast VERILOG reader reads files written by write_verilog", "[fast_verilog_reader]" )
+{
+  xag_network xag;
+  std::vector<xag_network::signal> a, b;
+  for ( auto i = 0u; i < 8u; ++i )
+  {
+    a.push_back( xag.create_pi() );
+    b.push_back( xag.create_pi() );
+  }
+  auto carry = xag.get_constant( false );
+  for ( auto i = 0u; i < 8u; ++i )
+  {
+    xag.create_po( xag.create_xor( xag.create_xor( a[i], b[i] ), carry ) );
+    carry = xag.create_maj( a[i], b[i], carry );
+  }
+  xag.create_po( !carry );
+
+  std::ostringstream out;
+  write_verilog( xag, out );
+  auto const text = out.str();
+
+  xag_network fast, lorina_xag;
+  CHECK( read_verilog_fast_from_buffer( text, fast ) == lorina::return_code::success );
+  std::istringstream in( text );
+  CHECK( lorina::read_verilog( in, verilog_reader( lorina_xag ) ) == lorina::return_code::success );
+
+  CHECK( fast.num_gates() == lorina_xag.num_gates() );
+  default_simulator<kitty::dynamic_truth_table> sim( xag.num_pis() );
+  CHECK( simulate<kitty::dynamic_truth_table>( fast, sim ) == simulate<kitty::dynamic_truth_table>( xag, sim ) );
+}
+
+TEST_CASE( "fast VERILOG reader parses many modules in parallel", "[fast_verilog_reader]" )
+{
+  /* a chain of modules, each one instantiating the previous one twice */
+  std::string file{ "module m0( a, b, y );\n  input a, b;\n  output y;\n  assign y = a ^ b;\nendmodule\n" };
+  for ( auto i = 1u; i < 12u; ++i )
+  {
+    file += fmt::format( "module m{0}( a, b, c, y );\n"
+                         "  input a, b, c;\n"
+                         "  output y;\n"
+                         "  wire t1, t2;\n"
+                         "  m{1} i1( .a( a ), .b( b ), {2}.y( t1 ) );\n"
+                         "  m{1} i2( .a( t1 ), .b( ~c ), {2}.y( t2 ) );\n"
+                         "  assign y = t2 & ( a | c );\n"
+                         "endmodule\n",
+                         i, i - 1u, i == 1u ? "" : ".c( c ), " );
+  }
+
+  aig_network aig1, aig4;
+  fast_verilog_reader_params ps;
+  ps.num_threads = 1u;
+  CHECK( read_verilog_fast_from_buffer( file, aig1, ps ) == lorina::return_code::success );
+  ps.num_threads = 4u;
+  CHECK( read_verilog_fast_from_buffer( file, aig4, ps ) == lorina::return_code::success );
+
+  CHECK( aig1.num_pis() == 3u );
+  CHECK( aig1.num_gates() == aig4.num_gates() );
+  default_simulator<kitty::dynamic_truth_table> sim( 3u );
+  CHECK( simulate<kitty::dynamic_truth_table>( aig1, sim ) == simulate<kitty::dynamic_truth_table>( aig4, sim ) );
+}
+
+TEST_CASE( "fast VERILOG reader reports errors", "[fast_verilog_reader]" )
+{
+  aig_network aig;
+
+  /* undefined signal */
+  CHECK( read_verilog_fast_from_buffer( "module top( a, y ); input a; output y; assign y = a & b; endmodule", aig ) == lorina::return_code::parse_error );
+
+  /* combinational cycle */
+  CHECK( read_verilog_fast_from_buffer( "module top( a, y ); input a; output y; wire t; assign t = a & y; assign y = t; endmodule", aig ) == lorina::return_code::parse_error );
+
+  /* unknown module */
+  CHECK( read_verilog_fast_from_buffer( "module top( a, y ); input a; output y; sub s( .a( a ), .y( y ) ); endmodule", aig ) == lorina::return_code::parse_error );
+
+  /* syntax error */
+  CHECK( read_verilog_fast_from_buffer( "module top( a, y ); input a; output y; assign y = a & ; endmodule", aig ) == lorina::return_code::parse_error );
+
+  /* unknown top module */
+  fast_verilog_reader_params ps;
+  ps.top_module = "main";
+  CHECK( read_verilog_fast_from_buffer( "module top( a, y ); input a; output y; assign y = a; endmodule", aig, ps ) == lorina::return_code::parse_error );
+}
@@ -98,6 +98,49 @@ TEST_CASE( "write a simple combinational k-LUT into BLIF file", "[write_blif]" )
   blif_read_after_write_test( klut, ps );
 }
 
+TEST_CASE( "write a k-LUT into BLIF file with multiple threads", "[write_blif]" )
+{
+  names_view<klut_network> klut;
+
+  std::vector<klut_network::signal> fs;
+  for ( auto i = 0u; i < 4u; ++i )
+  {
+    fs.push_back( klut.create_pi() );
+  }
+  klut.set_name( fs[0], "a" );
+
+  for ( auto i = 0u; i < 10000u; ++i )
+  {
+    auto const n = fs.size();
+    switch ( i % 3u )
+    {
+    case 0u:
+      fs.push_back( klut.create_maj( fs[n - 1u], fs[n - 3u], fs[n - 4u] ) );
+      break;
+    case 1u:
+      fs.push_back( klut.create_xor( fs[n - 1u], fs[n - 2u] ) );
+      break;
+    default:
+      fs.push_back( klut.create_and( fs[n - 1u], klut.create_not( fs[n - 3u] ) ) );
+      break;
+    }
+    if ( i % 500u == 0u )
+    {
+      klut.set_name( fs.back(), fmt::format( "w{}", i ) );
+      klut.create_po( fs.back() );
+    }
+  }
+  klut.create_po( fs.back() );
+
+  std::ostringstream out1, out4;
+  write_blif_params ps;
+  write_blif( klut, out1, ps );
+  ps.num_threads = 4u;
+  write_blif( klut, out4, ps );
+
+  CHECK( out1.str() == out4.str() );
+}
+
 TEST_CASE( "write a k-LUT with dual outputs node into BLIF file", "[write_blif]" )
 {
   klut_network klut;
@@ -419,6 +419,93 @@ TEST_CASE( "write cell network with multiple driven POs and register names into
                       "endmodule\n" );
 }
 
+TEST_CASE( "write Verilog with multiple threads", "[write_verilog]" )
+{
+  aig_network aig;
+  std::vector<aig_network::signal> a( 32u ), b( 32u );
+  std::generate( a.begin(), a.end(), [&]() { return aig.create_pi(); } );
+  std::generate( b.begin(), b.end(), [&]() { return aig.create_pi(); } );
+  for ( auto const& f : carry_ripple_multiplier( aig, a, b ) )
+  {
+    aig.create_po( f );
+  }
+  CHECK( aig.num_gates() > 4096u );
+
+  std::ostringstream out1, out4;
+  write_verilog_params ps;
+  write_verilog( aig, out1, ps );
+  ps.num_threads = 4u;
+  write_verilog( aig, out4, ps );
+
+  CHECK( out1.str() == out4.str() );
+}
+
+TEST_CASE( "write mapped network with multiple threads", "[write_verilog]" )
+{
+  std::string const simple_test_library = "GATE   inv1    1 Y=!a;     PIN * INV 1 999 0.9 0.3 0.9 0.3\n"
+                                          "GATE   buf     2 Y=a;      PIN * NONINV 1 999 1.0 0.0 1.0 0.0\n"
+                                          "GATE   nand2   2 Y=!(a*b); PIN * INV 1 999 1.0 0.2 1.0 0.2\n"
+                                          "GATE   ha      5 C=a*b;    PIN * INV 1 999 1.9 0.4 1.9 0.4\n"
+                                          "GATE   ha      5 S=a^b;    PIN * INV 1 999 3.0 0.4 3.0 0.4\n";
+
+  std::vector<gate> gates;
+  std::istringstream in( simple_test_library );
+  auto result = lorina::read_genlib( in, genlib_reader( gates ) );
+  std::vector<standard_cell> cells = get_standard_cells( gates );
+
+  CHECK( result == lorina::return_code::success );
+
+  binding_view<klut_network> klut( gates );
+  cell_view<block_network> ntk( cells );
+
+  std::vector<klut_network::signal> klut_fs{ klut.create_pi(), klut.create_pi(), klut.create_pi() };
+  std::vector<block_network::signal> fs{ ntk.create_pi(), ntk.create_pi(), ntk.create_pi() };
+  for ( auto i = 0u; i < 10000u; ++i )
+  {
+    auto const j = klut_fs.size() - 1u - ( i % 3u );
+    if ( i % 100u == 99u )
+    {
+      klut_fs.push_back( klut.create_not( klut_fs[j] ) );
+      klut.add_binding( klut.get_node( klut_fs.back() ), 0 );
+
+      fs.push_back( ntk.create_ha( fs.back(), fs[j] ) );
+      ntk.add_cell( ntk.get_node( fs.back() ), 3 );
+      ntk.create_po( fs.back() );
+      ntk.create_po( ntk.next_output_pin( fs.back() ) );
+      ntk.create_po( ntk.next_output_pin( fs.back() ) );
+    }
+    else
+    {
+      klut_fs.push_back( klut.create_nand( klut_fs.back(), klut_fs[j] ) );
+      klut.add_binding( klut.get_node( klut_fs.back() ), 2 );
+
+      fs.push_back( ntk.create_nand( fs.back(), fs[j] ) );
+      ntk.add_cell( ntk.get_node( fs.back() ), 2 );
+    }
+
+    /* some nodes drive multiple POs */
+    if ( i % 1000u == 0u )
+    {
+      klut.create_po( klut_fs.back() );
+      klut.create_po( klut_fs.back() );
+    }
+  }
+  klut.create_po( klut_fs.back() );
+  ntk.create_po( fs.back() );
+
+  std::ostringstream klut_out1, klut_out3, out1, out3;
+  write_verilog_params ps;
+  write_verilog_with_binding( klut, klut_out1, ps );
+  write_verilog_with_cell( ntk, out1, ps );
+  ps.num_threads = 3u;
+  write_verilog_with_binding( klut, klut_out3, ps );
+  write_verilog_with_cell( ntk, out3, ps );
+
+  CHECK( klut_out1.str() == klut_out3.str() );
+  CHECK( out1.str() == out3.str() );
+  CHECK( out1.str().find( "  buf   g" ) != std::string::npos );
+}
+
 TEST_CASE( "write cell network with names_view", "[write_verilog]" )
 {
   std::string const simple_test_library = "GATE   inv1    1 Y=!a;     PIN * INV 1 999 0.9 0.3 0.9 0.3\n"
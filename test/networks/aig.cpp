@@ -1081,3 +1081,76 @@ TEST_CASE( "substitute node without re-strashing case 3", "[aig]" )
   CHECK( aig.num_gates() == 2 );
   CHECK( simulate<kitty::static_truth_table<3u>>( aig )[0]._bits == 0x80 );
 }
+
+template<class Ntk>
+void test_aig_storage_layout()
+{
+  Ntk aig;
+  CHECK( is_network_type_v<Ntk> );
+  CHECK( Ntk::is_aig_network_type );
+
+  auto const x1 = aig.create_pi();
+  auto const x2 = aig.create_pi();
+  auto const x3 = aig.create_pi();
+  auto const f1 = aig.create_and( x1, !x2 );
+  auto const f2 = aig.create_and( f1, x3 );
+  CHECK( aig.create_and( !x2, x1 ) == f1 );
+  aig.create_po( !f2 );
+  aig.create_po( f1 );
+
+  CHECK( aig.size() == 6u );
+  CHECK( aig.is_pi( aig.get_node( x3 ) ) );
+  CHECK( !aig.is_pi( aig.get_node( f1 ) ) );
+  CHECK( aig.fanout_size( aig.get_node( f1 ) ) == 2u );
+  CHECK( aig.is_complemented( aig.po_at( 0 ) ) );
+  CHECK( simulate<kitty::static_truth_table<3u>>( aig )[0]._bits == 0xdf );
+
+  /* values and visited flags of nodes created after clearing them */
+  aig.clear_values();
+  aig.clear_visited();
+  auto const f3 = aig.create_and( x2, x3 );
+  aig.foreach_node( [&]( auto n ) {
+    CHECK( aig.value( n ) == 0u );
+    CHECK( aig.visited( n ) == 0u );
+  } );
+  aig.set_value( aig.get_node( f3 ), 5u );
+  CHECK( aig.incr_value( aig.get_node( f3 ) ) == 5u );
+  CHECK( aig.decr_value( aig.get_node( f3 ) ) == 5u );
+  aig.set_visited( aig.get_node( f3 ), 3u );
+  CHECK( aig.visited( aig.get_node( f3 ) ) == 3u );
+  CHECK( aig.visited( aig.get_node( f2 ) ) == 0u );
+
+  /* dead nodes keep their terminal flag */
+  aig.substitute_node( aig.get_node( f1 ), x1 );
+  CHECK( aig.is_dead( aig.get_node( f1 ) ) );
+  CHECK( !aig.is_dead( aig.get_node( x1 ) ) );
+  CHECK( aig.is_ci( aig.get_node( x1 ) ) );
+  CHECK( aig.fanout_size( aig.get_node( x1 ) ) == 2u );
+
+  aig = cleanup_dangling( aig );
+  CHECK( aig.num_gates() == 1u );
+  CHECK( simulate<kitty::static_truth_table<3u>>( aig )[0]._bits == 0x5f );
+  CHECK( simulate<kitty::static_truth_table<3u>>( aig )[1]._bits == 0xaa );
+}
+
+TEST_CASE( "compact storage layouts of AIGs", "[aig]" )
+{
+  test_aig_storage_layout<aig_network>();
+  test_aig_storage_layout<compact_aig_network>();
+  test_aig_storage_layout<compact_cold_aig_network>();
+
+  CHECK( sizeof( aig_network::storage::element_type::node_type ) == 32u );
+  CHECK( sizeof( compact_aig_network::storage::element_type::node_type ) == 20u );
+  CHECK( sizeof( compact_cold_aig_network::storage::element_type::node_type ) == 12u );
+
+  /* networks with different layouts can be converted into each other */
+  aig_network aig;
+  auto const a = aig.create_pi();
+  auto const b = aig.create_pi();
+  aig.create_po( aig.create_xor( a, b ) );
+
+  auto const compact = cleanup_dangling<aig_network, compact_cold_aig_network>( aig );
+  CHECK( compact.num_gates() == aig.num_gates() );
+  CHECK( simulate<kitty::static_truth_table<2u>>( compact )[0]._bits == 0x6 );
+  CHECK( compact.memory_usage() < aig.memory_usage() );
+}
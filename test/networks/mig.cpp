@@ -915,3 +915,30 @@ TEST_CASE( "substitute node without re-strashing case 3 in mig_network", "[mig]"
   CHECK( mig.num_gates() == 2 );
   CHECK( simulate<kitty::static_truth_table<3u>>( mig )[0]._bits == 0x80 );
 }
+
+TEST_CASE( "compact storage layouts of MIGs", "[mig]" )
+{
+  CHECK( sizeof( mig_network::storage::element_type::node_type ) == 40u );
+  CHECK( sizeof( compact_mig_network::storage::element_type::node_type ) == 24u );
+  CHECK( sizeof( compact_cold_mig_network::storage::element_type::node_type ) == 16u );
+  CHECK( is_mig_network_type_v<compact_mig_network> );
+  CHECK( is_mig_network_type_v<compact_cold_mig_network> );
+
+  compact_mig_network mig;
+  auto const a = mig.create_pi();
+  auto const b = mig.create_pi();
+  auto const c = mig.create_pi();
+  auto const f1 = mig.create_maj( a, b, c );
+  auto const f2 = mig.create_and( f1, !c );
+  CHECK( mig.create_maj( c, a, b ) == f1 );
+  CHECK( mig.fanout_size( mig.get_node( c ) ) == 2u );
+  mig.create_po( f2 );
+
+  CHECK( simulate<kitty::static_truth_table<3u>>( mig )[0]._bits == 0x08 );
+
+  mig.substitute_node( mig.get_node( f1 ), a );
+  CHECK( mig.is_dead( mig.get_node( f1 ) ) );
+  CHECK( mig.is_pi( mig.get_node( c ) ) );
+  CHECK( mig.fanout_size( mig.get_node( c ) ) == 1u );
+  CHECK( simulate<kitty::static_truth_table<3u>>( mig )[0]._bits == 0x0a );
+}
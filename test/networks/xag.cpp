@@ -915,3 +915,35 @@ TEST_CASE( "substitute node without re-strashing case 4 in xag_network", "[xag]"
   CHECK( xag.num_gates() == 1 );
   CHECK( simulate<kitty::static_truth_table<2u>>( xag )[0]._bits == 0x6 );
 }
+
+TEST_CASE( "compact storage layouts of XAGs", "[xag]" )
+{
+  CHECK( sizeof( compact_xag_network::storage::element_type::node_type ) == 20u );
+  CHECK( sizeof( compact_cold_xag_network::storage::element_type::node_type ) == 12u );
+  CHECK( is_xag_network_type_v<compact_xag_network> );
+  CHECK( is_xag_network_type_v<compact_cold_xag_network> );
+  CHECK( !is_aig_network_type_v<compact_xag_network> );
+
+  compact_cold_xag_network xag;
+  auto const a = xag.create_pi();
+  auto const b = xag.create_pi();
+  auto const c = xag.create_pi();
+  auto const f1 = xag.create_xor( a, b );
+  auto const f2 = xag.create_and( f1, !c );
+  CHECK( xag.create_xor( b, a ) == f1 );
+  CHECK( xag.is_xor( xag.get_node( f1 ) ) );
+  CHECK( xag.is_and( xag.get_node( f2 ) ) );
+  xag.create_po( f2 );
+
+  CHECK( simulate<kitty::static_truth_table<3u>>( xag )[0]._bits == 0x06 );
+
+  xag.clear_visited();
+  xag.set_visited( xag.get_node( f2 ), 1u );
+  CHECK( xag.visited( xag.get_node( f1 ) ) == 0u );
+  CHECK( xag.visited( xag.get_node( f2 ) ) == 1u );
+  xag.clear_visited();
+
+  auto const wide = cleanup_dangling<compact_cold_xag_network, xag_network>( xag );
+  CHECK( wide.num_gates() == 2u );
+  CHECK( simulate<kitty::static_truth_table<3u>>( wide )[0]._bits == 0x06 );
+}
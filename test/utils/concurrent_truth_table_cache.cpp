@@ -0,0 +1,105 @@
+#include <catch.hpp>
+
+#include <thread>
+#include <vector>
+
+#include <kitty/constructors.hpp>
+#include <kitty/dynamic_truth_table.hpp>
+#include <kitty/operations.hpp>
+#include <kitty/static_truth_table.hpp>
+#include <mockturtle/utils/concurrent_truth_table_cache.hpp>
+
+using namespace mockturtle;
+
+TEST_CASE( "insert and read truth tables in concurrent cache", "[concurrent_truth_table_cache]" )
+{
+  concurrent_truth_table_cache<kitty::dynamic_truth_table> cache( 8u );
+
+  kitty::dynamic_truth_table maj( 3u ), x( 2u ), big( 8u );
+  kitty::create_majority( maj );
+  kitty::create_nth_var( x, 0u );
+  kitty::create_random( big, 5u );
+
+  auto const l1 = cache.insert( maj );
+  CHECK( ( l1 & 1u ) == 0u );
+  CHECK( cache[l1] == maj );
+  CHECK( cache[l1 ^ 1u] == ~maj );
+
+  /* complement is stored only once */
+  auto const l2 = cache.insert( ~maj );
+  CHECK( l2 == ( l1 ^ 1u ) );
+  CHECK( cache.size() == 1u );
+
+  /* same bits, different number of variables */
+  kitty::dynamic_truth_table x3( 3u );
+  kitty::create_nth_var( x3, 0u );
+  auto const l3 = cache.insert( x );
+  auto const l4 = cache.insert( x3 );
+  CHECK( l3 != l4 );
+  CHECK( cache[l3] == x );
+  CHECK( cache[l4] == x3 );
+
+  auto const l5 = cache.insert( big );
+  CHECK( cache[l5] == big );
+  CHECK( cache.insert( big ) == l5 );
+  CHECK( cache.size() == 4u );
+}
+
+TEST_CASE( "concurrent cache of small static truth tables", "[concurrent_truth_table_cache]" )
+{
+  /* small blocks to exercise the block growth */
+  concurrent_truth_table_cache<kitty::static_truth_table<4>> cache( 4u, 2u, 2u );
+
+  std::vector<uint32_t> lits;
+  for ( auto i = 0u; i < ( 1u << 16 ); ++i )
+  {
+    kitty::static_truth_table<4> tt;
+    kitty::create_from_words( tt, &i, &i + 1 );
+    auto const lit = cache.insert( tt );
+    CHECK( cache[lit] == tt );
+    lits.push_back( lit );
+  }
+  CHECK( cache.size() == ( 1u << 15 ) );
+
+  for ( auto i = 0u; i < ( 1u << 16 ); ++i )
+  {
+    CHECK( ( lits[i] ^ lits[i ^ 0xffff] ) == 1u );
+  }
+}
+
+TEST_CASE( "insert truth tables from several threads", "[concurrent_truth_table_cache]" )
+{
+  concurrent_truth_table_cache<kitty::dynamic_truth_table> cache( 6u, 3u, 4u );
+
+  constexpr uint32_t num_threads = 4u;
+  constexpr uint32_t num_tts = 2000u;
+
+  std::vector<std::vector<uint32_t>> lits( num_threads, std::vector<uint32_t>( num_tts ) );
+  std::vector<uint32_t> mismatches( num_threads, 0u );
+  std::vector<std::thread> threads;
+  for ( auto t = 0u; t < num_threads; ++t )
+  {
+    threads.emplace_back( [&, t]() {
+      for ( auto i = 0u; i < num_tts; ++i )
+      {
+        /* each thread inserts the same functions in a different order */
+        auto const j = ( i + t * 500u ) % num_tts;
+        kitty::dynamic_truth_table tt( 6u );
+        kitty::create_random( tt, j );
+        lits[t][j] = cache.insert( tt );
+        mismatches[t] += cache[lits[t][j]] == tt ? 0u : 1u;
+      }
+    } );
+  }
+  for ( auto& t : threads )
+  {
+    t.join();
+  }
+
+  for ( auto t = 0u; t < num_threads; ++t )
+  {
+    CHECK( mismatches[t] == 0u );
+    CHECK( lits[t] == lits[0] );
+  }
+  CHECK( cache.size() <= num_tts );
+}
@@ -0,0 +1,129 @@
+#include <catch.hpp>
+
+#include <kitty/constructors.hpp>
+#include <kitty/operations.hpp>
+#include <kitty/static_truth_table.hpp>
+#include <mockturtle/networks/aig.hpp>
+#include <mockturtle/utils/cut_store.hpp>
+#include <mockturtle/views/fanout_view.hpp>
+
+using namespace mockturtle;
+
+TEST_CASE( "enumerate cuts with a cut store", "[cut_store]" )
+{
+  aig_network aig;
+  auto const a = aig.create_pi();
+  auto const b = aig.create_pi();
+  auto const c = aig.create_pi();
+  auto const f1 = aig.create_and( a, b );
+  auto const f2 = aig.create_and( !a, !b );
+  auto const f3 = aig.create_and( f1, c );
+  aig.create_po( f2 );
+  aig.create_po( f3 );
+
+  fanout_view<aig_network> ntk{ aig };
+
+  cut_enumeration_params ps;
+  ps.cut_size = 3;
+  ps.cut_limit = 8;
+  cut_store<fanout_view<aig_network>, 3u> store( ntk, ps );
+
+  CHECK( store.is_compatible( ps ) );
+  ps.cut_limit = 4;
+  CHECK( !store.is_compatible( ps ) );
+
+  /* { a, b, c } and { f1, c } */
+  auto const& cuts3 = store.cuts( aig.get_node( f3 ) );
+  CHECK( cuts3.size() == 3u );
+
+  kitty::static_truth_table<3> x, y, z;
+  kitty::create_nth_var( x, 0 );
+  kitty::create_nth_var( y, 1 );
+  kitty::create_nth_var( z, 2 );
+
+  bool found = false;
+  for ( auto const& cut : cuts3 )
+  {
+    if ( cut->size() == 3u )
+    {
+      CHECK( store.truth_table( *cut ) == ( x & y & z ) );
+      found = true;
+    }
+  }
+  CHECK( found );
+
+  /* the fanin cone was enumerated with the node */
+  auto const enumerated = store.stats().enumerated_cuts;
+  store.cuts( aig.get_node( f1 ) );
+  CHECK( store.stats().enumerated_cuts == enumerated );
+  CHECK( store.stats().reused == 1u );
+
+  /* the functions of the cuts { a, b } of f1 and f2 are NPN-equivalent */
+  auto const& cuts1 = store.cuts( aig.get_node( f1 ) );
+  auto const& cuts2 = store.cuts( aig.get_node( f2 ) );
+  auto const& npn1 = store.npn_class( cuts1[0] );
+  auto const npn_computed = store.stats().npn_computed;
+  auto const& npn2 = store.npn_class( cuts2[0] );
+  CHECK( std::get<0>( npn1 ) == std::get<0>( npn2 ) );
+  CHECK( store.stats().npn_computed == npn_computed + ( cuts1[0]->func_id == cuts2[0]->func_id ? 0u : 1u ) );
+  store.npn_class( cuts2[0] );
+  CHECK( store.stats().npn_computed == npn_computed + ( cuts1[0]->func_id == cuts2[0]->func_id ? 0u : 1u ) );
+}
+
+TEST_CASE( "invalidate cuts in the transitive fanout", "[cut_store]" )
+{
+  aig_network aig;
+  auto const a = aig.create_pi();
+  auto const b = aig.create_pi();
+  auto const c = aig.create_pi();
+  auto const d = aig.create_pi();
+  auto const f1 = aig.create_and( a, b );
+  auto const f2 = aig.create_and( f1, c );
+  auto const f3 = aig.create_and( f2, d );
+  auto const g1 = aig.create_and( c, d );
+  aig.create_po( f3 );
+  aig.create_po( g1 );
+
+  fanout_view<aig_network> ntk{ aig };
+  cut_enumeration_params ps;
+  ps.cut_limit = 8;
+  cut_store<fanout_view<aig_network>, 4u> store( ntk, ps );
+
+  store.cuts( aig.get_node( f3 ) );
+  store.cuts( aig.get_node( g1 ) );
+  CHECK( store.stats().invalidated == 0u );
+
+  /* replace f1 by a new node: f2 and f3 depend on the change */
+  auto const f1_new = aig.create_and( a, !b );
+  ntk.substitute_node( aig.get_node( f1 ), f1_new );
+
+  CHECK( store.stats().invalidated == 3u );
+
+  /* cuts of g1 are not affected */
+  auto const reused = store.stats().reused;
+  auto const enumerated = store.stats().enumerated_cuts;
+  store.cuts( aig.get_node( g1 ) );
+  CHECK( store.stats().reused == reused + 1u );
+  CHECK( store.stats().enumerated_cuts == enumerated );
+
+  /* cuts of f3 are enumerated again and use the new function */
+  auto const& cuts3 = store.cuts( aig.get_node( f3 ) );
+  CHECK( store.stats().enumerated_cuts > enumerated );
+
+  kitty::static_truth_table<4> x0, x1, x2, x3;
+  kitty::create_nth_var( x0, 0 );
+  kitty::create_nth_var( x1, 1 );
+  kitty::create_nth_var( x2, 2 );
+  kitty::create_nth_var( x3, 3 );
+
+  bool found = false;
+  for ( auto const& cut : cuts3 )
+  {
+    if ( cut->size() == 4u )
+    {
+      CHECK( store.truth_table( *cut ) == ( x0 & ~x1 & x2 & x3 ) );
+      found = true;
+    }
+  }
+  CHECK( found );
+}
@@ -1,5 +1,8 @@
 #include <catch.hpp>
 
+#include <algorithm>
+#include <iterator>
+#include <random>
 #include <vector>
 
 #include <mockturtle/utils/cuts.hpp>
@@ -188,3 +191,48 @@ TEST_CASE( "merge three cuts", "[cuts]" )
   ct.merge( c3, cr, 10 );
   CHECK( std::vector<uint32_t>( cr.begin(), cr.end() ) == std::vector{ 1u, 2u, 3u, 4u, 5u, 6u, 7u, 9u } );
 }
+
+TEST_CASE( "merge and dominance of random cuts", "[cuts]" )
+{
+  using cut_type = cut<16>;
+
+  std::mt19937 rng( 42 );
+  std::uniform_int_distribution<uint32_t> leaf_dist( 1u, 40u );
+  std::uniform_int_distribution<uint32_t> size_dist( 0u, 8u );
+
+  auto const random_leaves = [&]() {
+    std::vector<uint32_t> leaves( size_dist( rng ) );
+    std::generate( leaves.begin(), leaves.end(), [&]() { return leaf_dist( rng ); } );
+    std::sort( leaves.begin(), leaves.end() );
+    leaves.erase( std::unique( leaves.begin(), leaves.end() ), leaves.end() );
+    return leaves;
+  };
+
+  for ( auto i = 0u; i < 2000u; ++i )
+  {
+    auto const l1 = random_leaves();
+    auto const l2 = random_leaves();
+
+    cut_type c1, c2, cr;
+    c1.set_leaves( l1 );
+    c2.set_leaves( l2 );
+
+    std::vector<uint32_t> expected;
+    std::set_union( l1.begin(), l1.end(), l2.begin(), l2.end(), std::back_inserter( expected ) );
+
+    for ( auto cut_size : { 6u, 8u, 16u } )
+    {
+      auto const merged = c1.merge( c2, cr, cut_size );
+      CHECK( merged == ( expected.size() <= cut_size ) );
+      if ( merged )
+      {
+        CHECK( std::vector<uint32_t>( cr.begin(), cr.end() ) == expected );
+        CHECK( cr.size() == expected.size() );
+        CHECK( cr.signature() == ( c1.signature() | c2.signature() ) );
+      }
+    }
+
+    CHECK( c1.dominates( c2 ) == std::includes( l2.begin(), l2.end(), l1.begin(), l1.end() ) );
+    CHECK( c2.dominates( c1 ) == std::includes( l1.begin(), l1.end(), l2.begin(), l2.end() ) );
+  }
+}
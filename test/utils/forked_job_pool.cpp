@@ -0,0 +1,86 @@
+#ifndef _MSC_VER
+
+#include <catch.hpp>
+
+#include <chrono>
+#include <csignal>
+#include <cstdlib>
+#include <functional>
+#include <map>
+#include <optional>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include <mockturtle/utils/forked_job_pool.hpp>
+
+using namespace mockturtle;
+
+namespace
+{
+
+/* runs each job in its own slot and collects the outcomes by id */
+std::map<uint64_t, forked_job_outcome> run_jobs( std::vector<std::function<bool()>> const& jobs, std::optional<uint64_t> timeout = std::nullopt )
+{
+  forked_job_pool pool( static_cast<uint32_t>( jobs.size() ), timeout );
+  for ( auto i = 0u; i < jobs.size(); ++i )
+  {
+    auto const slot = pool.free_slot();
+    REQUIRE( slot );
+    REQUIRE( pool.start( *slot, i, jobs[i] ) );
+  }
+  CHECK( pool.num_running() == jobs.size() );
+  CHECK( !pool.free_slot() );
+
+  std::map<uint64_t, forked_job_outcome> outcomes;
+  while ( pool.num_running() > 0u )
+  {
+    auto const [id, outcome] = pool.wait_any();
+    outcomes.emplace( id, outcome );
+  }
+  return outcomes;
+}
+
+} // namespace
+
+TEST_CASE( "Outcomes of forked jobs", "[forked_job_pool]" )
+{
+  auto const outcomes = run_jobs( { []() { return true; },
+                                    []() { return false; },
+                                    []() -> bool { std::signal( SIGABRT, SIG_DFL ); std::abort(); },
+                                    []() -> bool { throw std::runtime_error( "job" ); } } );
+
+  REQUIRE( outcomes.size() == 4u );
+  CHECK( outcomes.at( 0u ) == forked_job_outcome::passed );
+  CHECK( outcomes.at( 1u ) == forked_job_outcome::failed );
+  CHECK( outcomes.at( 2u ) == forked_job_outcome::crashed );
+  CHECK( outcomes.at( 3u ) == forked_job_outcome::crashed );
+}
+
+TEST_CASE( "Forked jobs exceeding the timeout", "[forked_job_pool]" )
+{
+  auto const start = std::chrono::steady_clock::now();
+  auto const outcomes = run_jobs( { []() { std::this_thread::sleep_for( std::chrono::seconds( 30 ) ); return true; },
+                                    []() { return true; } },
+                                  1u );
+
+  REQUIRE( outcomes.size() == 2u );
+  CHECK( outcomes.at( 0u ) == forked_job_outcome::timed_out );
+  CHECK( outcomes.at( 1u ) == forked_job_outcome::passed );
+  CHECK( std::chrono::steady_clock::now() - start < std::chrono::seconds( 10 ) );
+}
+
+TEST_CASE( "Side effects of forked jobs are not visible to the caller", "[forked_job_pool]" )
+{
+  uint32_t value{ 0u };
+  forked_job_pool pool( 1u );
+  REQUIRE( pool.start( 0u, 7u, [&]() { value = 1u; return value == 1u; } ) );
+
+  auto const [id, outcome] = pool.wait_any();
+  CHECK( id == 7u );
+  CHECK( outcome == forked_job_outcome::passed );
+  CHECK( value == 0u );
+  CHECK( pool.num_running() == 0u );
+}
+
+#endif
@@ -0,0 +1,135 @@
+#include <catch.hpp>
+
+#include <algorithm>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <kitty/constructors.hpp>
+#include <kitty/dynamic_truth_table.hpp>
+#include <mockturtle/algorithms/cut_enumeration.hpp>
+#include <mockturtle/algorithms/lut_mapper.hpp>
+#include <mockturtle/algorithms/node_resynthesis/xag_npn.hpp>
+#include <mockturtle/algorithms/rewrite.hpp>
+#include <mockturtle/generators/arithmetic.hpp>
+#include <mockturtle/networks/aig.hpp>
+#include <mockturtle/networks/klut.hpp>
+#include <mockturtle/networks/sequential.hpp>
+#include <mockturtle/traits.hpp>
+#include <mockturtle/utils/memory_usage.hpp>
+#include <mockturtle/utils/tech_library.hpp>
+#include <mockturtle/views/depth_view.hpp>
+#include <mockturtle/views/fanout_view.hpp>
+
+using namespace mockturtle;
+
+TEST_CASE( "memory usage of containers", "[memory_usage]" )
+{
+  std::vector<uint32_t> vec;
+  vec.reserve( 100u );
+  CHECK( dynamic_memory_usage( vec ) == 400u );
+  CHECK( memory_usage( vec ) == sizeof( vec ) + 400u );
+
+  /* nested containers are visited */
+  std::vector<std::vector<uint64_t>> nested( 3u, std::vector<uint64_t>( 10u ) );
+  CHECK( dynamic_memory_usage( nested ) == 3u * sizeof( std::vector<uint64_t> ) + 3u * 80u );
+
+  kitty::dynamic_truth_table tt( 10u );
+  CHECK( dynamic_memory_usage( tt ) == 16u * sizeof( uint64_t ) );
+
+  std::unordered_map<uint32_t, kitty::dynamic_truth_table> map;
+  map.emplace( 0u, tt );
+  CHECK( dynamic_memory_usage( map ) >= sizeof( std::pair<uint32_t const, kitty::dynamic_truth_table> ) + 16u * sizeof( uint64_t ) );
+
+  CHECK( dynamic_memory_usage( 42u ) == 0u );
+  CHECK( dynamic_memory_usage( std::string( 100u, 'x' ) ) > 100u );
+
+#if defined( __unix__ ) || defined( __APPLE__ )
+  CHECK( peak_process_memory() > 0u );
+#endif
+}
+
+TEST_CASE( "memory usage of networks and views", "[memory_usage]" )
+{
+  CHECK( has_memory_usage_v<aig_network> );
+  CHECK( has_memory_usage_v<klut_network> );
+  CHECK( has_memory_usage_v<sequential<aig_network>> );
+  CHECK( has_memory_usage_v<fanout_view<aig_network>> );
+
+  aig_network aig;
+  auto const empty = aig.memory_usage();
+  CHECK( empty >= sizeof( aig_network ) + sizeof( aig_storage ) );
+
+  std::vector<aig_network::signal> a( 64u ), b( 64u );
+  std::generate( a.begin(), a.end(), [&]() { return aig.create_pi(); } );
+  std::generate( b.begin(), b.end(), [&]() { return aig.create_pi(); } );
+  auto const product = carry_ripple_multiplier( aig, a, b );
+  std::for_each( product.begin(), product.end(), [&]( auto const& f ) { aig.create_po( f ); } );
+
+  /* the network outgrew the reserved capacity */
+  CHECK( aig.size() > 10000u );
+  auto const used = aig.memory_usage();
+  CHECK( used > empty );
+  CHECK( used >= aig.size() * sizeof( aig_storage::node_type ) );
+
+  /* copies share the storage */
+  aig_network copy = aig;
+  CHECK( copy.memory_usage() == used );
+
+  /* views add their data structures */
+  fanout_view<aig_network> fanout_aig{ aig };
+  CHECK( fanout_aig.memory_usage() >= used + aig.size() * sizeof( std::vector<aig_network::node> ) );
+
+  depth_view<aig_network> depth_aig{ aig };
+  CHECK( depth_aig.memory_usage() >= used + 2u * aig.size() * sizeof( uint32_t ) );
+
+  /* functions of LUTs are counted */
+  klut_network klut;
+  auto const klut_empty = klut.memory_usage();
+  std::vector<klut_network::signal> pis( 10u );
+  std::generate( pis.begin(), pis.end(), [&]() { return klut.create_pi(); } );
+  kitty::dynamic_truth_table maj( 10u );
+  kitty::create_majority( maj );
+  klut.create_po( klut.create_node( pis, maj ) );
+  CHECK( klut.memory_usage() >= klut_empty + 16u * sizeof( uint64_t ) );
+}
+
+TEST_CASE( "memory footprint of a network and data structures", "[memory_usage]" )
+{
+  aig_network aig;
+  aig.create_po( aig.create_and( aig.create_pi(), aig.create_pi() ) );
+
+  std::vector<uint32_t> vec;
+  vec.reserve( 100u );
+  kitty::dynamic_truth_table tt( 10u );
+  CHECK( memory_footprint( aig ) == aig.memory_usage() );
+  CHECK( memory_footprint( aig, vec, tt ) == aig.memory_usage() + 400u + 16u * sizeof( uint64_t ) );
+
+  /* networks without memory accounting are not counted */
+  CHECK( memory_footprint( 42u, vec ) == 400u );
+}
+
+TEST_CASE( "memory usage of cut enumeration and algorithms", "[memory_usage]" )
+{
+  aig_network aig;
+  std::vector<aig_network::signal> a( 8u ), b( 8u );
+  std::generate( a.begin(), a.end(), [&]() { return aig.create_pi(); } );
+  std::generate( b.begin(), b.end(), [&]() { return aig.create_pi(); } );
+  auto carry = aig.get_constant( false );
+  carry_ripple_adder_inplace( aig, a, b, carry );
+  std::for_each( a.begin(), a.end(), [&]( auto const& f ) { aig.create_po( f ); } );
+  aig.create_po( carry );
+
+  auto const cuts = cut_enumeration<aig_network, true>( aig );
+  CHECK( cuts.memory_usage() >= aig.size() * sizeof( decltype( cuts )::cut_set_t ) );
+
+  lut_map_stats lst;
+  lut_map( aig, {}, &lst );
+  CHECK( lst.memory_footprint >= aig.memory_usage() );
+
+  xag_npn_resynthesis<aig_network, aig_network, xag_npn_db_kind::aig_complete> resyn;
+  exact_library<aig_network> exact_lib( resyn );
+  rewrite_stats rst;
+  rewrite( aig, exact_lib, {}, &rst );
+  CHECK( rst.memory_footprint > aig.memory_usage() );
+}
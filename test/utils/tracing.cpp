@@ -0,0 +1,79 @@
+#include <catch.hpp>
+
+#include <sstream>
+#include <string>
+#include <thread>
+
+#include <mockturtle/algorithms/node_resynthesis/xag_npn.hpp>
+#include <mockturtle/algorithms/rewrite.hpp>
+#include <mockturtle/networks/aig.hpp>
+#include <mockturtle/utils/stopwatch.hpp>
+#include <mockturtle/utils/tech_library.hpp>
+#include <mockturtle/utils/tracing.hpp>
+
+using namespace mockturtle;
+
+TEST_CASE( "record trace spans and counters", "[tracing]" )
+{
+  clear_trace();
+
+  {
+    trace_span outer( "outer_phase", "test" );
+    stopwatch<>::duration time{ 0 };
+    call_with_stopwatch( time, "inner_phase", []() {} );
+    trace_counter( "test_counter", 42, "test" );
+  }
+
+  std::thread worker( []() { trace_span span( "worker_phase", "test" ); } );
+  worker.join();
+
+  std::ostringstream os;
+  write_chrome_trace( os );
+  auto const trace = os.str();
+
+  CHECK( trace.find( "\"traceEvents\":[" ) != std::string::npos );
+  if constexpr ( tracing_enabled )
+  {
+    CHECK( trace.find( "\"name\":\"outer_phase\",\"cat\":\"test\",\"ph\":\"X\"" ) != std::string::npos );
+    CHECK( trace.find( "\"name\":\"inner_phase\",\"cat\":\"mockturtle\",\"ph\":\"X\"" ) != std::string::npos );
+    CHECK( trace.find( "\"args\":{\"test_counter\":42}" ) != std::string::npos );
+    CHECK( trace.find( "\"name\":\"worker_phase\"" ) != std::string::npos );
+  }
+  else
+  {
+    CHECK( trace.find( "\"ph\"" ) == std::string::npos );
+  }
+
+  /* nothing is recorded while tracing is stopped */
+  clear_trace();
+  stop_tracing();
+  {
+    trace_span span( "stopped_phase" );
+  }
+  start_tracing();
+
+  std::ostringstream os2;
+  write_chrome_trace( os2 );
+  CHECK( os2.str().find( "stopped_phase" ) == std::string::npos );
+}
+
+TEST_CASE( "trace phases of an algorithm", "[tracing]" )
+{
+  aig_network aig;
+  auto const a = aig.create_pi();
+  auto const b = aig.create_pi();
+  auto const c = aig.create_pi();
+  aig.create_po( aig.create_or( aig.create_and( a, b ), aig.create_and( a, c ) ) );
+
+  clear_trace();
+
+  exact_library_params eps;
+  xag_npn_resynthesis<aig_network, aig_network, xag_npn_db_kind::aig_complete> resyn;
+  exact_library<aig_network> exact_lib( resyn, eps );
+  rewrite( aig, exact_lib );
+
+  std::ostringstream os;
+  write_chrome_trace( os );
+  CHECK( ( os.str().find( "\"name\":\"rewrite\"" ) != std::string::npos ) == tracing_enabled );
+  CHECK( ( os.str().find( "\"args\":{\"gates\":" ) != std::string::npos ) == tracing_enabled );
+}
@@ -0,0 +1,162 @@
+#include <catch.hpp>
+
+#include <set>
+#include <thread>
+#include <vector>
+
+#include <kitty/static_truth_table.hpp>
+#include <mockturtle/algorithms/simulation.hpp>
+#include <mockturtle/networks/aig.hpp>
+#include <mockturtle/networks/klut.hpp>
+#include <mockturtle/networks/mig.hpp>
+#include <mockturtle/networks/xag.hpp>
+#include <mockturtle/traits.hpp>
+#include <mockturtle/views/depth_view.hpp>
+#include <mockturtle/views/fanout_view.hpp>
+#include <mockturtle/views/snapshot_view.hpp>
+
+using namespace mockturtle;
+
+template<typename Ntk>
+void test_snapshot_view_traits()
+{
+  using snapshot_ntk = snapshot_view<Ntk>;
+
+  CHECK( is_network_type_v<snapshot_ntk> );
+  CHECK( has_foreach_fanout_v<snapshot_ntk> );
+  CHECK( has_level_v<snapshot_ntk> );
+  CHECK( has_depth_v<snapshot_ntk> );
+  CHECK( !has_create_pi_v<snapshot_ntk> );
+  CHECK( !has_create_and_v<snapshot_ntk> );
+  CHECK( !has_substitute_node_v<snapshot_ntk> );
+}
+
+TEST_CASE( "create different snapshot views", "[snapshot_view]" )
+{
+  test_snapshot_view_traits<aig_network>();
+  test_snapshot_view_traits<xag_network>();
+  test_snapshot_view_traits<mig_network>();
+  test_snapshot_view_traits<klut_network>();
+}
+
+template<typename Ntk>
+void test_snapshot_structure()
+{
+  using node = node<Ntk>;
+
+  Ntk ntk;
+  auto const a = ntk.create_pi();
+  auto const b = ntk.create_pi();
+  auto const f1 = ntk.create_and( a, b );
+  auto const f2 = ntk.create_and( a, f1 );
+  auto const f3 = ntk.create_and( b, f1 );
+  auto const f4 = ntk.create_and( f2, f3 );
+  ntk.create_po( f4 );
+
+  snapshot_view snapshot{ ntk };
+  CHECK( snapshot.size() == ntk.size() );
+  CHECK( snapshot.num_gates() == 4u );
+  CHECK( snapshot.depth() == 3u );
+  CHECK( snapshot.level( ntk.get_node( f1 ) ) == 1u );
+  CHECK( snapshot.level( ntk.get_node( f4 ) ) == 3u );
+  CHECK( snapshot.fanout_size( ntk.get_node( f1 ) ) == 2u );
+  CHECK( snapshot.fanin_size( ntk.get_node( f4 ) ) == ntk.fanin_size( ntk.get_node( f4 ) ) );
+
+  std::set<node> fanouts;
+  snapshot.foreach_fanout( ntk.get_node( f1 ), [&]( auto const& n ) { fanouts.insert( n ); } );
+  CHECK( fanouts == std::set<node>{ ntk.get_node( f2 ), ntk.get_node( f3 ) } );
+
+  std::vector<signal<Ntk>> fanins;
+  snapshot.foreach_fanin( ntk.get_node( f2 ), [&]( auto const& f ) { fanins.emplace_back( f ); } );
+  CHECK( fanins.size() == ntk.fanin_size( ntk.get_node( f2 ) ) );
+
+  /* modifying the original network does not affect the snapshot */
+  auto const f5 = ntk.create_and( f4, a );
+  ntk.create_po( f5 );
+  CHECK( snapshot.size() + 1u == ntk.size() );
+  CHECK( snapshot.num_pos() == 1u );
+  CHECK( snapshot.fanout_size( ntk.get_node( f4 ) ) == 1u );
+
+  /* traversal ids are local to each copy */
+  auto copy = snapshot;
+  copy.incr_trav_id();
+  copy.set_visited( ntk.get_node( f1 ), copy.trav_id() );
+  CHECK( snapshot.visited( ntk.get_node( f1 ) ) == 0u );
+  CHECK( ntk.visited( ntk.get_node( f1 ) ) == 0u );
+
+  depth_view depth_snapshot{ snapshot };
+  CHECK( depth_snapshot.depth() == 3u );
+
+  fanout_view fanout_snapshot{ snapshot };
+  fanouts.clear();
+  fanout_snapshot.foreach_fanout( ntk.get_node( a ), [&]( auto const& n ) { fanouts.insert( n ); } );
+  CHECK( fanouts == std::set<node>{ ntk.get_node( f1 ), ntk.get_node( f2 ) } );
+}
+
+TEST_CASE( "structure of snapshot views", "[snapshot_view]" )
+{
+  test_snapshot_structure<aig_network>();
+  test_snapshot_structure<xag_network>();
+  test_snapshot_structure<mig_network>();
+}
+
+TEST_CASE( "topological order in snapshot view after substitution", "[snapshot_view]" )
+{
+  aig_network aig;
+  auto const a = aig.create_pi();
+  auto const b = aig.create_pi();
+  auto const c = aig.create_pi();
+  auto const f1 = aig.create_and( a, b );
+  auto const f2 = aig.create_and( f1, c );
+  aig.create_po( f2 );
+
+  /* f3 is created after f2 but becomes its fanin */
+  auto const f3 = aig.create_and( !a, c );
+  aig.substitute_node( aig.get_node( f1 ), f3 );
+
+  snapshot_view snapshot{ aig };
+  std::vector<node<aig_network>> order;
+  snapshot.foreach_gate( [&]( auto const& n ) { order.emplace_back( n ); } );
+  REQUIRE( order.size() == 2u );
+  CHECK( snapshot.level( order[0] ) == 1u );
+  CHECK( snapshot.level( order[1] ) == 2u );
+  CHECK( snapshot.depth() == 2u );
+}
+
+TEST_CASE( "concurrent algorithms on snapshot view", "[snapshot_view]" )
+{
+  aig_network aig;
+  std::vector<aig_network::signal> pis( 6 );
+  std::generate( pis.begin(), pis.end(), [&]() { return aig.create_pi(); } );
+  auto const f1 = aig.create_and( pis[0], pis[1] );
+  auto const f2 = aig.create_xor( pis[2], pis[3] );
+  auto const f3 = aig.create_maj( pis[4], pis[5], f1 );
+  aig.create_po( aig.create_or( f2, f3 ) );
+  aig.create_po( f1 );
+
+  auto const expected = simulate<kitty::static_truth_table<6>>( aig );
+  snapshot_view const snapshot{ aig };
+
+  std::vector<std::vector<kitty::static_truth_table<6>>> sims( 4 );
+  std::vector<uint32_t> depths( 4 );
+  std::vector<std::thread> threads;
+  for ( auto i = 0u; i < 4u; ++i )
+  {
+    threads.emplace_back( [&, i, snapshot]() {
+      sims[i] = simulate<kitty::static_truth_table<6>>( snapshot );
+      depth_view dsnapshot{ snapshot };
+      depths[i] = dsnapshot.depth();
+    } );
+  }
+  for ( auto& t : threads )
+  {
+    t.join();
+  }
+
+  depth_view daig{ aig };
+  for ( auto i = 0u; i < 4u; ++i )
+  {
+    CHECK( sims[i] == expected );
+    CHECK( depths[i] == daig.depth() );
+  }
+}